@@ -1,9 +1,11 @@
-import { useState, useCallback, useEffect, useMemo } from 'react';
+import { useState, useCallback, useEffect, useRef } from 'react';
 import {
   SimulationEngine,
   createSimulationBuilder,
   PresetName,
   Observer,
+  AgentView,
+  RenderFrame,
   createObserver,
   SimulationState,
   createSaveFile,
@@ -21,6 +23,10 @@ import styles from './App.module.css';
 
 const SPEED_OPTIONS = [0.25, 0.5, 1, 2, 4];
 
+// Simulation callbacks come from the builder and frames from the canvas
+// render loop; the observer runs no loop of its own
+const OBSERVER_CONFIG = { trackAgentEvents: false, trackStateChanges: false };
+
 export function App() {
   const [simulation, setSimulation] = useState<SimulationEngine | null>(null);
   const [observer, setObserver] = useState<Observer | null>(null);
@@ -31,6 +37,8 @@ export function App() {
   const [renderSettings, setRenderSettings] = useState<RenderSettings>(DEFAULT_RENDER_SETTINGS);
   const [showShortcuts, setShowShortcuts] = useState(false);
   const [selectedAgentId, setSelectedAgentId] = useState<string | null>(null);
+  const [selectedAgent, setSelectedAgent] = useState<AgentView | null>(null);
+  const inspectedFrame = useRef(0);
 
   const initSimulation = useCallback((presetName: PresetName) => {
     // Clean up existing simulation
@@ -49,7 +57,7 @@ export function App() {
       .buildAndInitialize();
 
     // Create observer
-    const obs = createObserver(sim);
+    const obs = createObserver(sim, OBSERVER_CONFIG);
 
     setSimulation(sim);
     setObserver(obs);
@@ -147,7 +155,7 @@ export function App() {
     }
 
     // Create observer for loaded simulation
-    const obs = createObserver(loadedSim);
+    const obs = createObserver(loadedSim, OBSERVER_CONFIG);
 
     setSimulation(loadedSim);
     setObserver(obs);
@@ -157,12 +165,23 @@ export function App() {
     setSelectedAgentId(null);
   }, [simulation, observer]);
 
-  // Get selected agent data from observer
-  const selectedAgent = useMemo(() => {
-    if (!observer || !selectedAgentId) return null;
-    const view = observer.getView();
-    return view.agents.find((a) => a.id === selectedAgentId) ?? null;
-  }, [observer, selectedAgentId, tick]); // Re-compute on tick change
+  useEffect(() => {
+    inspectedFrame.current = 0;
+    setSelectedAgent(observer && selectedAgentId ? observer.getAgentView(selectedAgentId) : null);
+  }, [observer, selectedAgentId]);
+
+  // After each canvas frame, refresh the selected agent only when a delta
+  // reports a change to its slot. Energy drains every tick, so age and
+  // rotation follow along.
+  const handleFrame = useCallback((_frame: RenderFrame) => {
+    if (!observer || !simulation || !selectedAgentId) return;
+
+    const delta = observer.getDelta(inspectedFrame.current);
+    inspectedFrame.current = delta.toFrame;
+    const slot = simulation.getAgentManager().getAgent(selectedAgentId)?.slot ?? -1;
+    if (delta.complete && !delta.agents.slots.includes(slot)) return;
+    setSelectedAgent(observer.getAgentView(selectedAgentId));
+  }, [observer, simulation, selectedAgentId]);
 
   // Keyboard shortcuts
   useKeyboardShortcuts({
@@ -223,6 +242,7 @@ export function App() {
             settings={renderSettings}
             selectedAgentId={selectedAgentId}
             onAgentSelect={handleAgentSelect}
+            onFrame={handleFrame}
           />
           <AgentInspector
             agent={selectedAgent}
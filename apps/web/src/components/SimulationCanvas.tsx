@@ -2,8 +2,9 @@ import { useRef, useEffect, useCallback, useState } from 'react';
 import {
   SimulationEngine,
   Observer,
-  AgentView,
-  FoodView,
+  RenderFrame,
+  AGENT_FLAG_ALIVE,
+  FOOD_FLAG_CONSUMED,
   energyToColor,
   generationToColor,
 } from '@genesisx/core-engine';
@@ -16,6 +17,7 @@ interface SimulationCanvasProps {
   settings: RenderSettings;
   selectedAgentId: string | null;
   onAgentSelect: (agentId: string | null) => void;
+  onFrame?: (frame: RenderFrame) => void;   // After each rendered frame
 }
 
 const COLORS = {
@@ -34,6 +36,7 @@ export function SimulationCanvas({
   settings,
   selectedAgentId,
   onAgentSelect,
+  onFrame,
 }: SimulationCanvasProps) {
   const canvasRef = useRef<HTMLCanvasElement>(null);
   const containerRef = useRef<HTMLDivElement>(null);
@@ -92,25 +95,26 @@ export function SimulationCanvas({
       const worldX = (clickX - offset.x) / scale;
       const worldY = (clickY - offset.y) / scale;
 
-      const view = observer.getView();
+      const frame = observer.captureFrame();
+      const { x, y } = frame.agents;
       const hitRadius = settings.agentSize * 2;
 
       // Find closest agent within hit radius
-      let closestAgent: AgentView | null = null;
+      let closestIndex = -1;
       let closestDistance = hitRadius;
 
-      for (const agent of view.agents) {
-        const dx = agent.x - worldX;
-        const dy = agent.y - worldY;
+      for (let i = 0; i < frame.agentCount; i++) {
+        const dx = x[i] - worldX;
+        const dy = y[i] - worldY;
         const distance = Math.sqrt(dx * dx + dy * dy);
 
         if (distance < closestDistance) {
           closestDistance = distance;
-          closestAgent = agent;
+          closestIndex = i;
         }
       }
 
-      onAgentSelect(closestAgent?.id ?? null);
+      onAgentSelect(closestIndex >= 0 ? frame.agentIds[closestIndex] : null);
     },
     [observer, offset, scale, settings.agentSize, onAgentSelect]
   );
@@ -124,7 +128,8 @@ export function SimulationCanvas({
       return;
     }
 
-    const view = observer.getView();
+    const frame = observer.captureFrame();
+    const world = observer.getWorld();
     const dpr = window.devicePixelRatio;
 
     // Clear canvas
@@ -138,31 +143,32 @@ export function SimulationCanvas({
 
     // Draw grid
     if (settings.showGrid) {
-      drawGrid(ctx, view.world.width, view.world.height);
+      drawGrid(ctx, world.width, world.height);
     }
 
     // Draw world border
     ctx.strokeStyle = '#333355';
     ctx.lineWidth = 2 / scale;
-    ctx.strokeRect(0, 0, view.world.width, view.world.height);
+    ctx.strokeRect(0, 0, world.width, world.height);
 
     // Draw food
-    for (const food of view.food) {
-      drawFood(ctx, food, settings);
+    for (let i = 0; i < frame.foodCount; i++) {
+      drawFood(ctx, frame, i, settings);
     }
 
     // Draw agents
-    for (const agent of view.agents) {
-      drawAgent(ctx, agent, settings, agent.id === selectedAgentId);
+    for (let i = 0; i < frame.agentCount; i++) {
+      drawAgent(ctx, frame, i, settings, frame.agentIds[i] === selectedAgentId);
     }
 
     ctx.restore();
 
     // Draw overlay info
-    drawOverlay(ctx, view.tick, view.agents.length, view.food.length);
+    drawOverlay(ctx, frame.tick, frame.agentCount, frame.foodCount);
+    onFrame?.(frame);
 
     animationRef.current = requestAnimationFrame(render);
-  }, [observer, scale, offset, settings, selectedAgentId]);
+  }, [observer, scale, offset, settings, selectedAgentId, onFrame]);
 
   // Start render loop
   useEffect(() => {
@@ -207,52 +213,61 @@ function drawGrid(ctx: CanvasRenderingContext2D, width: number, height: number)
 
 function drawFood(
   ctx: CanvasRenderingContext2D,
-  food: FoodView,
+  frame: RenderFrame,
+  i: number,
   settings: RenderSettings
 ) {
-  if (food.isConsumed) return;
+  const food = frame.food;
+  if (food.flags[i] & FOOD_FLAG_CONSUMED) return;
 
   const color = energyToColor(
-    food.energy,
-    food.maxEnergy,
+    food.energy[i],
+    food.maxEnergy[i],
     COLORS.food,
     COLORS.foodDepleted
   );
 
   ctx.fillStyle = color;
   ctx.beginPath();
-  ctx.arc(food.x, food.y, settings.foodSize, 0, Math.PI * 2);
+  ctx.arc(food.x[i], food.y[i], settings.foodSize, 0, Math.PI * 2);
   ctx.fill();
 }
 
 function drawAgent(
   ctx: CanvasRenderingContext2D,
-  agent: AgentView,
+  frame: RenderFrame,
+  i: number,
   settings: RenderSettings,
   isSelected: boolean
 ) {
   const size = settings.agentSize;
+  const agents = frame.agents;
+  const x = agents.x[i];
+  const y = agents.y[i];
+  const energy = agents.energy[i];
+  const maxEnergy = agents.maxEnergy[i];
+  const isAlive = (agents.flags[i] & AGENT_FLAG_ALIVE) !== 0;
 
   // Determine color
   let color: string;
   if (isSelected) {
     color = COLORS.agentSelected;
-  } else if (!agent.isAlive) {
+  } else if (!isAlive) {
     color = COLORS.agentDead;
   } else if (settings.colorByGeneration) {
-    color = generationToColor(agent.generation);
+    color = generationToColor(agents.generation[i]);
   } else {
     color = energyToColor(
-      agent.energy,
-      agent.maxEnergy,
+      energy,
+      maxEnergy,
       COLORS.agent,
       COLORS.agentDead
     );
   }
 
   ctx.save();
-  ctx.translate(agent.x, agent.y);
-  ctx.rotate(agent.rotation);
+  ctx.translate(x, y);
+  ctx.rotate(agents.rotation[i]);
 
   // Draw body (triangle pointing in direction)
   ctx.fillStyle = color;
@@ -273,7 +288,7 @@ function drawAgent(
   }
 
   // Draw direction indicator
-  if (settings.showAgentDirection && agent.isAlive) {
+  if (settings.showAgentDirection && isAlive) {
     ctx.strokeStyle = 'rgba(255, 255, 255, 0.5)';
     ctx.lineWidth = 1;
     ctx.beginPath();
@@ -285,18 +300,18 @@ function drawAgent(
   ctx.restore();
 
   // Draw energy bar
-  if (settings.showAgentEnergy && agent.isAlive) {
+  if (settings.showAgentEnergy && isAlive) {
     const barWidth = size * 2;
     const barHeight = 3;
-    const energyRatio = agent.energy / agent.maxEnergy;
+    const energyRatio = energy / maxEnergy;
 
     ctx.fillStyle = 'rgba(0, 0, 0, 0.5)';
-    ctx.fillRect(agent.x - barWidth / 2, agent.y - size - 6, barWidth, barHeight);
+    ctx.fillRect(x - barWidth / 2, y - size - 6, barWidth, barHeight);
 
     ctx.fillStyle = energyRatio > 0.3 ? COLORS.agent : '#f87171';
     ctx.fillRect(
-      agent.x - barWidth / 2,
-      agent.y - size - 6,
+      x - barWidth / 2,
+      y - size - 6,
       barWidth * energyRatio,
       barHeight
     );
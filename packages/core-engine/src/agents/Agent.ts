@@ -4,7 +4,17 @@
 
 import { Brain, SensoryInput, BrainOutput } from '../neural/Brain';
 import { Genome } from '../genetics/Genome';
-import { Action, Actions, ActionResult } from './Action';
+import {
+  Action,
+  ActionType,
+  ActionResult,
+  MoveAction,
+  RotateAction,
+  EatAction,
+  ReproduceAction,
+  IdleAction,
+} from './Action';
+import type { AgentPool } from './AgentPool';
 
 export interface Position {
   x: number;
@@ -69,10 +79,25 @@ export class Agent {
   brain: Brain;
   genome: Genome;
 
+  // Dense index assigned by AgentManager for column-stored state (-1 = unmanaged)
+  slot: number = -1;
+
+  // Pool that offspring are drawn from (set by AgentManager when recycling)
+  pool?: AgentPool;
+
   private config: AgentConfig;
   private isAlive: boolean;
   private stats: AgentStats;
 
+  // Action records reused across ticks; see update()
+  private readonly actionList: Action[] = [];
+  private readonly moveAction: MoveAction = { type: ActionType.MOVE, speed: 0, timestamp: 0 };
+  private readonly rotateAction: RotateAction = { type: ActionType.ROTATE, angleDelta: 0, timestamp: 0 };
+  private readonly eatAction: EatAction = { type: ActionType.EAT, targetId: undefined, timestamp: 0 };
+  private readonly reproduceAction: ReproduceAction = { type: ActionType.REPRODUCE, mateId: undefined, timestamp: 0 };
+  private readonly idleAction: IdleAction = { type: ActionType.IDLE, timestamp: 0 };
+  private readonly brainOutput: BrainOutput = { moveForward: 0, rotate: 0, action: 0 };
+
   onDeath?: (agent: Agent) => void;
   onReproduce?: (parent: Agent, offspring: Agent) => void;
 
@@ -109,6 +134,11 @@ export class Agent {
     };
   }
 
+  /**
+   * Advance one tick and return the chosen actions. The returned array and
+   * its action records are owned by the agent and overwritten by the next
+   * update() call; copy them to keep them longer.
+   */
   update(sensoryInput: SensoryInput, deltaTime: number = 1): Action[] {
     if (!this.isAlive) return [];
 
@@ -121,32 +151,43 @@ export class Agent {
       return [];
     }
 
-    const brainOutput = this.brain.think(sensoryInput);
+    const brainOutput = this.brain.thinkInto
+      ? this.brain.thinkInto(sensoryInput, this.brainOutput)
+      : this.brain.think(sensoryInput);
     return this.interpretBrainOutput(brainOutput);
   }
 
   private interpretBrainOutput(output: BrainOutput): Action[] {
-    const actions: Action[] = [];
+    const actions = this.actionList;
+    const timestamp = Date.now();
+    actions.length = 0;
 
     // Move forward based on moveForward output
     if (output.moveForward > 0.1) {
-      actions.push(Actions.move(output.moveForward));
+      this.moveAction.speed = Math.max(0, Math.min(1, output.moveForward));
+      this.moveAction.timestamp = timestamp;
+      actions.push(this.moveAction);
     }
 
     // Rotate based on rotate output (positive = left, negative = right)
     if (Math.abs(output.rotate) > 0.1) {
-      actions.push(Actions.rotate(output.rotate * this.config.rotationSpeed));
+      this.rotateAction.angleDelta = output.rotate * this.config.rotationSpeed;
+      this.rotateAction.timestamp = timestamp;
+      actions.push(this.rotateAction);
     }
 
     // Action output: 0 = none, 1 = eat, 2 = reproduce
     if (output.action > 0.5 && output.action < 1.5) {
-      actions.push(Actions.eat());
+      this.eatAction.timestamp = timestamp;
+      actions.push(this.eatAction);
     } else if (output.action >= 1.5) {
-      actions.push(Actions.reproduce());
+      this.reproduceAction.timestamp = timestamp;
+      actions.push(this.reproduceAction);
     }
 
     if (actions.length === 0) {
-      actions.push(Actions.idle());
+      this.idleAction.timestamp = timestamp;
+      actions.push(this.idleAction);
     }
 
     return actions;
@@ -199,36 +240,65 @@ export class Agent {
   reproduce(mate?: Agent): Agent | null {
     if (!this.canReproduce()) return null;
 
-    let offspringGenome: Genome;
-    if (mate && mate.genome) {
-      offspringGenome = this.genome.crossover(mate.genome);
-    } else {
-      offspringGenome = this.genome.reproduce();
+    // Subclasses carry extra state, so only plain agents are recycled
+    const recycled = this.pool && this.constructor === Agent ? this.pool.acquire() : undefined;
+
+    let offspringGenome: Genome | undefined;
+    if (recycled) {
+      const reused = mate && mate.genome
+        ? this.genome.crossoverInto(mate.genome, recycled.genome)
+        : this.genome.reproduceInto(recycled.genome);
+      if (reused) offspringGenome = recycled.genome;
+    }
+    if (!offspringGenome) {
+      offspringGenome = mate && mate.genome
+        ? this.genome.crossover(mate.genome)
+        : this.genome.reproduce();
     }
 
-    // Clone and mutate brain - mutate returns a new brain instance
-    const offspringBrain = this.brain.clone().mutate(0.1, 0.2);
+    // Mutate into the recycled brain when possible, otherwise into a clone
+    const offspringBrain = recycled && this.brain.mutateInto?.(recycled.brain, 0.1, 0.2)
+      ? recycled.brain
+      : this.brain.clone().mutate(0.1, 0.2);
 
     const offspringId = `${this.id}_offspring_${Date.now()}`;
     const offsetAngle = Math.random() * 2 * Math.PI;
     const offsetDistance = this.config.maxSpeed * 2;
-    const offspringPosition: Position = {
-      x: this.position.x + Math.cos(offsetAngle) * offsetDistance,
-      y: this.position.y + Math.sin(offsetAngle) * offsetDistance,
-    };
-
-    const offspring = new Agent(
-      offspringId,
-      this.speciesId,
-      offspringPosition,
-      Math.random() * 2 * Math.PI,
-      this.config.maxEnergy * 0.5,
-      offspringBrain,
-      offspringGenome,
-      this.generation + 1,
-      this.lineageId,
-      this.config
-    );
+    const offspringX = this.position.x + Math.cos(offsetAngle) * offsetDistance;
+    const offspringY = this.position.y + Math.sin(offsetAngle) * offsetDistance;
+    const offspringRotation = Math.random() * 2 * Math.PI;
+
+    let offspring: Agent;
+    if (recycled) {
+      recycled.recycle(
+        offspringId,
+        this.speciesId,
+        offspringX,
+        offspringY,
+        offspringRotation,
+        this.config.maxEnergy * 0.5,
+        offspringBrain,
+        offspringGenome,
+        this.generation + 1,
+        this.lineageId,
+        this.config
+      );
+      offspring = recycled;
+    } else {
+      offspring = new Agent(
+        offspringId,
+        this.speciesId,
+        { x: offspringX, y: offspringY },
+        offspringRotation,
+        this.config.maxEnergy * 0.5,
+        offspringBrain,
+        offspringGenome,
+        this.generation + 1,
+        this.lineageId,
+        this.config
+      );
+    }
+    offspring.pool = this.pool;
 
     this.energy -= this.config.energyCostReproduce;
     this.stats.offspringProduced++;
@@ -238,6 +308,57 @@ export class Agent {
     return offspring;
   }
 
+  /**
+   * Reinitialize a dead, pooled agent in place as a newborn. Reuses the
+   * position, stats, config and action objects; brain and genome are
+   * replaced (usually by the same instances, rewritten by mutateInto /
+   * reproduceInto).
+   */
+  recycle(
+    id: string,
+    speciesId: string,
+    x: number,
+    y: number,
+    rotation: number,
+    energy: number,
+    brain: Brain,
+    genome: Genome,
+    generation: number,
+    lineageId: string,
+    config: AgentConfig
+  ): void {
+    const self = this as { id: string; speciesId: string; generation: number; lineageId: string };
+    self.id = id;
+    self.speciesId = speciesId;
+    self.generation = generation;
+    self.lineageId = lineageId;
+
+    this.position.x = x;
+    this.position.y = y;
+    this.rotation = rotation;
+    this.energy = energy;
+    this.brain = brain;
+    this.genome = genome;
+    if (config !== this.config) Object.assign(this.config, config);
+
+    this.age = 0;
+    this.isAlive = true;
+    this.slot = -1;
+    this.onDeath = undefined;
+    this.onReproduce = undefined;
+    this.actionList.length = 0;
+    this.stats.totalDistance = 0;
+    this.stats.foodEaten = 0;
+    this.stats.offspringProduced = 0;
+    this.stats.ticksAlive = 0;
+  }
+
+  /**
+   * Release storage held outside the agent when it is dropped without dying
+   * (reinitialize, load). The base agent holds none.
+   */
+  dispose(): void {}
+
   die(): void {
     if (!this.isAlive) return;
     this.isAlive = false;
@@ -264,6 +385,13 @@ export class Agent {
     return { ...this.config };
   }
 
+  /**
+   * Energy capacity, without copying the config (for per-frame readers)
+   */
+  get maxEnergy(): number {
+    return this.config.maxEnergy;
+  }
+
   toJSON(): AgentState {
     return {
       id: this.id,
@@ -0,0 +1,148 @@
+/**
+ * AgentPool.test.ts - Tests for agent recycling and reused action records
+ */
+
+import { describe, it, expect } from 'vitest';
+import { Agent } from './Agent';
+import { AgentPool } from './AgentPool';
+import { Genome } from '../genetics/Genome';
+import { NeuralBrain } from '../neural/NeuralBrain';
+import { SensoryInput } from '../neural/Brain';
+import { AgentManager } from '../simulation/AgentManager';
+
+const INPUT: SensoryInput = {
+  front: 0.5,
+  frontLeft: 0,
+  frontRight: 0,
+  left: 0,
+  right: 0,
+  energy: 1,
+  bias: 1,
+};
+
+function makeAgent(id: string): Agent {
+  return new Agent(
+    id,
+    'species_0',
+    { x: 10, y: 10 },
+    0,
+    100,
+    new NeuralBrain(),
+    Genome.withSize(10),
+    0,
+    id,
+    { matureAge: 0, reproductionThreshold: 10 }
+  );
+}
+
+describe('Agent action records', () => {
+  it('reuses the same action list across updates', () => {
+    const agent = makeAgent('a');
+
+    const first = agent.update(INPUT);
+    const firstTypes = first.map(a => a.type);
+    const second = agent.update(INPUT);
+
+    expect(second).toBe(first);
+    expect(second.map(a => a.type)).toEqual(firstTypes);
+    expect(second.length).toBeGreaterThan(0);
+  });
+
+  it('returns a fresh empty list for dead agents', () => {
+    const agent = makeAgent('a');
+    agent.die();
+    expect(agent.update(INPUT)).toEqual([]);
+  });
+});
+
+describe('AgentPool', () => {
+  it('only accepts dead agents and respects maxSize', () => {
+    const pool = new AgentPool({ maxSize: 1 });
+    const live = makeAgent('live');
+    const dead1 = makeAgent('d1');
+    const dead2 = makeAgent('d2');
+    dead1.die();
+    dead2.die();
+
+    expect(pool.release(live)).toBe(false);
+    expect(pool.release(dead1)).toBe(true);
+    expect(pool.release(dead2)).toBe(false);
+    const stats = pool.getStats();
+    expect(stats.available).toBe(1);
+    expect(stats.released).toBe(1);
+    expect(stats.dropped).toBe(1);
+
+    expect(pool.acquire()).toBe(dead1);
+    expect(pool.acquire()).toBeUndefined();
+  });
+
+  it('recycles a pooled agent, brain and genome as offspring', () => {
+    const pool = new AgentPool();
+    const parent = makeAgent('parent');
+    parent.pool = pool;
+
+    const corpse = makeAgent('corpse');
+    corpse.update(INPUT);
+    corpse.die();
+    const corpseBrain = corpse.brain;
+    const corpseGenome = corpse.genome;
+    pool.release(corpse);
+
+    const child = parent.reproduce();
+
+    expect(child).toBe(corpse);
+    expect(child!.alive()).toBe(true);
+    expect(child!.id).not.toBe('corpse');
+    expect(child!.generation).toBe(1);
+    expect(child!.age).toBe(0);
+    expect(child!.getStats().ticksAlive).toBe(0);
+    expect(child!.brain).toBe(corpseBrain);
+    expect(child!.genome).toBe(corpseGenome);
+    expect(child!.genome.parentId).toBe(parent.genome.id);
+    expect(child!.pool).toBe(pool);
+    expect(pool.getStats().reused).toBe(1);
+  });
+
+  it('allocates a new agent when the pool is empty', () => {
+    const parent = makeAgent('parent');
+    parent.pool = new AgentPool();
+
+    const child = parent.reproduce();
+
+    expect(child).not.toBeNull();
+    expect(child!.brain).not.toBe(parent.brain);
+  });
+});
+
+describe('NeuralBrain.mutateInto', () => {
+  it('writes mutated weights into a brain of the same shape', () => {
+    const source = new NeuralBrain();
+    const target = new NeuralBrain();
+
+    expect(source.mutateInto(target, 0, 0)).toBe(true);
+    expect(target.getNetwork().getWeights()).toEqual(source.getNetwork().getWeights());
+    expect(source.think(INPUT)).toEqual(target.think(INPUT));
+  });
+
+  it('rejects brains with a different shape', () => {
+    const source = new NeuralBrain();
+    const target = new NeuralBrain({ hiddenSize: 4 });
+    expect(source.mutateInto(target)).toBe(false);
+  });
+});
+
+describe('AgentManager recycling', () => {
+  it('does not pool agents unless recycleAgents is set', () => {
+    const manager = new AgentManager(100, 100, { initialPopulation: 3 });
+    manager.initialize();
+    const agent = manager.getAllAgents()[0];
+    expect(agent.pool).toBeUndefined();
+  });
+
+  it('hands its pool to agents when recycleAgents is set', () => {
+    const manager = new AgentManager(100, 100, { initialPopulation: 3, recycleAgents: true });
+    manager.initialize();
+    const agent = manager.getAllAgents()[0];
+    expect(agent.pool).toBe(manager.getAgentPool());
+  });
+});
@@ -0,0 +1,99 @@
+/**
+ * AgentPool.ts - Free list of dead agents for recycling
+ *
+ * Births in a steady-state population are roughly matched by deaths, so
+ * instead of constructing a new Agent (plus position, stats, action records,
+ * brain weights and gene buffer) per birth, dead agents are parked here and
+ * reinitialized in place by Agent.reproduce().
+ *
+ * Only agents that nothing else references may be released: a recycled
+ * agent keeps its object identity under a new id.
+ */
+
+import type { Agent } from './Agent';
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+export interface AgentPoolConfig {
+  maxSize: number;   // Agents kept beyond this are left to the GC
+}
+
+export const DEFAULT_AGENT_POOL_CONFIG: AgentPoolConfig = {
+  maxSize: 256,
+};
+
+export interface AgentPoolStats {
+  available: number;
+  released: number;
+  reused: number;
+  dropped: number;
+}
+
+// ============================================================================
+// AgentPool Class
+// ============================================================================
+
+export class AgentPool {
+  private config: AgentPoolConfig;
+  private free: Agent[] = [];
+  private released: number = 0;
+  private reused: number = 0;
+  private dropped: number = 0;
+
+  constructor(config?: Partial<AgentPoolConfig>) {
+    this.config = { ...DEFAULT_AGENT_POOL_CONFIG, ...config };
+  }
+
+  get size(): number {
+    return this.free.length;
+  }
+
+  /**
+   * Park a dead agent for reuse. Live agents are ignored.
+   */
+  release(agent: Agent): boolean {
+    if (agent.alive()) return false;
+    if (this.free.length >= this.config.maxSize) {
+      this.dropped++;
+      return false;
+    }
+
+    agent.pool = undefined;
+    agent.onDeath = undefined;
+    agent.onReproduce = undefined;
+    this.free.push(agent);
+    this.released++;
+    return true;
+  }
+
+  /**
+   * Take a parked agent, or undefined when the pool is empty. The caller
+   * must reinitialize it (Agent.recycle) before use.
+   */
+  acquire(): Agent | undefined {
+    const agent = this.free.pop();
+    if (agent) this.reused++;
+    return agent;
+  }
+
+  clear(): void {
+    this.free.length = 0;
+  }
+
+  getStats(): AgentPoolStats {
+    return {
+      available: this.free.length,
+      released: this.released,
+      reused: this.reused,
+      dropped: this.dropped,
+    };
+  }
+
+  getConfig(): AgentPoolConfig {
+    return { ...this.config };
+  }
+}
+
+export default AgentPool;
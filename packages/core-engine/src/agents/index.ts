@@ -23,3 +23,10 @@ export {
   type AgentState,
   DEFAULT_AGENT_CONFIG,
 } from './Agent';
+
+export {
+  AgentPool,
+  type AgentPoolConfig,
+  type AgentPoolStats,
+  DEFAULT_AGENT_POOL_CONFIG,
+} from './AgentPool';
@@ -93,6 +93,13 @@ export interface GridLayerConfig {
   min?: number;
   max?: number;
   wrapEdges?: boolean;
+  shared?: boolean;   // Back the layer with a SharedArrayBuffer (worker kernels)
+  backend?: 'dense' | 'chunked' | 'file';   // Storage backend (default dense)
+  chunkSize?: number; // Tile edge length for the chunked backend
+  file?: string;      // Backing file for the file backend (Node only)
+  pageSize?: number;  // Elements per cached page for the file backend
+  cachePages?: number; // Pages kept in memory by the file backend
+  resume?: boolean;    // File backend: continue from the existing file instead of defaultValue
 }
 
 /**
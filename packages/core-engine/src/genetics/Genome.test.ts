@@ -249,6 +249,29 @@ describe('Genome', () => {
         expect(parent.getGene(i)).toBeCloseTo(0.5, 5);
       }
     });
+
+    it('should reproduce into an existing genome', () => {
+      const parent = new Genome({ size: 10, initRange: [-1, 1], generation: 3 });
+      const target = new Genome({ size: 10, generation: 9 });
+      const oldId = target.id;
+
+      expect(parent.reproduceInto(target, 0, false)).toBe(true);
+
+      expect(target.id).not.toBe(oldId);
+      expect(target.generation).toBe(4);
+      expect(target.parentId).toBe(parent.id);
+      for (let i = 0; i < 10; i++) {
+        expect(target.getGene(i)).toBeCloseTo(parent.getGene(i), 5);
+      }
+    });
+
+    it('should refuse to reproduce into a genome of another size', () => {
+      const parent = new Genome({ size: 10 });
+      const target = new Genome({ size: 5 });
+
+      expect(parent.reproduceInto(target)).toBe(false);
+      expect(target.parentId).toBeNull();
+    });
   });
 
   // =====================
@@ -305,6 +328,19 @@ describe('Genome', () => {
       const offspring = parent1.crossover(parent2);
       expect(offspring.parentId).toBe(parent1.id);
     });
+
+    it('should cross over into an existing genome', () => {
+      const target = new Genome({ size: 10 });
+      for (let i = 0; i < 10; i++) target.setGene(i, 0.5);
+
+      expect(parent1.crossoverInto(parent2, target)).toBe(true);
+
+      expect(target.parentId).toBe(parent1.id);
+      for (let i = 0; i < 10; i++) {
+        expect([0, 1]).toContain(target.getGene(i));
+      }
+      expect(parent1.crossoverInto(parent2, parent1)).toBe(false);
+    });
   });
 
   // =====================
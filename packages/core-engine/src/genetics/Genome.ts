@@ -209,6 +209,73 @@ export class Genome {
     return child;
   }
 
+  /**
+   * reproduce() into an existing genome of the same size, reusing its gene
+   * buffer. The target takes a fresh id and lineage stats. Returns false
+   * when the sizes differ.
+   */
+  reproduceInto(target: Genome, tick: number = 0, mutate: boolean = true): boolean {
+    if (target === this || target._genes.length !== this._genes.length) return false;
+
+    target.reinitialize(this._stats.generation + 1, this.id, this._mutationConfig);
+    target._genes.set(this._genes);
+    if (mutate) {
+      target.mutateGenes(tick);
+    }
+    return true;
+  }
+
+  /**
+   * crossover() into an existing genome of the same size, reusing its gene
+   * buffer. Returns false when the sizes differ.
+   */
+  crossoverInto(other: Genome, target: Genome, crossoverRate: number = 0.5): boolean {
+    const n = this._genes.length;
+    if (other._genes.length !== n || target._genes.length !== n) return false;
+    if (target === this || target === other) return false;
+
+    target.reinitialize(
+      Math.max(this._stats.generation, other._stats.generation) + 1,
+      this.id,
+      this._mutationConfig
+    );
+    for (let i = 0; i < n; i++) {
+      target._genes[i] = Math.random() < crossoverRate
+        ? other._genes[i]
+        : this._genes[i];
+    }
+    return true;
+  }
+
+  private reinitialize(generation: number, parentId: GenomeId, mutationConfig: MutationConfig): void {
+    (this as { id: GenomeId }).id = Genome.generateId();
+    Object.assign(this._mutationConfig, mutationConfig);
+    this._stats.generation = generation;
+    this._stats.mutationCount = 0;
+    this._stats.lastMutationTick = 0;
+    this._stats.parentId = parentId;
+    this._stats.createdAt = Date.now();
+  }
+
+  // mutate() without the per-gene result record
+  private mutateGenes(tick: number): void {
+    const config = this._mutationConfig;
+    for (let i = 0; i < this._genes.length; i++) {
+      if (Math.random() < config.mutationRate) {
+        const delta = config.useGaussian
+          ? this.randomGaussian() * config.mutationMagnitude
+          : (Math.random() - 0.5) * 2 * config.mutationMagnitude;
+        this._genes[i] = Math.max(
+          config.minValue,
+          Math.min(config.maxValue, this._genes[i] + delta)
+        );
+      }
+    }
+
+    this._stats.mutationCount++;
+    this._stats.lastMutationTick = tick;
+  }
+
   distanceFrom(other: Genome): number {
     if (this._genes.length !== other._genes.length) {
       throw new Error('Cannot calculate distance between genomes of different sizes');
@@ -14,9 +14,15 @@ export * from './engine/EngineConfig';
 
 // World and grid system
 export { World, StandardLayers } from './world/World';
-export type { Position, Region, WorldStats } from './world/World';
+export type { Position, Region, WorldStats, LayerUpdate, WorldCheckpoint } from './world/World';
 export { Grid, GridManager } from './world/Grid';
-export type { TypedArray, GridDataType } from './world/Grid';
+export { ChunkedGrid } from './world/ChunkedGrid';
+export { FileBackedGrid, registerFileGridBackend } from './world/FileBackedGrid';
+export type { TypedArray, GridDataType, GridCheckpoint } from './world/Grid';
+export { getRadiusStencil } from './world/RadiusStencil';
+export type { RadiusStencil } from './world/RadiusStencil';
+export { GridWorkerPool } from './world/GridWorkers';
+export type { GridWorkerPoolConfig } from './world/GridWorkers';
 
 // Species system
 export * from './species/SpeciesDefinition';
@@ -9,9 +9,11 @@ import {
   createMorphologicalAgent,
 } from './MorphologicalAgent';
 import { MorphologyGenome } from './MorphologyGenome';
+import { PhenotypeTable } from './PhenotypeTable';
 import { Genome } from '../genetics/Genome';
 import { Brain, SensoryInput, BrainOutput } from '../neural/Brain';
 import { TrophicAgent } from '../trophic/types';
+import { InteractionSystem } from '../simulation/InteractionSystem';
 
 // Simple test brain implementation
 class TestBrain implements Brain {
@@ -227,6 +229,36 @@ describe('MorphologicalAgent', () => {
       expect(traits.mass).toBeDefined();
       expect(traits.segmentCount).toBeGreaterThan(0);
     });
+
+    it('should keep compiled traits after death releases the row', () => {
+      const size = agent.physicalSize;
+      const combat = agent.getCombatScore();
+      expect(agent.getPhenotypeSlot()).toBeGreaterThanOrEqual(0);
+
+      agent.die();
+
+      expect(agent.getPhenotypeSlot()).toBe(-1);
+      expect(agent.physicalSize).toBe(size);
+      expect(agent.getCombatScore()).toBe(combat);
+    });
+
+    it('should release the row when disposed without dying', () => {
+      const table = new PhenotypeTable(4);
+      const owned = new MorphologicalAgent(
+        'owned', 'species', { x: 0, y: 0 }, 0, 100, brain, genome, morphGenome, 0, 'lineage',
+        { phenotypeTable: table }
+      );
+      const size = owned.physicalSize;
+      expect(table.size).toBe(1);
+
+      owned.dispose();
+      expect(table.size).toBe(0);
+      expect(owned.getPhenotypeSlot()).toBe(-1);
+      expect(owned.physicalSize).toBe(size);
+
+      owned.die();
+      expect(table.size).toBe(0);
+    });
   });
 
   // =====================
@@ -348,6 +380,21 @@ describe('MorphologicalAgent', () => {
       expect(range).toBeGreaterThan(50);
       expect(range).toBe(50 + agent.physicalPerception * 100);
     });
+
+    it('should collide at the sum of both body radii', () => {
+      const other = new MorphologicalAgent(
+        'test-agent-2', 'test-species', { x: 100, y: 100 }, 0, 100,
+        brain, genome, morphGenome, 1, 'test-lineage'
+      );
+      const contact = agent.getCollisionRadius() + other.getCollisionRadius();
+      const system = new InteractionSystem(1000, 1000, { collisionRadius: 0.5 });
+
+      other.position.x = 100 + contact * 0.99;
+      expect(system.detectCollisions([agent, other])).toHaveLength(1);
+
+      other.position.x = 100 + contact * 1.01;
+      expect(system.detectCollisions([agent, other])).toHaveLength(0);
+    });
   });
 
   // =====================
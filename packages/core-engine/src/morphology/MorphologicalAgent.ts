@@ -11,6 +11,14 @@ import { Genome } from '../genetics/Genome';
 import { MorphologyGenome } from './MorphologyGenome';
 import { MorphologyDecoder } from './MorphologyDecoder';
 import { MorphologyPhenotype, MorphologyConfig, DEFAULT_MORPHOLOGY_CONFIG } from './types';
+import {
+  PhenotypeTable,
+  PhenotypeField,
+  PHENOTYPE_STRIDE,
+  getDefaultPhenotypeTable,
+  computeCollisionRadius,
+  computeVisionRange,
+} from './PhenotypeTable';
 import { TrophicAgent } from '../trophic/types';
 
 // ============================================================================
@@ -21,6 +29,7 @@ export interface MorphologicalAgentConfig extends AgentConfig {
   morphologyConfig: MorphologyConfig;
   usePhysicalTraits: boolean;  // Override config with morphology-derived traits
   traitInfluence: number;      // How much morphology affects traits [0, 1]
+  phenotypeTable?: PhenotypeTable; // Table holding compiled rows (default: shared table)
 }
 
 export const DEFAULT_MORPHOLOGICAL_AGENT_CONFIG: MorphologicalAgentConfig = {
@@ -36,15 +45,21 @@ export const DEFAULT_MORPHOLOGICAL_AGENT_CONFIG: MorphologicalAgentConfig = {
 
 export class MorphologicalAgent extends Agent implements TrophicAgent {
   private morphologyGenome: MorphologyGenome;
-  private phenotype: MorphologyPhenotype;
+  private phenotype: MorphologyPhenotype | null = null;
   private decoder: MorphologyDecoder;
   private morphConfig: MorphologicalAgentConfig;
 
+  // Compiled phenotype row (see PhenotypeTable)
+  private phenotypeTable: PhenotypeTable;
+  private phenotypeSlot: number;
+  private phenotypeRow: Float32Array;
+  private phenotypeOffset: number;
+
   // Physical traits derived from morphology
-  readonly physicalSize: number;
-  readonly physicalSpeed: number;
-  readonly physicalStrength: number;
-  readonly physicalPerception: number;
+  get physicalSize(): number { return this.phenotypeRow[this.phenotypeOffset + PhenotypeField.BOUNDING_RADIUS]; }
+  get physicalSpeed(): number { return this.phenotypeRow[this.phenotypeOffset + PhenotypeField.SPEED]; }
+  get physicalStrength(): number { return this.phenotypeRow[this.phenotypeOffset + PhenotypeField.STRENGTH]; }
+  get physicalPerception(): number { return this.phenotypeRow[this.phenotypeOffset + PhenotypeField.PERCEPTION]; }
 
   // TrophicAgent implementation
   get size(): number { return this.physicalSize; }
@@ -72,9 +87,13 @@ export class MorphologicalAgent extends Agent implements TrophicAgent {
       ...config,
     };
 
-    // Initialize decoder and decode phenotype
+    // Compile phenotype into a table row; the segment tree is built lazily
     const decoder = new MorphologyDecoder(fullConfig.morphologyConfig);
-    const phenotype = decoder.decode(morphologyGenome);
+    const table = fullConfig.phenotypeTable ?? getDefaultPhenotypeTable();
+    const slot = table.allocate();
+    const row = table.pageOf(slot);
+    const offset = table.offsetOf(slot);
+    decoder.compile(morphologyGenome, row, offset);
 
     // Calculate effective traits based on morphology
     const influence = fullConfig.traitInfluence;
@@ -84,17 +103,17 @@ export class MorphologicalAgent extends Agent implements TrophicAgent {
       // Blend base config with phenotype-derived values
       effectiveConfig.maxSpeed = blendValue(
         fullConfig.maxSpeed,
-        phenotype.speed,
+        row[offset + PhenotypeField.SPEED],
         influence
       );
       effectiveConfig.sensorRange = blendValue(
         fullConfig.sensorRange,
-        phenotype.perception * 150,
+        row[offset + PhenotypeField.PERCEPTION] * 150,
         influence
       );
       effectiveConfig.energyCostPerTick = blendValue(
         fullConfig.energyCostPerTick,
-        phenotype.metabolicRate,
+        row[offset + PhenotypeField.METABOLIC_RATE],
         influence
       );
     }
@@ -113,15 +132,12 @@ export class MorphologicalAgent extends Agent implements TrophicAgent {
     );
 
     this.morphologyGenome = morphologyGenome;
-    this.phenotype = phenotype;
     this.decoder = decoder;
     this.morphConfig = fullConfig;
-
-    // Store physical traits
-    this.physicalSize = phenotype.size;
-    this.physicalSpeed = phenotype.speed;
-    this.physicalStrength = phenotype.strength;
-    this.physicalPerception = phenotype.perception;
+    this.phenotypeTable = table;
+    this.phenotypeSlot = slot;
+    this.phenotypeRow = row;
+    this.phenotypeOffset = offset;
   }
 
   /**
@@ -210,8 +226,8 @@ export class MorphologicalAgent extends Agent implements TrophicAgent {
       offspringMorphGenome = this.morphologyGenome.mutate();
     }
 
-    // Clone and mutate brain
-    const offspringBrain = this.brain.clone().mutate(0.1, 0.2);
+    // Mutate brain - mutate returns a new brain instance
+    const offspringBrain = this.brain.mutate(0.1, 0.2);
 
     const config = this.getConfig() as MorphologicalAgentConfig;
     const offspringId = `${this.id}_offspring_${Date.now()}`;
@@ -245,12 +261,60 @@ export class MorphologicalAgent extends Agent implements TrophicAgent {
   }
 
   /**
-   * Get morphology phenotype
+   * Get the full morphology phenotype (segment tree).
+   * Decoded on first access; simulation hot paths use the compiled row instead.
    */
   getPhenotype(): MorphologyPhenotype {
+    if (!this.phenotype) {
+      this.phenotype = this.decoder.decode(this.morphologyGenome);
+    }
     return this.phenotype;
   }
 
+  /**
+   * Get the compiled phenotype slot (-1 once the agent has died)
+   */
+  getPhenotypeSlot(): number {
+    return this.phenotypeSlot;
+  }
+
+  /**
+   * Read a single compiled phenotype field
+   */
+  getPhenotypeField(field: PhenotypeField): number {
+    return this.phenotypeRow[this.phenotypeOffset + field];
+  }
+
+  /**
+   * Release the table row on death, keeping a private copy of the values so
+   * that retained references (lineage, inspection) still read valid traits.
+   */
+  die(): void {
+    if (!this.alive()) return;
+    super.die();
+    this.releasePhenotypeRow();
+  }
+
+  /**
+   * Release the table row when the agent is dropped without dying
+   * (AgentManager.initialize / clearForRestore)
+   */
+  dispose(): void {
+    this.releasePhenotypeRow();
+  }
+
+  private releasePhenotypeRow(): void {
+    if (this.phenotypeSlot < 0) return;
+    const detached = this.phenotypeRow.slice(
+      this.phenotypeOffset,
+      this.phenotypeOffset + PHENOTYPE_STRIDE
+    );
+    this.phenotypeTable.release(this.phenotypeSlot);
+    this.phenotypeSlot = -1;
+    this.phenotypeRow = detached;
+    this.phenotypeOffset = 0;
+  }
+
   /**
    * Get morphology genome
    */
@@ -273,17 +337,18 @@ export class MorphologicalAgent extends Agent implements TrophicAgent {
     limbCount: number;
     symmetryScore: number;
   } {
+    const phenotype = this.getPhenotype();
     return {
       size: this.physicalSize,
       speed: this.physicalSpeed,
       strength: this.physicalStrength,
       perception: this.physicalPerception,
-      agility: this.phenotype.agility,
-      metabolicRate: this.phenotype.metabolicRate,
-      mass: this.phenotype.totalMass,
-      segmentCount: this.phenotype.segmentCount,
-      limbCount: this.phenotype.limbCount,
-      symmetryScore: this.phenotype.symmetryScore,
+      agility: this.getPhenotypeField(PhenotypeField.AGILITY),
+      metabolicRate: this.getPhenotypeField(PhenotypeField.METABOLIC_RATE),
+      mass: this.getPhenotypeField(PhenotypeField.TOTAL_MASS),
+      segmentCount: phenotype.segmentCount,
+      limbCount: phenotype.limbCount,
+      symmetryScore: phenotype.symmetryScore,
     };
   }
 
@@ -291,37 +356,30 @@ export class MorphologicalAgent extends Agent implements TrophicAgent {
    * Calculate combat effectiveness (for hunting/fleeing)
    */
   getCombatScore(): number {
-    return (
-      this.physicalStrength * 0.4 +
-      this.physicalSpeed * 0.3 +
-      this.physicalSize * 0.2 +
-      this.phenotype.agility * 0.1
-    );
+    return this.phenotypeRow[this.phenotypeOffset + PhenotypeField.COMBAT];
   }
 
   /**
    * Calculate evasion score
    */
   getEvasionScore(): number {
-    return (
-      this.physicalSpeed * 0.4 +
-      this.phenotype.agility * 0.4 +
-      this.physicalPerception * 0.2
-    );
+    return this.phenotypeRow[this.phenotypeOffset + PhenotypeField.EVASION];
   }
 
   /**
    * Get collision radius based on size
    */
   getCollisionRadius(): number {
-    return Math.max(2, this.physicalSize * 0.5);
+    return computeCollisionRadius(this.physicalSize);
   }
 
   /**
    * Get vision range based on perception
    */
   getVisionRange(): number {
-    return 50 + this.physicalPerception * 100;
+    // Computed in double precision so it matches computeVisionRange() of
+    // the stored perception exactly; the VISION_RANGE column is float32
+    return computeVisionRange(this.physicalPerception);
   }
 
   /**
@@ -5,6 +5,7 @@
 import { describe, it, expect, beforeEach } from 'vitest';
 import { MorphologyDecoder } from './MorphologyDecoder';
 import { MorphologyGenome } from './MorphologyGenome';
+import { PhenotypeField, PHENOTYPE_STRIDE } from './PhenotypeTable';
 import {
   SegmentGene,
   GENES_PER_SEGMENT,
@@ -455,4 +456,35 @@ describe('MorphologyDecoder', () => {
       expect(phenotype.limbCount).toBe(expectedLimbs);
     });
   });
+
+  // =====================
+  // COMPILATION TESTS
+  // =====================
+  describe('compile', () => {
+    it('should match decoded traits', () => {
+      for (let i = 0; i < 20; i++) {
+        const genome = MorphologyGenome.random();
+        const phenotype = decoder.decode(genome);
+        const row = new Float32Array(PHENOTYPE_STRIDE);
+        decoder.compile(genome, row);
+
+        expect(row[PhenotypeField.SPEED]).toBe(Math.fround(phenotype.speed));
+        expect(row[PhenotypeField.STRENGTH]).toBe(Math.fround(phenotype.strength));
+        expect(row[PhenotypeField.AGILITY]).toBe(Math.fround(phenotype.agility));
+        expect(row[PhenotypeField.METABOLIC_RATE]).toBe(Math.fround(phenotype.metabolicRate));
+        expect(row[PhenotypeField.BOUNDING_RADIUS]).toBe(Math.fround(phenotype.size));
+        expect(row[PhenotypeField.PERCEPTION]).toBe(Math.fround(phenotype.perception));
+        expect(row[PhenotypeField.TOTAL_MASS]).toBe(Math.fround(phenotype.totalMass));
+      }
+    });
+
+    it('should write at the given offset', () => {
+      const genome = MorphologyGenome.random();
+      const row = new Float32Array(PHENOTYPE_STRIDE * 2);
+      decoder.compile(genome, row, PHENOTYPE_STRIDE);
+
+      expect(row[PhenotypeField.SPEED]).toBe(0);
+      expect(row[PHENOTYPE_STRIDE + PhenotypeField.SPEED]).toBeGreaterThan(0);
+    });
+  });
 });
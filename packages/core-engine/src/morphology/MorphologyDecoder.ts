@@ -15,7 +15,25 @@ import {
   DEFAULT_TRAIT_WEIGHTS,
   SerializedMorphology,
   SerializedSegment,
+  SegmentGene,
 } from './types';
+import {
+  PhenotypeField,
+  computeCombatScore,
+  computeEvasionScore,
+  computeVisionRange,
+} from './PhenotypeTable';
+
+// Accumulator slots used by compile()
+const ACC_MASS = 0;
+const ACC_SEGMENTS = 1;
+const ACC_SENSORS = 2;
+const ACC_EFFECTORS = 3;
+const ACC_NEURONS = 4;
+const ACC_LIMBS = 5;
+const ACC_FLEXIBILITY = 6;
+const ACC_EXTENT = 7;
+const ACC_SIZE = 8;
 
 // ============================================================================
 // MorphologyDecoder Class
@@ -24,6 +42,7 @@ import {
 export class MorphologyDecoder {
   private config: MorphologyConfig;
   private traitWeights: TraitWeights;
+  private compileScratch: Float64Array = new Float64Array(ACC_SIZE);
 
   constructor(
     config?: Partial<MorphologyConfig>,
@@ -54,6 +73,109 @@ export class MorphologyDecoder {
     return phenotype;
   }
 
+  /**
+   * Compile a MorphologyGenome directly into a fixed-layout phenotype row
+   * (see PhenotypeTable). Walks the same segment tree as decode() but only
+   * accumulates the aggregates needed for derived traits, so no segment
+   * objects are built.
+   */
+  compile(genome: MorphologyGenome, out: Float32Array, offset: number = 0): void {
+    const acc = this.compileScratch;
+    acc.fill(0);
+
+    this.accumulateSegment(genome, 0, 0, 1);
+    this.compileSubtree(genome, 0, 0, 1);
+
+    const segmentCount = acc[ACC_SEGMENTS];
+    const speed = this.calculateSpeed(acc[ACC_MASS], acc[ACC_LIMBS], acc[ACC_EFFECTORS]);
+    const strength = this.calculateStrength(acc[ACC_MASS], acc[ACC_EFFECTORS]);
+    const perception = this.calculatePerception(acc[ACC_SENSORS], acc[ACC_NEURONS], segmentCount);
+    const agility = this.agilityFromFlexibility(acc[ACC_FLEXIBILITY], segmentCount);
+    const metabolicRate = this.calculateMetabolicRate(acc[ACC_MASS], acc[ACC_NEURONS]);
+    const size = acc[ACC_EXTENT];
+
+    out[offset + PhenotypeField.SPEED] = speed;
+    out[offset + PhenotypeField.STRENGTH] = strength;
+    out[offset + PhenotypeField.AGILITY] = agility;
+    out[offset + PhenotypeField.METABOLIC_RATE] = metabolicRate;
+    out[offset + PhenotypeField.BOUNDING_RADIUS] = size;
+    out[offset + PhenotypeField.VISION_RANGE] = computeVisionRange(perception);
+    out[offset + PhenotypeField.COMBAT] = computeCombatScore(strength, speed, size, agility);
+    out[offset + PhenotypeField.EVASION] = computeEvasionScore(speed, agility, perception);
+    out[offset + PhenotypeField.PERCEPTION] = perception;
+    out[offset + PhenotypeField.TOTAL_MASS] = acc[ACC_MASS];
+  }
+
+  /**
+   * Add one segment's contribution to the compile accumulators.
+   * Mirrors createSegment() plus the child scaling in buildSegmentTree().
+   */
+  private accumulateSegment(
+    genome: MorphologyGenome,
+    segmentIndex: number,
+    depth: number,
+    scale: number
+  ): void {
+    const acc = this.compileScratch;
+    const { minSegmentSize, maxSegmentSize, minDensity, maxDensity, geneThreshold } = this.config;
+    const sizeRange = maxSegmentSize - minSegmentSize;
+
+    const length = (minSegmentSize + genome.getSegmentGene(segmentIndex, SegmentGene.LENGTH) * sizeRange) * scale;
+    const width = (minSegmentSize + genome.getSegmentGene(segmentIndex, SegmentGene.WIDTH) * sizeRange) * scale;
+    const height = (minSegmentSize + genome.getSegmentGene(segmentIndex, SegmentGene.HEIGHT) * sizeRange) * scale;
+    const density = minDensity + genome.getSegmentGene(segmentIndex, SegmentGene.DENSITY) * (maxDensity - minDensity);
+
+    acc[ACC_MASS] += length * width * height * density;
+    acc[ACC_SEGMENTS]++;
+    acc[ACC_FLEXIBILITY] += genome.getSegmentGene(segmentIndex, SegmentGene.FLEXIBILITY);
+    acc[ACC_EXTENT] = Math.max(acc[ACC_EXTENT], Math.max(length, width, height) * (depth + 1));
+
+    const hasEffectors = genome.getSegmentGene(segmentIndex, SegmentGene.HAS_EFFECTORS) > geneThreshold;
+    if (genome.getSegmentGene(segmentIndex, SegmentGene.HAS_SENSORS) > geneThreshold) acc[ACC_SENSORS]++;
+    if (genome.getSegmentGene(segmentIndex, SegmentGene.HAS_NEURONS) > geneThreshold) acc[ACC_NEURONS]++;
+    if (hasEffectors) acc[ACC_EFFECTORS]++;
+    if (depth > 0 && hasEffectors) acc[ACC_LIMBS]++;
+  }
+
+  /**
+   * Allocation-free counterpart of buildSegmentTree() used by compile()
+   */
+  private compileSubtree(
+    genome: MorphologyGenome,
+    parentIndex: number,
+    parentDepth: number,
+    nextSegmentIndex: number
+  ): number {
+    const acc = this.compileScratch;
+    const { maxDepth, maxSegments, maxChildrenPerSegment } = this.config;
+
+    if (parentDepth >= maxDepth - 1) return nextSegmentIndex;
+    if (acc[ACC_SEGMENTS] >= maxSegments) return nextSegmentIndex;
+    if (nextSegmentIndex >= genome.segmentCount) return nextSegmentIndex;
+
+    const recursionDepth = Math.floor(
+      genome.getSegmentGene(parentIndex, SegmentGene.RECURSION_DEPTH) * maxDepth
+    );
+    const childCount = Math.min(
+      genome.getChildCount(parentIndex, maxChildrenPerSegment),
+      maxSegments - acc[ACC_SEGMENTS]
+    );
+
+    if (childCount === 0 || recursionDepth === 0) return nextSegmentIndex;
+
+    const childScale = genome.getChildScale(parentIndex);
+
+    for (let i = 0; i < childCount && acc[ACC_SEGMENTS] < maxSegments; i++) {
+      if (nextSegmentIndex >= genome.segmentCount) break;
+
+      const childIndex = nextSegmentIndex++;
+      this.accumulateSegment(genome, childIndex, parentDepth + 1, childScale);
+      nextSegmentIndex = this.compileSubtree(genome, childIndex, parentDepth + 1, nextSegmentIndex);
+    }
+
+    return nextSegmentIndex;
+  }
+
   /**
    * Create a single body segment from genome data
    */
@@ -312,8 +434,17 @@ export class MorphologyDecoder {
       totalFlexibility += segment.properties.flexibility;
     }
 
-    const avgFlexibility = totalFlexibility / segments.length;
-    const segmentBonus = Math.min(0.3, segments.length * 0.03);
+    return this.agilityFromFlexibility(totalFlexibility, segments.length);
+  }
+
+  /**
+   * Agility from summed flexibility and segment count
+   */
+  private agilityFromFlexibility(totalFlexibility: number, segmentCount: number): number {
+    if (segmentCount === 0) return 0;
+
+    const avgFlexibility = totalFlexibility / segmentCount;
+    const segmentBonus = Math.min(0.3, segmentCount * 0.03);
 
     return Math.min(1, Math.max(0, avgFlexibility * 0.7 + segmentBonus));
   }
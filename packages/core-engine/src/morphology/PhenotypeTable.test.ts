@@ -0,0 +1,93 @@
+/**
+ * PhenotypeTable.test.ts - Tests for compiled phenotype storage
+ */
+
+import { describe, it, expect, beforeEach } from 'vitest';
+import {
+  PhenotypeTable,
+  PhenotypeField,
+  PHENOTYPE_STRIDE,
+  computeCollisionRadius,
+  computeVisionRange,
+} from './PhenotypeTable';
+
+describe('PhenotypeTable', () => {
+  let table: PhenotypeTable;
+
+  beforeEach(() => {
+    table = new PhenotypeTable(4);
+  });
+
+  describe('allocation', () => {
+    it('should allocate sequential slots', () => {
+      expect(table.allocate()).toBe(0);
+      expect(table.allocate()).toBe(1);
+      expect(table.size).toBe(2);
+    });
+
+    it('should reuse released slots', () => {
+      const a = table.allocate();
+      table.allocate();
+      table.release(a);
+
+      expect(table.size).toBe(1);
+      expect(table.allocate()).toBe(a);
+    });
+
+    it('should zero reused rows', () => {
+      const slot = table.allocate();
+      table.set(slot, PhenotypeField.SPEED, 3);
+      table.release(slot);
+
+      const reused = table.allocate();
+      expect(table.get(reused, PhenotypeField.SPEED)).toBe(0);
+    });
+
+    it('should grow by pages without moving existing rows', () => {
+      const first = table.allocate();
+      const page = table.pageOf(first);
+      table.set(first, PhenotypeField.COMBAT, 1.5);
+
+      for (let i = 0; i < 10; i++) table.allocate();
+
+      expect(table.capacity).toBe(12);
+      expect(table.pageOf(first)).toBe(page);
+      expect(page[table.offsetOf(first) + PhenotypeField.COMBAT]).toBe(1.5);
+    });
+  });
+
+  describe('layout', () => {
+    it('should place rows at stride offsets within a page', () => {
+      for (let i = 0; i < 6; i++) table.allocate();
+
+      expect(table.offsetOf(1)).toBe(PHENOTYPE_STRIDE);
+      expect(table.offsetOf(5)).toBe(PHENOTYPE_STRIDE);
+      expect(table.pageOf(5)).not.toBe(table.pageOf(1));
+    });
+
+    it('should report memory usage of allocated pages', () => {
+      table.allocate();
+      expect(table.memoryUsage()).toBe(4 * PHENOTYPE_STRIDE * 4);
+    });
+
+    it('should reset on clear', () => {
+      table.allocate();
+      table.clear();
+
+      expect(table.size).toBe(0);
+      expect(table.capacity).toBe(0);
+      expect(table.allocate()).toBe(0);
+    });
+  });
+
+  describe('derived formulas', () => {
+    it('should clamp collision radius to a minimum', () => {
+      expect(computeCollisionRadius(1)).toBe(2);
+      expect(computeCollisionRadius(10)).toBe(5);
+    });
+
+    it('should derive vision range from perception', () => {
+      expect(computeVisionRange(0.5)).toBe(100);
+    });
+  });
+});
@@ -0,0 +1,184 @@
+/**
+ * PhenotypeTable.ts - Compiled, fixed-layout phenotype storage
+ *
+ * Hot paths (hunting, collisions, movement) only need a handful of derived
+ * scalars per agent. Rather than walking the MorphologyPhenotype object graph,
+ * each agent owns one fixed-layout Float32Array row in a shared table. Rows
+ * are written once at decode time by MorphologyDecoder.compile().
+ *
+ * Rows live in fixed-size pages so that growing the table never moves an
+ * existing row: an agent can keep a direct reference to its page.
+ */
+
+// ============================================================================
+// Row Layout
+// ============================================================================
+
+export enum PhenotypeField {
+  SPEED = 0,
+  STRENGTH = 1,
+  AGILITY = 2,
+  METABOLIC_RATE = 3,
+  BOUNDING_RADIUS = 4,
+  VISION_RANGE = 5,
+  COMBAT = 6,
+  EVASION = 7,
+  PERCEPTION = 8,
+  TOTAL_MASS = 9,
+}
+
+export const PHENOTYPE_STRIDE = 10;
+
+export const DEFAULT_PHENOTYPE_PAGE_SIZE = 1024;
+
+// ============================================================================
+// Derived Trait Formulas
+// ============================================================================
+
+/**
+ * Combat effectiveness (for hunting/fleeing)
+ */
+export function computeCombatScore(
+  strength: number,
+  speed: number,
+  size: number,
+  agility: number
+): number {
+  return strength * 0.4 + speed * 0.3 + size * 0.2 + agility * 0.1;
+}
+
+/**
+ * Evasion effectiveness
+ */
+export function computeEvasionScore(speed: number, agility: number, perception: number): number {
+  return speed * 0.4 + agility * 0.4 + perception * 0.2;
+}
+
+/**
+ * Vision range based on perception
+ */
+export function computeVisionRange(perception: number): number {
+  return 50 + perception * 100;
+}
+
+/**
+ * Collision radius based on bounding radius
+ */
+export function computeCollisionRadius(boundingRadius: number): number {
+  return Math.max(2, boundingRadius * 0.5);
+}
+
+// ============================================================================
+// PhenotypeTable Class
+// ============================================================================
+
+export class PhenotypeTable {
+  readonly pageSize: number;
+
+  private pages: Float32Array[] = [];
+  private freeSlots: number[] = [];
+  private nextSlot: number = 0;
+  private liveCount: number = 0;
+
+  constructor(pageSize: number = DEFAULT_PHENOTYPE_PAGE_SIZE) {
+    this.pageSize = Math.max(1, Math.floor(pageSize));
+  }
+
+  /**
+   * Allocate a zeroed row and return its slot index
+   */
+  allocate(): number {
+    let slot: number;
+    if (this.freeSlots.length > 0) {
+      slot = this.freeSlots.pop()!;
+    } else {
+      slot = this.nextSlot++;
+      if (slot >= this.pages.length * this.pageSize) {
+        this.pages.push(new Float32Array(this.pageSize * PHENOTYPE_STRIDE));
+      }
+    }
+
+    const offset = this.offsetOf(slot);
+    this.pageOf(slot).fill(0, offset, offset + PHENOTYPE_STRIDE);
+    this.liveCount++;
+    return slot;
+  }
+
+  /**
+   * Return a row to the free list
+   */
+  release(slot: number): void {
+    if (slot < 0 || slot >= this.nextSlot) return;
+    this.freeSlots.push(slot);
+    this.liveCount--;
+  }
+
+  /**
+   * Page holding a slot's row. Stable for the lifetime of the table.
+   */
+  pageOf(slot: number): Float32Array {
+    return this.pages[Math.floor(slot / this.pageSize)];
+  }
+
+  /**
+   * Offset of a slot's row within its page
+   */
+  offsetOf(slot: number): number {
+    return (slot % this.pageSize) * PHENOTYPE_STRIDE;
+  }
+
+  get(slot: number, field: PhenotypeField): number {
+    return this.pageOf(slot)[this.offsetOf(slot) + field];
+  }
+
+  set(slot: number, field: PhenotypeField, value: number): void {
+    this.pageOf(slot)[this.offsetOf(slot) + field] = value;
+  }
+
+  /**
+   * Number of rows currently in use
+   */
+  get size(): number {
+    return this.liveCount;
+  }
+
+  /**
+   * Number of rows backed by allocated pages
+   */
+  get capacity(): number {
+    return this.pages.length * this.pageSize;
+  }
+
+  memoryUsage(): number {
+    return this.pages.length * this.pageSize * PHENOTYPE_STRIDE * Float32Array.BYTES_PER_ELEMENT;
+  }
+
+  /**
+   * Drop all rows. Outstanding slots become invalid.
+   */
+  clear(): void {
+    this.pages = [];
+    this.freeSlots = [];
+    this.nextSlot = 0;
+    this.liveCount = 0;
+  }
+}
+
+// ============================================================================
+// Default Table
+// ============================================================================
+
+let defaultTable: PhenotypeTable | null = null;
+
+export function getDefaultPhenotypeTable(): PhenotypeTable {
+  if (!defaultTable) {
+    defaultTable = new PhenotypeTable();
+  }
+  return defaultTable;
+}
+
+export function setDefaultPhenotypeTable(table: PhenotypeTable): void {
+  defaultTable = table;
+}
+
+export default PhenotypeTable;
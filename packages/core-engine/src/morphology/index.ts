@@ -7,8 +7,10 @@
 export * from './types';
 export * from './MorphologyGenome';
 export * from './MorphologyDecoder';
+export * from './PhenotypeTable';
 export * from './MorphologicalAgent';
 
 export { default as MorphologyGenome } from './MorphologyGenome';
 export { default as MorphologyDecoder } from './MorphologyDecoder';
+export { default as PhenotypeTable } from './PhenotypeTable';
 export { default as MorphologicalAgent } from './MorphologicalAgent';
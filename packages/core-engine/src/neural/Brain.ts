@@ -5,6 +5,8 @@
  * Enables a pluggable architecture for different decision-making systems.
  */
 
+import type { RecurrentStateBuffer } from './RecurrentStateBuffer';
+
 // ============================================================================
 // Types
 // ============================================================================
@@ -55,6 +57,33 @@ export interface Brain {
   crossover(other: Brain): Brain;
   serialize(): BrainState;
   getComplexity(): number;
+
+  /**
+   * Optional in-place variant of mutate(): overwrite `target` with a mutated
+   * copy of this brain, reusing its buffers. Returns false when the target
+   * is incompatible, in which case the caller falls back to mutate().
+   */
+  mutateInto?(target: Brain, mutationRate?: number, mutationStrength?: number): boolean;
+
+  /**
+   * Optional allocation-free variant of think(): write the decision into a
+   * caller-owned output record and return it.
+   */
+  thinkInto?(inputs: SensoryInput, out: BrainOutput): BrainOutput;
+
+  /**
+   * Optional hook for brains with state carried across ticks. AgentManager
+   * calls it with the population state buffer and the agent's slot when
+   * the agent is registered, and with (null, -1) when the slot is released.
+   */
+  bindState?(states: RecurrentStateBuffer | null, slot: number): void;
+
+  /**
+   * Optional awaited decision for brains whose think() answers from a
+   * fallback while a slow request is pending (LLMBrain). Callers that need
+   * the brain's real answer, such as distillation, use this instead.
+   */
+  thinkAsync?(inputs: SensoryInput): Promise<BrainOutput>;
 }
 
 // ============================================================================
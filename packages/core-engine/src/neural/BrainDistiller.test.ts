@@ -0,0 +1,165 @@
+/**
+ * BrainDistiller.test.ts - Tests for brain distillation and DistilledBrain
+ */
+
+import { describe, it, expect } from 'vitest';
+import { BrainDistiller } from './BrainDistiller';
+import { DistilledBrain, actionBin } from './DistilledBrain';
+import { Brain, BrainOutput, BrainRegistry, BrainState, SensoryInput } from './Brain';
+import { FCMBrain } from './fcm/FCMBrain';
+import { LLMBrain } from './LLMBrain';
+import { MockLLMService } from './llm/MockLLMService';
+
+/**
+ * Deterministic stand-in for a slow brain: eats food ahead, turns toward
+ * food, reproduces when energy is high
+ */
+class ScriptedBrain implements Brain {
+  readonly type = 'scripted';
+  calls = 0;
+
+  think(input: SensoryInput): BrainOutput {
+    this.calls++;
+    if (input.energy > 0.8) return { moveForward: 0, rotate: 0, action: 2 };
+    if (input.front > 0.5) return { moveForward: 1, rotate: 0, action: 1 };
+    return { moveForward: 0.5, rotate: (input.frontLeft - input.frontRight) * 0.5, action: 0 };
+  }
+
+  mutate(): Brain { return this; }
+  clone(): Brain { return this; }
+  crossover(): Brain { return this; }
+  serialize(): BrainState { return { type: this.type, version: 1, config: {}, data: null }; }
+  getComplexity(): number { return 1; }
+}
+
+function randomInputs(count: number): SensoryInput[] {
+  const inputs: SensoryInput[] = [];
+  for (let i = 0; i < count; i++) {
+    inputs.push({
+      front: Math.random(), frontLeft: Math.random(), frontRight: Math.random(),
+      left: 0, right: 0, energy: Math.random(), bias: 1,
+    });
+  }
+  return inputs;
+}
+
+describe('BrainDistiller', () => {
+  it('compiles a sweep into a faithful decision table', () => {
+    const source = new ScriptedBrain();
+    const distiller = new BrainDistiller({ bits: 4 });
+    distiller.sweep(source);
+    expect(distiller.sampleCount).toBe(2 ** 16);
+
+    const brain = distiller.compileTable();
+    expect(brain.mode).toBe('table');
+    expect(brain.getConfig().sourceType).toBe('scripted');
+    expect(brain.getFidelity().coverage).toBe(1);
+    expect(brain.getFidelity().actionAgreement).toBe(1);
+
+    const fidelity = BrainDistiller.measureFidelity(source, brain, randomInputs(2000));
+    expect(fidelity.actionAgreement).toBeGreaterThan(0.9);
+    expect(fidelity.rotateRMSE).toBeLessThan(0.05);
+  });
+
+  it('records online and fills unobserved cells from a fallback', () => {
+    const source = new ScriptedBrain();
+    const distiller = new BrainDistiller({ inputs: ['front', 'energy'], bits: 3 });
+    const input: SensoryInput = { front: 0.9, frontLeft: 0, frontRight: 0, left: 0, right: 0, energy: 0.3, bias: 1 };
+
+    const output = distiller.observe(source, input);
+    expect(output.action).toBe(1);
+
+    const sparse = distiller.compileTable();
+    expect(sparse.getFidelity().coverage).toBe(1 / 64);
+    expect(sparse.think({ ...input, front: 0 }).moveForward).toBe(0);
+    expect(sparse.think(input).action).toBe(1);
+
+    const filled = distiller.compileTable(source);
+    expect(filled.think({ ...input, front: 0 }).moveForward).toBe(0.5);
+  });
+
+  it('majority-votes the action within a cell', () => {
+    const distiller = new BrainDistiller({ inputs: ['front'], bits: 2 });
+    const input: SensoryInput = { front: 0.5, frontLeft: 0, frontRight: 0, left: 0, right: 0, energy: 0, bias: 1 };
+    distiller.record(input, { moveForward: 1, rotate: 0, action: 1 });
+    distiller.record(input, { moveForward: 0, rotate: 0, action: 1 });
+    distiller.record(input, { moveForward: 0.5, rotate: 0, action: 2 });
+
+    const brain = distiller.compileTable();
+    const out = brain.think(input);
+    expect(out.action).toBe(1);
+    expect(out.moveForward).toBeCloseTo(0.5, 5);
+    expect(brain.getFidelity().actionAgreement).toBeCloseTo(2 / 3, 5);
+  });
+
+  it('fits a small network', () => {
+    const distiller = new BrainDistiller({ inputs: ['front', 'energy'], bits: 4 });
+    const source = new ScriptedBrain();
+    distiller.sweep(source);
+
+    const brain = distiller.compileNetwork({ epochs: 150 });
+    expect(brain.mode).toBe('network');
+    expect(brain.getFidelity().actionAgreement).toBeGreaterThan(0.8);
+    expect(actionBin(brain.think({ front: 0, frontLeft: 0, frontRight: 0, left: 0, right: 0, energy: 1, bias: 1 }).action)).toBe(2);
+  });
+
+  it('distills an FCM brain', () => {
+    const fcm = new FCMBrain();
+    const distiller = new BrainDistiller({ bits: 3 });
+    distiller.sweep(fcm);
+    const brain = distiller.compileTable();
+
+    const fidelity = BrainDistiller.measureFidelity(fcm, brain, randomInputs(500));
+    expect(fidelity.samples).toBe(500);
+    expect(fidelity.actionAgreement).toBeGreaterThan(0.5);
+  });
+
+  it('distills an LLM brain from its answers, not its fallback', async () => {
+    const service = new MockLLMService({ delay: 1 });
+    service.setCustomResponse('creature', 'TURN_LEFT');
+    const llm = new LLMBrain(service);
+    const distiller = new BrainDistiller({ inputs: ['front', 'energy'], bits: 2 });
+
+    expect(() => distiller.sweep(llm)).toThrow(/sweepAsync/);
+    expect(distiller.sampleCount).toBe(0);
+
+    await distiller.sweepAsync(llm);
+    expect(distiller.sampleCount).toBe(16);
+    expect(llm.getStats().fallbackUsed).toBe(0);
+
+    const brain = distiller.compileTable();
+    expect(brain.getConfig().sourceType).toBe('llm');
+    for (const front of [0, 0.4, 1]) {
+      const output = brain.think({ front, frontLeft: 0, frontRight: 0, left: 0, right: 0, energy: 0.1, bias: 1 });
+      expect(output.moveForward).toBe(0);
+      expect(output.rotate).toBe(0.5);
+    }
+  });
+});
+
+describe('DistilledBrain', () => {
+  it('round-trips through the brain registry', () => {
+    const distiller = new BrainDistiller({ inputs: ['front', 'energy'], bits: 3 });
+    distiller.sweep(new ScriptedBrain());
+    const brain = distiller.compileTable(undefined, 'forager');
+
+    const restored = BrainRegistry.deserialize(brain.serialize()) as DistilledBrain;
+    expect(restored).toBeInstanceOf(DistilledBrain);
+    expect(restored.label).toBe('forager');
+    const input: SensoryInput = { front: 0.9, frontLeft: 0, frontRight: 0, left: 0, right: 0, energy: 0.3, bias: 1 };
+    expect(restored.think(input)).toEqual(brain.think(input));
+    expect(restored.getFidelity()).toEqual(brain.getFidelity());
+  });
+
+  it('mutates and crosses over tables of the same shape', () => {
+    const distiller = new BrainDistiller({ inputs: ['front'], bits: 3 });
+    distiller.sweep(new ScriptedBrain());
+    const a = distiller.compileTable();
+    const b = a.mutate(1, 0.5);
+    const child = a.crossover(b);
+
+    expect(child).toBeInstanceOf(DistilledBrain);
+    expect(child.mode).toBe('table');
+    expect(b.getComplexity()).toBe(1);
+  });
+});
@@ -0,0 +1,460 @@
+/**
+ * BrainDistiller.ts - Record a slow brain's decisions and compile them
+ *
+ * Online: wrap agents' think() calls with observe(), or feed pairs to
+ * record(). Offline: sweep() queries a brain at every cell centre of the
+ * quantization grid. Brains with thinkAsync() (LLMBrain) answer think()
+ * from a fallback while a request is pending, so the synchronous paths
+ * refuse them; use observeAsync()/sweepAsync(), which await each answer. Observations are aggregated per cell (mean movement,
+ * majority action bin), then compiled into a DistilledBrain as a dense
+ * decision table or a small fitted NeuralNetwork.
+ */
+
+import { Brain, SensoryInput, BrainOutput } from './Brain';
+import { NeuralNetwork } from './NeuralNetwork';
+import { packDecisionKey } from './llm/LLMDecisionCache';
+import {
+  DistilledBrain,
+  DistilledBrainConfig,
+  DistilledInput,
+  DistillationFidelity,
+  DEFAULT_DISTILLED_INPUTS,
+  actionBin,
+} from './DistilledBrain';
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+export interface BrainDistillerConfig {
+  inputs: DistilledInput[];
+  bits: number;
+}
+
+export const DEFAULT_BRAIN_DISTILLER_CONFIG: BrainDistillerConfig = {
+  inputs: DEFAULT_DISTILLED_INPUTS,
+  bits: 4,
+};
+
+export interface NetworkFitOptions {
+  hiddenSize: number;
+  epochs: number;
+  learningRate: number;
+}
+
+export const DEFAULT_NETWORK_FIT_OPTIONS: NetworkFitOptions = {
+  hiddenSize: 12,
+  epochs: 200,
+  learningRate: 0.05,
+};
+
+// Table cells default to the neutral output until observed or filled
+const NEUTRAL_OUTPUT: BrainOutput = { moveForward: 0, rotate: 0, action: 0 };
+
+// ============================================================================
+// BrainDistiller Class
+// ============================================================================
+
+export class BrainDistiller {
+  private config: BrainDistillerConfig;
+  private cells: number;
+  private levels: number;
+
+  // Per-cell aggregates
+  private counts: Uint32Array;
+  private sums: Float64Array;        // moveForward, rotate
+  private squares: Float64Array;     // moveForward², rotate²
+  private votes: Uint32Array;        // Action bins 0..2
+
+  private sourceType: string = 'unknown';
+  private samples: number = 0;
+  private inputBuffer: Float64Array;
+
+  constructor(config?: Partial<BrainDistillerConfig>) {
+    this.config = { ...DEFAULT_BRAIN_DISTILLER_CONFIG, ...config };
+    this.config.inputs = [...this.config.inputs];
+    if (this.config.inputs.length * this.config.bits > 20) {
+      throw new Error('Distillation grid too large: use fewer inputs or bits (at most 20 bits in total)');
+    }
+    this.cells = DistilledBrain.cellCount(this.config);
+    this.levels = (1 << this.config.bits) - 1;
+
+    this.counts = new Uint32Array(this.cells);
+    this.sums = new Float64Array(this.cells * 2);
+    this.squares = new Float64Array(this.cells * 2);
+    this.votes = new Uint32Array(this.cells * 3);
+    this.inputBuffer = new Float64Array(this.config.inputs.length);
+  }
+
+  get sampleCount(): number {
+    return this.samples;
+  }
+
+  /**
+   * Record one decision
+   */
+  record(input: SensoryInput, output: BrainOutput): void {
+    const cell = this.cellOf(input);
+    this.counts[cell]++;
+    this.sums[cell * 2] += output.moveForward;
+    this.sums[cell * 2 + 1] += output.rotate;
+    this.squares[cell * 2] += output.moveForward * output.moveForward;
+    this.squares[cell * 2 + 1] += output.rotate * output.rotate;
+    this.votes[cell * 3 + actionBin(output.action)]++;
+    this.samples++;
+  }
+
+  /**
+   * Run a brain and record its decision; returns the decision unchanged so
+   * the call can stand in for brain.think() in a live run
+   */
+  observe(brain: Brain, input: SensoryInput): BrainOutput {
+    requireSynchronous(brain, 'observeAsync()');
+    const output = brain.think(input);
+    this.sourceType = brain.type;
+    this.record(input, output);
+    return output;
+  }
+
+  /**
+   * observe() for any brain, awaiting thinkAsync() when the brain has it
+   */
+  async observeAsync(brain: Brain, input: SensoryInput): Promise<BrainOutput> {
+    const output = brain.thinkAsync ? await brain.thinkAsync(input) : brain.think(input);
+    this.sourceType = brain.type;
+    this.record(input, output);
+    return output;
+  }
+
+  /**
+   * Offline sweep: query the brain `repeats` times at every cell centre.
+   * Inputs not being distilled take the values in `base`.
+   */
+  sweep(brain: Brain, base?: Partial<SensoryInput>, repeats: number = 1): void {
+    requireSynchronous(brain, 'sweepAsync()');
+    const input: SensoryInput = {
+      front: 0, frontLeft: 0, frontRight: 0, left: 0, right: 0, energy: 0, bias: 1,
+      ...base,
+    };
+    for (let cell = 0; cell < this.cells; cell++) {
+      this.cellCentre(cell, input);
+      for (let r = 0; r < repeats; r++) {
+        this.observe(brain, input);
+      }
+    }
+  }
+
+  /**
+   * sweep() awaiting each answer, with up to `concurrency` cells in flight
+   * so a broker can coalesce and batch the requests
+   */
+  async sweepAsync(
+    brain: Brain,
+    base?: Partial<SensoryInput>,
+    repeats: number = 1,
+    concurrency: number = 8
+  ): Promise<void> {
+    let next = 0;
+    const run = async (): Promise<void> => {
+      const input: SensoryInput = {
+        front: 0, frontLeft: 0, frontRight: 0, left: 0, right: 0, energy: 0, bias: 1,
+        ...base,
+      };
+      while (next < this.cells) {
+        const cell = next++;
+        for (let r = 0; r < repeats; r++) {
+          this.cellCentre(cell, input);
+          await this.observeAsync(brain, input);
+        }
+      }
+    };
+    const lanes: Promise<void>[] = [];
+    for (let i = 0; i < Math.max(1, Math.min(concurrency, this.cells)); i++) {
+      lanes.push(run());
+    }
+    await Promise.all(lanes);
+  }
+
+  /**
+   * Compile a dense decision table. Unobserved cells are filled from
+   * `fill` (queried at the cell centre) when given, else left neutral.
+   */
+  compileTable(fill?: Brain, label?: string): DistilledBrain {
+    if (fill) requireSynchronous(fill, 'sweepAsync() before compiling');
+    const table = new Float32Array(this.cells * 3);
+    const input: SensoryInput = { front: 0, frontLeft: 0, frontRight: 0, left: 0, right: 0, energy: 0, bias: 1 };
+
+    for (let cell = 0; cell < this.cells; cell++) {
+      const n = this.counts[cell];
+      const base = cell * 3;
+      if (n > 0) {
+        table[base] = this.sums[cell * 2] / n;
+        table[base + 1] = this.sums[cell * 2 + 1] / n;
+        table[base + 2] = this.majority(cell);
+      } else {
+        let output = NEUTRAL_OUTPUT;
+        if (fill) {
+          this.cellCentre(cell, input);
+          output = fill.think(input);
+        }
+        table[base] = output.moveForward;
+        table[base + 1] = output.rotate;
+        table[base + 2] = actionBin(output.action);
+      }
+    }
+
+    return new DistilledBrain(this.brainConfig(label), { table }, this.tableFidelity());
+  }
+
+  /**
+   * Fit a one-hidden-layer NeuralNetwork to the per-cell aggregates with
+   * count-weighted SGD. The action output is trained on (bin - 1) so the
+   * tanh range covers all three bins.
+   */
+  compileNetwork(options?: Partial<NetworkFitOptions>, label?: string): DistilledBrain {
+    const fit = { ...DEFAULT_NETWORK_FIT_OPTIONS, ...options };
+    const k = this.config.inputs.length;
+    const H = fit.hiddenSize;
+
+    // Training set: observed cell centres with their aggregated targets
+    const observed: number[] = [];
+    for (let cell = 0; cell < this.cells; cell++) {
+      if (this.counts[cell] > 0) observed.push(cell);
+    }
+    if (observed.length === 0) {
+      throw new Error('No recorded decisions to distill');
+    }
+
+    const X = new Float64Array(observed.length * k);
+    const Y = new Float64Array(observed.length * 3);
+    const W = new Float64Array(observed.length);
+    const centre: SensoryInput = { front: 0, frontLeft: 0, frontRight: 0, left: 0, right: 0, energy: 0, bias: 1 };
+    let maxCount = 0;
+    for (let s = 0; s < observed.length; s++) {
+      const cell = observed[s];
+      this.cellCentre(cell, centre);
+      for (let i = 0; i < k; i++) X[s * k + i] = centre[this.config.inputs[i]];
+      const n = this.counts[cell];
+      Y[s * 3] = this.sums[cell * 2] / n;
+      Y[s * 3 + 1] = this.sums[cell * 2 + 1] / n;
+      Y[s * 3 + 2] = this.majority(cell) - 1;
+      W[s] = n;
+      maxCount = Math.max(maxCount, n);
+    }
+
+    const network = NeuralNetwork.createRandom({ inputSize: k, hiddenSize: H, outputSize: 3 });
+    const weights = network.getWeights();
+    const w1 = weights.inputToHidden;
+    const w2 = weights.hiddenToOutput;
+    const b1 = weights.hiddenBias;
+    const b2 = weights.outputBias;
+    const hidden = new Float64Array(H);
+    const out = new Float64Array(3);
+    const dOut = new Float64Array(3);
+    const order = observed.map((_, i) => i);
+
+    for (let epoch = 0; epoch < fit.epochs; epoch++) {
+      shuffle(order);
+      for (const s of order) {
+        const rate = fit.learningRate * (W[s] / maxCount);
+        forward(X, s * k, k, w1, b1, w2, b2, hidden, out);
+        for (let o = 0; o < 3; o++) {
+          dOut[o] = (out[o] - Y[s * 3 + o]) * (1 - out[o] * out[o]);
+        }
+        for (let h = 0; h < H; h++) {
+          let dh = 0;
+          for (let o = 0; o < 3; o++) {
+            dh += dOut[o] * w2[h][o];
+            w2[h][o] -= rate * dOut[o] * hidden[h];
+          }
+          dh *= 1 - hidden[h] * hidden[h];
+          for (let i = 0; i < k; i++) {
+            w1[i][h] -= rate * dh * X[s * k + i];
+          }
+          b1[h] -= rate * dh;
+        }
+        for (let o = 0; o < 3; o++) b2[o] -= rate * dOut[o];
+      }
+    }
+    network.setWeights(weights);
+
+    const brain = new DistilledBrain(this.brainConfig(label), { network });
+    return new DistilledBrain(this.brainConfig(label), { network }, this.modelFidelity(brain));
+  }
+
+  /**
+   * Compare a distilled brain with its source on fresh inputs
+   */
+  static measureFidelity(source: Brain, distilled: Brain, inputs: SensoryInput[]): DistillationFidelity {
+    requireSynchronous(source, 'getFidelity() on the distilled brain');
+    let agree = 0;
+    let moveSq = 0;
+    let rotateSq = 0;
+    for (const input of inputs) {
+      const a = source.think(input);
+      const b = distilled.think(input);
+      if (actionBin(a.action) === actionBin(b.action)) agree++;
+      moveSq += (a.moveForward - b.moveForward) ** 2;
+      rotateSq += (a.rotate - b.rotate) ** 2;
+    }
+    const n = Math.max(1, inputs.length);
+    return {
+      samples: inputs.length,
+      actionAgreement: agree / n,
+      moveForwardRMSE: Math.sqrt(moveSq / n),
+      rotateRMSE: Math.sqrt(rotateSq / n),
+      coverage: 1,
+    };
+  }
+
+  reset(): void {
+    this.counts.fill(0);
+    this.sums.fill(0);
+    this.squares.fill(0);
+    this.votes.fill(0);
+    this.samples = 0;
+  }
+
+  getConfig(): BrainDistillerConfig {
+    return { ...this.config, inputs: [...this.config.inputs] };
+  }
+
+  // --------------------------------------------------------------------------
+  // Internals
+  // --------------------------------------------------------------------------
+
+  private cellOf(input: SensoryInput): number {
+    const values = this.inputBuffer;
+    for (let i = 0; i < values.length; i++) {
+      values[i] = input[this.config.inputs[i]];
+    }
+    return packDecisionKey(values, this.config.bits);
+  }
+
+  private cellCentre(cell: number, out: SensoryInput): void {
+    const mask = this.levels;
+    for (let i = 0; i < this.config.inputs.length; i++) {
+      out[this.config.inputs[i]] = ((cell >>> (i * this.config.bits)) & mask) / mask;
+    }
+  }
+
+  private majority(cell: number): number {
+    const v = this.votes;
+    const base = cell * 3;
+    let best = 0;
+    if (v[base + 1] > v[base + best]) best = 1;
+    if (v[base + 2] > v[base + best]) best = 2;
+    return best;
+  }
+
+  /**
+   * Training fidelity of the table: within-cell spread of the recorded
+   * outputs around the cell mean, and majority-vote agreement
+   */
+  private tableFidelity(): DistillationFidelity {
+    let agree = 0;
+    let moveSq = 0;
+    let rotateSq = 0;
+    let observed = 0;
+    for (let cell = 0; cell < this.cells; cell++) {
+      const n = this.counts[cell];
+      if (n === 0) continue;
+      observed++;
+      agree += this.votes[cell * 3 + this.majority(cell)];
+      for (let j = 0; j < 2; j++) {
+        const sum = this.sums[cell * 2 + j];
+        const spread = Math.max(0, this.squares[cell * 2 + j] - (sum * sum) / n);
+        if (j === 0) moveSq += spread;
+        else rotateSq += spread;
+      }
+    }
+    const n = Math.max(1, this.samples);
+    return {
+      samples: this.samples,
+      actionAgreement: agree / n,
+      moveForwardRMSE: Math.sqrt(moveSq / n),
+      rotateRMSE: Math.sqrt(rotateSq / n),
+      coverage: observed / this.cells,
+    };
+  }
+
+  /**
+   * Training fidelity of a fitted model against the recorded aggregates
+   */
+  private modelFidelity(brain: DistilledBrain): DistillationFidelity {
+    const input: SensoryInput = { front: 0, frontLeft: 0, frontRight: 0, left: 0, right: 0, energy: 0, bias: 1 };
+    let agree = 0;
+    let moveSq = 0;
+    let rotateSq = 0;
+    let observed = 0;
+    for (let cell = 0; cell < this.cells; cell++) {
+      const n = this.counts[cell];
+      if (n === 0) continue;
+      observed++;
+      this.cellCentre(cell, input);
+      const out = brain.think(input);
+      agree += this.votes[cell * 3 + actionBin(out.action)];
+      for (let j = 0; j < 2; j++) {
+        const predicted = j === 0 ? out.moveForward : out.rotate;
+        const sum = this.sums[cell * 2 + j];
+        // Σ(y - p)² = Σy² - 2pΣy + np²
+        const err = Math.max(0, this.squares[cell * 2 + j] - 2 * predicted * sum + n * predicted * predicted);
+        if (j === 0) moveSq += err;
+        else rotateSq += err;
+      }
+    }
+    const n = Math.max(1, this.samples);
+    return {
+      samples: this.samples,
+      actionAgreement: agree / n,
+      moveForwardRMSE: Math.sqrt(moveSq / n),
+      rotateRMSE: Math.sqrt(rotateSq / n),
+      coverage: observed / this.cells,
+    };
+  }
+
+  private brainConfig(label?: string): DistilledBrainConfig {
+    return {
+      inputs: [...this.config.inputs],
+      bits: this.config.bits,
+      sourceType: this.sourceType,
+      label,
+    };
+  }
+}
+
+/**
+ * Refuse brains whose think() may answer from a fallback instead of
+ * their real decision
+ */
+function requireSynchronous(brain: Brain, instead: string): void {
+  if (brain.thinkAsync) {
+    throw new Error(`Cannot distill a ${brain.type} brain synchronously: its think() answers from a fallback while requests are pending; use ${instead}`);
+  }
+}
+
+function forward(
+  X: Float64Array, offset: number, k: number,
+  w1: number[][], b1: number[], w2: number[][], b2: number[],
+  hidden: Float64Array, out: Float64Array
+): void {
+  for (let h = 0; h < hidden.length; h++) {
+    let sum = b1[h];
+    for (let i = 0; i < k; i++) sum += X[offset + i] * w1[i][h];
+    hidden[h] = Math.tanh(sum);
+  }
+  for (let o = 0; o < out.length; o++) {
+    let sum = b2[o];
+    for (let h = 0; h < hidden.length; h++) sum += hidden[h] * w2[h][o];
+    out[o] = Math.tanh(sum);
+  }
+}
+
+function shuffle(values: number[]): void {
+  for (let i = values.length - 1; i > 0; i--) {
+    const j = Math.floor(Math.random() * (i + 1));
+    [values[i], values[j]] = [values[j], values[i]];
+  }
+}
+
+export default BrainDistiller;
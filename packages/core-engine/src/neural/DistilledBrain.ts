@@ -0,0 +1,232 @@
+/**
+ * DistilledBrain.ts - Lookup-speed replay of a slower brain's behaviour
+ *
+ * A DistilledBrain is compiled by BrainDistiller from (quantized input ->
+ * output) pairs recorded from an LLM, FCM or any other brain. It replays
+ * either a dense decision table over the quantization grid or a small
+ * NeuralNetwork fitted to the recorded pairs, and carries the fidelity
+ * measured against its source.
+ */
+
+import { Brain, SensoryInput, BrainOutput, BrainState, BrainRegistry } from './Brain';
+import { NeuralNetwork, NetworkWeights, NeuralNetworkConfig } from './NeuralNetwork';
+import { packDecisionKey } from './llm/LLMDecisionCache';
+
+export const DISTILLED_BRAIN_TYPE = 'distilled';
+export const DISTILLED_BRAIN_VERSION = 1;
+
+// ============================================================================
+// Types
+// ============================================================================
+
+export type DistilledInput = 'front' | 'frontLeft' | 'frontRight' | 'left' | 'right' | 'energy';
+
+export const DEFAULT_DISTILLED_INPUTS: DistilledInput[] = ['front', 'frontLeft', 'frontRight', 'energy'];
+
+/**
+ * Agreement between a distilled brain and its source
+ */
+export interface DistillationFidelity {
+  samples: number;
+  actionAgreement: number;   // Fraction of samples with the same action bin
+  moveForwardRMSE: number;
+  rotateRMSE: number;
+  coverage: number;          // Fraction of table cells observed (table mode)
+}
+
+export interface DistilledBrainConfig {
+  inputs: DistilledInput[];
+  bits: number;              // Quantization bits per input
+  sourceType: string;        // Brain type the behaviour came from
+  label?: string;
+}
+
+interface DistilledBrainData {
+  mode: 'table' | 'network';
+  distillConfig: DistilledBrainConfig;
+  table?: number[];
+  network?: { config: NeuralNetworkConfig; weights: NetworkWeights };
+  fidelity: DistillationFidelity;
+}
+
+/**
+ * Map an action value to the bin Agent acts on: 0 none, 1 eat, 2 reproduce
+ */
+export function actionBin(action: number): number {
+  return action >= 1.5 ? 2 : action > 0.5 ? 1 : 0;
+}
+
+// ============================================================================
+// DistilledBrain Class
+// ============================================================================
+
+export class DistilledBrain implements Brain {
+  readonly type = DISTILLED_BRAIN_TYPE;
+  readonly label?: string;
+
+  private config: DistilledBrainConfig;
+  private table: Float32Array | null;
+  private network: NeuralNetwork | null;
+  private fidelity: DistillationFidelity;
+
+  // Reused across think() calls
+  private inputBuffer: Float64Array;
+  private outputBuffer: number[] = [];
+
+  /**
+   * `table` holds [moveForward, rotate, action] per cell, indexed by the
+   * packed key of the quantized inputs. Pass either a table or a network.
+   */
+  constructor(
+    config: DistilledBrainConfig,
+    model: { table: Float32Array } | { network: NeuralNetwork },
+    fidelity?: DistillationFidelity
+  ) {
+    this.config = { ...config, inputs: [...config.inputs] };
+    this.label = config.label;
+    this.table = 'table' in model ? model.table : null;
+    this.network = 'network' in model ? model.network : null;
+    this.fidelity = fidelity ?? { samples: 0, actionAgreement: 0, moveForwardRMSE: 0, rotateRMSE: 0, coverage: 0 };
+    this.inputBuffer = new Float64Array(config.inputs.length);
+
+    if (this.table && this.table.length !== DistilledBrain.cellCount(config) * 3) {
+      throw new Error(`Distilled table has ${this.table.length} entries, expected ${DistilledBrain.cellCount(config) * 3}`);
+    }
+  }
+
+  /**
+   * Number of cells in the quantization grid
+   */
+  static cellCount(config: Pick<DistilledBrainConfig, 'inputs' | 'bits'>): number {
+    return 2 ** (config.inputs.length * config.bits);
+  }
+
+  think(inputs: SensoryInput): BrainOutput {
+    const values = this.inputBuffer;
+    const names = this.config.inputs;
+    for (let i = 0; i < names.length; i++) {
+      values[i] = inputs[names[i]];
+    }
+
+    if (this.table) {
+      const base = packDecisionKey(values, this.config.bits) * 3;
+      return {
+        moveForward: this.table[base],
+        rotate: this.table[base + 1],
+        action: this.table[base + 2],
+      };
+    }
+
+    const outputs = this.network!.forwardInto(values, this.outputBuffer);
+    return {
+      moveForward: outputs[0],
+      rotate: outputs[1],
+      action: actionBin(outputs[2] + 1),
+    };
+  }
+
+  /**
+   * Perturb the replayed behaviour: continuous table entries or network
+   * weights mutate, action bins are kept
+   */
+  mutate(mutationRate: number = 0.1, mutationStrength: number = 0.2): DistilledBrain {
+    if (this.network) {
+      return new DistilledBrain(this.config, { network: this.network.mutate(mutationRate, mutationStrength) }, this.fidelity);
+    }
+
+    const table = this.table!.slice();
+    for (let i = 0; i < table.length; i += 3) {
+      if (Math.random() < mutationRate) {
+        table[i] = Math.max(0, Math.min(1, table[i] + (Math.random() - 0.5) * mutationStrength));
+      }
+      if (Math.random() < mutationRate) {
+        table[i + 1] = Math.max(-1, Math.min(1, table[i + 1] + (Math.random() - 0.5) * mutationStrength));
+      }
+    }
+    return new DistilledBrain(this.config, { table }, this.fidelity);
+  }
+
+  clone(): DistilledBrain {
+    const model = this.table ? { table: this.table.slice() } : { network: this.network!.clone() };
+    return new DistilledBrain(this.config, model, { ...this.fidelity });
+  }
+
+  /**
+   * Cell-wise (table) or weight-wise (network) crossover between brains of
+   * the same shape; anything else clones this brain
+   */
+  crossover(other: Brain): DistilledBrain {
+    if (!(other instanceof DistilledBrain) || !this.sameShape(other)) {
+      return this.clone();
+    }
+    if (this.network && other.network) {
+      return new DistilledBrain(this.config, { network: this.network.crossover(other.network) }, this.fidelity);
+    }
+
+    const a = this.table!;
+    const b = other.table!;
+    const table = new Float32Array(a.length);
+    for (let i = 0; i < a.length; i += 3) {
+      const src = Math.random() < 0.5 ? a : b;
+      table[i] = src[i];
+      table[i + 1] = src[i + 1];
+      table[i + 2] = src[i + 2];
+    }
+    return new DistilledBrain(this.config, { table }, this.fidelity);
+  }
+
+  serialize(): BrainState {
+    const data: DistilledBrainData = {
+      mode: this.table ? 'table' : 'network',
+      distillConfig: { ...this.config, inputs: [...this.config.inputs] },
+      table: this.table ? Array.from(this.table) : undefined,
+      network: this.network ? this.network.serialize() : undefined,
+      fidelity: { ...this.fidelity },
+    };
+    return {
+      type: DISTILLED_BRAIN_TYPE,
+      version: DISTILLED_BRAIN_VERSION,
+      config: { label: this.label },
+      data,
+    };
+  }
+
+  getComplexity(): number {
+    return this.network ? this.network.getParameterCount() : this.config.inputs.length;
+  }
+
+  getFidelity(): DistillationFidelity {
+    return { ...this.fidelity };
+  }
+
+  getConfig(): DistilledBrainConfig {
+    return { ...this.config, inputs: [...this.config.inputs] };
+  }
+
+  get mode(): 'table' | 'network' {
+    return this.table ? 'table' : 'network';
+  }
+
+  static fromState(state: BrainState): DistilledBrain {
+    if (state.type !== DISTILLED_BRAIN_TYPE) {
+      throw new Error(`Expected ${DISTILLED_BRAIN_TYPE}, got ${state.type}`);
+    }
+    const data = state.data as DistilledBrainData;
+    const config = { ...data.distillConfig, label: state.config?.label };
+    const model = data.mode === 'table'
+      ? { table: Float32Array.from(data.table ?? []) }
+      : { network: NeuralNetwork.deserialize(data.network!) };
+    return new DistilledBrain(config, model, data.fidelity);
+  }
+
+  private sameShape(other: DistilledBrain): boolean {
+    return (
+      this.mode === other.mode &&
+      this.config.bits === other.config.bits &&
+      this.config.inputs.join() === other.config.inputs.join() &&
+      (this.network === null || this.network.hiddenSize === other.network!.hiddenSize)
+    );
+  }
+}
+
+BrainRegistry.register(DISTILLED_BRAIN_TYPE, DistilledBrain.fromState);
@@ -0,0 +1,95 @@
+/**
+ * ForwardKernels.test.ts - Tests for generated forward-pass kernels
+ */
+
+import { describe, it, expect, afterEach } from 'vitest';
+import {
+  Activation,
+  activationFunction,
+  forwardWeightCount,
+  getForwardKernel,
+  isCodegenAvailable,
+  setCodegenEnabled,
+} from './ForwardKernels';
+import { NeuralNetwork, NetworkWeights } from './NeuralNetwork';
+
+function reference(weights: NetworkWeights, inputs: number[], act: (x: number) => number): number[] {
+  const hidden = weights.hiddenBias.map((bias, h) => {
+    let sum = bias;
+    for (let i = 0; i < inputs.length; i++) sum += inputs[i] * weights.inputToHidden[i][h];
+    return act(sum);
+  });
+  return weights.outputBias.map((bias, o) => {
+    let sum = bias;
+    for (let h = 0; h < hidden.length; h++) sum += hidden[h] * weights.hiddenToOutput[h][o];
+    return act(sum);
+  });
+}
+
+function randomArray(length: number): Float64Array {
+  return Float64Array.from({ length }, () => Math.random() * 2 - 1);
+}
+
+describe('ForwardKernels', () => {
+  afterEach(() => setCodegenEnabled(true));
+
+  it('generates code where allowed', () => {
+    expect(isCodegenAvailable()).toBe(true);
+    setCodegenEnabled(false);
+    expect(isCodegenAvailable()).toBe(false);
+  });
+
+  for (const activation of ['tanh', 'sigmoid', 'relu', 'linear'] as Activation[]) {
+    it(`generated and loop kernels agree bit for bit (${activation})`, () => {
+      const [I, H, O] = [7, 12, 3];
+      const offset = 5;
+      const weights = randomArray(offset + forwardWeightCount(I, H, O));
+      const inputs = randomArray(I);
+
+      const generated = getForwardKernel(I, H, O, activation);
+      const a = new Float64Array(O);
+      generated(weights, offset, inputs, a);
+
+      setCodegenEnabled(false);
+      const loop = getForwardKernel(I, H, O, activation);
+      expect(loop).not.toBe(generated);
+      const b = new Float64Array(O);
+      loop(weights, offset, inputs, b);
+
+      expect(Array.from(a)).toEqual(Array.from(b));
+      expect(Array.from(a).every(Number.isFinite)).toBe(true);
+    });
+  }
+
+  it('caches one kernel per shape and activation', () => {
+    expect(getForwardKernel(4, 5, 2)).toBe(getForwardKernel(4, 5, 2, 'tanh'));
+    expect(getForwardKernel(4, 5, 2)).not.toBe(getForwardKernel(4, 5, 2, 'relu'));
+  });
+
+  it('applies the named activation', () => {
+    expect(activationFunction('relu')(-2)).toBe(0);
+    expect(activationFunction('sigmoid')(0)).toBe(0.5);
+  });
+});
+
+describe('NeuralNetwork forward kernels', () => {
+  it('matches the nested-loop forward pass exactly', () => {
+    const network = new NeuralNetwork({ inputSize: 7, hiddenSize: 12, outputSize: 3 });
+    const inputs = Array.from(randomArray(7));
+    expect(network.forward(inputs)).toEqual(reference(network.getWeights(), inputs, Math.tanh));
+  });
+
+  it('picks up weight changes from setWeights and mutateInto', () => {
+    const a = new NeuralNetwork();
+    const b = new NeuralNetwork();
+    const inputs = Array.from(randomArray(7));
+    b.forward(inputs);
+
+    a.mutateInto(b, 1, 0.5);
+    expect(b.forward(inputs)).toEqual(reference(b.getWeights(), inputs, Math.tanh));
+
+    b.setWeights(a.getWeights());
+    expect(b.forward(inputs)).toEqual(a.forward(inputs));
+    expect(b.getFlatWeights().length).toBe(b.getParameterCount());
+  });
+});
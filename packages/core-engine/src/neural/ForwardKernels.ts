@@ -0,0 +1,234 @@
+/**
+ * ForwardKernels.ts - Specialised forward passes for fixed topologies
+ *
+ * Network shapes are fixed per population, so the forward pass for each
+ * (inputSize, hiddenSize, outputSize, activation) combination is generated
+ * once with `new Function` as fully unrolled straight-line code over a
+ * flat weight array, and cached. V8 optimises these small unrolled matmuls
+ * far better than nested loops with bounds read from fields.
+ *
+ * Where code generation is disallowed (a CSP without 'unsafe-eval') or the
+ * shape is too large to unroll sensibly, a generic loop kernel with the
+ * same arithmetic order is used instead, so results are bit-identical.
+ *
+ * Flat layout at `offset`:
+ *   inputToHidden  [i * hiddenSize + h]
+ *   hiddenBias     [h]
+ *   hiddenToOutput [h * outputSize + o]
+ *   outputBias     [o]
+ *
+ * Single dense layers (used by MultiLayerNetwork) follow the genome layout
+ * of Genome.extractNeuralWeights instead:
+ *   weights        [o * inputSize + i]
+ *   biases         [o]
+ */
+
+// ============================================================================
+// Types
+// ============================================================================
+
+export type Activation = 'tanh' | 'sigmoid' | 'relu' | 'linear';
+
+export type ForwardKernel = (
+  weights: ArrayLike<number>,
+  offset: number,
+  inputs: ArrayLike<number>,
+  outputs: { [index: number]: number }
+) => void;
+
+// Largest weight count that is unrolled; bigger shapes use the loop kernel
+export const MAX_UNROLLED_WEIGHTS = 4096;
+
+/**
+ * Number of flat weights for a shape
+ */
+export function forwardWeightCount(inputSize: number, hiddenSize: number, outputSize: number): number {
+  return inputSize * hiddenSize + hiddenSize + hiddenSize * outputSize + outputSize;
+}
+
+// ============================================================================
+// Code generation support
+// ============================================================================
+
+let codegenAllowed: boolean | null = null;
+let codegenEnabled = true;
+
+/**
+ * Whether `new Function` works in this environment (checked once)
+ */
+export function isCodegenAvailable(): boolean {
+  if (codegenAllowed === null) {
+    try {
+      codegenAllowed = new Function('return 1')() === 1;
+    } catch {
+      codegenAllowed = false;
+    }
+  }
+  return codegenAllowed && codegenEnabled;
+}
+
+/**
+ * Turn generated kernels on or off (for example to compare against the
+ * loop kernels). Clears the kernel cache.
+ */
+export function setCodegenEnabled(enabled: boolean): void {
+  codegenEnabled = enabled;
+  KERNELS.clear();
+}
+
+// ============================================================================
+// Kernel cache
+// ============================================================================
+
+const KERNELS: Map<string, ForwardKernel> = new Map();
+
+/**
+ * Get (generating on first use) the forward kernel for a shape
+ */
+export function getForwardKernel(
+  inputSize: number,
+  hiddenSize: number,
+  outputSize: number,
+  activation: Activation = 'tanh'
+): ForwardKernel {
+  const key = `${inputSize}:${hiddenSize}:${outputSize}:${activation}`;
+  let kernel = KERNELS.get(key);
+  if (!kernel) {
+    const unroll =
+      isCodegenAvailable() &&
+      forwardWeightCount(inputSize, hiddenSize, outputSize) <= MAX_UNROLLED_WEIGHTS;
+    kernel = unroll
+      ? generateKernel(inputSize, hiddenSize, outputSize, activation)
+      : loopKernel(inputSize, hiddenSize, outputSize, activation);
+    KERNELS.set(key, kernel);
+  }
+  return kernel;
+}
+
+/**
+ * Get (generating on first use) the kernel for one dense layer
+ */
+export function getLayerKernel(inputSize: number, outputSize: number, activation: Activation = 'tanh'): ForwardKernel {
+  const key = `layer:${inputSize}:${outputSize}:${activation}`;
+  let kernel = KERNELS.get(key);
+  if (!kernel) {
+    const unroll = isCodegenAvailable() && inputSize * outputSize + outputSize <= MAX_UNROLLED_WEIGHTS;
+    kernel = unroll
+      ? generateLayerKernel(inputSize, outputSize, activation)
+      : loopLayerKernel(inputSize, outputSize, activation);
+    KERNELS.set(key, kernel);
+  }
+  return kernel;
+}
+
+export function activationFunction(activation: Activation): (x: number) => number {
+  switch (activation) {
+    case 'tanh':
+      return Math.tanh;
+    case 'sigmoid':
+      return (x: number) => 1 / (1 + Math.exp(-x));
+    case 'relu':
+      return (x: number) => (x > 0 ? x : 0);
+    case 'linear':
+      return (x: number) => x;
+  }
+}
+
+// Expression applying the activation to the local `s`
+function activationSource(activation: Activation): string {
+  switch (activation) {
+    case 'tanh':
+      return 'Math.tanh(s)';
+    case 'sigmoid':
+      return '1 / (1 + Math.exp(-s))';
+    case 'relu':
+      return '(s > 0 ? s : 0)';
+    case 'linear':
+      return 's';
+  }
+}
+
+function generateKernel(I: number, H: number, O: number, activation: Activation): ForwardKernel {
+  const act = activationSource(activation);
+  const hiddenBias = I * H;
+  const hiddenToOutput = hiddenBias + H;
+  const outputBias = hiddenToOutput + H * O;
+  const lines: string[] = ['let s;'];
+
+  for (let i = 0; i < I; i++) {
+    lines.push(`const x${i} = x[${i}];`);
+  }
+  for (let h = 0; h < H; h++) {
+    let expr = `w[o + ${hiddenBias + h}]`;
+    for (let i = 0; i < I; i++) {
+      expr += ` + x${i} * w[o + ${i * H + h}]`;
+    }
+    lines.push(`s = ${expr};`, `const h${h} = ${act};`);
+  }
+  for (let k = 0; k < O; k++) {
+    let expr = `w[o + ${outputBias + k}]`;
+    for (let h = 0; h < H; h++) {
+      expr += ` + h${h} * w[o + ${hiddenToOutput + h * O + k}]`;
+    }
+    lines.push(`s = ${expr};`, `y[${k}] = ${act};`);
+  }
+
+  return new Function('w', 'o', 'x', 'y', lines.join('\n')) as ForwardKernel;
+}
+
+function loopKernel(I: number, H: number, O: number, activation: Activation): ForwardKernel {
+  const act = activationFunction(activation);
+  const hidden = new Float64Array(H);
+  const hiddenBias = I * H;
+  const hiddenToOutput = hiddenBias + H;
+  const outputBias = hiddenToOutput + H * O;
+
+  return (w, o, x, y) => {
+    for (let h = 0; h < H; h++) {
+      let s = w[o + hiddenBias + h];
+      for (let i = 0; i < I; i++) {
+        s += x[i] * w[o + i * H + h];
+      }
+      hidden[h] = act(s);
+    }
+    for (let k = 0; k < O; k++) {
+      let s = w[o + outputBias + k];
+      for (let h = 0; h < H; h++) {
+        s += hidden[h] * w[o + hiddenToOutput + h * O + k];
+      }
+      y[k] = act(s);
+    }
+  };
+}
+
+function generateLayerKernel(I: number, O: number, activation: Activation): ForwardKernel {
+  const act = activationSource(activation);
+  const lines: string[] = ['let s;'];
+  for (let i = 0; i < I; i++) {
+    lines.push(`const x${i} = x[${i}];`);
+  }
+  for (let k = 0; k < O; k++) {
+    // Bias first, then inputs in order: the loop kernel's summation order
+    let expr = `w[o + ${O * I + k}]`;
+    for (let i = 0; i < I; i++) {
+      expr += ` + x${i} * w[o + ${k * I + i}]`;
+    }
+    lines.push(`s = ${expr};`, `y[${k}] = ${act};`);
+  }
+  return new Function('w', 'o', 'x', 'y', lines.join('\n')) as ForwardKernel;
+}
+
+function loopLayerKernel(I: number, O: number, activation: Activation): ForwardKernel {
+  const act = activationFunction(activation);
+  const biases = O * I;
+  return (w, o, x, y) => {
+    for (let k = 0; k < O; k++) {
+      let s = w[o + biases + k];
+      const row = o + k * I;
+      for (let i = 0; i < I; i++) {
+        s += x[i] * w[row + i];
+      }
+      y[k] = act(s);
+    }
+  };
+}
@@ -7,6 +7,8 @@
 
 import { Brain, SensoryInput, BrainOutput, BrainState } from './Brain';
 import { LLMService } from './llm/LLMService';
+import { LLMDecisionBroker } from './llm/LLMDecisionBroker';
+import { LLMDecisionCache, packDecisionKey } from './llm/LLMDecisionCache';
 import { formatPrompt, parseAction, AGENT_REASONING_PROMPT, SensoryInputForPrompt } from './llm/PromptTemplates';
 
 export interface LLMBrainConfig {
@@ -15,8 +17,14 @@ export interface LLMBrainConfig {
   cacheTTL?: number; // Time in ms before cache entries expire
   maxCacheSize?: number;
   fallbackToRule?: boolean;
+  quantizationBits?: number; // Bits per input in the packed cache key
+  // Shared between brains; brains sharing these should share a prompt template
+  broker?: LLMDecisionBroker; // Population broker (coalescing, batching)
+  sharedCache?: LLMDecisionCache; // Population cache, replaces the per-brain one
 }
 
+type ResolvedLLMBrainConfig = Required<Omit<LLMBrainConfig, 'broker' | 'sharedCache'>>;
+
 interface CacheEntry {
   output: BrainOutput;
   timestamp: number;
@@ -27,8 +35,11 @@ export class LLMBrain implements Brain {
   readonly label?: string;
 
   private llmService: LLMService;
-  private config: Required<LLMBrainConfig>;
-  private cache: Map<string, CacheEntry> = new Map();
+  private config: ResolvedLLMBrainConfig;
+  private broker: LLMDecisionBroker | null;
+  private sharedCache: LLMDecisionCache | null;
+  private cache: Map<number, CacheEntry> = new Map();
+  private keyInputs: Float64Array = new Float64Array(4);
   private pendingRequest: Promise<BrainOutput> | null = null;
   private lastOutput: BrainOutput = { moveForward: 0.5, rotate: 0, action: 0 };
 
@@ -49,7 +60,10 @@ export class LLMBrain implements Brain {
       cacheTTL: config?.cacheTTL ?? 5000,
       maxCacheSize: config?.maxCacheSize ?? 100,
       fallbackToRule: config?.fallbackToRule ?? true,
+      quantizationBits: config?.quantizationBits ?? 4,
     };
+    this.broker = config?.broker ?? null;
+    this.sharedCache = config?.sharedCache ?? null;
   }
 
   think(input: SensoryInput): BrainOutput {
@@ -57,13 +71,9 @@ export class LLMBrain implements Brain {
 
     // Check cache first
     const cacheKey = this.getCacheKey(input);
-    if (this.config.cacheEnabled) {
-      const cached = this.cache.get(cacheKey);
-      if (cached && Date.now() - cached.timestamp < this.config.cacheTTL) {
-        this.stats.cacheHits++;
-        return cached.output;
-      }
-      this.stats.cacheMisses++;
+    const cached = this.lookup(cacheKey);
+    if (cached) {
+      return cached;
     }
 
     // Start async LLM call if not already pending
@@ -83,37 +93,75 @@ export class LLMBrain implements Brain {
     return this.lastOutput;
   }
 
-  private async asyncThink(input: SensoryInput, cacheKey: string): Promise<BrainOutput> {
-    try {
-      // Convert SensoryInput to prompt format
-      const promptInput: SensoryInputForPrompt = {
-        energy: input.energy,
-        frontFood: input.front,
-        frontLeftFood: input.frontLeft,
-        frontRightFood: input.frontRight,
-      };
-
-      const prompt = formatPrompt(this.config.promptTemplate, promptInput);
-
-      this.stats.llmCalls++;
-      const response = await this.llmService.complete(prompt);
-      const action = parseAction(response);
-
-      const output = this.actionToOutput(action);
-      this.lastOutput = output;
+  /**
+   * Awaited decision: the cached answer, or the model's answer once the
+   * request completes. Never answers from the rule fallback; service
+   * errors reject.
+   */
+  async thinkAsync(input: SensoryInput): Promise<BrainOutput> {
+    this.stats.totalDecisions++;
+    const cacheKey = this.getCacheKey(input);
+    return this.lookup(cacheKey) ?? this.request(input, cacheKey);
+  }
 
-      // Cache the result
-      if (this.config.cacheEnabled) {
-        this.cacheResult(cacheKey, output);
+  private lookup(cacheKey: number): BrainOutput | null {
+    if (this.sharedCache) {
+      const shared = this.sharedCache.get(cacheKey, this.config.quantizationBits);
+      if (shared) {
+        this.stats.cacheHits++;
+        return shared;
+      }
+      this.stats.cacheMisses++;
+    } else if (this.config.cacheEnabled) {
+      const cached = this.cache.get(cacheKey);
+      if (cached && Date.now() - cached.timestamp < this.config.cacheTTL) {
+        this.stats.cacheHits++;
+        return cached.output;
       }
+      this.stats.cacheMisses++;
+    }
+    return null;
+  }
 
-      return output;
+  private async asyncThink(input: SensoryInput, cacheKey: number): Promise<BrainOutput> {
+    try {
+      return await this.request(input, cacheKey);
     } catch (error) {
       // On error, use rule-based fallback
       return this.ruleFallback(input);
     }
   }
 
+  private async request(input: SensoryInput, cacheKey: number): Promise<BrainOutput> {
+    // Convert SensoryInput to prompt format
+    const promptInput: SensoryInputForPrompt = {
+      energy: input.energy,
+      frontFood: input.front,
+      frontLeftFood: input.frontLeft,
+      frontRightFood: input.frontRight,
+    };
+
+    const prompt = formatPrompt(this.config.promptTemplate, promptInput);
+
+    this.stats.llmCalls++;
+    // Through the broker, hungrier agents are served first
+    const action = this.broker
+      ? await this.broker.request(cacheKey * 16 + this.config.quantizationBits, prompt, 1 - input.energy)
+      : parseAction(await this.llmService.complete(prompt));
+
+    const output = this.actionToOutput(action);
+    this.lastOutput = output;
+
+    // Cache the result
+    if (this.sharedCache) {
+      this.sharedCache.set(cacheKey, this.config.quantizationBits, output);
+    } else if (this.config.cacheEnabled) {
+      this.cacheResult(cacheKey, output);
+    }
+
+    return output;
+  }
+
   private actionToOutput(action: string): BrainOutput {
     switch (action) {
       case 'MOVE_FORWARD':
@@ -166,17 +214,21 @@ export class LLMBrain implements Brain {
     return { moveForward: 0.5, rotate: randomTurn, action: 0 };
   }
 
-  private getCacheKey(input: SensoryInput): string {
+  private getCacheKey(input: SensoryInput): number {
     // Quantize inputs for better cache hits
-    const quantize = (n: number) => Math.round(n * 10) / 10;
-    return `${quantize(input.front)},${quantize(input.frontLeft)},${quantize(input.frontRight)},${quantize(input.energy)}`;
+    const inputs = this.keyInputs;
+    inputs[0] = input.front;
+    inputs[1] = input.frontLeft;
+    inputs[2] = input.frontRight;
+    inputs[3] = input.energy;
+    return packDecisionKey(inputs, this.config.quantizationBits);
   }
 
-  private cacheResult(key: string, output: BrainOutput): void {
+  private cacheResult(key: number, output: BrainOutput): void {
     // Evict old entries if cache is full
     if (this.cache.size >= this.config.maxCacheSize) {
       const oldestKey = this.cache.keys().next().value;
-      if (oldestKey) {
+      if (oldestKey !== undefined) {
         this.cache.delete(oldestKey);
       }
     }
@@ -192,6 +244,8 @@ export class LLMBrain implements Brain {
     // We can adjust the prompt template slightly or other parameters
     const newConfig: LLMBrainConfig = {
       ...this.config,
+      broker: this.broker ?? undefined,
+      sharedCache: this.sharedCache ?? undefined,
       // Could add prompt variation here in the future
     };
 
@@ -199,7 +253,11 @@ export class LLMBrain implements Brain {
   }
 
   clone(): Brain {
-    const cloned = new LLMBrain(this.llmService, { ...this.config }, this.label);
+    const cloned = new LLMBrain(this.llmService, {
+      ...this.config,
+      broker: this.broker ?? undefined,
+      sharedCache: this.sharedCache ?? undefined,
+    }, this.label);
     return cloned;
   }
 
@@ -211,6 +269,9 @@ export class LLMBrain implements Brain {
         cacheEnabled: Math.random() < 0.5 ? this.config.cacheEnabled : other.config.cacheEnabled,
         cacheTTL: Math.random() < 0.5 ? this.config.cacheTTL : other.config.cacheTTL,
         fallbackToRule: Math.random() < 0.5 ? this.config.fallbackToRule : other.config.fallbackToRule,
+        quantizationBits: this.config.quantizationBits,
+        broker: this.broker ?? undefined,
+        sharedCache: this.sharedCache ?? undefined,
       };
       return new LLMBrain(this.llmService, newConfig, this.label);
     }
@@ -231,6 +292,7 @@ export class LLMBrain implements Brain {
           cacheTTL: this.config.cacheTTL,
           maxCacheSize: this.config.maxCacheSize,
           fallbackToRule: this.config.fallbackToRule,
+          quantizationBits: this.config.quantizationBits,
         },
         stats: this.stats,
       },
@@ -246,10 +308,21 @@ export class LLMBrain implements Brain {
     return { ...this.stats };
   }
 
-  getConfig(): Required<LLMBrainConfig> {
+  getConfig(): ResolvedLLMBrainConfig {
     return { ...this.config };
   }
 
+  getBroker(): LLMDecisionBroker | null {
+    return this.broker;
+  }
+
+  getSharedCache(): LLMDecisionCache | null {
+    return this.sharedCache;
+  }
+
+  /**
+   * Clear the per-brain cache; a shared cache is cleared by its owner
+   */
   clearCache(): void {
     this.cache.clear();
   }
@@ -260,10 +333,14 @@ export class LLMBrain implements Brain {
 }
 
 // Factory function for creating LLMBrain (requires LLMService instance)
-export function createLLMBrainFactory(llmService: LLMService) {
+export function createLLMBrainFactory(
+  llmService: LLMService,
+  broker?: LLMDecisionBroker,
+  sharedCache?: LLMDecisionCache
+) {
   return (state: BrainState): Brain => {
     const data = state.data as { llmConfig?: LLMBrainConfig };
-    return new LLMBrain(llmService, data?.llmConfig, state.config?.label);
+    return new LLMBrain(llmService, { ...data?.llmConfig, broker, sharedCache }, state.config?.label);
   };
 }
 
@@ -0,0 +1,177 @@
+/**
+ * MLPBrain.ts - Multi-layer network brain
+ *
+ * Wraps MultiLayerNetwork to implement the Brain interface for layer lists
+ * deeper than NeuralBrain's single hidden layer, such as the presets'
+ * [7, 16, 8, 3]. The seven sensory inputs feed the first layer and the
+ * last layer's three outputs map to moveForward, rotate and action.
+ */
+
+import {
+  Brain,
+  BrainConfig,
+  BrainOutput,
+  BrainRegistry,
+  BrainState,
+  SensoryInput,
+} from './Brain';
+import { MultiLayerNetwork, MultiLayerNetworkState } from './MultiLayerNetwork';
+import type { Activation } from './ForwardKernels';
+import type { Genome } from '../genetics/Genome';
+
+export const MLP_BRAIN_TYPE = 'mlp';
+export const MLP_BRAIN_VERSION = 1;
+
+export interface MLPBrainConfig extends BrainConfig {
+  layers?: number[];            // Defaults to [7, 16, 8, 3]
+  activations?: Activation[];   // Defaults to tanh on every layer
+}
+
+export const DEFAULT_MLP_LAYERS = [7, 16, 8, 3];
+
+interface MLPBrainData {
+  network: MultiLayerNetworkState;
+}
+
+export class MLPBrain implements Brain {
+  readonly type = MLP_BRAIN_TYPE;
+  readonly label?: string;
+
+  private network: MultiLayerNetwork;
+  private config: MLPBrainConfig;
+
+  // Reused across think() calls
+  private inputBuffer: Float64Array = new Float64Array(7);
+  private outputBuffer: Float64Array = new Float64Array(3);
+
+  constructor(config: MLPBrainConfig = {}, network?: MultiLayerNetwork) {
+    const layers = network?.getLayers() ?? config.layers ?? DEFAULT_MLP_LAYERS;
+    if (layers[0] !== 7 || layers[layers.length - 1] !== 3) {
+      throw new Error(`MLPBrain needs 7 inputs and 3 outputs, got [${layers.join(', ')}]`);
+    }
+    this.network = network ?? new MultiLayerNetwork({ layers, activations: config.activations });
+    this.config = {
+      layers: [...layers],
+      activations: this.network.getActivations(),
+      mutationRate: config.mutationRate ?? 0.1,
+      mutationStrength: config.mutationStrength ?? 0.3,
+      label: config.label,
+    };
+    this.label = config.label;
+  }
+
+  /**
+   * Brain whose weights are the genome's genes, as laid out by
+   * Genome.forNeuralNetwork(layers)
+   */
+  static fromGenome(genome: Genome, config: MLPBrainConfig = {}): MLPBrain {
+    const layers = config.layers ?? DEFAULT_MLP_LAYERS;
+    return new MLPBrain(config, MultiLayerNetwork.fromGenome(genome, layers, config.activations));
+  }
+
+  think(inputs: SensoryInput): BrainOutput {
+    return this.thinkInto(inputs, { moveForward: 0, rotate: 0, action: 0 });
+  }
+
+  thinkInto(inputs: SensoryInput, out: BrainOutput): BrainOutput {
+    const inputArray = this.inputBuffer;
+    inputArray[0] = inputs.front;
+    inputArray[1] = inputs.frontLeft;
+    inputArray[2] = inputs.frontRight;
+    inputArray[3] = inputs.left;
+    inputArray[4] = inputs.right;
+    inputArray[5] = inputs.energy;
+    inputArray[6] = inputs.bias;
+
+    const outputs = this.network.forwardInto(inputArray, this.outputBuffer);
+    out.moveForward = outputs[0];
+    out.rotate = outputs[1];
+    out.action = outputs[2];
+    return out;
+  }
+
+  mutate(mutationRate?: number, mutationStrength?: number): MLPBrain {
+    const rate = mutationRate ?? this.config.mutationRate ?? 0.1;
+    const strength = mutationStrength ?? this.config.mutationStrength ?? 0.3;
+
+    return new MLPBrain(
+      { ...this.config, label: this.label ? `${this.label}_mutant` : undefined },
+      this.network.mutate(rate, strength)
+    );
+  }
+
+  /**
+   * Mutate into an existing MLPBrain of the same shape, reusing its weight
+   * buffer (used when recycling pooled agents)
+   */
+  mutateInto(target: Brain, mutationRate?: number, mutationStrength?: number): boolean {
+    if (!(target instanceof MLPBrain) || target === this) return false;
+
+    const rate = mutationRate ?? this.config.mutationRate ?? 0.1;
+    const strength = mutationStrength ?? this.config.mutationStrength ?? 0.3;
+    if (!this.network.mutateInto(target.network, rate, strength)) return false;
+
+    target.config = { ...this.config, label: this.label ? `${this.label}_mutant` : undefined };
+    (target as { label?: string }).label = target.config.label;
+    return true;
+  }
+
+  clone(): MLPBrain {
+    return new MLPBrain({ ...this.config }, this.network.clone());
+  }
+
+  crossover(other: Brain): MLPBrain {
+    if (other.type !== MLP_BRAIN_TYPE) {
+      throw new Error(`Cannot crossover MLPBrain with ${other.type}`);
+    }
+
+    return new MLPBrain(
+      { ...this.config, label: this.label ? `${this.label}_child` : undefined },
+      this.network.crossover((other as MLPBrain).network)
+    );
+  }
+
+  serialize(): BrainState {
+    return {
+      type: MLP_BRAIN_TYPE,
+      version: MLP_BRAIN_VERSION,
+      config: {
+        mutationRate: this.config.mutationRate,
+        mutationStrength: this.config.mutationStrength,
+        label: this.label,
+      },
+      data: { network: this.network.serialize() } as MLPBrainData,
+    };
+  }
+
+  getComplexity(): number {
+    return this.network.getParameterCount();
+  }
+
+  getMultiLayerNetwork(): MultiLayerNetwork {
+    return this.network;
+  }
+
+  getConfig(): MLPBrainConfig {
+    return {
+      ...this.config,
+      layers: [...this.config.layers!],
+      activations: [...this.config.activations!],
+    };
+  }
+
+  static fromState(state: BrainState): MLPBrain {
+    if (state.type !== MLP_BRAIN_TYPE) {
+      throw new Error(`Expected ${MLP_BRAIN_TYPE}, got ${state.type}`);
+    }
+
+    const data = state.data as MLPBrainData;
+    return new MLPBrain(state.config, MultiLayerNetwork.deserialize(data.network));
+  }
+
+  static createRandom(config?: MLPBrainConfig): MLPBrain {
+    return new MLPBrain(config);
+  }
+}
+
+BrainRegistry.register(MLP_BRAIN_TYPE, MLPBrain.fromState);
@@ -0,0 +1,179 @@
+/**
+ * MultiLayerNetwork.test.ts - Tests for N-layer networks and MLPBrain
+ */
+
+import { describe, it, expect, afterEach } from 'vitest';
+import { MultiLayerNetwork, NeuralLayer, multiLayerWeightCount } from './MultiLayerNetwork';
+import { MLPBrain, MLP_BRAIN_TYPE } from './MLPBrain';
+import { BrainRegistry, DEFAULT_SENSORY_INPUT } from './Brain';
+import { Activation, activationFunction, setCodegenEnabled } from './ForwardKernels';
+import { Genome } from '../genetics/Genome';
+import { SimulationEngine } from '../simulation/SimulationEngine';
+import { serializeSimulation, loadSimulation } from '../simulation/Serialization';
+
+function reference(layers: NeuralLayer[], activations: Activation[], inputs: number[]): number[] {
+  let x = inputs;
+  layers.forEach((layer, l) => {
+    const act = activationFunction(activations[l]);
+    x = layer.biases.map((bias, o) => {
+      let sum = bias;
+      for (let i = 0; i < x.length; i++) sum += x[i] * layer.weights[o][i];
+      return act(sum);
+    });
+  });
+  return x;
+}
+
+const INPUTS = [0.2, 0.9, 0.1, 0.4, 0.6, 0.75, 1];
+
+describe('MultiLayerNetwork', () => {
+  afterEach(() => setCodegenEnabled(true));
+
+  it('sizes weights like Genome.forNeuralNetwork', () => {
+    const layers = [7, 16, 8, 3];
+    const genome = Genome.forNeuralNetwork(layers);
+    expect(multiLayerWeightCount(layers)).toBe(genome.size);
+    expect(new MultiLayerNetwork({ layers }).getParameterCount()).toBe(genome.size);
+  });
+
+  it('matches the per-layer reference built from extractNeuralWeights', () => {
+    const layers = [7, 16, 8, 3];
+    const activations: Activation[] = ['relu', 'tanh', 'sigmoid'];
+    const genome = Genome.forNeuralNetwork(layers);
+    const network = MultiLayerNetwork.fromGenome(genome, layers, activations);
+    const expected = reference(genome.extractNeuralWeights(layers), activations, INPUTS);
+
+    const out = network.forward(INPUTS);
+    for (let o = 0; o < 3; o++) {
+      expect(out[o]).toBeCloseTo(expected[o], 12);
+    }
+  });
+
+  it('round-trips extractNeuralWeights layers', () => {
+    const layers = [7, 5, 4, 3];
+    const genome = Genome.forNeuralNetwork(layers);
+    const neuralLayers = genome.extractNeuralWeights(layers);
+    const network = MultiLayerNetwork.fromNeuralLayers(neuralLayers);
+
+    expect(network.getLayers()).toEqual(layers);
+    expect(network.toNeuralLayers()).toEqual(neuralLayers);
+    expect(Array.from(network.getWeights())).toEqual(Array.from(genome.genes));
+  });
+
+  it('gives identical results with generated and loop kernels', () => {
+    const network = new MultiLayerNetwork({ layers: [7, 12, 9, 6, 3] });
+    const generated = network.forward(INPUTS);
+    setCodegenEnabled(false);
+    const looped = new MultiLayerNetwork(network.getConfig(), network.getWeights()).forward(INPUTS);
+    expect(looped).toEqual(generated);
+  });
+
+  it('reuses its output array across forward passes', () => {
+    const network = new MultiLayerNetwork({ layers: [7, 10, 10, 3] });
+    const out = new Float64Array(3);
+    expect(network.forwardInto(INPUTS, out)).toBe(out);
+    const first = Array.from(out);
+    network.forwardInto(INPUTS, out);
+    expect(Array.from(out)).toEqual(first);
+  });
+
+  it('batches bit-identically to single forward passes', () => {
+    const network = new MultiLayerNetwork({ layers: [7, 16, 8, 3], activations: ['relu', 'tanh', 'linear'] });
+    const count = 5;
+    const inputs = new Float64Array(count * 7);
+    for (let i = 0; i < inputs.length; i++) inputs[i] = Math.random();
+    const outputs = new Float64Array(count * 3);
+    network.forwardBatch(inputs, outputs, count, network.createBatchScratch(count));
+
+    for (let r = 0; r < count; r++) {
+      const single = network.forward(inputs.subarray(r * 7, r * 7 + 7));
+      expect(Array.from(outputs.subarray(r * 3, r * 3 + 3))).toEqual(single);
+    }
+  });
+
+  it('rejects mismatched weights, activations and shapes', () => {
+    expect(() => new MultiLayerNetwork({ layers: [7] })).toThrow();
+    expect(() => new MultiLayerNetwork({ layers: [7, 4, 3], activations: ['tanh'] })).toThrow();
+    expect(() => new MultiLayerNetwork({ layers: [7, 4, 3] }, [1, 2, 3])).toThrow();
+
+    const a = new MultiLayerNetwork({ layers: [7, 4, 3] });
+    const b = new MultiLayerNetwork({ layers: [7, 5, 3] });
+    expect(a.mutateInto(b)).toBe(false);
+    expect(() => a.crossover(b)).toThrow();
+  });
+
+  it('mutates into an existing network without touching the source', () => {
+    const source = new MultiLayerNetwork({ layers: [7, 6, 4, 3] });
+    const target = new MultiLayerNetwork({ layers: [7, 6, 4, 3] });
+    const before = source.getWeights();
+
+    expect(source.mutateInto(target, 1, 0.5)).toBe(true);
+    expect(source.getWeights()).toEqual(before);
+    expect(target.getWeights()).not.toEqual(before);
+  });
+
+  it('writes weights back to a genome', () => {
+    const layers = [7, 4, 3];
+    const network = new MultiLayerNetwork({ layers });
+    const genome = Genome.forNeuralNetwork(layers);
+    network.writeToGenome(genome);
+    // Genes are stored as float32
+    expect(Array.from(genome.genes)).toEqual(Array.from(Float32Array.from(network.getWeights())));
+  });
+});
+
+describe('MLPBrain', () => {
+  it('builds from a genome and thinks without allocating outputs', () => {
+    const layers = [7, 16, 8, 3];
+    const genome = Genome.forNeuralNetwork(layers);
+    const brain = MLPBrain.fromGenome(genome, { layers });
+    const out = { moveForward: 0, rotate: 0, action: 0 };
+
+    expect(brain.thinkInto(DEFAULT_SENSORY_INPUT, out)).toBe(out);
+    expect(brain.think(DEFAULT_SENSORY_INPUT)).toEqual(out);
+    expect(brain.getComplexity()).toBe(genome.size);
+  });
+
+  it('requires seven inputs and three outputs', () => {
+    expect(() => new MLPBrain({ layers: [5, 8, 3] })).toThrow();
+    expect(() => new MLPBrain({ layers: [7, 8, 2] })).toThrow();
+  });
+
+  it('round-trips through the brain registry', () => {
+    const brain = new MLPBrain({ layers: [7, 10, 6, 3], activations: ['relu', 'relu', 'tanh'], label: 'deep' });
+    const restored = BrainRegistry.deserialize(brain.serialize()) as MLPBrain;
+
+    expect(restored.type).toBe(MLP_BRAIN_TYPE);
+    expect(restored.label).toBe('deep');
+    expect(restored.getConfig().activations).toEqual(['relu', 'relu', 'tanh']);
+    expect(restored.think(DEFAULT_SENSORY_INPUT)).toEqual(brain.think(DEFAULT_SENSORY_INPUT));
+  });
+
+  it('keeps its mutation settings and label through a saved simulation', () => {
+    const engine = new SimulationEngine({ agents: { initialPopulation: 1, networkLayers: [7, 8, 8, 3] } });
+    engine.initialize();
+    const agent = engine.getAgentManager().getAllAgents()[0];
+    agent.brain = new MLPBrain({ layers: [7, 8, 8, 3], mutationRate: 0.05, mutationStrength: 0.7, label: 'scout' });
+
+    const loaded = loadSimulation(serializeSimulation(engine));
+    const restored = loaded.getAgentManager().getAllAgents()[0].brain as MLPBrain;
+
+    expect(restored.label).toBe('scout');
+    expect(restored.getConfig().mutationRate).toBe(0.05);
+    expect(restored.getConfig().mutationStrength).toBe(0.7);
+    expect(restored.think(DEFAULT_SENSORY_INPUT)).toEqual(agent.brain.think(DEFAULT_SENSORY_INPUT));
+  });
+
+  it('mutates, clones and crosses over within its shape', () => {
+    const a = new MLPBrain({ layers: [7, 8, 8, 3] });
+    const b = new MLPBrain({ layers: [7, 8, 8, 3] });
+
+    expect(a.clone().think(DEFAULT_SENSORY_INPUT)).toEqual(a.think(DEFAULT_SENSORY_INPUT));
+    expect(a.mutate(1, 0.5).getComplexity()).toBe(a.getComplexity());
+    expect(a.crossover(b).getConfig().layers).toEqual([7, 8, 8, 3]);
+
+    const target = new MLPBrain({ layers: [7, 8, 8, 3] });
+    expect(a.mutateInto(target, 0, 0)).toBe(true);
+    expect(target.think(DEFAULT_SENSORY_INPUT)).toEqual(a.think(DEFAULT_SENSORY_INPUT));
+  });
+});
@@ -0,0 +1,373 @@
+/**
+ * MultiLayerNetwork.ts - N-layer feedforward network over flat weights
+ *
+ * Takes the same layer lists as Genome.forNeuralNetwork (for example
+ * [7, 16, 8, 3]) and stores all weights in one Float64Array in genome
+ * order: per layer, weights [out][in] then biases. A genome therefore maps
+ * onto a network with a single copy and no reshaping.
+ *
+ * Each layer runs through a kernel from ForwardKernels with its own
+ * activation. Activations ping-pong between two buffers sized for the
+ * widest hidden layer, so a forward pass allocates nothing at any depth.
+ */
+
+import { Activation, ForwardKernel, activationFunction, getLayerKernel } from './ForwardKernels';
+import type { Genome } from '../genetics/Genome';
+
+// ============================================================================
+// Types
+// ============================================================================
+
+export interface MultiLayerNetworkConfig {
+  layers: number[];            // Layer sizes, input first
+  activations?: Activation[];  // One per weight layer; defaults to tanh
+}
+
+/**
+ * Per-layer weights as returned by Genome.extractNeuralWeights
+ */
+export interface NeuralLayer {
+  weights: number[][];   // [out][in]
+  biases: number[];
+}
+
+export interface MultiLayerNetworkState {
+  layers: number[];
+  activations: Activation[];
+  weights: number[];
+}
+
+/**
+ * Number of weights (and genome genes) for a layer list
+ */
+export function multiLayerWeightCount(layers: number[]): number {
+  let count = 0;
+  for (let l = 1; l < layers.length; l++) {
+    count += layers[l - 1] * layers[l] + layers[l];
+  }
+  return count;
+}
+
+// ============================================================================
+// MultiLayerNetwork Class
+// ============================================================================
+
+export class MultiLayerNetwork {
+  readonly inputSize: number;
+  readonly outputSize: number;
+
+  private layers: number[];
+  private activations: Activation[];
+  private weights: Float64Array;
+  private kernels: ForwardKernel[];
+  private offsets: number[];
+
+  // Ping-pong activation buffers, each as wide as the widest hidden layer
+  private bufferA: Float64Array;
+  private bufferB: Float64Array;
+
+  constructor(config: MultiLayerNetworkConfig, weights?: ArrayLike<number>) {
+    const layers = config.layers;
+    if (layers.length < 2) {
+      throw new Error(`A network needs at least 2 layers, got ${layers.length}`);
+    }
+    const depth = layers.length - 1;
+    const activations = config.activations ?? new Array<Activation>(depth).fill('tanh');
+    if (activations.length !== depth) {
+      throw new Error(`Expected ${depth} activations, got ${activations.length}`);
+    }
+
+    this.layers = [...layers];
+    this.activations = [...activations];
+    this.inputSize = layers[0];
+    this.outputSize = layers[depth];
+
+    const count = multiLayerWeightCount(layers);
+    if (weights) {
+      if (weights.length !== count) {
+        throw new Error(`Weight count mismatch: expected ${count}, got ${weights.length}`);
+      }
+      this.weights = Float64Array.from(weights);
+    } else {
+      this.weights = new Float64Array(count);
+      this.initializeWeights();
+    }
+
+    this.kernels = [];
+    this.offsets = [];
+    let offset = 0;
+    let widest = 1;
+    for (let l = 1; l <= depth; l++) {
+      this.kernels.push(getLayerKernel(layers[l - 1], layers[l], activations[l - 1]));
+      this.offsets.push(offset);
+      offset += layers[l - 1] * layers[l] + layers[l];
+      if (l < depth) widest = Math.max(widest, layers[l]);
+    }
+    this.bufferA = new Float64Array(widest);
+    this.bufferB = new Float64Array(widest);
+  }
+
+  /**
+   * Build a network from a genome sized by Genome.forNeuralNetwork(layers)
+   */
+  static fromGenome(genome: Genome, layers: number[], activations?: Activation[]): MultiLayerNetwork {
+    const count = multiLayerWeightCount(layers);
+    const genes = genome.genes;
+    if (genes.length < count) {
+      throw new Error(`Genome has ${genes.length} genes, network needs ${count}`);
+    }
+    return new MultiLayerNetwork({ layers, activations }, genes.subarray(0, count));
+  }
+
+  /**
+   * Build a network from Genome.extractNeuralWeights output
+   */
+  static fromNeuralLayers(neuralLayers: NeuralLayer[], activations?: Activation[]): MultiLayerNetwork {
+    if (neuralLayers.length === 0) {
+      throw new Error('Cannot build a network from no layers');
+    }
+    const layers = [neuralLayers[0].weights[0]?.length ?? 0];
+    const weights: number[] = [];
+    for (const layer of neuralLayers) {
+      layers.push(layer.biases.length);
+      for (const row of layer.weights) weights.push(...row);
+      weights.push(...layer.biases);
+    }
+    return new MultiLayerNetwork({ layers, activations }, weights);
+  }
+
+  private initializeWeights(): void {
+    let k = 0;
+    for (let l = 1; l < this.layers.length; l++) {
+      const inputSize = this.layers[l - 1];
+      const outputSize = this.layers[l];
+      const stddev = Math.sqrt(2 / (inputSize + outputSize));
+      for (let i = 0; i < inputSize * outputSize; i++) {
+        this.weights[k++] = randomGaussian() * stddev;
+      }
+      for (let i = 0; i < outputSize; i++) {
+        this.weights[k++] = (Math.random() - 0.5) * 0.1;
+      }
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // Forward passes
+  // --------------------------------------------------------------------------
+
+  forward(inputs: ArrayLike<number>): number[] {
+    return this.forwardInto(inputs, new Array(this.outputSize));
+  }
+
+  /**
+   * Forward pass writing into a caller-owned output array. Hidden layers
+   * alternate between the two activation buffers; the last layer writes
+   * straight into `outputs`. Repeated calls allocate nothing.
+   */
+  forwardInto<T extends { [index: number]: number }>(inputs: ArrayLike<number>, outputs: T): T {
+    if (inputs.length !== this.inputSize) {
+      throw new Error(`Input size mismatch: expected ${this.inputSize}, got ${inputs.length}`);
+    }
+    const last = this.kernels.length - 1;
+    const w = this.weights;
+    let src: ArrayLike<number> = inputs;
+    let dst = this.bufferA;
+    for (let l = 0; l < last; l++) {
+      this.kernels[l](w, this.offsets[l], src, dst);
+      src = dst;
+      dst = dst === this.bufferA ? this.bufferB : this.bufferA;
+    }
+    this.kernels[last](w, this.offsets[last], src, outputs);
+    return outputs;
+  }
+
+  /**
+   * Forward `count` inputs packed row-major in `inputs` (inputSize each)
+   * into `outputs` (outputSize each). The batch is run layer by layer, so
+   * each layer's weights stay hot in cache across rows; the summation
+   * order matches the per-sample kernels, so results are bit-identical to
+   * forwardInto(). `scratch` holds two halves of count * widest hidden
+   * layer values; pass one from createBatchScratch() and reuse it.
+   */
+  forwardBatch(
+    inputs: Float64Array | Float32Array,
+    outputs: Float64Array | Float32Array,
+    count: number,
+    scratch: Float64Array = this.createBatchScratch(count)
+  ): void {
+    const layers = this.layers;
+    const last = this.kernels.length - 1;
+    const half = scratch.length >> 1;
+    if (inputs.length < count * this.inputSize || outputs.length < count * this.outputSize) {
+      throw new Error(`Batch of ${count} does not fit the input or output buffer`);
+    }
+    if (half < count * this.bufferA.length) {
+      throw new Error(`Batch scratch too small for ${count} rows`);
+    }
+
+    const w = this.weights;
+    let src: Float64Array | Float32Array = inputs;
+    let srcBase = 0;
+    for (let l = 0; l <= last; l++) {
+      const act = activationFunction(this.activations[l]);
+      const inSize = layers[l];
+      const outSize = layers[l + 1];
+      const offset = this.offsets[l];
+      const biases = offset + inSize * outSize;
+      const dst = l === last ? outputs : scratch;
+      const dstBase = l === last ? 0 : (l & 1) * half;
+
+      for (let r = 0; r < count; r++) {
+        const x = srcBase + r * inSize;
+        const y = dstBase + r * outSize;
+        for (let k = 0; k < outSize; k++) {
+          let s = w[biases + k];
+          const row = offset + k * inSize;
+          for (let i = 0; i < inSize; i++) {
+            s += src[x + i] * w[row + i];
+          }
+          dst[y + k] = act(s);
+        }
+      }
+      src = scratch;
+      srcBase = dstBase;
+    }
+  }
+
+  /**
+   * Scratch buffer for forwardBatch() with `count` rows
+   */
+  createBatchScratch(count: number): Float64Array {
+    return new Float64Array(2 * count * this.bufferA.length);
+  }
+
+  // --------------------------------------------------------------------------
+  // Evolution
+  // --------------------------------------------------------------------------
+
+  mutate(mutationRate: number = 0.1, mutationStrength: number = 0.3): MultiLayerNetwork {
+    const child = new MultiLayerNetwork(this.getConfig(), this.weights);
+    this.mutateInto(child, mutationRate, mutationStrength);
+    return child;
+  }
+
+  /**
+   * Write a mutated copy of this network's weights into an existing network
+   * of the same architecture. Returns false when the architectures differ.
+   */
+  mutateInto(target: MultiLayerNetwork, mutationRate: number = 0.1, mutationStrength: number = 0.3): boolean {
+    if (!this.sameShape(target)) return false;
+    const src = this.weights;
+    const dst = target.weights;
+    for (let i = 0; i < src.length; i++) {
+      dst[i] = Math.random() < mutationRate ? src[i] + randomGaussian() * mutationStrength : src[i];
+    }
+    return true;
+  }
+
+  crossover(other: MultiLayerNetwork): MultiLayerNetwork {
+    if (!this.sameShape(other)) {
+      throw new Error('Cannot crossover networks with different architectures');
+    }
+    const weights = new Float64Array(this.weights.length);
+    for (let i = 0; i < weights.length; i++) {
+      weights[i] = Math.random() < 0.5 ? this.weights[i] : other.weights[i];
+    }
+    return new MultiLayerNetwork(this.getConfig(), weights);
+  }
+
+  clone(): MultiLayerNetwork {
+    return new MultiLayerNetwork(this.getConfig(), this.weights);
+  }
+
+  // --------------------------------------------------------------------------
+  // Accessors
+  // --------------------------------------------------------------------------
+
+  /**
+   * Copy of the flat weights, in genome order
+   */
+  getWeights(): Float64Array {
+    return this.weights.slice();
+  }
+
+  setWeights(weights: ArrayLike<number>): void {
+    if (weights.length !== this.weights.length) {
+      throw new Error(`Weight count mismatch: expected ${this.weights.length}, got ${weights.length}`);
+    }
+    this.weights.set(weights);
+  }
+
+  /**
+   * Write the weights into a genome's genes (the inverse of fromGenome)
+   */
+  writeToGenome(genome: Genome): void {
+    for (let i = 0; i < this.weights.length; i++) {
+      genome.setGene(i, this.weights[i]);
+    }
+  }
+
+  /**
+   * Weights in the shape returned by Genome.extractNeuralWeights
+   */
+  toNeuralLayers(): NeuralLayer[] {
+    const result: NeuralLayer[] = [];
+    let k = 0;
+    for (let l = 1; l < this.layers.length; l++) {
+      const weights: number[][] = [];
+      for (let o = 0; o < this.layers[l]; o++) {
+        weights.push(Array.from(this.weights.subarray(k, k + this.layers[l - 1])));
+        k += this.layers[l - 1];
+      }
+      const biases = Array.from(this.weights.subarray(k, k + this.layers[l]));
+      k += this.layers[l];
+      result.push({ weights, biases });
+    }
+    return result;
+  }
+
+  getLayers(): number[] {
+    return [...this.layers];
+  }
+
+  getActivations(): Activation[] {
+    return [...this.activations];
+  }
+
+  getConfig(): MultiLayerNetworkConfig {
+    return { layers: [...this.layers], activations: [...this.activations] };
+  }
+
+  getParameterCount(): number {
+    return this.weights.length;
+  }
+
+  get depth(): number {
+    return this.kernels.length;
+  }
+
+  serialize(): MultiLayerNetworkState {
+    return {
+      layers: [...this.layers],
+      activations: [...this.activations],
+      weights: Array.from(this.weights),
+    };
+  }
+
+  static deserialize(state: MultiLayerNetworkState): MultiLayerNetwork {
+    return new MultiLayerNetwork({ layers: state.layers, activations: state.activations }, state.weights);
+  }
+
+  private sameShape(other: MultiLayerNetwork): boolean {
+    return this.layers.join() === other.layers.join() && this.activations.join() === other.activations.join();
+  }
+}
+
+function randomGaussian(): number {
+  let u = 0, v = 0;
+  while (u === 0) u = Math.random();
+  while (v === 0) v = Math.random();
+  return Math.sqrt(-2.0 * Math.log(u)) * Math.cos(2.0 * Math.PI * v);
+}
+
+export default MultiLayerNetwork;
@@ -29,6 +29,10 @@ export class NeuralBrain implements Brain {
   private network: NeuralNetwork;
   private config: BrainConfig;
 
+  // Reused across think() calls
+  private inputBuffer: number[] = new Array(7).fill(0);
+  private outputBuffer: number[] = [];
+
   constructor(config: BrainConfig = {}, network?: NeuralNetwork) {
     this.config = {
       inputSize: config.inputSize ?? 7,
@@ -52,17 +56,16 @@ export class NeuralBrain implements Brain {
   }
 
   think(inputs: SensoryInput): BrainOutput {
-    const inputArray = [
-      inputs.front,
-      inputs.frontLeft,
-      inputs.frontRight,
-      inputs.left,
-      inputs.right,
-      inputs.energy,
-      inputs.bias,
-    ];
-
-    const outputs = this.network.forward(inputArray);
+    const inputArray = this.inputBuffer;
+    inputArray[0] = inputs.front;
+    inputArray[1] = inputs.frontLeft;
+    inputArray[2] = inputs.frontRight;
+    inputArray[3] = inputs.left;
+    inputArray[4] = inputs.right;
+    inputArray[5] = inputs.energy;
+    inputArray[6] = inputs.bias;
+
+    const outputs = this.network.forwardInto(inputArray, this.outputBuffer);
 
     return {
       moveForward: outputs[0],
@@ -83,6 +86,22 @@ export class NeuralBrain implements Brain {
     );
   }
 
+  /**
+   * Mutate into an existing NeuralBrain of the same shape, reusing its
+   * weight arrays (used when recycling pooled agents)
+   */
+  mutateInto(target: Brain, mutationRate?: number, mutationStrength?: number): boolean {
+    if (!(target instanceof NeuralBrain) || target === this) return false;
+
+    const rate = mutationRate ?? this.config.mutationRate ?? 0.1;
+    const strength = mutationStrength ?? this.config.mutationStrength ?? 0.3;
+    if (!this.network.mutateInto(target.network, rate, strength)) return false;
+
+    target.config = { ...this.config, label: this.label ? `${this.label}_mutant` : undefined };
+    (target as { label?: string }).label = target.config.label;
+    return true;
+  }
+
   clone(): NeuralBrain {
     return new NeuralBrain({ ...this.config }, this.network.clone());
   }
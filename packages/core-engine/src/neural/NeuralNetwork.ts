@@ -8,6 +8,8 @@
  * - Mutation support for evolutionary algorithms
  */
 
+import { ForwardKernel, getForwardKernel, forwardWeightCount } from './ForwardKernels';
+
 // ============================================================================
 // Types
 // ============================================================================
@@ -45,6 +47,11 @@ export class NeuralNetwork {
   private hiddenBias: number[];
   private outputBias: number[];
 
+  // Flat copy of the weights for the specialised forward kernel
+  private flat: Float64Array;
+  private flatDirty: boolean = true;
+  private kernel: ForwardKernel;
+
   constructor(
     config: Partial<NeuralNetworkConfig> = {},
     weights?: NetworkWeights
@@ -65,6 +72,8 @@ export class NeuralNetwork {
       this.hiddenBias = this.initializeBias(this.hiddenSize);
       this.outputBias = this.initializeBias(this.outputSize);
     }
+    this.flat = new Float64Array(forwardWeightCount(this.inputSize, this.hiddenSize, this.outputSize));
+    this.kernel = getForwardKernel(this.inputSize, this.hiddenSize, this.outputSize);
   }
 
   private initializeWeights(inputSize: number, outputSize: number): number[][] {
@@ -100,34 +109,49 @@ export class NeuralNetwork {
     return arr.map(row => [...row]);
   }
 
-  private tanh(x: number): number {
-    return Math.tanh(x);
+  forward(inputs: number[]): number[] {
+    return this.forwardInto(inputs, new Array(this.outputSize));
   }
 
-  forward(inputs: number[]): number[] {
+  /**
+   * Forward pass writing into a caller-owned output array, through the
+   * generated kernel for this shape. Repeated calls allocate nothing.
+   */
+  forwardInto(inputs: ArrayLike<number>, outputs: number[]): number[] {
     if (inputs.length !== this.inputSize) {
       throw new Error(`Input size mismatch: expected ${this.inputSize}, got ${inputs.length}`);
     }
-
-    const hidden: number[] = new Array(this.hiddenSize);
-    for (let h = 0; h < this.hiddenSize; h++) {
-      let sum = this.hiddenBias[h];
-      for (let i = 0; i < this.inputSize; i++) {
-        sum += inputs[i] * this.inputToHidden[i][h];
-      }
-      hidden[h] = this.tanh(sum);
+    if (this.flatDirty) {
+      this.packFlat();
     }
+    this.kernel(this.flat, 0, inputs, outputs);
+    return outputs;
+  }
 
-    const outputs: number[] = new Array(this.outputSize);
-    for (let o = 0; o < this.outputSize; o++) {
-      let sum = this.outputBias[o];
-      for (let h = 0; h < this.hiddenSize; h++) {
-        sum += hidden[h] * this.hiddenToOutput[h][o];
-      }
-      outputs[o] = this.tanh(sum);
+  /**
+   * Copy of the weights in the flat kernel layout (see ForwardKernels)
+   */
+  getFlatWeights(): Float64Array {
+    if (this.flatDirty) {
+      this.packFlat();
     }
+    return this.flat.slice();
+  }
 
-    return outputs;
+  private packFlat(): void {
+    const H = this.hiddenSize;
+    const O = this.outputSize;
+    const flat = this.flat;
+    let k = 0;
+    for (let i = 0; i < this.inputSize; i++) {
+      for (let h = 0; h < H; h++) flat[k++] = this.inputToHidden[i][h];
+    }
+    for (let h = 0; h < H; h++) flat[k++] = this.hiddenBias[h];
+    for (let h = 0; h < H; h++) {
+      for (let o = 0; o < O; o++) flat[k++] = this.hiddenToOutput[h][o];
+    }
+    for (let o = 0; o < O; o++) flat[k++] = this.outputBias[o];
+    this.flatDirty = false;
   }
 
   mutate(mutationRate: number = 0.1, mutationStrength: number = 0.3): NeuralNetwork {
@@ -144,6 +168,44 @@ export class NeuralNetwork {
     );
   }
 
+  /**
+   * Write a mutated copy of this network's weights into an existing network
+   * of the same architecture, reusing its weight arrays. Returns false when
+   * the architectures differ.
+   */
+  mutateInto(
+    target: NeuralNetwork,
+    mutationRate: number = 0.1,
+    mutationStrength: number = 0.3
+  ): boolean {
+    if (
+      this.inputSize !== target.inputSize ||
+      this.hiddenSize !== target.hiddenSize ||
+      this.outputSize !== target.outputSize
+    ) {
+      return false;
+    }
+
+    this.mutateMatrixInto(this.inputToHidden, target.inputToHidden, mutationRate, mutationStrength);
+    this.mutateMatrixInto(this.hiddenToOutput, target.hiddenToOutput, mutationRate, mutationStrength);
+    this.mutateArrayInto(this.hiddenBias, target.hiddenBias, mutationRate, mutationStrength);
+    this.mutateArrayInto(this.outputBias, target.outputBias, mutationRate, mutationStrength);
+    target.flatDirty = true;
+    return true;
+  }
+
+  private mutateMatrixInto(src: number[][], dst: number[][], rate: number, strength: number): void {
+    for (let i = 0; i < src.length; i++) {
+      this.mutateArrayInto(src[i], dst[i], rate, strength);
+    }
+  }
+
+  private mutateArrayInto(src: number[], dst: number[], rate: number, strength: number): void {
+    for (let i = 0; i < src.length; i++) {
+      dst[i] = Math.random() < rate ? src[i] + this.randomGaussian() * strength : src[i];
+    }
+  }
+
   private mutateMatrix(matrix: number[][], rate: number, strength: number): number[][] {
     return matrix.map(row =>
       row.map(weight =>
@@ -211,6 +273,7 @@ export class NeuralNetwork {
     this.hiddenToOutput = this.deepCopy2D(weights.hiddenToOutput);
     this.hiddenBias = [...weights.hiddenBias];
     this.outputBias = [...weights.outputBias];
+    this.flatDirty = true;
   }
 
   getParameterCount(): number {
@@ -0,0 +1,198 @@
+/**
+ * RecurrentBrain.test.ts - Tests for recurrent brains and packed population state
+ */
+
+import { describe, it, expect } from 'vitest';
+import { RecurrentBrain, RECURRENT_BRAIN_TYPE } from './RecurrentBrain';
+import { RecurrentNetwork, recurrentWeightCount } from './RecurrentNetwork';
+import { RecurrentStateBuffer } from './RecurrentStateBuffer';
+import { BrainRegistry, DEFAULT_SENSORY_INPUT, SensoryInput } from './Brain';
+import { AgentManager } from '../simulation/AgentManager';
+import { SimulationEngine } from '../simulation/SimulationEngine';
+import { serializeSimulation, loadSimulation } from '../simulation/Serialization';
+
+const INPUT: SensoryInput = { ...DEFAULT_SENSORY_INPUT, front: 0.7, frontLeft: 0.2, energy: 0.9 };
+
+describe('RecurrentNetwork', () => {
+  it('sizes elman and gated weights', () => {
+    const elman = { inputSize: 7, hiddenSize: 4, outputSize: 3, cell: 'elman' as const };
+    expect(recurrentWeightCount(elman)).toBe(7 * 4 + 4 * 4 + 4 + 4 * 3 + 3);
+    expect(recurrentWeightCount({ ...elman, cell: 'gated' })).toBe(recurrentWeightCount(elman) + 7 * 4 + 4 * 4 + 4);
+  });
+
+  it('carries state between steps', () => {
+    const network = new RecurrentNetwork({ hiddenSize: 6 });
+    const x = [0.5, 0.1, 0.2, 0.3, 0.4, 0.8, 1];
+    const state = new Float32Array(6);
+    const first = new Float64Array(3);
+    const second = new Float64Array(3);
+
+    network.step(x, state, 0, first);
+    expect(Array.from(state).some(v => v !== 0)).toBe(true);
+    network.step(x, state, 0, second);
+    expect(Array.from(second)).not.toEqual(Array.from(first));
+  });
+
+  it('steps batches through buffer slots like single steps', () => {
+    for (const cell of ['elman', 'gated'] as const) {
+      const network = new RecurrentNetwork({ hiddenSize: 5, cell });
+      const states = new RecurrentStateBuffer({ stride: 8, initialSlots: 2 });
+      const slots = [3, 0, 7];
+      const inputs = new Float64Array(3 * 7).map(() => Math.random());
+      const outputs = new Float64Array(3 * 3);
+
+      const local = slots.map(() => new Float32Array(5));
+      const expected: number[] = [];
+      for (let tick = 0; tick < 3; tick++) {
+        network.stepBatch(inputs, outputs, 3, states, slots);
+        expected.length = 0;
+        for (let r = 0; r < 3; r++) {
+          const y = new Float64Array(3);
+          network.step(inputs.subarray(r * 7, r * 7 + 7), local[r], 0, y);
+          expected.push(...y);
+        }
+      }
+      expect(Array.from(outputs)).toEqual(expected);
+      slots.forEach((slot, r) => {
+        expect(states.read(slot, new Float32Array(5))).toEqual(local[r]);
+      });
+    }
+  });
+});
+
+describe('RecurrentStateBuffer', () => {
+  it('grows capacity and stride without losing rows', () => {
+    const states = new RecurrentStateBuffer({ stride: 2, initialSlots: 2 });
+    states.write(1, [1, 2]);
+    states.ensure(9, 5);
+
+    expect(states.capacity).toBeGreaterThan(9);
+    expect(states.stride).toBeGreaterThanOrEqual(5);
+    expect(Array.from(states.read(1, new Float32Array(2)))).toEqual([1, 2]);
+  });
+
+  it('round-trips through bytes', () => {
+    const states = new RecurrentStateBuffer({ stride: 4, initialSlots: 4 });
+    states.write(2, [0.5, -0.25, 1, 2]);
+    const bytes = states.toBytes();
+    const restored = RecurrentStateBuffer.fromBytes(bytes.subarray(0));
+
+    expect(restored.stride).toBe(4);
+    expect(restored.data).toEqual(states.data);
+    expect(() => RecurrentStateBuffer.fromBytes(new Uint8Array(16))).toThrow();
+  });
+
+  it('attaches to shared memory without copying', () => {
+    const states = new RecurrentStateBuffer({ stride: 4, initialSlots: 4, shared: true });
+    expect(states.data.buffer).toBeInstanceOf(SharedArrayBuffer);
+
+    const view = RecurrentStateBuffer.attach(states.data.buffer, states.stride);
+    view.write(3, [9]);
+    expect(states.data[12]).toBe(9);
+  });
+});
+
+describe('RecurrentBrain', () => {
+  it('moves state between local storage and a bound slot', () => {
+    const brain = new RecurrentBrain({ hiddenSize: 4 });
+    const states = new RecurrentStateBuffer({ stride: 4 });
+    brain.think(INPUT);
+    const before = brain.getState();
+
+    brain.bindState(states, 5);
+    expect(brain.getStateSlot()).toBe(5);
+    expect(states.read(5, new Float32Array(4))).toEqual(before);
+
+    brain.think(INPUT);
+    const bound = states.read(5, new Float32Array(4));
+    brain.bindState(null, -1);
+    expect(brain.getState()).toEqual(bound);
+  });
+
+  it('thinks identically bound or unbound', () => {
+    const a = new RecurrentBrain({ hiddenSize: 6, cell: 'gated' });
+    const b = a.clone();
+    b.bindState(new RecurrentStateBuffer(), 3);
+    for (let i = 0; i < 4; i++) {
+      expect(b.think(INPUT)).toEqual(a.think(INPUT));
+    }
+  });
+
+  it('copies state on clone and resets it on birth', () => {
+    const brain = new RecurrentBrain({ hiddenSize: 4 });
+    brain.think(INPUT);
+    const state = brain.getState();
+
+    expect(brain.clone().getState()).toEqual(state);
+    expect(Array.from(brain.mutate().getState())).toEqual([0, 0, 0, 0]);
+    expect(Array.from(brain.crossover(brain.clone()).getState())).toEqual([0, 0, 0, 0]);
+
+    const target = new RecurrentBrain({ hiddenSize: 4 });
+    target.think(INPUT);
+    expect(brain.mutateInto(target)).toBe(true);
+    expect(Array.from(target.getState())).toEqual([0, 0, 0, 0]);
+  });
+
+  it('serializes weights and state through the registry', () => {
+    const brain = new RecurrentBrain({ hiddenSize: 5, cell: 'gated', label: 'memory' });
+    brain.think(INPUT);
+    const restored = BrainRegistry.deserialize(brain.serialize()) as RecurrentBrain;
+
+    expect(restored.type).toBe(RECURRENT_BRAIN_TYPE);
+    expect(restored.label).toBe('memory');
+    expect(restored.getState()).toEqual(brain.getState());
+    expect(restored.think(INPUT)).toEqual(brain.think(INPUT));
+  });
+
+  it('is bound to agent slots by AgentManager', () => {
+    const manager = new AgentManager(200, 200, {
+      initialPopulation: 4,
+      autoRespawn: false,
+      brainType: RECURRENT_BRAIN_TYPE,
+    });
+    manager.initialize();
+    const states = manager.getRecurrentStates();
+    const agents = manager.getAllAgents();
+
+    for (const agent of agents) {
+      const brain = agent.brain as RecurrentBrain;
+      expect(brain).toBeInstanceOf(RecurrentBrain);
+      expect(brain.getStateSlot()).toBe(agent.slot);
+    }
+
+    const brain = agents[0].brain as RecurrentBrain;
+    brain.think(INPUT);
+    const hidden = brain.getRecurrentNetwork().hiddenSize;
+    expect(hidden).toBe(12);   // networkLayers [7, 12, 3]
+    expect(states.read(agents[0].slot, new Float32Array(hidden))).toEqual(brain.getState());
+
+    agents[0].die();
+    manager.update(1);
+    expect(brain.getStateSlot()).toBe(-1);
+  });
+
+  it('saves hidden state as one block and restores it by slot', () => {
+    const engine = new SimulationEngine({
+      agents: { initialPopulation: 3, autoRespawn: false, brainType: RECURRENT_BRAIN_TYPE },
+    });
+    engine.initialize();
+    const agents = engine.getAgentManager().getAllAgents();
+    for (const agent of agents) agent.brain.think(INPUT);
+
+    const data = serializeSimulation(engine);
+    expect(data.recurrentStates).toBeDefined();
+    for (const saved of data.agents) {
+      expect(saved.brain.stateSlot).toBeGreaterThanOrEqual(0);
+      expect((saved.brain.state!.data as { state: number[] }).state).toEqual([]);
+    }
+
+    const loaded = loadSimulation(JSON.parse(JSON.stringify(data)));
+    const restored = loaded.getAgentManager().getAllAgents();
+    for (let i = 0; i < agents.length; i++) {
+      const before = agents[i].brain as RecurrentBrain;
+      const after = restored[i].brain as RecurrentBrain;
+      expect(after.getState()).toEqual(before.getState());
+      expect(after.think(INPUT)).toEqual(before.think(INPUT));
+    }
+  });
+});
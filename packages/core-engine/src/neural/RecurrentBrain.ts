@@ -0,0 +1,240 @@
+/**
+ * RecurrentBrain.ts - Recurrent network brain with population-packed state
+ *
+ * Wraps RecurrentNetwork to implement the Brain interface. Once its agent
+ * is registered, the brain's hidden state lives in the AgentManager's
+ * RecurrentStateBuffer at the agent's slot (see Brain.bindState); until
+ * then, and after the slot is released, it is kept in a small local array.
+ *
+ * New brains (construction, mutate, crossover, mutateInto) start from a
+ * zero state, so offspring are born without memories. clone() copies the
+ * current state, and serialize() includes it unless asked not to (save
+ * files write the population buffer once instead; see fromState).
+ */
+
+import {
+  Brain,
+  BrainConfig,
+  BrainOutput,
+  BrainRegistry,
+  BrainState,
+  SensoryInput,
+} from './Brain';
+import { RecurrentNetwork, RecurrentNetworkState, RecurrentCell } from './RecurrentNetwork';
+import type { RecurrentStateBuffer } from './RecurrentStateBuffer';
+
+export const RECURRENT_BRAIN_TYPE = 'recurrent';
+export const RECURRENT_BRAIN_VERSION = 1;
+
+export interface RecurrentBrainConfig extends BrainConfig {
+  cell?: RecurrentCell;   // Defaults to 'elman'
+}
+
+interface RecurrentBrainData {
+  network: RecurrentNetworkState;
+  state: number[];
+}
+
+export class RecurrentBrain implements Brain {
+  readonly type = RECURRENT_BRAIN_TYPE;
+  readonly label?: string;
+
+  private network: RecurrentNetwork;
+  private config: RecurrentBrainConfig;
+
+  // Population buffer and slot while bound; local state otherwise
+  private states: RecurrentStateBuffer | null = null;
+  private slot: number = -1;
+  private local: Float32Array;
+
+  // Reused across think() calls
+  private inputBuffer: Float64Array = new Float64Array(7);
+  private outputBuffer: Float64Array = new Float64Array(3);
+
+  constructor(config: RecurrentBrainConfig = {}, network?: RecurrentNetwork, state?: ArrayLike<number>) {
+    this.network = network ?? new RecurrentNetwork({
+      inputSize: 7,
+      hiddenSize: config.hiddenSize ?? 8,
+      outputSize: 3,
+      cell: config.cell ?? 'elman',
+    });
+    if (this.network.inputSize !== 7 || this.network.outputSize !== 3) {
+      throw new Error(
+        `RecurrentBrain needs 7 inputs and 3 outputs, got ${this.network.inputSize} and ${this.network.outputSize}`
+      );
+    }
+    this.config = {
+      inputSize: 7,
+      hiddenSize: this.network.hiddenSize,
+      outputSize: 3,
+      cell: this.network.cell,
+      mutationRate: config.mutationRate ?? 0.1,
+      mutationStrength: config.mutationStrength ?? 0.3,
+      label: config.label,
+    };
+    this.label = config.label;
+
+    this.local = new Float32Array(this.network.hiddenSize);
+    if (state) this.local.set(state);
+  }
+
+  think(inputs: SensoryInput): BrainOutput {
+    return this.thinkInto(inputs, { moveForward: 0, rotate: 0, action: 0 });
+  }
+
+  thinkInto(inputs: SensoryInput, out: BrainOutput): BrainOutput {
+    const inputArray = this.inputBuffer;
+    inputArray[0] = inputs.front;
+    inputArray[1] = inputs.frontLeft;
+    inputArray[2] = inputs.frontRight;
+    inputArray[3] = inputs.left;
+    inputArray[4] = inputs.right;
+    inputArray[5] = inputs.energy;
+    inputArray[6] = inputs.bias;
+
+    const outputs = this.outputBuffer;
+    const states = this.states;
+    if (states) {
+      this.network.step(inputArray, states.data, this.slot * states.stride, outputs);
+    } else {
+      this.network.step(inputArray, this.local, 0, outputs);
+    }
+    out.moveForward = outputs[0];
+    out.rotate = outputs[1];
+    out.action = outputs[2];
+    return out;
+  }
+
+  /**
+   * Move the hidden state into a population buffer slot, or back into
+   * local storage when `states` is null
+   */
+  bindState(states: RecurrentStateBuffer | null, slot: number): void {
+    if (this.states) {
+      this.states.read(this.slot, this.local);
+    }
+    if (states && slot >= 0) {
+      states.ensure(slot, this.network.hiddenSize);
+      states.reset(slot);
+      states.write(slot, this.local);
+      this.states = states;
+      this.slot = slot;
+    } else {
+      this.states = null;
+      this.slot = -1;
+    }
+  }
+
+  /**
+   * Copy of the current hidden state
+   */
+  getState(): Float32Array {
+    const state = new Float32Array(this.network.hiddenSize);
+    if (this.states) {
+      return this.states.read(this.slot, state);
+    }
+    state.set(this.local);
+    return state;
+  }
+
+  /**
+   * Zero the hidden state
+   */
+  resetState(): void {
+    if (this.states) {
+      this.states.reset(this.slot);
+    } else {
+      this.local.fill(0);
+    }
+  }
+
+  getStateSlot(): number {
+    return this.slot;
+  }
+
+  mutate(mutationRate?: number, mutationStrength?: number): RecurrentBrain {
+    const rate = mutationRate ?? this.config.mutationRate ?? 0.1;
+    const strength = mutationStrength ?? this.config.mutationStrength ?? 0.3;
+
+    return new RecurrentBrain(
+      { ...this.config, label: this.label ? `${this.label}_mutant` : undefined },
+      this.network.mutate(rate, strength)
+    );
+  }
+
+  /**
+   * Mutate into an existing RecurrentBrain of the same shape, reusing its
+   * weight buffer (used when recycling pooled agents). The target's state
+   * is reset, as for any birth.
+   */
+  mutateInto(target: Brain, mutationRate?: number, mutationStrength?: number): boolean {
+    if (!(target instanceof RecurrentBrain) || target === this) return false;
+
+    const rate = mutationRate ?? this.config.mutationRate ?? 0.1;
+    const strength = mutationStrength ?? this.config.mutationStrength ?? 0.3;
+    if (!this.network.mutateInto(target.network, rate, strength)) return false;
+
+    target.config = { ...this.config, label: this.label ? `${this.label}_mutant` : undefined };
+    (target as { label?: string }).label = target.config.label;
+    target.resetState();
+    return true;
+  }
+
+  clone(): RecurrentBrain {
+    return new RecurrentBrain({ ...this.config }, this.network.clone(), this.getState());
+  }
+
+  crossover(other: Brain): RecurrentBrain {
+    if (other.type !== RECURRENT_BRAIN_TYPE) {
+      throw new Error(`Cannot crossover RecurrentBrain with ${other.type}`);
+    }
+
+    return new RecurrentBrain(
+      { ...this.config, label: this.label ? `${this.label}_child` : undefined },
+      this.network.crossover((other as RecurrentBrain).network)
+    );
+  }
+
+  serialize(includeState: boolean = true): BrainState {
+    return {
+      type: RECURRENT_BRAIN_TYPE,
+      version: RECURRENT_BRAIN_VERSION,
+      config: { ...this.config },
+      data: {
+        network: this.network.serialize(),
+        state: includeState ? Array.from(this.getState()) : [],
+      } as RecurrentBrainData,
+    };
+  }
+
+  getComplexity(): number {
+    return this.network.getParameterCount();
+  }
+
+  getRecurrentNetwork(): RecurrentNetwork {
+    return this.network;
+  }
+
+  /**
+   * Rebuild a brain. With `states` and `slot`, the hidden state is read
+   * from that slot of a saved population buffer instead of `state.data`.
+   */
+  static fromState(state: BrainState, states?: RecurrentStateBuffer, slot: number = -1): RecurrentBrain {
+    if (state.type !== RECURRENT_BRAIN_TYPE) {
+      throw new Error(`Expected ${RECURRENT_BRAIN_TYPE}, got ${state.type}`);
+    }
+
+    const data = state.data as RecurrentBrainData;
+    const network = RecurrentNetwork.deserialize(data.network);
+    const hidden = states && slot >= 0 && slot < states.capacity
+      ? states.read(slot, new Float32Array(Math.min(network.hiddenSize, states.stride)))
+      : data.state;
+    return new RecurrentBrain(state.config, network, hidden);
+  }
+
+  static createRandom(config?: RecurrentBrainConfig): RecurrentBrain {
+    return new RecurrentBrain(config);
+  }
+}
+
+BrainRegistry.register(RECURRENT_BRAIN_TYPE, (state) => RecurrentBrain.fromState(state));
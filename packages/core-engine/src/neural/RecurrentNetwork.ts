@@ -0,0 +1,314 @@
+/**
+ * RecurrentNetwork.ts - Single-layer recurrent network over flat weights
+ *
+ * An Elman network: the hidden layer sees the inputs and its own previous
+ * activations, and the outputs read the new hidden layer. The 'gated' cell
+ * adds a GRU-style update gate (without the reset gate) that blends the
+ * previous state with the candidate, so units can hold values over many
+ * ticks.
+ *
+ * The network holds no hidden state itself. step() reads and writes the
+ * state at an offset into a caller-owned Float32Array, normally a slot of
+ * a RecurrentStateBuffer, and stepBatch() steps many slots at once.
+ *
+ * Flat layout:
+ *   inputToHidden   [h * inputSize + i]
+ *   hiddenToHidden  [h * hiddenSize + j]
+ *   hiddenBias      [h]
+ *   hiddenToOutput  [o * hiddenSize + h]
+ *   outputBias      [o]
+ * and for the gated cell:
+ *   gateInput       [h * inputSize + i]
+ *   gateHidden      [h * hiddenSize + j]
+ *   gateBias        [h]
+ */
+
+import type { RecurrentStateBuffer } from './RecurrentStateBuffer';
+
+// ============================================================================
+// Types
+// ============================================================================
+
+export type RecurrentCell = 'elman' | 'gated';
+
+export interface RecurrentNetworkConfig {
+  inputSize: number;
+  hiddenSize: number;
+  outputSize: number;
+  cell: RecurrentCell;
+}
+
+export const DEFAULT_RECURRENT_NETWORK_CONFIG: RecurrentNetworkConfig = {
+  inputSize: 7,
+  hiddenSize: 8,
+  outputSize: 3,
+  cell: 'elman',
+};
+
+export interface RecurrentNetworkState {
+  config: RecurrentNetworkConfig;
+  weights: number[];
+}
+
+/**
+ * Number of flat weights for a configuration
+ */
+export function recurrentWeightCount(config: RecurrentNetworkConfig): number {
+  const { inputSize: I, hiddenSize: H, outputSize: O } = config;
+  const core = I * H + H * H + H + H * O + O;
+  return config.cell === 'gated' ? core + I * H + H * H + H : core;
+}
+
+// ============================================================================
+// RecurrentNetwork Class
+// ============================================================================
+
+export class RecurrentNetwork {
+  readonly inputSize: number;
+  readonly hiddenSize: number;
+  readonly outputSize: number;
+  readonly cell: RecurrentCell;
+
+  private weights: Float64Array;
+
+  // Offsets of each block in the flat weights
+  private hiddenToHidden: number;
+  private hiddenBias: number;
+  private hiddenToOutput: number;
+  private outputBias: number;
+  private gateInput: number;
+  private gateHidden: number;
+  private gateBias: number;
+
+  // New hidden activations, written back once the whole layer is computed
+  private next: Float64Array;
+
+  constructor(config: Partial<RecurrentNetworkConfig> = {}, weights?: ArrayLike<number>) {
+    const full = { ...DEFAULT_RECURRENT_NETWORK_CONFIG, ...config };
+    this.inputSize = full.inputSize;
+    this.hiddenSize = full.hiddenSize;
+    this.outputSize = full.outputSize;
+    this.cell = full.cell;
+
+    const I = this.inputSize;
+    const H = this.hiddenSize;
+    const O = this.outputSize;
+    this.hiddenToHidden = I * H;
+    this.hiddenBias = this.hiddenToHidden + H * H;
+    this.hiddenToOutput = this.hiddenBias + H;
+    this.outputBias = this.hiddenToOutput + H * O;
+    this.gateInput = this.outputBias + O;
+    this.gateHidden = this.gateInput + I * H;
+    this.gateBias = this.gateHidden + H * H;
+
+    const count = recurrentWeightCount(full);
+    if (weights) {
+      if (weights.length !== count) {
+        throw new Error(`Weight count mismatch: expected ${count}, got ${weights.length}`);
+      }
+      this.weights = Float64Array.from(weights);
+    } else {
+      this.weights = new Float64Array(count);
+      this.initializeWeights();
+    }
+    this.next = new Float64Array(H);
+  }
+
+  private initializeWeights(): void {
+    const I = this.inputSize;
+    const H = this.hiddenSize;
+    const O = this.outputSize;
+    const w = this.weights;
+    const fill = (start: number, length: number, stddev: number) => {
+      for (let k = start; k < start + length; k++) w[k] = randomGaussian() * stddev;
+    };
+    const bias = (start: number, length: number) => {
+      for (let k = start; k < start + length; k++) w[k] = (Math.random() - 0.5) * 0.1;
+    };
+
+    // Recurrent weights start small so early state does not saturate
+    fill(0, I * H, Math.sqrt(2 / (I + H)));
+    fill(this.hiddenToHidden, H * H, Math.sqrt(1 / H) * 0.5);
+    bias(this.hiddenBias, H);
+    fill(this.hiddenToOutput, H * O, Math.sqrt(2 / (H + O)));
+    bias(this.outputBias, O);
+    if (this.cell === 'gated') {
+      fill(this.gateInput, I * H, Math.sqrt(2 / (I + H)));
+      fill(this.gateHidden, H * H, Math.sqrt(1 / H) * 0.5);
+      bias(this.gateBias, H);
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // Stepping
+  // --------------------------------------------------------------------------
+
+  /**
+   * Advance one tick: update the hidden state at `state[offset..]` from the
+   * inputs and write the outputs. Allocates nothing.
+   */
+  step(
+    inputs: ArrayLike<number>,
+    state: Float32Array,
+    offset: number,
+    outputs: { [index: number]: number }
+  ): void {
+    this.stepAt(inputs, 0, state, offset, outputs, 0);
+  }
+
+  /**
+   * Step `count` agents sharing these weights. Inputs and outputs are packed
+   * row-major (inputSize / outputSize per row); row r uses the state of
+   * `slots[r]` in `states`.
+   */
+  stepBatch(
+    inputs: Float64Array | Float32Array,
+    outputs: Float64Array | Float32Array,
+    count: number,
+    states: RecurrentStateBuffer,
+    slots: ArrayLike<number>
+  ): void {
+    if (inputs.length < count * this.inputSize || outputs.length < count * this.outputSize) {
+      throw new Error(`Batch of ${count} does not fit the input or output buffer`);
+    }
+    for (let r = 0; r < count; r++) {
+      states.ensure(slots[r], this.hiddenSize);
+    }
+    const data = states.data;
+    const stride = states.stride;
+    for (let r = 0; r < count; r++) {
+      this.stepAt(inputs, r * this.inputSize, data, slots[r] * stride, outputs, r * this.outputSize);
+    }
+  }
+
+  private stepAt(
+    x: ArrayLike<number>,
+    xBase: number,
+    state: Float32Array,
+    offset: number,
+    y: { [index: number]: number },
+    yBase: number
+  ): void {
+    const I = this.inputSize;
+    const H = this.hiddenSize;
+    const O = this.outputSize;
+    const w = this.weights;
+    const next = this.next;
+    const gated = this.cell === 'gated';
+
+    for (let h = 0; h < H; h++) {
+      let s = w[this.hiddenBias + h];
+      const inRow = h * I;
+      for (let i = 0; i < I; i++) s += x[xBase + i] * w[inRow + i];
+      const recRow = this.hiddenToHidden + h * H;
+      for (let j = 0; j < H; j++) s += state[offset + j] * w[recRow + j];
+      let value = Math.tanh(s);
+
+      if (gated) {
+        let g = w[this.gateBias + h];
+        const gateRow = this.gateInput + h * I;
+        for (let i = 0; i < I; i++) g += x[xBase + i] * w[gateRow + i];
+        const gateRecRow = this.gateHidden + h * H;
+        for (let j = 0; j < H; j++) g += state[offset + j] * w[gateRecRow + j];
+        const z = 1 / (1 + Math.exp(-g));
+        const previous = state[offset + h];
+        value = previous + z * (value - previous);
+      }
+      next[h] = value;
+    }
+
+    for (let h = 0; h < H; h++) state[offset + h] = next[h];
+
+    for (let o = 0; o < O; o++) {
+      let s = w[this.outputBias + o];
+      const row = this.hiddenToOutput + o * H;
+      for (let h = 0; h < H; h++) s += next[h] * w[row + h];
+      y[yBase + o] = Math.tanh(s);
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // Evolution
+  // --------------------------------------------------------------------------
+
+  mutate(mutationRate: number = 0.1, mutationStrength: number = 0.3): RecurrentNetwork {
+    const child = this.clone();
+    this.mutateInto(child, mutationRate, mutationStrength);
+    return child;
+  }
+
+  /**
+   * Write a mutated copy of this network's weights into an existing network
+   * of the same architecture. Returns false when the architectures differ.
+   */
+  mutateInto(target: RecurrentNetwork, mutationRate: number = 0.1, mutationStrength: number = 0.3): boolean {
+    if (!this.sameShape(target)) return false;
+    const src = this.weights;
+    const dst = target.weights;
+    for (let i = 0; i < src.length; i++) {
+      dst[i] = Math.random() < mutationRate ? src[i] + randomGaussian() * mutationStrength : src[i];
+    }
+    return true;
+  }
+
+  crossover(other: RecurrentNetwork): RecurrentNetwork {
+    if (!this.sameShape(other)) {
+      throw new Error('Cannot crossover networks with different architectures');
+    }
+    const weights = new Float64Array(this.weights.length);
+    for (let i = 0; i < weights.length; i++) {
+      weights[i] = Math.random() < 0.5 ? this.weights[i] : other.weights[i];
+    }
+    return new RecurrentNetwork(this.getConfig(), weights);
+  }
+
+  clone(): RecurrentNetwork {
+    return new RecurrentNetwork(this.getConfig(), this.weights);
+  }
+
+  getConfig(): RecurrentNetworkConfig {
+    return {
+      inputSize: this.inputSize,
+      hiddenSize: this.hiddenSize,
+      outputSize: this.outputSize,
+      cell: this.cell,
+    };
+  }
+
+  /**
+   * Copy of the flat weights
+   */
+  getWeights(): Float64Array {
+    return this.weights.slice();
+  }
+
+  getParameterCount(): number {
+    return this.weights.length;
+  }
+
+  serialize(): RecurrentNetworkState {
+    return { config: this.getConfig(), weights: Array.from(this.weights) };
+  }
+
+  static deserialize(state: RecurrentNetworkState): RecurrentNetwork {
+    return new RecurrentNetwork(state.config, state.weights);
+  }
+
+  private sameShape(other: RecurrentNetwork): boolean {
+    return (
+      this.inputSize === other.inputSize &&
+      this.hiddenSize === other.hiddenSize &&
+      this.outputSize === other.outputSize &&
+      this.cell === other.cell
+    );
+  }
+}
+
+function randomGaussian(): number {
+  let u = 0, v = 0;
+  while (u === 0) u = Math.random();
+  while (v === 0) v = Math.random();
+  return Math.sqrt(-2.0 * Math.log(u)) * Math.cos(2.0 * Math.PI * v);
+}
+
+export default RecurrentNetwork;
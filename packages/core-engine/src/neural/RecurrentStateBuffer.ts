@@ -0,0 +1,195 @@
+/**
+ * RecurrentStateBuffer.ts - Population-wide hidden state for recurrent brains
+ *
+ * Recurrent brains keep their hidden state across ticks. Rather than a
+ * buffer per brain, the state of the whole population lives in one
+ * Float32Array with `stride` values per agent slot (see Agent.slot), so it
+ * can be stepped in batches, written out as one block and handed to
+ * workers without walking agents.
+ *
+ * AgentManager owns one buffer and binds each brain to its agent's slot
+ * (Brain.bindState). Growing the capacity or stride replaces `data`, so
+ * readers must not hold on to it across a bind. With `shared: true` the
+ * buffer is a SharedArrayBuffer that workers attach to with attach(); they
+ * must re-attach after growth.
+ */
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+export interface RecurrentStateBufferConfig {
+  stride: number;         // Values per slot; grows to the largest bound brain
+  initialSlots: number;
+  shared: boolean;        // Back with a SharedArrayBuffer (worker access)
+}
+
+export const DEFAULT_RECURRENT_STATE_BUFFER_CONFIG: RecurrentStateBufferConfig = {
+  stride: 8,
+  initialSlots: 64,
+  shared: false,
+};
+
+// Header words in toBytes(): magic, stride, slots
+const BYTES_MAGIC = 0x52534231; // 'RSB1'
+const HEADER_WORDS = 3;
+
+// ============================================================================
+// RecurrentStateBuffer Class
+// ============================================================================
+
+export class RecurrentStateBuffer {
+  readonly shared: boolean;
+
+  private _data: Float32Array;
+  private _stride: number;
+  private _slots: number;
+
+  constructor(config?: Partial<RecurrentStateBufferConfig>) {
+    const full = { ...DEFAULT_RECURRENT_STATE_BUFFER_CONFIG, ...config };
+    this.shared = full.shared;
+    this._stride = Math.max(1, full.stride);
+    this._slots = Math.max(1, full.initialSlots);
+    this._data = this.allocate(this._slots * this._stride);
+  }
+
+  /**
+   * Wrap existing memory (a SharedArrayBuffer posted to a worker, or a
+   * transferred ArrayBuffer) without copying
+   */
+  static attach(buffer: ArrayBufferLike, stride: number): RecurrentStateBuffer {
+    const states = new RecurrentStateBuffer({ stride, initialSlots: 1, shared: buffer instanceof SharedArrayBuffer });
+    states._data = new Float32Array(buffer);
+    states._slots = Math.floor(states._data.length / stride);
+    return states;
+  }
+
+  /**
+   * Packed state, `stride` values per slot
+   */
+  get data(): Float32Array {
+    return this._data;
+  }
+
+  get stride(): number {
+    return this._stride;
+  }
+
+  get capacity(): number {
+    return this._slots;
+  }
+
+  /**
+   * Make room for `slot` with at least `width` values per slot
+   */
+  ensure(slot: number, width: number): void {
+    if (width > this._stride) {
+      let stride = this._stride;
+      while (stride < width) stride *= 2;
+      this.relayout(this._slots, stride);
+    }
+    if (slot >= this._slots) {
+      let slots = this._slots;
+      while (slots <= slot) slots *= 2;
+      this.relayout(slots, this._stride);
+    }
+  }
+
+  /**
+   * Zero a slot's state (on birth)
+   */
+  reset(slot: number): void {
+    if (slot < this._slots) {
+      this._data.fill(0, slot * this._stride, (slot + 1) * this._stride);
+    }
+  }
+
+  /**
+   * Copy one slot's state to another
+   */
+  copy(from: number, to: number): void {
+    this.ensure(Math.max(from, to), 1);
+    const s = this._stride;
+    this._data.copyWithin(to * s, from * s, (from + 1) * s);
+  }
+
+  /**
+   * Copy `out.length` values of a slot into `out`
+   */
+  read(slot: number, out: Float32Array): Float32Array {
+    const base = slot * this._stride;
+    for (let i = 0; i < out.length; i++) out[i] = this._data[base + i];
+    return out;
+  }
+
+  write(slot: number, values: ArrayLike<number>): void {
+    this.ensure(slot, values.length);
+    this._data.set(values, slot * this._stride);
+  }
+
+  clear(): void {
+    this._data.fill(0);
+  }
+
+  // --------------------------------------------------------------------------
+  // Binary form
+  // --------------------------------------------------------------------------
+
+  /**
+   * Copy of the buffer as bytes: a three-word header (magic, stride, slots)
+   * followed by the packed float32 state
+   */
+  toBytes(): Uint8Array {
+    const words = new Uint32Array(HEADER_WORDS + this._data.length);
+    words[0] = BYTES_MAGIC;
+    words[1] = this._stride;
+    words[2] = this._slots;
+    new Float32Array(words.buffer, HEADER_WORDS * 4).set(this._data);
+    return new Uint8Array(words.buffer);
+  }
+
+  static fromBytes(bytes: Uint8Array, config?: Partial<Pick<RecurrentStateBufferConfig, 'shared'>>): RecurrentStateBuffer {
+    // Copy to an aligned buffer; `bytes` may be a view at any offset
+    const aligned = new Uint8Array(bytes.length);
+    aligned.set(bytes);
+    const header = new Uint32Array(aligned.buffer, 0, HEADER_WORDS);
+    if (header[0] !== BYTES_MAGIC) {
+      throw new Error('Not a recurrent state buffer');
+    }
+    const stride = header[1];
+    const slots = header[2];
+    const states = new RecurrentStateBuffer({ stride, initialSlots: slots, shared: config?.shared });
+    states._data.set(new Float32Array(aligned.buffer, HEADER_WORDS * 4, stride * slots));
+    return states;
+  }
+
+  memoryUsage(): number {
+    return this._data.byteLength;
+  }
+
+  private relayout(slots: number, stride: number): void {
+    const next = this.allocate(slots * stride);
+    const old = this._data;
+    const oldStride = this._stride;
+    if (stride === oldStride) {
+      next.set(old);
+    } else {
+      const width = Math.min(stride, oldStride);
+      for (let s = 0; s < this._slots; s++) {
+        next.set(old.subarray(s * oldStride, s * oldStride + width), s * stride);
+      }
+    }
+    this._data = next;
+    this._slots = slots;
+    this._stride = stride;
+  }
+
+  private allocate(length: number): Float32Array {
+    if (this.shared) {
+      return new Float32Array(new SharedArrayBuffer(length * Float32Array.BYTES_PER_ELEMENT));
+    }
+    return new Float32Array(length);
+  }
+}
+
+export default RecurrentStateBuffer;
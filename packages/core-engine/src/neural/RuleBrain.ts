@@ -3,12 +3,38 @@
  */
 
 import { Brain, SensoryInput, BrainOutput, BrainState, BrainRegistry } from './Brain';
+import { RuleTable, evaluateRules, thresholdKey } from './RuleTable';
 
 export interface RuleBrainConfig {
   criticalEnergyThreshold?: number;
   reproductionEnergyThreshold?: number;
   avoidCrowding?: boolean;
   crowdingThreshold?: number;
+  compiled?: boolean;     // Decide through a quantized lookup table
+  tableBits?: number;     // Quantization bits per input for the table
+  exact?: boolean;        // Cascade fallback for cells straddling a threshold
+}
+
+// Compiled tables shared by brains whose thresholds compile alike, keyed by
+// thresholdKey so mutated thresholds reuse tables; least recently used first out
+const TABLE_CACHE_SIZE = 64;
+const tableCache: Map<string, RuleTable> = new Map();
+
+function compiledTableFor(config: Required<RuleBrainConfig>): RuleTable {
+  const { tableBits: bits, exact } = config;
+  const key = `${thresholdKey(config.criticalEnergyThreshold, bits, exact)},` +
+    `${thresholdKey(config.reproductionEnergyThreshold, bits, exact)},${bits},${exact}`;
+  let table = tableCache.get(key);
+  if (table) {
+    tableCache.delete(key);
+  } else {
+    if (tableCache.size >= TABLE_CACHE_SIZE) {
+      tableCache.delete(tableCache.keys().next().value!);
+    }
+    table = new RuleTable(config, { bits, exact });
+  }
+  tableCache.set(key, table);
+  return table;
 }
 
 export class RuleBrain implements Brain {
@@ -16,6 +42,7 @@ export class RuleBrain implements Brain {
   readonly label?: string;
 
   private config: Required<RuleBrainConfig>;
+  private table: RuleTable | null = null;
   private stats = {
     totalDecisions: 0,
     actionCounts: {} as Record<string, number>,
@@ -28,72 +55,37 @@ export class RuleBrain implements Brain {
       reproductionEnergyThreshold: config?.reproductionEnergyThreshold ?? 0.7,
       avoidCrowding: config?.avoidCrowding ?? true,
       crowdingThreshold: config?.crowdingThreshold ?? 5,
+      compiled: config?.compiled ?? false,
+      tableBits: config?.tableBits ?? 4,
+      exact: config?.exact ?? true,
     };
   }
 
   think(input: SensoryInput): BrainOutput {
-    this.stats.totalDecisions++;
+    return this.thinkInto(input, { moveForward: 0, rotate: 0, action: 0 });
+  }
 
-    const energy = input.energy;
-    const front = input.front;
-    const frontLeft = input.frontLeft;
-    const frontRight = input.frontRight;
-
-    // Calculate outputs based on rules
-    let moveForward = 0;
-    let rotate = 0;
-    let action = 0;
-
-    // Critical energy - prioritize finding food
-    if (energy < this.config.criticalEnergyThreshold) {
-      if (front > 0.1) {
-        moveForward = 1;
-        action = 1; // Eat action
-      } else if (frontLeft > frontRight) {
-        rotate = 0.5; // Turn left (positive rotation)
-      } else if (frontRight > frontLeft) {
-        rotate = -0.5; // Turn right (negative rotation)
-      } else {
-        moveForward = 0.8;
-      }
+  /**
+   * Decide into a caller-owned output record, through the compiled table
+   * when enabled
+   */
+  thinkInto(input: SensoryInput, out: BrainOutput): BrainOutput {
+    this.stats.totalDecisions++;
+    if (this.config.compiled) {
+      return this.getRuleTable().evaluate(input, out, this.config);
     }
-    // Normal behavior
-    else {
-      // Food ahead - move toward it
-      if (front > 0.1) {
-        moveForward = front;
-        if (front > 0.5) {
-          action = 1; // Eat if close enough
-        }
-      }
-      // Food to side - turn toward it
-      else if (frontLeft > 0.1) {
-        rotate = frontLeft * 0.5;
-      } else if (frontRight > 0.1) {
-        rotate = -frontRight * 0.5;
-      }
-      // Explore
-      else {
-        moveForward = 0.5;
-        // Random exploration
-        if (Math.random() < 0.2) {
-          rotate = 0.3;
-        } else if (Math.random() < 0.2) {
-          rotate = -0.3;
-        }
-      }
+    return evaluateRules(this.config, input, out);
+  }
 
-      // Consider reproduction if energy is high
-      if (energy > this.config.reproductionEnergyThreshold) {
-        action = 2; // Reproduce action
-      }
+  /**
+   * The compiled table for this brain's thresholds, shared between brains
+   * whose thresholds compile to the same table
+   */
+  getRuleTable(): RuleTable {
+    if (!this.table) {
+      this.table = compiledTableFor(this.config);
     }
-
-    return {
-      moveForward,
-      rotate,
-      action,
-    };
+    return this.table;
   }
 
   mutate(mutationRate: number = 0.1, mutationStrength: number = 0.2): Brain {
@@ -110,6 +102,9 @@ export class RuleBrain implements Brain {
       reproductionEnergyThreshold: mutate(this.config.reproductionEnergyThreshold, 0.5, 0.9),
       avoidCrowding: this.config.avoidCrowding,
       crowdingThreshold: mutate(this.config.crowdingThreshold, 2, 10),
+      compiled: this.config.compiled,
+      tableBits: this.config.tableBits,
+      exact: this.config.exact,
     };
 
     return new RuleBrain(newConfig, this.label);
@@ -139,6 +134,9 @@ export class RuleBrain implements Brain {
         Math.random() < 0.5
           ? this.config.crowdingThreshold
           : other.config.crowdingThreshold,
+      compiled: this.config.compiled,
+      tableBits: this.config.tableBits,
+      exact: this.config.exact,
     };
 
     return new RuleBrain(childConfig, this.label);
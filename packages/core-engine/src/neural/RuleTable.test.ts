@@ -0,0 +1,115 @@
+/**
+ * RuleTable.test.ts - Tests for the compiled RuleBrain decision table
+ */
+
+import { describe, it, expect } from 'vitest';
+import { RuleTable } from './RuleTable';
+import { RuleBrain } from './RuleBrain';
+import { BrainOutput, SensoryInput } from './Brain';
+
+const realRandom = Math.random;
+
+function input(front: number, frontLeft: number, frontRight: number, energy: number): SensoryInput {
+  return { front, frontLeft, frontRight, left: 0, right: 0, energy, bias: 1 };
+}
+
+function probeInputs(): SensoryInput[] {
+  // Dense around thresholds, plus equal side readings and out-of-range values
+  const values = [-0.2, 0, 0.05, 0.0999, 0.1, 0.1001, 0.2, 0.23, 0.3, 0.5, 0.5001, 0.69, 0.7, 0.71, 0.9, 1, 1.3];
+  const inputs: SensoryInput[] = [];
+  for (const f of values) {
+    for (const l of [0, 0.1, 0.1001, 0.4]) {
+      for (const r of [0, 0.1, 0.4, 0.4001]) {
+        for (const e of values) inputs.push(input(f, l, r, e));
+      }
+    }
+  }
+  return inputs;
+}
+
+describe('RuleTable', () => {
+  for (const config of [{}, { criticalEnergyThreshold: 0.23, reproductionEnergyThreshold: 0.71 }]) {
+    it(`matches the interpreted cascade exactly (${JSON.stringify(config)})`, () => {
+      const interpreted = new RuleBrain(config);
+      const compiled = new RuleBrain({ ...config, compiled: true });
+
+      // Replay the same exploration draws for both brains
+      let draw = 0;
+      Math.random = () => [0.1, 0.5][draw++ % 2];
+      try {
+        for (const probe of probeInputs()) {
+          draw = 0;
+          const expected = interpreted.think(probe);
+          draw = 0;
+          expect(compiled.think(probe)).toEqual(expected);
+        }
+      } finally {
+        Math.random = realRandom;
+      }
+    });
+  }
+
+  it('falls back to the cascade only where a threshold splits a cell', () => {
+    const config = new RuleBrain({ criticalEnergyThreshold: 0.23 }).getConfig();
+    const exact = new RuleTable(config, { bits: 4 });
+    const approximate = new RuleTable(config, { bits: 4, exact: false });
+
+    expect(exact.exactFraction).toBeGreaterThan(0);
+    expect(exact.exactFraction).toBeLessThan(0.5);
+    expect(approximate.exactFraction).toBe(0);
+
+    // Energy 0.22 and 0.24 share a cell but lie on either side of 0.23
+    const low = { moveForward: 0, rotate: 0, action: 0 };
+    const high = { moveForward: 0, rotate: 0, action: 0 };
+    exact.evaluate(input(0.3, 0, 0, 0.22), low);
+    exact.evaluate(input(0.3, 0, 0, 0.24), high);
+    expect(low.action).toBe(1);
+    expect(high.moveForward).toBeCloseTo(0.3, 5);
+    expect(high.action).toBe(0);
+  });
+
+  it('evaluates batches into caller-owned records', () => {
+    const table = new RuleBrain({ compiled: true }).getRuleTable();
+    const inputs = [input(0.8, 0, 0, 0.5), input(0, 0.6, 0, 0.5), input(0, 0, 0, 0.9)];
+    const outputs: BrainOutput[] = inputs.map(() => ({ moveForward: 0, rotate: 0, action: 0 }));
+    const records = [...outputs];
+
+    table.evaluateBatch(inputs, outputs);
+
+    expect(outputs[0]).toBe(records[0]);
+    expect(outputs[0].action).toBe(1);
+    expect(outputs[1].rotate).toBeCloseTo(0.3, 5);
+    expect(outputs[2].action).toBe(2);
+  });
+
+  it('shares tables between brains with the same thresholds', () => {
+    const a = new RuleBrain({ compiled: true });
+    const b = new RuleBrain({ compiled: true });
+    const c = new RuleBrain({ compiled: true, criticalEnergyThreshold: 0.3 });
+
+    expect(a.getRuleTable()).toBe(b.getRuleTable());
+    expect(a.getRuleTable()).not.toBe(c.getRuleTable());
+    expect((a.clone() as RuleBrain).getRuleTable()).toBe(a.getRuleTable());
+    expect((a.mutate(1, 0.1) as RuleBrain).getConfig().compiled).toBe(true);
+  });
+
+  it('shares tables between thresholds that compile alike', () => {
+    // Both thresholds lie inside the energy cell around 0.2 at 4 bits
+    const a = new RuleBrain({ compiled: true, criticalEnergyThreshold: 0.2 });
+    const b = new RuleBrain({ compiled: true, criticalEnergyThreshold: 0.21 });
+    expect(a.getRuleTable()).toBe(b.getRuleTable());
+
+    // Each brain still splits the cell at its own threshold
+    const out = { moveForward: 0, rotate: 0, action: 0 };
+    expect(a.thinkInto(input(0.3, 0, 0, 0.205), out).action).toBe(0);
+    expect(b.thinkInto(input(0.3, 0, 0, 0.205), out).action).toBe(1);
+  });
+
+  it('thinks into a reused output record', () => {
+    const brain = new RuleBrain({ compiled: true });
+    const out = { moveForward: 0, rotate: 0, action: 0 };
+    expect(brain.thinkInto(input(0.8, 0, 0, 0.5), out)).toBe(out);
+    expect(out.moveForward).toBeCloseTo(0.8, 5);
+    expect(brain.getStats().totalDecisions).toBe(1);
+  });
+});
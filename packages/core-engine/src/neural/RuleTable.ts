@@ -0,0 +1,409 @@
+/**
+ * RuleTable.ts - Compiled decision table for RuleBrain
+ *
+ * The RuleBrain cascade only branches on front, frontLeft, frontRight and
+ * energy, so it can be compiled into a lookup table over those inputs
+ * quantized to `bits` each (the same cells as packDecisionKey in the LLM
+ * cache and distiller). Each cell stores which branch of the cascade fires; the
+ * branch's output formula is then applied to the actual inputs, so
+ * compiled and interpreted decisions are identical.
+ *
+ * In exact mode (the default) cells where a threshold falls inside the
+ * cell, and the branch therefore depends on where in the cell the input
+ * lies, fall back to the cascade. Without exact mode those cells take the
+ * branch at the cell centre.
+ *
+ * Compilation only compares thresholds with cell bounds and centres, so
+ * every threshold between the same two of those points yields the same
+ * table (thresholdKey). Brains share such a table and pass their own
+ * thresholds for the cascade fallback.
+ *
+ * For the stock four-threshold cascade V8 runs the interpreted rules about
+ * as fast as a lookup; most of the saving for rule-driven populations
+ * comes from thinkInto() not allocating. The table pays off as rule sets
+ * grow more branches.
+ */
+
+import type { SensoryInput, BrainOutput } from './Brain';
+import type { RuleBrainConfig } from './RuleBrain';
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+export interface RuleTableOptions {
+  bits: number;      // Quantization bits per input (4 inputs)
+  exact: boolean;    // Evaluate straddling cells with the cascade
+}
+
+export const DEFAULT_RULE_TABLE_OPTIONS: RuleTableOptions = {
+  bits: 4,
+  exact: true,
+};
+
+// Branch ids stored per cell; REPRODUCE is or-ed onto normal branches
+const EXACT = 0;
+const CRITICAL_EAT = 1;
+const CRITICAL_LEFT = 2;
+const CRITICAL_RIGHT = 3;
+const CRITICAL_WANDER = 4;
+const FOOD_AHEAD = 5;
+const FOOD_AHEAD_EAT = 6;
+const FOOD_LEFT = 7;
+const FOOD_RIGHT = 8;
+const EXPLORE = 9;
+const BRANCH_MASK = 0x0f;
+const REPRODUCE = 0x10;
+
+const TRUE = 1;
+const FALSE = 0;
+const UNKNOWN = -1;
+
+// Widen cells slightly so thresholds on a cell boundary count as inside
+const EPSILON = 1e-9;
+
+// ============================================================================
+// Threshold keys
+// ============================================================================
+
+const COMPARISON_POINTS: Map<number, Float64Array> = new Map();
+
+/**
+ * Sorted values compile() compares energy thresholds against: cell bounds,
+ * plus cell centres when not exact
+ */
+function comparisonPoints(bits: number, exact: boolean): Float64Array {
+  const id = bits * 2 + (exact ? 1 : 0);
+  let points = COMPARISON_POINTS.get(id);
+  if (!points) {
+    const levels = (1 << bits) - 1;
+    const values: number[] = [];
+    for (let q = 0; q <= levels; q++) {
+      if (q > 0) values.push((q - 0.5) / levels - EPSILON);
+      if (q < levels) values.push((q + 0.5) / levels + EPSILON);
+      if (!exact) values.push(q / levels);
+    }
+    points = Float64Array.from(values).sort();
+    COMPARISON_POINTS.set(id, points);
+  }
+  return points;
+}
+
+/**
+ * Integer key for a threshold: thresholds with equal keys fall on the same
+ * side of every point compile() compares them with, so they compile to the
+ * same table
+ */
+export function thresholdKey(threshold: number, bits: number, exact: boolean): number {
+  const points = comparisonPoints(bits, exact);
+  // Number of points below the threshold
+  let lo = 0;
+  let hi = points.length;
+  while (lo < hi) {
+    const mid = (lo + hi) >>> 1;
+    if (points[mid] < threshold) lo = mid + 1;
+    else hi = mid;
+  }
+  return 2 * lo + (points[lo] === threshold ? 1 : 0);
+}
+
+// ============================================================================
+// Interpreted rules
+// ============================================================================
+
+/**
+ * The RuleBrain cascade, writing into `out`
+ */
+export function evaluateRules(config: Required<RuleBrainConfig>, input: SensoryInput, out: BrainOutput): BrainOutput {
+  const { energy, front, frontLeft, frontRight } = input;
+  let moveForward = 0;
+  let rotate = 0;
+  let action = 0;
+
+  // Critical energy - prioritize finding food
+  if (energy < config.criticalEnergyThreshold) {
+    if (front > 0.1) {
+      moveForward = 1;
+      action = 1; // Eat action
+    } else if (frontLeft > frontRight) {
+      rotate = 0.5; // Turn left (positive rotation)
+    } else if (frontRight > frontLeft) {
+      rotate = -0.5; // Turn right (negative rotation)
+    } else {
+      moveForward = 0.8;
+    }
+  }
+  // Normal behavior
+  else {
+    // Food ahead - move toward it
+    if (front > 0.1) {
+      moveForward = front;
+      if (front > 0.5) {
+        action = 1; // Eat if close enough
+      }
+    }
+    // Food to side - turn toward it
+    else if (frontLeft > 0.1) {
+      rotate = frontLeft * 0.5;
+    } else if (frontRight > 0.1) {
+      rotate = -frontRight * 0.5;
+    }
+    // Explore
+    else {
+      moveForward = 0.5;
+      // Random exploration
+      if (Math.random() < 0.2) {
+        rotate = 0.3;
+      } else if (Math.random() < 0.2) {
+        rotate = -0.3;
+      }
+    }
+
+    // Consider reproduction if energy is high
+    if (energy > config.reproductionEnergyThreshold) {
+      action = 2; // Reproduce action
+    }
+  }
+
+  out.moveForward = moveForward;
+  out.rotate = rotate;
+  out.action = action;
+  return out;
+}
+
+// ============================================================================
+// RuleTable Class
+// ============================================================================
+
+export class RuleTable {
+  readonly bits: number;
+  readonly exact: boolean;
+
+  private config: Required<RuleBrainConfig>;
+  private table: Uint8Array;
+  private levels: number;
+  private exactCells: number = 0;
+
+  constructor(config: Required<RuleBrainConfig>, options?: Partial<RuleTableOptions>) {
+    const full = { ...DEFAULT_RULE_TABLE_OPTIONS, ...options };
+    if (full.bits < 1 || full.bits > 5) {
+      throw new Error(`Rule table bits must be between 1 and 5, got ${full.bits}`);
+    }
+    this.bits = full.bits;
+    this.exact = full.exact;
+    this.config = { ...config };
+    this.levels = (1 << full.bits) - 1;
+    this.table = new Uint8Array(2 ** (4 * full.bits));
+    this.compile();
+  }
+
+  get cellCount(): number {
+    return this.table.length;
+  }
+
+  /**
+   * Fraction of cells that fall back to the cascade
+   */
+  get exactFraction(): number {
+    return this.exactCells / this.table.length;
+  }
+
+  /**
+   * Decide for one input. Cells split by a threshold run the cascade with
+   * `config`, the deciding brain's own thresholds (the table may be shared
+   * by brains whose thresholds have the same thresholdKey).
+   */
+  evaluate(
+    input: SensoryInput,
+    out: BrainOutput,
+    config: Required<RuleBrainConfig> = this.config
+  ): BrainOutput {
+    // Same cells as packDecisionKey([front, frontLeft, frontRight, energy])
+    const levels = this.levels;
+    const bits = this.bits;
+    const key =
+      quantize(input.front, levels) |
+      (quantize(input.frontLeft, levels) << bits) |
+      (quantize(input.frontRight, levels) << (2 * bits)) |
+      (quantize(input.energy, levels) << (3 * bits));
+    const cell = this.table[key];
+    if (cell === EXACT) {
+      return evaluateRules(config, input, out);
+    }
+    return this.apply(cell, input, out);
+  }
+
+  /**
+   * Evaluate `count` inputs into caller-owned output records
+   */
+  evaluateBatch(
+    inputs: ArrayLike<SensoryInput>,
+    outputs: BrainOutput[],
+    count: number = inputs.length,
+    config: Required<RuleBrainConfig> = this.config
+  ): void {
+    for (let i = 0; i < count; i++) {
+      this.evaluate(inputs[i], outputs[i], config);
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // Compilation
+  // --------------------------------------------------------------------------
+
+  private compile(): void {
+    const levels = this.levels;
+    const lo = new Float64Array(4);
+    const hi = new Float64Array(4);
+
+    for (let cell = 0; cell < this.table.length; cell++) {
+      for (let i = 0; i < 4; i++) {
+        const q = (cell >>> (i * this.bits)) & levels;
+        lo[i] = q === 0 ? -Infinity : (q - 0.5) / levels - EPSILON;
+        hi[i] = q === levels ? Infinity : (q + 0.5) / levels + EPSILON;
+      }
+
+      let branch = this.classify(lo, hi);
+      if (branch === EXACT && !this.exact) {
+        // Decide at the cell centre
+        for (let i = 0; i < 4; i++) {
+          lo[i] = hi[i] = ((cell >>> (i * this.bits)) & levels) / levels;
+        }
+        branch = this.classify(lo, hi);
+      }
+      if (branch === EXACT) this.exactCells++;
+      this.table[cell] = branch;
+    }
+  }
+
+  /**
+   * Walk the cascade with three-valued predicates over the cell's input
+   * intervals; EXACT as soon as a predicate on the path is undecided
+   */
+  private classify(lo: Float64Array, hi: Float64Array): number {
+    const FRONT = 0;
+    const LEFT = 1;
+    const RIGHT = 2;
+    const ENERGY = 3;
+
+    const critical = below(lo[ENERGY], hi[ENERGY], this.config.criticalEnergyThreshold);
+    if (critical === UNKNOWN) return EXACT;
+
+    if (critical === TRUE) {
+      const ahead = above(lo[FRONT], hi[FRONT], 0.1);
+      if (ahead === UNKNOWN) return EXACT;
+      if (ahead === TRUE) return CRITICAL_EAT;
+      const left = greater(lo[LEFT], hi[LEFT], lo[RIGHT], hi[RIGHT]);
+      if (left === UNKNOWN) return EXACT;
+      if (left === TRUE) return CRITICAL_LEFT;
+      const right = greater(lo[RIGHT], hi[RIGHT], lo[LEFT], hi[LEFT]);
+      if (right === UNKNOWN) return EXACT;
+      return right === TRUE ? CRITICAL_RIGHT : CRITICAL_WANDER;
+    }
+
+    let branch: number;
+    const ahead = above(lo[FRONT], hi[FRONT], 0.1);
+    if (ahead === UNKNOWN) return EXACT;
+    if (ahead === TRUE) {
+      const eat = above(lo[FRONT], hi[FRONT], 0.5);
+      if (eat === UNKNOWN) return EXACT;
+      branch = eat === TRUE ? FOOD_AHEAD_EAT : FOOD_AHEAD;
+    } else {
+      const left = above(lo[LEFT], hi[LEFT], 0.1);
+      if (left === UNKNOWN) return EXACT;
+      if (left === TRUE) {
+        branch = FOOD_LEFT;
+      } else {
+        const right = above(lo[RIGHT], hi[RIGHT], 0.1);
+        if (right === UNKNOWN) return EXACT;
+        branch = right === TRUE ? FOOD_RIGHT : EXPLORE;
+      }
+    }
+
+    const reproduce = above(lo[ENERGY], hi[ENERGY], this.config.reproductionEnergyThreshold);
+    if (reproduce === UNKNOWN) return EXACT;
+    return reproduce === TRUE ? branch | REPRODUCE : branch;
+  }
+
+  private apply(cell: number, input: SensoryInput, out: BrainOutput): BrainOutput {
+    let moveForward = 0;
+    let rotate = 0;
+    let action = 0;
+
+    switch (cell & BRANCH_MASK) {
+      case CRITICAL_EAT:
+        moveForward = 1;
+        action = 1;
+        break;
+      case CRITICAL_LEFT:
+        rotate = 0.5;
+        break;
+      case CRITICAL_RIGHT:
+        rotate = -0.5;
+        break;
+      case CRITICAL_WANDER:
+        moveForward = 0.8;
+        break;
+      case FOOD_AHEAD:
+        moveForward = input.front;
+        break;
+      case FOOD_AHEAD_EAT:
+        moveForward = input.front;
+        action = 1;
+        break;
+      case FOOD_LEFT:
+        rotate = input.frontLeft * 0.5;
+        break;
+      case FOOD_RIGHT:
+        rotate = -input.frontRight * 0.5;
+        break;
+      case EXPLORE:
+        moveForward = 0.5;
+        if (Math.random() < 0.2) {
+          rotate = 0.3;
+        } else if (Math.random() < 0.2) {
+          rotate = -0.3;
+        }
+        break;
+    }
+    if (cell & REPRODUCE) action = 2;
+
+    out.moveForward = moveForward;
+    out.rotate = rotate;
+    out.action = action;
+    return out;
+  }
+}
+
+// Inline equivalent of packDecisionKey's per-input quantization
+function quantize(v: number, levels: number): number {
+  return v > 0 ? (v < 1 ? (v * levels + 0.5) | 0 : levels) : 0;
+}
+
+// Predicates over half-open intervals [lo, hi); lo === hi is a single point
+
+// v > t
+function above(lo: number, hi: number, t: number): number {
+  if (lo === hi) return lo > t ? TRUE : FALSE;
+  if (lo > t) return TRUE;
+  if (hi <= t) return FALSE;
+  return UNKNOWN;
+}
+
+// v < t
+function below(lo: number, hi: number, t: number): number {
+  if (lo === hi) return lo < t ? TRUE : FALSE;
+  if (hi <= t) return TRUE;
+  if (lo >= t) return FALSE;
+  return UNKNOWN;
+}
+
+// a > b
+function greater(loA: number, hiA: number, loB: number, hiB: number): number {
+  if (loA === hiA && loB === hiB) return loA > loB ? TRUE : FALSE;
+  if (loA >= hiB) return TRUE;
+  if (hiA <= loB) return FALSE;
+  return UNKNOWN;
+}
+
+export default RuleTable;
@@ -29,6 +29,22 @@ export type {
   NeuralNetworkConfig,
 } from './NeuralNetwork';
 
+// Generated forward-pass kernels
+export {
+  getForwardKernel,
+  getLayerKernel,
+  forwardWeightCount,
+  activationFunction,
+  isCodegenAvailable,
+  setCodegenEnabled,
+  MAX_UNROLLED_WEIGHTS,
+} from './ForwardKernels';
+
+export type {
+  Activation,
+  ForwardKernel,
+} from './ForwardKernels';
+
 // Neural Brain (neural network-based)
 export {
   NeuralBrain,
@@ -36,6 +52,61 @@ export {
   NEURAL_BRAIN_VERSION,
 } from './NeuralBrain';
 
+// Multi-layer networks and brain (layer lists deeper than NeuralBrain)
+export {
+  MultiLayerNetwork,
+  multiLayerWeightCount,
+} from './MultiLayerNetwork';
+
+export type {
+  MultiLayerNetworkConfig,
+  MultiLayerNetworkState,
+  NeuralLayer,
+} from './MultiLayerNetwork';
+
+export {
+  MLPBrain,
+  MLP_BRAIN_TYPE,
+  MLP_BRAIN_VERSION,
+  DEFAULT_MLP_LAYERS,
+} from './MLPBrain';
+
+export type {
+  MLPBrainConfig,
+} from './MLPBrain';
+
+// Recurrent networks and brain (hidden state packed per agent slot)
+export {
+  RecurrentNetwork,
+  DEFAULT_RECURRENT_NETWORK_CONFIG,
+  recurrentWeightCount,
+} from './RecurrentNetwork';
+
+export type {
+  RecurrentCell,
+  RecurrentNetworkConfig,
+  RecurrentNetworkState,
+} from './RecurrentNetwork';
+
+export {
+  RecurrentStateBuffer,
+  DEFAULT_RECURRENT_STATE_BUFFER_CONFIG,
+} from './RecurrentStateBuffer';
+
+export type {
+  RecurrentStateBufferConfig,
+} from './RecurrentStateBuffer';
+
+export {
+  RecurrentBrain,
+  RECURRENT_BRAIN_TYPE,
+  RECURRENT_BRAIN_VERSION,
+} from './RecurrentBrain';
+
+export type {
+  RecurrentBrainConfig,
+} from './RecurrentBrain';
+
 // Rule Brain (simple rule-based)
 export {
   RuleBrain,
@@ -46,6 +117,42 @@ export type {
   RuleBrainConfig,
 } from './RuleBrain';
 
+export {
+  RuleTable,
+  DEFAULT_RULE_TABLE_OPTIONS,
+  evaluateRules,
+} from './RuleTable';
+
+export type {
+  RuleTableOptions,
+} from './RuleTable';
+
+// Distilled Brain (table/network replay of a slower brain)
+export {
+  DistilledBrain,
+  DISTILLED_BRAIN_TYPE,
+  DISTILLED_BRAIN_VERSION,
+  DEFAULT_DISTILLED_INPUTS,
+  actionBin,
+} from './DistilledBrain';
+
+export type {
+  DistilledBrainConfig,
+  DistilledInput,
+  DistillationFidelity,
+} from './DistilledBrain';
+
+export {
+  BrainDistiller,
+  DEFAULT_BRAIN_DISTILLER_CONFIG,
+  DEFAULT_NETWORK_FIT_OPTIONS,
+} from './BrainDistiller';
+
+export type {
+  BrainDistillerConfig,
+  NetworkFitOptions,
+} from './BrainDistiller';
+
 // LLM Brain (LLM-powered)
 export {
   LLMBrain,
@@ -71,10 +178,36 @@ export {
   MockLLMService,
 } from './llm/MockLLMService';
 
+export {
+  LLMDecisionBroker,
+  DEFAULT_LLM_DECISION_BROKER_CONFIG,
+} from './llm/LLMDecisionBroker';
+
+export type {
+  LLMDecisionBrokerConfig,
+  LLMDecisionBrokerStats,
+  DecisionKey,
+} from './llm/LLMDecisionBroker';
+
+export {
+  LLMDecisionCache,
+  DEFAULT_LLM_DECISION_CACHE_CONFIG,
+  packDecisionKey,
+  getSharedLLMDecisionCache,
+} from './llm/LLMDecisionCache';
+
+export type {
+  LLMDecisionCacheConfig,
+  LLMDecisionCacheStats,
+  QuantizationLevelStats,
+} from './llm/LLMDecisionCache';
+
 export {
   AGENT_REASONING_PROMPT,
   formatPrompt,
   parseAction,
+  formatBatchPrompt,
+  parseBatchActions,
 } from './llm/PromptTemplates';
 
 export type {
@@ -0,0 +1,106 @@
+/**
+ * LLMDecisionBroker.test.ts - Tests for the shared LLM decision broker
+ */
+
+import { describe, it, expect } from 'vitest';
+import { LLMDecisionBroker } from './LLMDecisionBroker';
+import { MockLLMService } from './MockLLMService';
+import { formatBatchPrompt, parseBatchActions, splitBatchPrompt } from './PromptTemplates';
+import { LLMBrain } from '../LLMBrain';
+
+const FOOD_AHEAD = 'Energy: 50%\nFood ahead: Yes';
+const FOOD_LEFT = 'Energy: 50%\nFood ahead: No\nFood to left: Yes';
+
+describe('batch prompts', () => {
+  it('round-trips through split and parse', () => {
+    const prompt = formatBatchPrompt([FOOD_AHEAD, FOOD_LEFT]);
+    expect(splitBatchPrompt(prompt)).toEqual([FOOD_AHEAD, FOOD_LEFT]);
+    expect(splitBatchPrompt(FOOD_AHEAD)).toBe(null);
+    expect(parseBatchActions('1: EAT\n2: turn_left', 3)).toEqual(['EAT', 'TURN_LEFT', null]);
+  });
+});
+
+describe('LLMDecisionBroker', () => {
+  it('coalesces identical keys into one call and fans out the result', async () => {
+    const llm = new MockLLMService({ delay: 5 });
+    const broker = new LLMDecisionBroker(llm);
+
+    const results = await Promise.all(
+      Array.from({ length: 50 }, () => broker.request('k', FOOD_AHEAD))
+    );
+
+    expect(results.every(action => action === 'EAT')).toBe(true);
+    expect(llm.getStats().calls).toBe(1);
+    expect(broker.getStats().coalesced).toBe(49);
+    expect(broker.has('k')).toBe(false);
+  });
+
+  it('packs distinct prompts into batches within the limits', async () => {
+    const llm = new MockLLMService({ delay: 1 });
+    const broker = new LLMDecisionBroker(llm, { maxConcurrent: 1, maxBatchSize: 4 });
+
+    const pending = [];
+    for (let i = 0; i < 10; i++) {
+      pending.push(broker.request(i, i % 2 === 0 ? FOOD_AHEAD : FOOD_LEFT));
+    }
+    const results = await Promise.all(pending);
+
+    for (let i = 0; i < 10; i++) {
+      expect(results[i]).toBe(i % 2 === 0 ? 'EAT' : 'TURN_LEFT');
+    }
+    expect(llm.getStats().calls).toBe(3);
+    expect(broker.getStats().batchedCalls).toBe(3);
+  });
+
+  it('respects the token budget', async () => {
+    const llm = new MockLLMService();
+    const tokens = Math.ceil(FOOD_AHEAD.length / 4);
+    const broker = new LLMDecisionBroker(llm, { maxConcurrent: 1, maxBatchTokens: tokens * 2 });
+
+    await Promise.all([0, 1, 2, 3, 4].map(i => broker.request(i, FOOD_AHEAD)));
+    expect(llm.getStats().calls).toBe(3);
+  });
+
+  it('bounds concurrency and serves higher priority first', async () => {
+    const llm = new MockLLMService({ delay: 5 });
+    const broker = new LLMDecisionBroker(llm, { maxConcurrent: 2, maxBatchSize: 1 });
+
+    const order: number[] = [];
+    const pending = [];
+    for (let i = 0; i < 8; i++) {
+      pending.push(broker.request(i, `${FOOD_AHEAD} #${i}`, i).then(() => order.push(i)));
+    }
+    await Promise.all(pending);
+
+    expect(llm.getStats().peakConcurrency).toBe(2);
+    expect(order[0]).toBe(7);
+    expect(order[1]).toBe(6);
+    expect(order[7]).toBeLessThan(2);
+  });
+
+  it('rejects every waiter when the call fails', async () => {
+    const llm = new MockLLMService({ available: false });
+    const broker = new LLMDecisionBroker(llm);
+
+    const a = broker.request('x', FOOD_AHEAD);
+    const b = broker.request('x', FOOD_AHEAD);
+    await expect(a).rejects.toThrow();
+    await expect(b).rejects.toThrow();
+    expect(broker.getStats().failed).toBe(1);
+  });
+
+  it('serves a population of LLM brains with few calls', async () => {
+    const llm = new MockLLMService({ delay: 2 });
+    const broker = new LLMDecisionBroker(llm);
+    const brains = Array.from({ length: 100 }, () => new LLMBrain(llm, { broker }));
+    const input = { front: 0.8, frontLeft: 0, frontRight: 0, left: 0, right: 0, energy: 0.5, bias: 1 };
+
+    for (const brain of brains) brain.think(input);
+    await new Promise(resolve => setTimeout(resolve, 20));
+
+    expect(llm.getStats().calls).toBe(1);
+    expect(broker.getStats().completed).toBe(1);
+    expect(brains[0].clone()).toBeInstanceOf(LLMBrain);
+    expect((brains[0].clone() as LLMBrain).getBroker()).toBe(broker);
+  });
+});
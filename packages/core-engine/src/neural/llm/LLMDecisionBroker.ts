@@ -0,0 +1,286 @@
+/**
+ * LLMDecisionBroker.ts - Shared request broker for LLM-driven brains
+ *
+ * One broker serves a whole population. Requests carrying the same
+ * (quantized) decision key share a single in-flight call; distinct prompts
+ * are packed into multi-creature batch prompts up to a token budget; at
+ * most `maxConcurrent` calls run at once and queued requests are served in
+ * priority order. Every waiting brain receives its action.
+ */
+
+import { LLMService, LLMOptions } from './LLMService';
+import { formatBatchPrompt, parseAction, parseBatchActions } from './PromptTemplates';
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+export interface LLMDecisionBrokerConfig {
+  maxConcurrent: number;     // LLM calls in flight at once
+  maxBatchSize: number;      // Prompts packed into one call
+  maxBatchTokens: number;    // Estimated prompt tokens per batched call
+  charsPerToken: number;     // Token estimate for budget packing
+  options?: LLMOptions;      // Passed to every complete() call
+}
+
+export const DEFAULT_LLM_DECISION_BROKER_CONFIG: LLMDecisionBrokerConfig = {
+  maxConcurrent: 4,
+  maxBatchSize: 16,
+  maxBatchTokens: 2048,
+  charsPerToken: 4,
+};
+
+export interface LLMDecisionBrokerStats {
+  requests: number;       // request() calls
+  coalesced: number;      // Requests that joined an existing entry
+  completed: number;      // Entries resolved with an action
+  failed: number;         // Entries rejected
+  calls: number;          // LLM calls issued
+  batchedCalls: number;   // Calls carrying more than one prompt
+  queued: number;         // Entries waiting for a slot
+  inFlight: number;       // Calls running now
+}
+
+export type DecisionKey = string | number;
+
+interface PendingDecision {
+  key: DecisionKey;
+  prompt: string;
+  tokens: number;
+  priority: number;
+  seq: number;
+  promise: Promise<string>;
+  resolve: (action: string) => void;
+  reject: (error: unknown) => void;
+  queued: boolean;
+}
+
+// ============================================================================
+// LLMDecisionBroker Class
+// ============================================================================
+
+export class LLMDecisionBroker {
+  private llmService: LLMService;
+  private config: LLMDecisionBrokerConfig;
+
+  private entries: Map<DecisionKey, PendingDecision> = new Map();
+  private heap: PendingDecision[] = [];   // Max-heap on priority, FIFO on ties
+  private seq: number = 0;
+  private inFlight: number = 0;
+  private drainScheduled: boolean = false;
+
+  private stats = {
+    requests: 0,
+    coalesced: 0,
+    completed: 0,
+    failed: 0,
+    calls: 0,
+    batchedCalls: 0,
+  };
+
+  constructor(llmService: LLMService, config?: Partial<LLMDecisionBrokerConfig>) {
+    this.llmService = llmService;
+    this.config = { ...DEFAULT_LLM_DECISION_BROKER_CONFIG, ...config };
+  }
+
+  /**
+   * Request a decision. Resolves with a parsed action name. Requests with a
+   * key that is already queued or in flight share its result; a queued
+   * entry takes the highest priority of its requesters.
+   */
+  request(key: DecisionKey, prompt: string, priority: number = 0): Promise<string> {
+    this.stats.requests++;
+
+    const existing = this.entries.get(key);
+    if (existing) {
+      this.stats.coalesced++;
+      if (existing.queued && priority > existing.priority) {
+        existing.priority = priority;
+        this.siftUp(this.heap.indexOf(existing));
+      }
+      return existing.promise;
+    }
+
+    let resolve!: (action: string) => void;
+    let reject!: (error: unknown) => void;
+    const promise = new Promise<string>((res, rej) => {
+      resolve = res;
+      reject = rej;
+    });
+    const entry: PendingDecision = {
+      key,
+      prompt,
+      tokens: Math.ceil(prompt.length / this.config.charsPerToken),
+      priority,
+      seq: this.seq++,
+      promise,
+      resolve,
+      reject,
+      queued: true,
+    };
+    this.entries.set(key, entry);
+    this.push(entry);
+
+    // Let requests issued in the same tick join the first batch
+    if (!this.drainScheduled) {
+      this.drainScheduled = true;
+      queueMicrotask(() => {
+        this.drainScheduled = false;
+        this.drain();
+      });
+    }
+    return promise;
+  }
+
+  /**
+   * Whether a decision for the key is queued or in flight
+   */
+  has(key: DecisionKey): boolean {
+    return this.entries.has(key);
+  }
+
+  getStats(): LLMDecisionBrokerStats {
+    return {
+      ...this.stats,
+      queued: this.heap.length,
+      inFlight: this.inFlight,
+    };
+  }
+
+  getConfig(): LLMDecisionBrokerConfig {
+    return { ...this.config };
+  }
+
+  /**
+   * Reject everything still queued (in-flight calls complete normally)
+   */
+  clear(): void {
+    for (const entry of this.heap) {
+      entry.queued = false;
+      this.entries.delete(entry.key);
+      this.stats.failed++;
+      entry.reject(new Error('LLM decision request cancelled'));
+    }
+    this.heap = [];
+  }
+
+  // --------------------------------------------------------------------------
+  // Dispatch
+  // --------------------------------------------------------------------------
+
+  private drain(): void {
+    while (this.inFlight < this.config.maxConcurrent && this.heap.length > 0) {
+      const batch = this.takeBatch();
+      this.inFlight++;
+      this.dispatch(batch).finally(() => {
+        this.inFlight--;
+        this.drain();
+      });
+    }
+  }
+
+  /**
+   * Pop the highest-priority entries that fit the batch limits. The first
+   * entry is always taken, even if it alone exceeds the token budget.
+   */
+  private takeBatch(): PendingDecision[] {
+    const batch: PendingDecision[] = [this.pop()!];
+    let tokens = batch[0].tokens;
+    while (
+      this.heap.length > 0 &&
+      batch.length < this.config.maxBatchSize &&
+      tokens + this.heap[0].tokens <= this.config.maxBatchTokens
+    ) {
+      const next = this.pop()!;
+      tokens += next.tokens;
+      batch.push(next);
+    }
+    return batch;
+  }
+
+  private async dispatch(batch: PendingDecision[]): Promise<void> {
+    this.stats.calls++;
+    if (batch.length > 1) this.stats.batchedCalls++;
+
+    let actions: Array<string | null>;
+    try {
+      if (batch.length === 1) {
+        actions = [parseAction(await this.llmService.complete(batch[0].prompt, this.config.options))];
+      } else {
+        const prompt = formatBatchPrompt(batch.map(entry => entry.prompt));
+        const response = await this.llmService.complete(prompt, this.config.options);
+        actions = parseBatchActions(response, batch.length);
+      }
+    } catch (error) {
+      for (const entry of batch) this.settle(entry, null, error);
+      return;
+    }
+
+    for (let i = 0; i < batch.length; i++) {
+      this.settle(batch[i], actions[i], new Error('No action for creature in batch response'));
+    }
+  }
+
+  private settle(entry: PendingDecision, action: string | null, error: unknown): void {
+    this.entries.delete(entry.key);
+    if (action !== null) {
+      this.stats.completed++;
+      entry.resolve(action);
+    } else {
+      this.stats.failed++;
+      entry.reject(error);
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // Priority queue
+  // --------------------------------------------------------------------------
+
+  private before(a: PendingDecision, b: PendingDecision): boolean {
+    return a.priority > b.priority || (a.priority === b.priority && a.seq < b.seq);
+  }
+
+  private push(entry: PendingDecision): void {
+    this.heap.push(entry);
+    this.siftUp(this.heap.length - 1);
+  }
+
+  private pop(): PendingDecision | undefined {
+    const heap = this.heap;
+    if (heap.length === 0) return undefined;
+    const top = heap[0];
+    const last = heap.pop()!;
+    if (heap.length > 0) {
+      heap[0] = last;
+      this.siftDown(0);
+    }
+    top.queued = false;
+    return top;
+  }
+
+  private siftUp(i: number): void {
+    const heap = this.heap;
+    while (i > 0) {
+      const parent = (i - 1) >> 1;
+      if (!this.before(heap[i], heap[parent])) break;
+      [heap[i], heap[parent]] = [heap[parent], heap[i]];
+      i = parent;
+    }
+  }
+
+  private siftDown(i: number): void {
+    const heap = this.heap;
+    for (;;) {
+      const left = 2 * i + 1;
+      const right = left + 1;
+      let best = i;
+      if (left < heap.length && this.before(heap[left], heap[best])) best = left;
+      if (right < heap.length && this.before(heap[right], heap[best])) best = right;
+      if (best === i) break;
+      [heap[i], heap[best]] = [heap[best], heap[i]];
+      i = best;
+    }
+  }
+}
+
+export default LLMDecisionBroker;
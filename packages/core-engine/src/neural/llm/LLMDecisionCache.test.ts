@@ -0,0 +1,146 @@
+/**
+ * LLMDecisionCache.test.ts - Tests for the shared numeric decision cache
+ */
+
+import { describe, it, expect } from 'vitest';
+import { LLMDecisionCache, packDecisionKey } from './LLMDecisionCache';
+import { MockLLMService } from './MockLLMService';
+import { LLMBrain } from '../LLMBrain';
+import { SimulationEngine } from '../../simulation/SimulationEngine';
+
+const out = (moveForward: number) => ({ moveForward, rotate: 0, action: 0 });
+
+describe('packDecisionKey', () => {
+  it('packs quantized inputs with the first input lowest', () => {
+    expect(packDecisionKey([0, 0, 0, 0], 4)).toBe(0);
+    expect(packDecisionKey([1, 0, 0, 0], 4)).toBe(0xf);
+    expect(packDecisionKey([0, 0, 0, 1], 4)).toBe(0xf000);
+    expect(packDecisionKey([1, 1, 1, 1], 8)).toBe(0xffffffff);
+    expect(packDecisionKey([0.51, -3, 7, 0.49], 1)).toBe(0b0101);
+  });
+
+  it('maps nearby inputs to the same key', () => {
+    expect(packDecisionKey([0.5, 0.2, 0.3, 0.8], 4)).toBe(packDecisionKey([0.51, 0.21, 0.31, 0.79], 4));
+  });
+
+  it('rejects keys wider than 32 bits', () => {
+    expect(() => packDecisionKey([0, 0, 0, 0, 0], 8)).toThrow();
+  });
+});
+
+describe('LLMDecisionCache', () => {
+  it('stores per key and quantization level', () => {
+    const cache = new LLMDecisionCache();
+    cache.set(5, 4, out(1));
+    cache.set(5, 2, out(2));
+
+    expect(cache.get(5, 4)!.moveForward).toBe(1);
+    expect(cache.get(5, 2)!.moveForward).toBe(2);
+    expect(cache.get(6, 4)).toBe(undefined);
+
+    const stats = cache.getStats();
+    expect(stats.size).toBe(2);
+    expect(stats.levels.length).toBe(2);
+    const four = stats.levels.find(level => level.bits === 4)!;
+    expect(four.hits).toBe(1);
+    expect(four.misses).toBe(1);
+    expect(four.hitRate).toBe(0.5);
+  });
+
+  it('expires entries after ttl ticks', () => {
+    const cache = new LLMDecisionCache({ ttl: 10 });
+    cache.setTick(100);
+    cache.set(1, 4, out(1));
+
+    cache.setTick(109);
+    expect(cache.get(1, 4)).toBeDefined();
+    cache.setTick(110);
+    expect(cache.get(1, 4)).toBe(undefined);
+    expect(cache.getStats().expirations).toBe(1);
+    expect(cache.getStats().size).toBe(0);
+  });
+
+  it('expires entries on the simulation clock', () => {
+    const engine = new SimulationEngine({
+      engine: { seed: 1, world: { dimensions: { width: 100, height: 100 } } },
+      agents: { initialPopulation: 0, autoRespawn: false },
+    });
+    const cache = new LLMDecisionCache({ ttl: 5 });
+    engine.setDecisionCache(cache);
+    engine.initialize();
+    cache.set(1, 4, out(1));
+
+    engine.step(5);
+    expect(cache.getTick()).toBe(4);
+    expect(cache.get(1, 4)).toBeDefined();
+    engine.step(1);
+    expect(cache.get(1, 4)).toBe(undefined);
+    expect(cache.getStats().expirations).toBe(1);
+  });
+
+  it('drops entries when the clock moves backwards', () => {
+    const cache = new LLMDecisionCache({ ttl: 10 });
+    cache.setTick(100);
+    cache.set(1, 4, out(1));
+
+    cache.setTick(0);
+    expect(cache.getStats().size).toBe(0);
+  });
+
+  it('rejects a cache without room for an entry', () => {
+    expect(() => new LLMDecisionCache({ maxEntries: 0 })).toThrow(/maxEntries/);
+  });
+
+  it('evicts unreferenced entries first when full', () => {
+    const cache = new LLMDecisionCache({ maxEntries: 4 });
+    for (let key = 0; key < 4; key++) cache.set(key, 4, out(key));
+
+    // One CLOCK sweep clears every reference bit; touch key 1 afterwards
+    cache.set(10, 4, out(10));
+    cache.get(1, 4);
+    cache.set(11, 4, out(11));
+
+    const stats = cache.getStats();
+    expect(stats.size).toBe(4);
+    expect(stats.evictions).toBe(2);
+    expect(cache.has(1, 4)).toBe(true);
+    expect(cache.has(10, 4)).toBe(true);
+    expect(cache.has(11, 4)).toBe(true);
+  });
+
+  it('keeps probe chains intact under churn', () => {
+    const cache = new LLMDecisionCache({ maxEntries: 64 });
+    const live = new Map<number, number>();
+    for (let i = 0; i < 2000; i++) {
+      const key = (i * 2654435761) >>> 0;
+      cache.set(key, 4, out(i));
+      live.set(key, i);
+    }
+    let found = 0;
+    for (const [key, i] of live) {
+      const hit = cache.get(key, 4);
+      if (hit) {
+        expect(hit.moveForward).toBe(i);
+        found++;
+      }
+    }
+    expect(found).toBe(64);
+  });
+
+  it('lets brains reuse each other\'s decisions', async () => {
+    const llm = new MockLLMService();
+    const cache = new LLMDecisionCache();
+    const a = new LLMBrain(llm, { sharedCache: cache });
+    const b = new LLMBrain(llm, { sharedCache: cache });
+    const input = { front: 0.8, frontLeft: 0, frontRight: 0, left: 0, right: 0, energy: 0.5, bias: 1 };
+
+    a.think(input);
+    await new Promise(resolve => setTimeout(resolve, 0));
+
+    const decision = b.think({ ...input, front: 0.81 });
+    expect(decision.action).toBe(1);
+    expect(b.getStats().cacheHits).toBe(1);
+    expect(llm.getStats().calls).toBe(1);
+    expect((b.clone() as LLMBrain).getSharedCache()).toBe(cache);
+  });
+});
@@ -0,0 +1,277 @@
+/**
+ * LLMDecisionCache.ts - Population-wide cache of LLM decisions
+ *
+ * Decisions are keyed by a packed integer of quantized sensory inputs
+ * (`bits` per input, at most 32 bits in total), so every agent benefits
+ * from every other agent's LLM calls and a lookup hashes a single integer.
+ *
+ * Storage is an open-addressing table with linear probing and backward-
+ * shift deletion. When full, a CLOCK hand evicts the first entry not used
+ * since it last passed. Entries expire after `ttl` simulation ticks; the
+ * owner advances the clock with setTick(), or hands the cache to
+ * SimulationEngine.setDecisionCache() to have it follow the simulation.
+ */
+
+import type { BrainOutput } from '../Brain';
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+export interface LLMDecisionCacheConfig {
+  maxEntries: number;  // At least 1
+  ttl: number;         // Lifetime in ticks
+}
+
+export const DEFAULT_LLM_DECISION_CACHE_CONFIG: LLMDecisionCacheConfig = {
+  maxEntries: 4096,
+  ttl: 50,
+};
+
+export const MAX_QUANTIZATION_BITS = 8;
+
+export interface QuantizationLevelStats {
+  bits: number;
+  hits: number;
+  misses: number;
+  hitRate: number;
+}
+
+export interface LLMDecisionCacheStats {
+  size: number;
+  capacity: number;
+  evictions: number;
+  expirations: number;
+  levels: QuantizationLevelStats[];   // Levels that have seen lookups
+}
+
+/**
+ * Quantize inputs in [0, 1] to `bits` each and pack them into one unsigned
+ * integer, first input in the lowest bits
+ */
+export function packDecisionKey(inputs: ArrayLike<number>, bits: number): number {
+  if (bits < 1 || bits > MAX_QUANTIZATION_BITS || inputs.length * bits > 32) {
+    throw new Error(`Cannot pack ${inputs.length} inputs at ${bits} bits into 32 bits`);
+  }
+  const levels = (1 << bits) - 1;
+  let key = 0;
+  for (let i = inputs.length - 1; i >= 0; i--) {
+    const v = inputs[i];
+    const q = v > 0 ? (v < 1 ? Math.round(v * levels) : levels) : 0;
+    key = ((key << bits) | q) >>> 0;
+  }
+  return key;
+}
+
+// ============================================================================
+// LLMDecisionCache Class
+// ============================================================================
+
+export class LLMDecisionCache {
+  private config: LLMDecisionCacheConfig;
+  private capacity: number;
+  private mask: number;
+
+  private keys: Uint32Array;
+  private levels: Uint8Array;          // Quantization bits; 0 marks an empty slot
+  private expires: Float64Array;
+  private referenced: Uint8Array;
+  private values: Array<BrainOutput | undefined>;
+  private size: number = 0;
+  private hand: number = 0;
+  private tick: number = 0;
+
+  private hits: Float64Array = new Float64Array(MAX_QUANTIZATION_BITS + 1);
+  private misses: Float64Array = new Float64Array(MAX_QUANTIZATION_BITS + 1);
+  private evictions: number = 0;
+  private expirations: number = 0;
+
+  constructor(config?: Partial<LLMDecisionCacheConfig>) {
+    this.config = { ...DEFAULT_LLM_DECISION_CACHE_CONFIG, ...config };
+    if (!(this.config.maxEntries >= 1)) {
+      throw new Error(`LLMDecisionCache needs maxEntries >= 1, got ${this.config.maxEntries}`);
+    }
+    // Keep the load factor at or below one half
+    let capacity = 8;
+    while (capacity < this.config.maxEntries * 2) capacity *= 2;
+    this.capacity = capacity;
+    this.mask = capacity - 1;
+
+    this.keys = new Uint32Array(capacity);
+    this.levels = new Uint8Array(capacity);
+    this.expires = new Float64Array(capacity);
+    this.referenced = new Uint8Array(capacity);
+    this.values = new Array(capacity);
+  }
+
+  /**
+   * Advance the clock used for TTL expiry. A clock that moves backwards
+   * (simulation reset or load) drops every entry, since their expiry ticks
+   * belong to the old timeline.
+   */
+  setTick(tick: number): void {
+    if (tick < this.tick) this.clear();
+    this.tick = tick;
+  }
+
+  getTick(): number {
+    return this.tick;
+  }
+
+  /**
+   * Look up a decision. Expired entries count as misses and are dropped.
+   */
+  get(key: number, bits: number): BrainOutput | undefined {
+    const slot = this.find(key, bits);
+    if (slot >= 0) {
+      if (this.expires[slot] > this.tick) {
+        this.referenced[slot] = 1;
+        this.hits[bits]++;
+        return this.values[slot];
+      }
+      this.remove(slot);
+      this.expirations++;
+    }
+    this.misses[bits]++;
+    return undefined;
+  }
+
+  set(key: number, bits: number, output: BrainOutput): void {
+    let slot = this.find(key, bits);
+    if (slot < 0) {
+      if (this.size >= this.config.maxEntries) this.evict();
+      slot = this.home(key, bits);
+      while (this.levels[slot] !== 0) slot = (slot + 1) & this.mask;
+      this.keys[slot] = key;
+      this.levels[slot] = bits;
+      this.size++;
+    }
+    this.values[slot] = output;
+    this.expires[slot] = this.tick + this.config.ttl;
+    this.referenced[slot] = 1;
+  }
+
+  has(key: number, bits: number): boolean {
+    const slot = this.find(key, bits);
+    return slot >= 0 && this.expires[slot] > this.tick;
+  }
+
+  clear(): void {
+    this.levels.fill(0);
+    this.values.fill(undefined);
+    this.size = 0;
+    this.hand = 0;
+  }
+
+  resetStats(): void {
+    this.hits.fill(0);
+    this.misses.fill(0);
+    this.evictions = 0;
+    this.expirations = 0;
+  }
+
+  getStats(): LLMDecisionCacheStats {
+    const levels: QuantizationLevelStats[] = [];
+    for (let bits = 1; bits <= MAX_QUANTIZATION_BITS; bits++) {
+      const hits = this.hits[bits];
+      const misses = this.misses[bits];
+      if (hits + misses === 0) continue;
+      levels.push({ bits, hits, misses, hitRate: hits / (hits + misses) });
+    }
+    return {
+      size: this.size,
+      capacity: this.capacity,
+      evictions: this.evictions,
+      expirations: this.expirations,
+      levels,
+    };
+  }
+
+  getConfig(): LLMDecisionCacheConfig {
+    return { ...this.config };
+  }
+
+  // --------------------------------------------------------------------------
+  // Table internals
+  // --------------------------------------------------------------------------
+
+  private home(key: number, bits: number): number {
+    return (Math.imul(key ^ Math.imul(bits, 0x27d4eb2d), 0x9e3779b1) >>> 0) & this.mask;
+  }
+
+  private find(key: number, bits: number): number {
+    let slot = this.home(key, bits);
+    while (this.levels[slot] !== 0) {
+      if (this.keys[slot] === key && this.levels[slot] === bits) return slot;
+      slot = (slot + 1) & this.mask;
+    }
+    return -1;
+  }
+
+  /**
+   * CLOCK sweep: expired entries go first, then the first entry whose
+   * reference bit is already clear
+   */
+  private evict(): void {
+    for (;;) {
+      const slot = this.hand;
+      this.hand = (this.hand + 1) & this.mask;
+      if (this.levels[slot] === 0) continue;
+      if (this.expires[slot] <= this.tick) {
+        this.remove(slot);
+        this.expirations++;
+        return;
+      }
+      if (this.referenced[slot]) {
+        this.referenced[slot] = 0;
+        continue;
+      }
+      this.remove(slot);
+      this.evictions++;
+      return;
+    }
+  }
+
+  /**
+   * Backward-shift deletion keeps probe chains intact without tombstones
+   */
+  private remove(slot: number): void {
+    let hole = slot;
+    let next = (slot + 1) & this.mask;
+    while (this.levels[next] !== 0) {
+      const home = this.home(this.keys[next], this.levels[next]);
+      // Move next into the hole unless its home lies cyclically in (hole, next]
+      const inRange = hole <= next ? home > hole && home <= next : home > hole || home <= next;
+      if (!inRange) {
+        this.keys[hole] = this.keys[next];
+        this.levels[hole] = this.levels[next];
+        this.expires[hole] = this.expires[next];
+        this.referenced[hole] = this.referenced[next];
+        this.values[hole] = this.values[next];
+        hole = next;
+      }
+      next = (next + 1) & this.mask;
+    }
+    this.levels[hole] = 0;
+    this.values[hole] = undefined;
+    this.size--;
+  }
+}
+
+// ============================================================================
+// Process-wide instance
+// ============================================================================
+
+let sharedCache: LLMDecisionCache | null = null;
+
+/**
+ * The process-wide decision cache, created on first use
+ */
+export function getSharedLLMDecisionCache(): LLMDecisionCache {
+  if (!sharedCache) {
+    sharedCache = new LLMDecisionCache();
+  }
+  return sharedCache;
+}
+
+export default LLMDecisionCache;
@@ -3,11 +3,16 @@
  */
 
 import { LLMService, LLMOptions } from './LLMService';
+import { splitBatchPrompt } from './PromptTemplates';
 
 export class MockLLMService implements LLMService {
   private available: boolean = true;
   private responseDelay: number = 0;
   private customResponses: Map<string, string> = new Map();
+  private calls: number = 0;
+  private active: number = 0;
+  private peakActive: number = 0;
+  private prompts: string[] = [];
 
   constructor(options?: { delay?: number; available?: boolean }) {
     this.responseDelay = options?.delay ?? 0;
@@ -19,10 +24,44 @@ export class MockLLMService implements LLMService {
       throw new Error('MockLLMService is not available');
     }
 
-    if (this.responseDelay > 0) {
-      await new Promise((resolve) => setTimeout(resolve, this.responseDelay));
+    this.calls++;
+    this.prompts.push(prompt);
+    this.active++;
+    this.peakActive = Math.max(this.peakActive, this.active);
+    try {
+      if (this.responseDelay > 0) {
+        await new Promise((resolve) => setTimeout(resolve, this.responseDelay));
+      }
+
+      // Batched prompts get one numbered answer per creature
+      const batch = splitBatchPrompt(prompt);
+      if (batch) {
+        return batch.map((part, i) => `${i + 1}: ${this.respond(part)}`).join('\n');
+      }
+      return this.respond(prompt);
+    } finally {
+      this.active--;
     }
+  }
+
+  /**
+   * Call counts and peak concurrency since construction or resetStats()
+   */
+  getStats(): { calls: number; peakConcurrency: number; prompts: string[] } {
+    return { calls: this.calls, peakConcurrency: this.peakActive, prompts: [...this.prompts] };
+  }
+
+  resetStats(): void {
+    this.calls = 0;
+    this.peakActive = this.active;
+    this.prompts = [];
+  }
+
+  setDelay(delay: number): void {
+    this.responseDelay = delay;
+  }
 
+  private respond(prompt: string): string {
     for (const [pattern, response] of this.customResponses) {
       if (prompt.includes(pattern)) {
         return response;
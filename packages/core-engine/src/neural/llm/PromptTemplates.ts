@@ -82,3 +82,48 @@ export function parseAction(response: string): string {
 
   return 'IDLE';
 }
+
+// Multi-agent batch prompts. Each creature's prompt is wrapped in a
+// numbered section and the model answers one "<n>: ACTION" line each.
+
+export const BATCH_PROMPT_HEADER = `
+You are deciding for several creatures in an ecosystem simulation at once.
+Each creature's situation follows under its own "### Creature <n>" heading.
+Respond with one line per creature in the form "<n>: ACTION", nothing else.
+`;
+
+const BATCH_SECTION = /^### Creature (\d+)$/m;
+
+export function formatBatchPrompt(prompts: string[]): string {
+  const sections = prompts.map((prompt, i) => `### Creature ${i + 1}\n${prompt.trim()}`);
+  return `${BATCH_PROMPT_HEADER}\n${sections.join('\n\n')}\n`;
+}
+
+/**
+ * Split a batch prompt back into its per-creature prompts, or null if the
+ * prompt is not a batch
+ */
+export function splitBatchPrompt(prompt: string): string[] | null {
+  if (!prompt.startsWith(BATCH_PROMPT_HEADER) || !BATCH_SECTION.test(prompt)) {
+    return null;
+  }
+  const parts = prompt.slice(BATCH_PROMPT_HEADER.length).split(/^### Creature \d+$/m);
+  return parts.slice(1).map(part => part.trim());
+}
+
+/**
+ * Parse a batch response into one action per creature; null where the
+ * response has no line for that creature
+ */
+export function parseBatchActions(response: string, count: number): Array<string | null> {
+  const actions: Array<string | null> = new Array(count).fill(null);
+  for (const line of response.split('\n')) {
+    const match = line.match(/^\s*(\d+)\s*[:.)-]\s*(.+)$/);
+    if (!match) continue;
+    const index = parseInt(match[1], 10) - 1;
+    if (index >= 0 && index < count && actions[index] === null) {
+      actions[index] = parseAction(match[2]);
+    }
+  }
+  return actions;
+}
@@ -8,10 +8,28 @@ export type { LLMService, LLMOptions } from './LLMService';
 
 export { MockLLMService } from './MockLLMService';
 
+export { LLMDecisionBroker, DEFAULT_LLM_DECISION_BROKER_CONFIG } from './LLMDecisionBroker';
+
+export type { LLMDecisionBrokerConfig, LLMDecisionBrokerStats, DecisionKey } from './LLMDecisionBroker';
+
+export {
+  LLMDecisionCache,
+  DEFAULT_LLM_DECISION_CACHE_CONFIG,
+  MAX_QUANTIZATION_BITS,
+  packDecisionKey,
+  getSharedLLMDecisionCache,
+} from './LLMDecisionCache';
+
+export type { LLMDecisionCacheConfig, LLMDecisionCacheStats, QuantizationLevelStats } from './LLMDecisionCache';
+
 export {
   AGENT_REASONING_PROMPT,
   formatPrompt,
   parseAction,
+  BATCH_PROMPT_HEADER,
+  formatBatchPrompt,
+  splitBatchPrompt,
+  parseBatchActions,
 } from './PromptTemplates';
 
 export type { SensoryInputForPrompt } from './PromptTemplates';
@@ -0,0 +1,264 @@
+/**
+ * FrameDelta.ts - Changes between observer frame ids
+ *
+ * The Observer folds the managers' ChangeSets into a DeltaLog at every
+ * frame id it hands out. The log stamps each slot with the last frame id
+ * at which its position, energy or alive status changed, and keeps recent
+ * births and deaths in a ring, so a caller holding any earlier frame id can
+ * ask what changed since then (Observer.getDelta).
+ *
+ * The slots stamped at recent frames are also journaled, so a delta from a
+ * recent frame id walks only the slots changed after it. Older bases fall
+ * back to scanning every stamped slot.
+ *
+ * A delta is incomplete when the caller's frame id predates what the log
+ * still knows: before tracking started, before a reset (initialize, clear,
+ * load), or older than the oldest birth/death still retained. The caller
+ * should then resync from a full frame.
+ */
+
+import { RingBuffer } from '../utils/RingBuffer';
+import {
+  ChangeTracker,
+  ChangeSet,
+  CHANGE_POSITION,
+  CHANGE_ENERGY,
+  CHANGE_ALIVE,
+} from '../simulation/ChangeTracker';
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * Changes to one kind of entity. Slots are agent slots (Agent.slot) or
+ * food store rows (Food.row); arrays are parallel.
+ */
+export interface EntityDelta {
+  readonly slots: ReadonlyArray<number>;
+  readonly changes: ReadonlyArray<number>;     // CHANGE_* bits since fromFrame
+  readonly ids: ReadonlyArray<string>;         // Current occupant, '' when vacated
+  readonly births: ReadonlyArray<string>;
+  readonly birthSlots: ReadonlyArray<number>;
+  readonly deaths: ReadonlyArray<string>;
+  readonly deathSlots: ReadonlyArray<number>;
+}
+
+export interface ObserverDelta {
+  readonly fromFrame: number;
+  readonly toFrame: number;     // Pass to the next getDelta()
+  readonly tick: number;
+  readonly complete: boolean;   // False: resync from captureFrame()
+  readonly agents: EntityDelta;
+  readonly food: EntityDelta;
+}
+
+/**
+ * True when a delta carries no changes
+ */
+export function isDeltaEmpty(delta: ObserverDelta): boolean {
+  return (
+    delta.complete &&
+    delta.agents.slots.length === 0 &&
+    delta.agents.births.length === 0 &&
+    delta.agents.deaths.length === 0 &&
+    delta.food.slots.length === 0 &&
+    delta.food.births.length === 0 &&
+    delta.food.deaths.length === 0
+  );
+}
+
+// ============================================================================
+// DeltaLog Class
+// ============================================================================
+
+interface LifeEvent {
+  frame: number;
+  id: string;
+  slot: number;
+  birth: boolean;
+}
+
+interface StampedSlots {
+  frame: number;
+  slots: Int32Array;
+}
+
+// Journal bounds: recorded frames, and slots across them (at least)
+const JOURNAL_FRAMES = 64;
+const JOURNAL_MIN_SLOTS = 4096;
+
+export class DeltaLog {
+  private tracker: ChangeTracker;       // Source of slot ids
+  private capacity: number = 0;
+  private size: number = 0;             // Highest stamped slot + 1
+  private positionAt: Uint32Array = new Uint32Array(0);
+  private energyAt: Uint32Array = new Uint32Array(0);
+  private aliveAt: Uint32Array = new Uint32Array(0);
+  private events: RingBuffer<LifeEvent>;
+  private floor: number;                // Deltas from before this frame are incomplete
+
+  // Slots stamped per recent frame; deltas from before journalFloor scan
+  private journal: RingBuffer<StampedSlots> = new RingBuffer<StampedSlots>(JOURNAL_FRAMES);
+  private journalSlots: number = 0;
+  private journalFloor: number;
+  private seen: Uint8Array = new Uint8Array(0);
+
+  constructor(tracker: ChangeTracker, startFrame: number, historySize: number = 4096) {
+    this.tracker = tracker;
+    this.events = new RingBuffer<LifeEvent>(historySize);
+    this.floor = startFrame;
+    this.journalFloor = startFrame;
+    this.grow(256);
+  }
+
+  /**
+   * Stamp a ChangeSet taken at `frame`
+   */
+  record(frame: number, changes: ChangeSet): void {
+    if (changes.reset) {
+      this.floor = frame;
+      this.events.clear();
+      this.positionAt.fill(0);
+      this.energyAt.fill(0);
+      this.aliveAt.fill(0);
+      this.size = 0;
+      this.journal.clear();
+      this.journalSlots = 0;
+      this.journalFloor = frame;
+    }
+
+    const { slots, bits } = changes;
+    for (let i = 0; i < slots.length; i++) {
+      const slot = slots[i];
+      if (slot >= this.capacity) this.grow(slot + 1);
+      if (slot >= this.size) this.size = slot + 1;
+      const b = bits[i];
+      if (b & CHANGE_POSITION) this.positionAt[slot] = frame;
+      if (b & CHANGE_ENERGY) this.energyAt[slot] = frame;
+      if (b & CHANGE_ALIVE) this.aliveAt[slot] = frame;
+    }
+    if (slots.length > 0) this.journalFrame(frame, slots);
+
+    // Births and deaths in one take are ordered births first; an entity
+    // that was born and died within it keeps both
+    for (let i = 0; i < changes.spawnIds.length; i++) {
+      this.push({ frame, id: changes.spawnIds[i], slot: changes.spawnSlots[i], birth: true });
+    }
+    for (let i = 0; i < changes.deathIds.length; i++) {
+      this.push({ frame, id: changes.deathIds[i], slot: changes.deathSlots[i], birth: false });
+    }
+  }
+
+  /**
+   * Whether a delta since `frame` can be built
+   */
+  covers(frame: number): boolean {
+    return frame >= this.floor;
+  }
+
+  /**
+   * Changes after `since`
+   */
+  delta(since: number): EntityDelta {
+    const slots: number[] = [];
+    const changes: number[] = [];
+    const ids: string[] = [];
+    if (since >= this.journalFloor) {
+      // Every frame after `since` is journaled: collect just those slots
+      const seen = this.seen;
+      for (let i = this.journal.length - 1; i >= 0; i--) {
+        const stamped = this.journal.get(i)!;
+        if (stamped.frame <= since) break;
+        for (let j = 0; j < stamped.slots.length; j++) {
+          const slot = stamped.slots[j];
+          if (seen[slot]) continue;
+          seen[slot] = 1;
+          slots.push(slot);
+        }
+      }
+      slots.sort((a, b) => a - b);
+      for (const slot of slots) {
+        seen[slot] = 0;
+        changes.push(this.changesSince(slot, since));
+        ids.push(this.tracker.idAt(slot));
+      }
+    } else {
+      for (let slot = 0; slot < this.size; slot++) {
+        const b = this.changesSince(slot, since);
+        if (b === 0) continue;
+        slots.push(slot);
+        changes.push(b);
+        ids.push(this.tracker.idAt(slot));
+      }
+    }
+
+    const births: string[] = [];
+    const birthSlots: number[] = [];
+    const deaths: string[] = [];
+    const deathSlots: number[] = [];
+    // Events are in frame order, so scan back from the newest
+    let first = this.events.length;
+    while (first > 0 && this.events.get(first - 1)!.frame > since) first--;
+    for (let i = first; i < this.events.length; i++) {
+      const event = this.events.get(i)!;
+      if (event.birth) {
+        births.push(event.id);
+        birthSlots.push(event.slot);
+      } else {
+        deaths.push(event.id);
+        deathSlots.push(event.slot);
+      }
+    }
+
+    return Object.freeze({ slots, changes, ids, births, birthSlots, deaths, deathSlots });
+  }
+
+  memoryUsage(): number {
+    return this.capacity * (4 * 3 + 1) + this.journalSlots * 4;
+  }
+
+  private changesSince(slot: number, since: number): number {
+    let b = 0;
+    if (this.positionAt[slot] > since) b |= CHANGE_POSITION;
+    if (this.energyAt[slot] > since) b |= CHANGE_ENERGY;
+    if (this.aliveAt[slot] > since) b |= CHANGE_ALIVE;
+    return b;
+  }
+
+  private journalFrame(frame: number, slots: number[]): void {
+    const dropped = this.journal.push({ frame, slots: Int32Array.from(slots) });
+    this.journalSlots += slots.length;
+    if (dropped) this.dropJournaled(dropped);
+
+    const limit = Math.max(JOURNAL_MIN_SLOTS, this.size * 2);
+    while (this.journalSlots > limit && this.journal.length > 1) {
+      this.dropJournaled(this.journal.shift()!);
+    }
+  }
+
+  private dropJournaled(stamped: StampedSlots): void {
+    this.journalSlots -= stamped.slots.length;
+    if (stamped.frame > this.journalFloor) this.journalFloor = stamped.frame;
+  }
+
+  private push(event: LifeEvent): void {
+    const evicted = this.events.push(event);
+    if (evicted && evicted.frame > this.floor) this.floor = evicted.frame;
+  }
+
+  private grow(minCapacity: number): void {
+    let capacity = Math.max(1, this.capacity);
+    while (capacity < minCapacity) capacity *= 2;
+    const growU32 = (src: Uint32Array) => {
+      const dst = new Uint32Array(capacity);
+      dst.set(src);
+      return dst;
+    };
+    this.positionAt = growU32(this.positionAt);
+    this.energyAt = growU32(this.energyAt);
+    this.aliveAt = growU32(this.aliveAt);
+    this.seen = new Uint8Array(capacity);
+    this.capacity = capacity;
+  }
+}
@@ -0,0 +1,251 @@
+/**
+ * Observer.test.ts - Tests for render frames, deltas and the object view layer
+ */
+
+import { describe, it, expect } from 'vitest';
+import { Observer } from './Observer';
+import {
+  AGENT_FLAG_ALIVE,
+  FOOD_FLAG_CONSUMED,
+  frameFromMessage,
+  frameToMessage,
+  renderFrameByteLength,
+} from './RenderFrame';
+import { isDeltaEmpty } from './FrameDelta';
+import { CHANGE_POSITION, CHANGE_ENERGY, CHANGE_ALIVE } from '../simulation/ChangeTracker';
+import { SimulationEngine } from '../simulation/SimulationEngine';
+
+function setup(agents: number = 12, food: number = 20) {
+  const engine = new SimulationEngine({
+    engine: { seed: 3, world: { dimensions: { width: 200, height: 200 } } },
+    agents: { initialPopulation: agents, maxPopulation: Math.max(200, agents) },
+    food: { initialCount: food },
+  });
+  engine.initialize();
+  engine.step(3);
+  return { engine, observer: new Observer(engine) };
+}
+
+describe('Observer render frames', () => {
+  it('fills agent and food columns from the simulation', () => {
+    const { engine, observer } = setup();
+    const frame = observer.captureFrame();
+    const agents = engine.getAgentManager().getAllAgents();
+    const food = engine.getFoodManager().getAllFood();
+
+    expect(frame.tick).toBe(engine.getCurrentTick());
+    expect(frame.agentCount).toBe(agents.length);
+    expect(frame.foodCount).toBe(food.length);
+
+    agents.forEach((agent, i) => {
+      expect(frame.agentIds[i]).toBe(agent.id);
+      expect(frame.agents.x[i]).toBe(Math.fround(agent.position.x));
+      expect(frame.agents.energy[i]).toBe(Math.fround(agent.energy));
+      expect(frame.agents.slot[i]).toBe(agent.slot);
+      expect(frame.speciesIds[frame.agents.species[i]]).toBe(agent.speciesId);
+      expect((frame.agents.flags[i] & AGENT_FLAG_ALIVE) !== 0).toBe(agent.alive());
+    });
+    food.forEach((item, i) => {
+      expect(frame.foodIds[i]).toBe(item.id);
+      expect(frame.food.y[i]).toBe(Math.fround(item.y));
+      expect((frame.food.flags[i] & FOOD_FLAG_CONSUMED) !== 0).toBe(item.isConsumed);
+    });
+  });
+
+  it('double-buffers frames over one buffer each', () => {
+    const { engine, observer } = setup();
+    const first = observer.captureFrame();
+    engine.step(1);
+    const second = observer.captureFrame();
+    const third = observer.captureFrame();
+
+    expect(second.frameId).toBe(first.frameId + 1);
+    expect(second.buffer).not.toBe(first.buffer);
+    expect(second.agents.x.buffer).toBe(second.buffer);
+    expect(third.buffer).toBe(first.buffer);
+  });
+
+  it('grows frame buffers with the population', () => {
+    const { observer } = setup(300, 10);
+    const frame = observer.captureFrame();
+    expect(frame.agentCapacity).toBeGreaterThanOrEqual(300);
+    expect(frame.buffer.byteLength).toBe(renderFrameByteLength(frame.agentCapacity, frame.foodCapacity));
+  });
+
+  it('round-trips through a message without copying columns', () => {
+    const { observer } = setup();
+    const frame = observer.captureFrame();
+    const { message, transfer } = frameToMessage(frame);
+    expect(transfer).toEqual([frame.buffer]);
+
+    const received = frameFromMessage(message);
+    expect(received.agents.x.buffer).toBe(frame.buffer);
+    expect(received.agentIds).toEqual(frame.agentIds);
+    expect(Array.from(received.food.energy.subarray(0, frame.foodCount))).toEqual(
+      Array.from(frame.food.energy.subarray(0, frame.foodCount))
+    );
+  });
+
+  it('reallocates a transferred buffer and adopts it when handed back', () => {
+    const { observer } = setup();
+    const frame = observer.captureFrame();
+    const { message } = frameToMessage(frame, false);
+    const moved = structuredClone(message, { transfer: [frame.buffer as ArrayBuffer] });
+    expect(frame.buffer.byteLength).toBe(0);
+
+    expect(observer.releaseFrame(moved)).toBe(true);
+    observer.captureFrame();
+    const reused = observer.captureFrame();
+    expect(reused.buffer).toBe(moved.buffer);
+  });
+
+  it('uses shared buffers when configured', () => {
+    const { engine } = setup();
+    const observer = new Observer(engine, { sharedFrames: true });
+    const frame = observer.captureFrame();
+    expect(frame.buffer).toBeInstanceOf(SharedArrayBuffer);
+    expect(frameToMessage(frame).transfer).toEqual([]);
+  });
+});
+
+describe('Observer deltas', () => {
+  it('is incomplete until tracking has started', () => {
+    const { observer } = setup();
+    const frame = observer.captureFrame();
+    const first = observer.getDelta(frame.frameId);
+    expect(first.complete).toBe(false);
+    expect(observer.getDelta(first.toFrame).complete).toBe(true);
+  });
+
+  it('lists changed slots since a frame id', () => {
+    const { engine } = setup();
+    const observer = new Observer(engine, { sweepEveryFrame: true });
+    const base = observer.getDelta(0).toFrame;
+    expect(isDeltaEmpty(observer.getDelta(base))).toBe(true);
+
+    const [moved, drained] = engine.getAgentManager().getAllAgents();
+    moved.position.y += 2;
+    const mid = observer.captureFrame().frameId;
+    drained.energy -= 5;
+
+    const all = observer.getDelta(base);
+    expect(all.agents.slots).toEqual([moved.slot, drained.slot].sort((a, b) => a - b));
+    expect(all.agents.ids[all.agents.slots.indexOf(moved.slot)]).toBe(moved.id);
+    expect(all.agents.changes[all.agents.slots.indexOf(drained.slot)]).toBe(CHANGE_ENERGY);
+
+    const later = observer.getDelta(mid);
+    expect(later.agents.slots).toEqual([drained.slot]);
+    expect(all.agents.changes[all.agents.slots.indexOf(moved.slot)]).toBe(CHANGE_POSITION);
+  });
+
+  it('takes a view frame id as the base', () => {
+    const { engine } = setup();
+    const observer = new Observer(engine, { sweepEveryFrame: true });
+    observer.getDelta(0);
+    const view = observer.getView();
+    expect(isDeltaEmpty(observer.getDelta(view.frameId))).toBe(true);
+
+    const agent = engine.getAgentManager().getAllAgents()[0];
+    agent.energy -= 5;
+    expect(observer.getDelta(view.frameId).agents.slots).toEqual([agent.slot]);
+  });
+
+  it('sweeps entities once per tick by default', () => {
+    const { engine, observer } = setup();
+    const base = observer.getDelta(0).toFrame;
+
+    const agent = engine.getAgentManager().getAllAgents()[0];
+    agent.energy -= 5;
+    observer.captureFrame();
+    expect(isDeltaEmpty(observer.getDelta(base))).toBe(true);
+
+    engine.step(1);
+    const delta = observer.getDelta(base);
+    expect(delta.agents.slots).toContain(agent.slot);
+    expect(isDeltaEmpty(observer.getDelta(delta.toFrame))).toBe(true);
+  });
+
+  it('walks only recent changes, or scans from an old base', () => {
+    const { engine } = setup();
+    const observer = new Observer(engine, { sweepEveryFrame: true });
+    const base = observer.getDelta(0).toFrame;
+    const agents = engine.getAgentManager().getAllAgents();
+
+    // Push the base out of the journal with many single-slot frames
+    let last = base;
+    for (let i = 0; i < 100; i++) {
+      agents[i % agents.length].energy -= 0.5;
+      last = observer.getDelta(last).toFrame;
+    }
+    agents[3].energy -= 1;
+    const recent = observer.getDelta(last);
+    expect(recent.agents.slots).toEqual([agents[3].slot]);
+
+    const old = observer.getDelta(base);
+    expect(old.agents.slots).toEqual(agents.map(a => a.slot).sort((a, b) => a - b));
+  });
+
+  it('reports births and deaths', () => {
+    const { engine, observer } = setup();
+    const manager = engine.getAgentManager();
+    const base = observer.getDelta(0).toFrame;
+
+    const victim = manager.getAllAgents()[0];
+    victim.die();
+    const born = manager.spawnAgent()!;
+    const delta = observer.getDelta(base);
+
+    expect(delta.agents.deaths).toEqual([victim.id]);
+    expect(delta.agents.births).toEqual([born.id]);
+    expect(delta.agents.changes[delta.agents.slots.indexOf(victim.slot)] & CHANGE_ALIVE).toBe(CHANGE_ALIVE);
+    expect(observer.getDelta(delta.toFrame).agents.deaths).toEqual([]);
+  });
+
+  it('is incomplete past the birth and death history or a reset', () => {
+    const { engine } = setup();
+    const observer = new Observer(engine, { deltaHistory: 2 });
+    const manager = engine.getAgentManager();
+    const base = observer.getDelta(0).toFrame;
+
+    for (let i = 0; i < 3; i++) {
+      manager.spawnAgent();
+      observer.captureFrame();
+    }
+    expect(observer.getDelta(base).complete).toBe(false);
+
+    const after = observer.getDelta(base).toFrame;
+    engine.reset();
+    expect(observer.getDelta(after).complete).toBe(false);
+  });
+});
+
+describe('Observer object views', () => {
+  it('builds views that match the simulation', () => {
+    const { engine, observer } = setup();
+    const view = observer.getView();
+    const agents = engine.getAgentManager().getAllAgents();
+
+    expect(view.agents).toHaveLength(agents.length);
+    expect(Object.isFrozen(view.agents[0])).toBe(true);
+    expect(view.agents[0].id).toBe(agents[0].id);
+    expect(view.agents[0].speciesId).toBe(agents[0].speciesId);
+    expect(view.agents[0].lineageId).toBe(agents[0].lineageId);
+    expect(view.agents[0].maxEnergy).toBe(agents[0].getConfig().maxEnergy);
+    expect(view.agents[0].x).toBe(agents[0].position.x);
+    expect(view.agents[0].energy).toBe(agents[0].energy);
+    expect(view.food).toHaveLength(engine.getFoodManager().getAllFood().length);
+    expect(view.food[0].y).toBe(engine.getFoodManager().getAllFood()[0].y);
+    expect(observer.getAgents()).toHaveLength(agents.length);
+    const single = observer.getAgentView(agents[1].id)!;
+    expect(single.id).toBe(agents[1].id);
+    expect(single.x).toBe(agents[1].position.x);
+    expect(observer.getAgentView('missing')).toBeNull();
+  });
+
+  it('does not disturb the render double buffer', () => {
+    const { observer } = setup();
+    const frame = observer.captureFrame();
+    observer.getView();
+    expect(observer.captureFrame().buffer).not.toBe(frame.buffer);
+  });
+});
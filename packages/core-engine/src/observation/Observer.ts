@@ -5,10 +5,33 @@
  * read simulation state without any ability to mutate it.
  *
  * Principle: The simulation is the truth; observation is just one way of witnessing it.
+ *
+ * Renderers should prefer captureFrame(): it fills preallocated typed-array
+ * columns (see RenderFrame) in a double buffer instead of building a view
+ * object per agent and food item. getView() and friends still build frozen
+ * objects from the live entities, with exact (float64) values.
+ *
+ * UI that only shows details (an inspector, counters) can ask for deltas
+ * instead: getDelta(frameId) lists the agent and food slots whose position,
+ * energy or alive status changed after that frame, plus births and deaths.
+ * Once tracking has started, the first frame id handed out in a tick
+ * compares every living entity with its last seen values (O(live)); later
+ * frame ids in the same tick only collect births and deaths, and a delta
+ * costs O(changes since its base). Edits made between ticks therefore show
+ * up at the next tick unless sweepEveryFrame is set.
  */
 
 import { SimulationEngine } from '../simulation/SimulationEngine';
 import { SimulationState } from '../engine/EngineConfig';
+import {
+  RenderFrame,
+  RenderFrameMessage,
+  FrameBuffer,
+  AGENT_FLAG_ALIVE,
+  FOOD_FLAG_CONSUMED,
+} from './RenderFrame';
+import { ObserverDelta, DeltaLog, isDeltaEmpty } from './FrameDelta';
+import { ChangeSet, createChangeSet } from '../simulation/ChangeTracker';
 
 /**
  * Read-only view of an agent
@@ -70,6 +93,7 @@ export interface StatsView {
  * Complete simulation view at a point in time
  */
 export interface SimulationView {
+  readonly frameId: number;     // Pass to getDelta() for changes after this view
   readonly tick: number;
   readonly state: SimulationState;
   readonly world: WorldView;
@@ -83,6 +107,8 @@ export interface SimulationView {
  */
 export interface ObserverCallbacks {
   onFrame?: (view: SimulationView) => void;
+  onRenderFrame?: (frame: RenderFrame) => void;
+  onDelta?: (delta: ObserverDelta) => void;   // Only called when something changed
   onAgentSpawn?: (agent: AgentView) => void;
   onAgentDeath?: (agent: AgentView) => void;
   onStateChange?: (oldState: SimulationState, newState: SimulationState) => void;
@@ -98,12 +124,21 @@ export interface ObserverConfig {
   trackAgentEvents: boolean;
   /** Whether to track state changes */
   trackStateChanges: boolean;
+  /** Back render frames with SharedArrayBuffers instead of transferable ArrayBuffers */
+  sharedFrames: boolean;
+  /** Births and deaths kept for getDelta(); older frame ids get incomplete deltas */
+  deltaHistory: number;
+  /** Compare every entity at each frame id instead of once per tick */
+  sweepEveryFrame: boolean;
 }
 
 export const DEFAULT_OBSERVER_CONFIG: ObserverConfig = {
   frameInterval: 16, // ~60fps
   trackAgentEvents: true,
   trackStateChanges: true,
+  sharedFrames: false,
+  deltaHistory: 4096,
+  sweepEveryFrame: false,
 };
 
 /**
@@ -121,9 +156,26 @@ export class Observer {
   private animationFrameId?: number;
   private timeoutId?: ReturnType<typeof setTimeout>;
 
+  // Render frames: captureFrame() fills frames[back] and then flips
+  private frames: [FrameBuffer, FrameBuffer];
+  private back: number = 0;
+  private frameCounter: number = 0;
+  private speciesIndex: Map<string, number> = new Map();
+  private speciesIds: string[] = [];
+
+  // Change logs, created by the first getDelta()
+  private agentLog: DeltaLog | null = null;
+  private foodLog: DeltaLog | null = null;
+  private agentChanges: ChangeSet = createChangeSet();
+  private foodChanges: ChangeSet = createChangeSet();
+  private lastDeltaFrame: number = 0;
+  private sweptTick: number = -1;      // Tick of the last entity sweep
+
   constructor(simulation: SimulationEngine, config?: Partial<ObserverConfig>) {
     this.simulation = simulation;
     this.config = { ...DEFAULT_OBSERVER_CONFIG, ...config };
+    const shared = this.config.sharedFrames;
+    this.frames = [new FrameBuffer(256, 256, shared), new FrameBuffer(256, 256, shared)];
   }
 
   /**
@@ -196,54 +248,254 @@ export class Observer {
     const now = performance.now();
     if (now - this.lastFrameTime >= this.config.frameInterval) {
       this.lastFrameTime = now;
-      this.callbacks.onFrame?.(this.getView());
+      if (this.callbacks.onRenderFrame) {
+        this.callbacks.onRenderFrame(this.captureFrame());
+      }
+      if (this.callbacks.onFrame) {
+        this.callbacks.onFrame(this.getView());
+      }
+      if (this.callbacks.onDelta) {
+        const delta = this.getDelta(this.lastDeltaFrame);
+        this.lastDeltaFrame = delta.toFrame;
+        if (!isDeltaEmpty(delta)) this.callbacks.onDelta(delta);
+      }
     }
 
     this.scheduleFrame();
   }
 
+  // ==========================================================================
+  // Render frames
+  // ==========================================================================
+
   /**
-   * Get a complete read-only view of the current simulation state
+   * Fill the back frame buffer with the current state and hand it out.
+   * The frame stays valid until the next-but-one capture, so a renderer can
+   * draw one frame while the next is filled. Transferring `frame.buffer` to
+   * another thread is fine; hand it back with releaseFrame() to avoid a
+   * reallocation.
    */
-  getView(): SimulationView {
+  captureFrame(): RenderFrame {
+    const target = this.frames[this.back];
+    this.back ^= 1;
+    return this.fillFrame(target);
+  }
+
+  /**
+   * Return a transferred frame buffer to the double buffer
+   */
+  releaseFrame(frame: RenderFrame | RenderFrameMessage): boolean {
+    for (const target of this.frames) {
+      if (target.buffer.byteLength === 0) {
+        return target.adopt(frame.buffer, frame.agentCapacity, frame.foodCapacity);
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Species ids by species index, as used in frame columns
+   */
+  getSpeciesIds(): string[] {
+    return [...this.speciesIds];
+  }
+
+  private fillFrame(target: FrameBuffer): RenderFrame {
+    const frameId = ++this.frameCounter;
+    this.syncChanges(frameId);
+
     const agentManager = this.simulation.getAgentManager();
     const foodManager = this.simulation.getFoodManager();
-    const config = this.simulation.getConfig();
+    target.ensure(agentManager.getAgentCount(), foodManager.getFoodCount());
+
+    const a = target.agents;
+    const agentIds = target.agentIds;
+    const lineageIds = target.lineageIds;
+    let agentCount = 0;
+    for (const agent of agentManager.iterateAgents()) {
+      const i = agentCount++;
+      a.x[i] = agent.position.x;
+      a.y[i] = agent.position.y;
+      a.rotation[i] = agent.rotation;
+      a.energy[i] = agent.energy;
+      a.maxEnergy[i] = agent.maxEnergy;
+      a.age[i] = agent.age;
+      a.generation[i] = agent.generation;
+      a.slot[i] = agent.slot;
+      a.species[i] = this.speciesSlot(agent.speciesId);
+      a.flags[i] = agent.alive() ? AGENT_FLAG_ALIVE : 0;
+      agentIds[i] = agent.id;
+      lineageIds[i] = agent.lineageId;
+    }
+    agentIds.length = agentCount;
+    lineageIds.length = agentCount;
+
+    const f = target.food;
+    const foodIds = target.foodIds;
+    let foodCount = 0;
+    for (const food of foodManager.iterateFood()) {
+      const i = foodCount++;
+      f.x[i] = food.x;
+      f.y[i] = food.y;
+      f.energy[i] = food.energy;
+      f.maxEnergy[i] = food.maxEnergy;
+      f.row[i] = food.row;
+      f.flags[i] = food.isConsumed ? FOOD_FLAG_CONSUMED : 0;
+      foodIds[i] = food.id;
+    }
+    foodIds.length = foodCount;
+
+    return Object.freeze({
+      frameId,
+      tick: this.simulation.getCurrentTick(),
+      agentCount,
+      foodCount,
+      agentCapacity: target.agentCapacity,
+      foodCapacity: target.foodCapacity,
+      agents: target.agents,
+      food: target.food,
+      buffer: target.buffer,
+      agentIds,
+      lineageIds,
+      foodIds,
+      speciesIds: this.speciesIds,
+    });
+  }
+
+  private speciesSlot(speciesId: string): number {
+    let index = this.speciesIndex.get(speciesId);
+    if (index === undefined) {
+      index = this.speciesIds.length;
+      this.speciesIndex.set(speciesId, index);
+      this.speciesIds.push(speciesId);
+    }
+    return index;
+  }
+
+  // ==========================================================================
+  // Deltas
+  // ==========================================================================
+
+  /**
+   * Changes after `sinceFrameId` (the frameId of a captureFrame() or
+   * getView() result, or a previous delta's toFrame). The first call starts change
+   * tracking, so it is incomplete; resync from a full frame whenever
+   * `complete` is false.
+   */
+  getDelta(sinceFrameId: number): ObserverDelta {
+    const frameId = ++this.frameCounter;
+    this.syncChanges(frameId);
+    if (!this.agentLog || !this.foodLog) {
+      const agentTracker = this.simulation.getAgentManager().trackChanges();
+      const foodTracker = this.simulation.getFoodManager().trackChanges();
+      this.agentLog = new DeltaLog(agentTracker, frameId, this.config.deltaHistory);
+      this.foodLog = new DeltaLog(foodTracker, frameId, this.config.deltaHistory);
+      this.syncChanges(frameId);
+    }
 
+    const complete = this.agentLog.covers(sinceFrameId) && this.foodLog.covers(sinceFrameId);
     return Object.freeze({
+      fromFrame: sinceFrameId,
+      toFrame: frameId,
+      tick: this.simulation.getCurrentTick(),
+      complete,
+      agents: this.agentLog.delta(sinceFrameId),
+      food: this.foodLog.delta(sinceFrameId),
+    });
+  }
+
+  /**
+   * Whether getDelta() has started change tracking
+   */
+  isTrackingChanges(): boolean {
+    return this.agentLog !== null;
+  }
+
+  // Stamp everything the managers recorded since the last frame id,
+  // sweeping living entities once per tick
+  private syncChanges(frameId: number): void {
+    if (!this.agentLog || !this.foodLog) return;
+    const agentManager = this.simulation.getAgentManager();
+    const foodManager = this.simulation.getFoodManager();
+    const tick = this.simulation.getCurrentTick();
+    const sweep = this.config.sweepEveryFrame || tick !== this.sweptTick;
+    this.sweptTick = tick;
+    this.agentLog.record(frameId, agentManager.collectChanges(this.agentChanges, sweep));
+    this.foodLog.record(frameId, foodManager.collectChanges(this.foodChanges, sweep));
+  }
+
+  // ==========================================================================
+  // Object views
+  // ==========================================================================
+
+  /**
+   * Get a complete read-only view of the current simulation state
+   */
+  getView(): SimulationView {
+    // Views take a frame id too, so they can serve as a getDelta() base
+    const frameId = ++this.frameCounter;
+    this.syncChanges(frameId);
+
+    return Object.freeze({
+      frameId,
       tick: this.simulation.getCurrentTick(),
       state: this.simulation.getState(),
-      world: Object.freeze({
-        width: config.world.dimensions.width,
-        height: config.world.dimensions.height,
-        wrapEdges: config.world.wrapEdges ?? true,
-      }),
-      agents: Object.freeze(
-        agentManager.getAllAgents().map((a) => this.agentToView(a))
-      ),
-      food: Object.freeze(
-        foodManager.getAllFood().map((f) => this.foodToView(f))
-      ),
+      world: this.getWorld(),
+      agents: this.agentViews(),
+      food: this.foodViews(),
       stats: this.getStats(),
     });
   }
 
+  /**
+   * View of a single agent, or null if it is not in the simulation
+   */
+  getAgentView(id: string): AgentView | null {
+    const agent = this.simulation.getAgentManager().getAgent(id);
+    return agent ? this.agentToView(agent) : null;
+  }
+
   /**
    * Get just the agents view (for rendering optimization)
    */
   getAgents(): ReadonlyArray<AgentView> {
-    return Object.freeze(
-      this.simulation.getAgentManager().getAllAgents().map((a) => this.agentToView(a))
-    );
+    return this.agentViews();
   }
 
   /**
    * Get just the food view (for rendering optimization)
    */
   getFood(): ReadonlyArray<FoodView> {
-    return Object.freeze(
-      this.simulation.getFoodManager().getAllFood().map((f) => this.foodToView(f))
-    );
+    return this.foodViews();
+  }
+
+  private agentViews(): ReadonlyArray<AgentView> {
+    const agentManager = this.simulation.getAgentManager();
+    const views: AgentView[] = new Array(agentManager.getAgentCount());
+    let count = 0;
+    for (const agent of agentManager.iterateAgents()) {
+      views[count++] = this.agentToView(agent);
+    }
+    views.length = count;
+    return Object.freeze(views);
+  }
+
+  private foodViews(): ReadonlyArray<FoodView> {
+    const foodManager = this.simulation.getFoodManager();
+    const views: FoodView[] = new Array(foodManager.getFoodCount());
+    let count = 0;
+    for (const food of foodManager.iterateFood()) {
+      views[count++] = Object.freeze({
+        id: food.id,
+        x: food.x,
+        y: food.y,
+        energy: food.energy,
+        maxEnergy: food.maxEnergy,
+        isConsumed: food.isConsumed,
+      });
+    }
+    views.length = count;
+    return Object.freeze(views);
   }
 
   /**
@@ -323,7 +575,7 @@ export class Observer {
     generation: number;
     lineageId: string;
     alive: () => boolean;
-    getConfig: () => { maxEnergy: number };
+    maxEnergy: number;
   }): AgentView {
     return Object.freeze({
       id: agent.id,
@@ -332,7 +584,7 @@ export class Observer {
       y: agent.position.y,
       rotation: agent.rotation,
       energy: agent.energy,
-      maxEnergy: agent.getConfig().maxEnergy,
+      maxEnergy: agent.maxEnergy,
       age: agent.age,
       generation: agent.generation,
       lineageId: agent.lineageId,
@@ -340,24 +592,6 @@ export class Observer {
     });
   }
 
-  private foodToView(food: {
-    id: string;
-    x: number;
-    y: number;
-    energy: number;
-    isConsumed: boolean;
-    getConfig: () => { energyValue: number };
-  }): FoodView {
-    return Object.freeze({
-      id: food.id,
-      x: food.x,
-      y: food.y,
-      energy: food.energy,
-      maxEnergy: food.getConfig().energyValue,
-      isConsumed: food.isConsumed,
-    });
-  }
-
   /**
    * Clean up observer
    */
@@ -0,0 +1,267 @@
+/**
+ * RenderFrame.ts - Typed-array frames of simulation state for rendering
+ *
+ * A frame stores agents and food as columns (x, y, rotation, energy,
+ * species index, flags, ...) in typed arrays that all view one
+ * ArrayBuffer. Renderers loop over the columns instead of per-agent view
+ * objects, and the whole frame crosses a thread boundary by transferring
+ * (or sharing) that single buffer: see frameToMessage / frameFromMessage.
+ *
+ * String ids are not part of the buffer. They travel alongside it as plain
+ * arrays, and renderers that only draw can leave them out.
+ */
+
+// ============================================================================
+// Flags
+// ============================================================================
+
+export const AGENT_FLAG_ALIVE = 1;
+export const FOOD_FLAG_CONSUMED = 1;
+
+// ============================================================================
+// Types
+// ============================================================================
+
+export interface AgentFrameColumns {
+  x: Float32Array;
+  y: Float32Array;
+  rotation: Float32Array;
+  energy: Float32Array;
+  maxEnergy: Float32Array;
+  age: Uint32Array;
+  generation: Uint32Array;
+  slot: Int32Array;          // Agent.slot (-1 when unmanaged)
+  species: Uint16Array;      // Index into RenderFrame.speciesIds
+  flags: Uint8Array;         // AGENT_FLAG_*
+}
+
+export interface FoodFrameColumns {
+  x: Float32Array;
+  y: Float32Array;
+  energy: Float32Array;
+  maxEnergy: Float32Array;
+  row: Int32Array;           // Row in the FoodStore
+  flags: Uint8Array;         // FOOD_FLAG_*
+}
+
+/**
+ * Read-only frame handed out by Observer.captureFrame(). Only the first
+ * agentCount / foodCount entries of each column are valid.
+ */
+export interface RenderFrame {
+  readonly frameId: number;
+  readonly tick: number;
+  readonly agentCount: number;
+  readonly foodCount: number;
+  readonly agentCapacity: number;
+  readonly foodCapacity: number;
+  readonly agents: Readonly<AgentFrameColumns>;
+  readonly food: Readonly<FoodFrameColumns>;
+  readonly buffer: ArrayBufferLike;
+  readonly agentIds: ReadonlyArray<string>;
+  readonly lineageIds: ReadonlyArray<string>;
+  readonly foodIds: ReadonlyArray<string>;
+  readonly speciesIds: ReadonlyArray<string>;   // Species index -> id
+}
+
+/**
+ * Structured-clone friendly form of a frame; post it with `[buffer]` in
+ * the transfer list to move the columns without copying
+ */
+export interface RenderFrameMessage {
+  frameId: number;
+  tick: number;
+  agentCount: number;
+  foodCount: number;
+  agentCapacity: number;
+  foodCapacity: number;
+  buffer: ArrayBufferLike;
+  agentIds?: string[];
+  lineageIds?: string[];
+  foodIds?: string[];
+  speciesIds: string[];
+}
+
+// ============================================================================
+// Layout
+// ============================================================================
+
+// Bytes per agent / food across all columns, before padding
+const AGENT_BYTES = 4 * 8 + 2 + 1;
+const FOOD_BYTES = 4 * 5 + 1;
+
+function align4(bytes: number): number {
+  return (bytes + 3) & ~3;
+}
+
+/**
+ * Bytes needed for a frame with the given capacities
+ */
+export function renderFrameByteLength(agentCapacity: number, foodCapacity: number): number {
+  return align4(agentCapacity * AGENT_BYTES) + align4(foodCapacity * FOOD_BYTES);
+}
+
+/**
+ * Column views over `buffer` for the given capacities. 4-byte columns come
+ * first so every view is aligned.
+ */
+export function mapFrameColumns(
+  buffer: ArrayBufferLike,
+  agentCapacity: number,
+  foodCapacity: number
+): { agents: AgentFrameColumns; food: FoodFrameColumns } {
+  const A = agentCapacity;
+  const F = foodCapacity;
+  let offset = 0;
+  const take = <T>(ctor: new (b: ArrayBufferLike, o: number, n: number) => T, n: number, bytes: number): T => {
+    const view = new ctor(buffer, offset, n);
+    offset += n * bytes;
+    return view;
+  };
+
+  const agents: AgentFrameColumns = {
+    x: take(Float32Array, A, 4),
+    y: take(Float32Array, A, 4),
+    rotation: take(Float32Array, A, 4),
+    energy: take(Float32Array, A, 4),
+    maxEnergy: take(Float32Array, A, 4),
+    age: take(Uint32Array, A, 4),
+    generation: take(Uint32Array, A, 4),
+    slot: take(Int32Array, A, 4),
+    species: take(Uint16Array, A, 2),
+    flags: take(Uint8Array, A, 1),
+  };
+  offset = align4(offset);
+
+  const food: FoodFrameColumns = {
+    x: take(Float32Array, F, 4),
+    y: take(Float32Array, F, 4),
+    energy: take(Float32Array, F, 4),
+    maxEnergy: take(Float32Array, F, 4),
+    row: take(Int32Array, F, 4),
+    flags: take(Uint8Array, F, 1),
+  };
+  return { agents, food };
+}
+
+// ============================================================================
+// Transfer
+// ============================================================================
+
+/**
+ * Message for postMessage(message, transfer). With `includeIds` false only
+ * the species table goes along with the buffer. The transfer list is empty
+ * for shared buffers, which are shared rather than moved.
+ */
+export function frameToMessage(
+  frame: RenderFrame,
+  includeIds: boolean = true
+): { message: RenderFrameMessage; transfer: ArrayBuffer[] } {
+  const message: RenderFrameMessage = {
+    frameId: frame.frameId,
+    tick: frame.tick,
+    agentCount: frame.agentCount,
+    foodCount: frame.foodCount,
+    agentCapacity: frame.agentCapacity,
+    foodCapacity: frame.foodCapacity,
+    buffer: frame.buffer,
+    speciesIds: frame.speciesIds.slice(),
+  };
+  if (includeIds) {
+    message.agentIds = frame.agentIds.slice(0, frame.agentCount);
+    message.lineageIds = frame.lineageIds.slice(0, frame.agentCount);
+    message.foodIds = frame.foodIds.slice(0, frame.foodCount);
+  }
+  const shared = typeof SharedArrayBuffer !== 'undefined' && frame.buffer instanceof SharedArrayBuffer;
+  return { message, transfer: shared ? [] : [frame.buffer as ArrayBuffer] };
+}
+
+/**
+ * Rebuild a frame from a received message; the columns view the received
+ * buffer directly
+ */
+export function frameFromMessage(message: RenderFrameMessage): RenderFrame {
+  const { agents, food } = mapFrameColumns(message.buffer, message.agentCapacity, message.foodCapacity);
+  return Object.freeze({
+    frameId: message.frameId,
+    tick: message.tick,
+    agentCount: message.agentCount,
+    foodCount: message.foodCount,
+    agentCapacity: message.agentCapacity,
+    foodCapacity: message.foodCapacity,
+    agents: Object.freeze(agents),
+    food: Object.freeze(food),
+    buffer: message.buffer,
+    agentIds: message.agentIds ?? [],
+    lineageIds: message.lineageIds ?? [],
+    foodIds: message.foodIds ?? [],
+    speciesIds: message.speciesIds,
+  });
+}
+
+// ============================================================================
+// FrameBuffer Class
+// ============================================================================
+
+/**
+ * One side of the observer's double buffer: a growable set of columns plus
+ * the id arrays, refilled in place each frame
+ */
+export class FrameBuffer {
+  readonly shared: boolean;
+
+  agentCapacity: number = 0;
+  foodCapacity: number = 0;
+  buffer!: ArrayBufferLike;
+  agents!: AgentFrameColumns;
+  food!: FoodFrameColumns;
+  agentIds: string[] = [];
+  lineageIds: string[] = [];
+  foodIds: string[] = [];
+
+  constructor(agentCapacity: number = 256, foodCapacity: number = 256, shared: boolean = false) {
+    this.shared = shared;
+    this.allocate(Math.max(1, agentCapacity), Math.max(1, foodCapacity));
+  }
+
+  /**
+   * Make room for the given counts. Also reallocates when the buffer has
+   * been transferred away (detached) and not handed back.
+   */
+  ensure(agentCount: number, foodCount: number): void {
+    let A = this.agentCapacity;
+    let F = this.foodCapacity;
+    while (A < agentCount) A *= 2;
+    while (F < foodCount) F *= 2;
+    if (A !== this.agentCapacity || F !== this.foodCapacity || this.buffer.byteLength === 0) {
+      this.allocate(A, F);
+    }
+  }
+
+  /**
+   * Adopt a buffer handed back after a transfer, if it fits
+   */
+  adopt(buffer: ArrayBufferLike, agentCapacity: number, foodCapacity: number): boolean {
+    if (buffer.byteLength < renderFrameByteLength(agentCapacity, foodCapacity)) return false;
+    if (this.buffer.byteLength !== 0 && agentCapacity <= this.agentCapacity && foodCapacity <= this.foodCapacity) {
+      return false;
+    }
+    this.buffer = buffer;
+    this.agentCapacity = agentCapacity;
+    this.foodCapacity = foodCapacity;
+    ({ agents: this.agents, food: this.food } = mapFrameColumns(buffer, agentCapacity, foodCapacity));
+    return true;
+  }
+
+  memoryUsage(): number {
+    return this.buffer.byteLength;
+  }
+
+  private allocate(agentCapacity: number, foodCapacity: number): void {
+    const bytes = renderFrameByteLength(agentCapacity, foodCapacity);
+    this.buffer = this.shared ? new SharedArrayBuffer(bytes) : new ArrayBuffer(bytes);
+    this.agentCapacity = agentCapacity;
+    this.foodCapacity = foodCapacity;
+    ({ agents: this.agents, food: this.food } = mapFrameColumns(this.buffer, agentCapacity, foodCapacity));
+  }
+}
@@ -20,3 +20,30 @@ export type {
   ObserverCallbacks,
   ObserverConfig,
 } from './Observer';
+
+export {
+  FrameBuffer,
+  frameToMessage,
+  frameFromMessage,
+  mapFrameColumns,
+  renderFrameByteLength,
+  AGENT_FLAG_ALIVE,
+  FOOD_FLAG_CONSUMED,
+} from './RenderFrame';
+
+export type {
+  RenderFrame,
+  RenderFrameMessage,
+  AgentFrameColumns,
+  FoodFrameColumns,
+} from './RenderFrame';
+
+export {
+  DeltaLog,
+  isDeltaEmpty,
+} from './FrameDelta';
+
+export type {
+  ObserverDelta,
+  EntityDelta,
+} from './FrameDelta';
@@ -189,6 +189,7 @@ export const PRESET_LARGE: SimulationConfig = {
     minPopulation: 20,
     autoRespawn: true,
     networkLayers: [7, 24, 12, 3],
+    recycleAgents: true,
     agentConfig: {
       maxEnergy: 120,
       maxSpeed: 3,
@@ -381,6 +382,7 @@ export const PRESET_FAST_EVOLUTION: SimulationConfig = {
     minPopulation: 8,
     autoRespawn: true,
     networkLayers: [7, 12, 3],
+    recycleAgents: true,
     agentConfig: {
       maxEnergy: 80,
       maxSpeed: 3,
@@ -419,6 +421,76 @@ export const PRESET_FAST_EVOLUTION: SimulationConfig = {
   },
 };
 
+/**
+ * Predator-prey ecosystem - two founding species with a seeded food web
+ * Good for: Trophic dynamics, arms races, population cycles
+ */
+export const PRESET_PREDATOR_PREY: SimulationConfig = {
+  engine: {
+    world: {
+      dimensions: { width: 800, height: 600 },
+      wrapEdges: true,
+    },
+    timing: {
+      deltaTime: 16.667,
+      targetStepsPerSecond: 60,
+      maxStepsPerFrame: 4,
+      useFixedTimestep: true,
+      timeScale: 1.0,
+    },
+  },
+  agents: {
+    initialPopulation: 30,
+    maxPopulation: 150,
+    minPopulation: 10,
+    autoRespawn: true,
+    networkLayers: [7, 16, 8, 3],
+    speciesCount: 2,
+    agentConfig: {
+      maxEnergy: 100,
+      maxSpeed: 2.5,
+      rotationSpeed: Math.PI / 4,
+      sensorRange: 120,
+      energyCostPerTick: 0.1,
+      energyCostMove: 0.4,
+      energyCostRotate: 0.1,
+      energyCostReproduce: 35,
+      reproductionThreshold: 65,
+      matureAge: 80,
+    },
+  },
+  food: {
+    initialCount: 60,
+    maxCount: 200,
+    spawnRate: 0.15,
+    clusteringFactor: 0.4,
+    foodConfig: {
+      energyValue: 20,
+      respawnDelay: 80,
+      decayRate: 0.01,
+    },
+  },
+  interaction: {
+    eatRadius: 12,
+    mateRadius: 18,
+    collisionRadius: 6,
+  },
+  sensory: {
+    visionRange: 100,
+    foodWeight: 1.0,
+    agentWeight: 0.5,
+  },
+  statistics: {
+    historyLength: 1000,
+    snapshotInterval: 5,
+  },
+  trophic: {
+    enabled: true,
+    cellSize: 50,
+    predation: [{ predator: 'species_1', prey: 'species_0' }],
+  },
+};
+
 /**
  * All available presets
  */
@@ -430,6 +502,7 @@ export const PRESETS = {
   survival: PRESET_SURVIVAL,
   abundant: PRESET_ABUNDANT,
   fastEvolution: PRESET_FAST_EVOLUTION,
+  predatorPrey: PRESET_PREDATOR_PREY,
 } as const;
 
 export type PresetName = keyof typeof PRESETS;
@@ -463,6 +536,7 @@ export function customizePreset(
     interaction: { ...base.interaction, ...overrides.interaction },
     sensory: { ...base.sensory, ...overrides.sensory },
     statistics: { ...base.statistics, ...overrides.statistics },
+    trophic: { ...base.trophic, ...overrides.trophic },
   };
 }
 
@@ -477,6 +551,7 @@ const PRESET_DESCRIPTIONS: Record<PresetName, string> = {
   survival: 'Scarce resources, high competition',
   abundant: 'Plentiful resources, focus on breeding',
   fastEvolution: 'Accelerated time for quick evolution',
+  predatorPrey: 'Two species with predation enabled',
 };
 
 /**
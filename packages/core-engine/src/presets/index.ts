@@ -10,6 +10,7 @@ export {
   PRESET_SURVIVAL,
   PRESET_ABUNDANT,
   PRESET_FAST_EVOLUTION,
+  PRESET_PREDATOR_PREY,
   PRESETS,
   getPreset,
   listPresets,
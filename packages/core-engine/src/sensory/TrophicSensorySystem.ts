@@ -9,7 +9,7 @@ import { SensorySystem, SensorConfig, AgentLike, WorldLike, DEFAULT_SENSOR_CONFI
 import { Direction, distance, directionTo, normalize } from './Direction';
 import { TrophicRoleTracker } from '../trophic/TrophicRoleTracker';
 import { TrophicSensoryInput, DEFAULT_TROPHIC_SENSORY_INPUT } from '../trophic/types';
-import { SpatialHash, QueryResult } from '../spatial';
+import { SpatialQuery, QueryResult } from '../spatial';
 
 // ============================================================================
 // Types
@@ -17,6 +17,7 @@ import { SpatialHash, QueryResult } from '../spatial';
 
 export interface TrophicAgent extends AgentLike {
   speciesId: string;
+  speciesSlot?: number;   // Tracker species slot, enables bitmask threat tests
   size?: number;
   speed?: number;
   strength?: number;
@@ -32,6 +33,9 @@ export interface TrophicSensorConfig extends SensorConfig {
   threatWeight: number;              // How much threat affects behavior
   opportunityWeight: number;         // How much opportunity affects behavior
   useSpatialHash: boolean;           // Whether to use spatial hash for queries
+  worldWidth: number;                // World size for wrapped directions (0 = unknown)
+  worldHeight: number;
+  wrapEdges: boolean;                // Measure directions across the world edge
 }
 
 export const DEFAULT_TROPHIC_SENSOR_CONFIG: TrophicSensorConfig = {
@@ -41,8 +45,27 @@ export const DEFAULT_TROPHIC_SENSOR_CONFIG: TrophicSensorConfig = {
   threatWeight: 1.0,
   opportunityWeight: 1.0,
   useSpatialHash: true,
+  worldWidth: 0,
+  worldHeight: 0,
+  wrapEdges: false,
 };
 
+/**
+ * Closeness (1 = touching, 0 = out of range) of the nearest predator in
+ * each directional cone
+ */
+export interface PredatorChannels {
+  front: number;
+  frontLeft: number;
+  frontRight: number;
+  left: number;
+  right: number;
+}
+
+export function createPredatorChannels(): PredatorChannels {
+  return { front: 0, frontLeft: 0, frontRight: 0, left: 0, right: 0 };
+}
+
 // ============================================================================
 // TrophicSensorySystem Class
 // ============================================================================
@@ -51,6 +74,10 @@ export class TrophicSensorySystem extends SensorySystem {
   private trophicConfig: TrophicSensorConfig;
   private trophicTracker: TrophicRoleTracker;
 
+  // State for the bound channel visitor; see sensePredatorChannels()
+  private channelAgent: TrophicAgent | null = null;
+  private channelOut: PredatorChannels = createPredatorChannels();
+
   constructor(
     trophicTracker: TrophicRoleTracker,
     config?: Partial<TrophicSensorConfig>
@@ -66,7 +93,7 @@ export class TrophicSensorySystem extends SensorySystem {
   gatherTrophic(
     agent: TrophicAgent,
     world: TrophicWorldLike,
-    spatialHash?: SpatialHash<TrophicAgent>
+    spatialHash?: SpatialQuery<TrophicAgent>
   ): TrophicSensoryInput {
     // Get base sensory input
     const baseInput = this.gather(agent, world);
@@ -110,7 +137,7 @@ export class TrophicSensorySystem extends SensorySystem {
   private getNearbyAgents(
     agent: TrophicAgent,
     world: TrophicWorldLike,
-    spatialHash?: SpatialHash<TrophicAgent>
+    spatialHash?: SpatialQuery<TrophicAgent>
   ): Array<{ agent: TrophicAgent; distance: number }> {
     const maxRange = Math.max(
       this.trophicConfig.threatDetectionRange,
@@ -153,7 +180,7 @@ export class TrophicSensorySystem extends SensorySystem {
       if (dist > this.trophicConfig.threatDetectionRange) continue;
 
       // Check if this agent is a threat to us
-      if (this.trophicTracker.isThreatTo(other.speciesId, agent.speciesId)) {
+      if (this.threatens(other, agent)) {
         const direction = this.calculateRelativeDirection(agent, other);
         const normalizedDistance = Math.min(1, dist / this.trophicConfig.threatDetectionRange);
 
@@ -179,7 +206,7 @@ export class TrophicSensorySystem extends SensorySystem {
       if (dist > this.trophicConfig.preyDetectionRange) continue;
 
       // Check if this agent is prey to us
-      if (this.trophicTracker.isOpportunityFor(agent.speciesId, other.speciesId)) {
+      if (this.threatens(agent, other)) {
         const direction = this.calculateRelativeDirection(agent, other);
         const normalizedDistance = Math.min(1, dist / this.trophicConfig.preyDetectionRange);
 
@@ -194,17 +221,45 @@ export class TrophicSensorySystem extends SensorySystem {
     return null;
   }
 
+  /**
+   * Whether predator's species threatens prey's species. Agents that carry
+   * their tracker species slot are answered with a single bit test.
+   */
+  private threatens(predator: TrophicAgent, prey: TrophicAgent): boolean {
+    const a = predator.speciesSlot;
+    const b = prey.speciesSlot;
+    if (a !== undefined && b !== undefined && a >= 0 && b >= 0) {
+      return this.trophicTracker.isThreatToSlot(a, b);
+    }
+    return this.trophicTracker.isThreatTo(predator.speciesId, prey.speciesId);
+  }
+
   /**
    * Calculate the relative direction to another agent from the agent's perspective
    * Returns angle in radians: 0 = directly ahead, positive = right, negative = left
    */
   private calculateRelativeDirection(agent: TrophicAgent, target: TrophicAgent): number {
-    const dx = target.position.x - agent.position.x;
-    const dy = target.position.y - agent.position.y;
-    const absoluteAngle = Math.atan2(dy, dx);
+    const angle = this.relativeAngle(agent, target.position);
+    return Number.isNaN(angle) ? 0 : angle;
+  }
 
-    // Calculate relative angle (difference from agent's facing direction)
-    let relativeAngle = absoluteAngle - agent.rotation;
+  /**
+   * Angle to a position relative to the agent's heading, in [-PI, PI], along
+   * the shortest (wrapped, when configured) offset. NaN when coincident.
+   */
+  private relativeAngle(agent: TrophicAgent, position: { x: number; y: number }): number {
+    let dx = position.x - agent.position.x;
+    let dy = position.y - agent.position.y;
+    const { wrapEdges, worldWidth, worldHeight } = this.trophicConfig;
+    if (wrapEdges && worldWidth > 0 && worldHeight > 0) {
+      if (dx > worldWidth / 2) dx -= worldWidth;
+      else if (dx < -worldWidth / 2) dx += worldWidth;
+      if (dy > worldHeight / 2) dy -= worldHeight;
+      else if (dy < -worldHeight / 2) dy += worldHeight;
+    }
+    if (dx === 0 && dy === 0) return NaN;
+
+    let relativeAngle = Math.atan2(dy, dx) - agent.rotation;
 
     // Normalize to [-PI, PI]
     while (relativeAngle > Math.PI) relativeAngle -= 2 * Math.PI;
@@ -223,7 +278,7 @@ export class TrophicSensorySystem extends SensorySystem {
     const threats = nearbyAgents
       .filter(({ agent: other, distance: dist }) =>
         dist <= this.trophicConfig.threatDetectionRange &&
-        this.trophicTracker.isThreatTo(other.speciesId, agent.speciesId)
+        this.threatens(other, agent)
       )
       .map(({ agent: other, distance: dist }) => ({
         speciesId: other.speciesId,
@@ -244,7 +299,7 @@ export class TrophicSensorySystem extends SensorySystem {
     const opportunities = nearbyAgents
       .filter(({ agent: other, distance: dist }) =>
         dist <= this.trophicConfig.preyDetectionRange &&
-        this.trophicTracker.isOpportunityFor(agent.speciesId, other.speciesId)
+        this.threatens(agent, other)
       )
       .map(({ agent: other, distance: dist }) => ({
         speciesId: other.speciesId,
@@ -263,7 +318,7 @@ export class TrophicSensorySystem extends SensorySystem {
     agent: TrophicAgent,
     world: TrophicWorldLike,
     direction: Direction,
-    spatialHash?: SpatialHash<TrophicAgent>
+    spatialHash?: SpatialQuery<TrophicAgent>
   ): number {
     const nearbyAgents = this.getNearbyAgents(agent, world, spatialHash);
     let closestDistance = Infinity;
@@ -271,7 +326,7 @@ export class TrophicSensorySystem extends SensorySystem {
     for (const { agent: other, distance: dist } of nearbyAgents) {
       if (dist > this.trophicConfig.threatDetectionRange) continue;
 
-      if (this.trophicTracker.isThreatTo(other.speciesId, agent.speciesId)) {
+      if (this.threatens(other, agent)) {
         if (this.isInDirectionCone(agent, other.position, direction)) {
           if (dist < closestDistance) {
             closestDistance = dist;
@@ -291,7 +346,7 @@ export class TrophicSensorySystem extends SensorySystem {
     agent: TrophicAgent,
     world: TrophicWorldLike,
     direction: Direction,
-    spatialHash?: SpatialHash<TrophicAgent>
+    spatialHash?: SpatialQuery<TrophicAgent>
   ): number {
     const nearbyAgents = this.getNearbyAgents(agent, world, spatialHash);
     let closestDistance = Infinity;
@@ -299,7 +354,7 @@ export class TrophicSensorySystem extends SensorySystem {
     for (const { agent: other, distance: dist } of nearbyAgents) {
       if (dist > this.trophicConfig.preyDetectionRange) continue;
 
-      if (this.trophicTracker.isOpportunityFor(agent.speciesId, other.speciesId)) {
+      if (this.threatens(agent, other)) {
         if (this.isInDirectionCone(agent, other.position, direction)) {
           if (dist < closestDistance) {
             closestDistance = dist;
@@ -312,6 +367,60 @@ export class TrophicSensorySystem extends SensorySystem {
     return 1 - Math.min(1, closestDistance / this.trophicConfig.preyDetectionRange);
   }
 
+  /**
+   * Sense predators in all five directions from a single neighbour query.
+   * Equivalent to calling sensePredators() once per direction. Writes into
+   * `out` and returns it; with an index the pass allocates nothing.
+   */
+  sensePredatorChannels(
+    agent: TrophicAgent,
+    world: TrophicWorldLike,
+    spatialHash?: SpatialQuery<TrophicAgent>,
+    out: PredatorChannels = createPredatorChannels()
+  ): PredatorChannels {
+    out.front = 0;
+    out.frontLeft = 0;
+    out.frontRight = 0;
+    out.left = 0;
+    out.right = 0;
+    const range = this.trophicConfig.threatDetectionRange;
+
+    if (this.trophicConfig.useSpatialHash && spatialHash) {
+      const outerAgent = this.channelAgent;
+      const outerOut = this.channelOut;
+      this.channelAgent = agent;
+      this.channelOut = out;
+      spatialHash.forEachInRadius(agent.position.x, agent.position.y, range, this.visitThreat);
+      this.channelAgent = outerAgent;
+      this.channelOut = outerOut;
+      return out;
+    }
+
+    for (const { agent: other, distance: dist } of this.getNearbyAgents(agent, world)) {
+      if (dist > range) break;
+      if (this.threatens(other, agent)) this.recordThreat(agent, other, dist, out);
+    }
+    return out;
+  }
+
+  // Bound once so index visits allocate no closures
+  private visitThreat = (other: TrophicAgent, distanceSq: number): void => {
+    const agent = this.channelAgent!;
+    if (other.id === agent.id || other.isAlive === false) return;
+    if (!this.threatens(other, agent)) return;
+    this.recordThreat(agent, other, Math.sqrt(distanceSq), this.channelOut);
+  };
+
+  private recordThreat(agent: TrophicAgent, other: TrophicAgent, dist: number, out: PredatorChannels): void {
+    const value = 1 - Math.min(1, dist / this.trophicConfig.threatDetectionRange);
+    const angle = this.relativeAngle(agent, other.position);
+    if (value > out.front && this.inCone(angle, Direction.FRONT)) out.front = value;
+    if (value > out.frontLeft && this.inCone(angle, Direction.FRONT_LEFT)) out.frontLeft = value;
+    if (value > out.frontRight && this.inCone(angle, Direction.FRONT_RIGHT)) out.frontRight = value;
+    if (value > out.left && this.inCone(angle, Direction.LEFT)) out.left = value;
+    if (value > out.right && this.inCone(angle, Direction.RIGHT)) out.right = value;
+  }
+
   /**
    * Check if a position is within a direction cone from the agent
    */
@@ -320,18 +429,15 @@ export class TrophicSensorySystem extends SensorySystem {
     position: { x: number; y: number },
     direction: Direction
   ): boolean {
-    const dx = position.x - agent.position.x;
-    const dy = position.y - agent.position.y;
-    const dist = Math.sqrt(dx * dx + dy * dy);
-
-    if (dist === 0) return true;
-
-    const absoluteAngle = Math.atan2(dy, dx);
-    let relativeAngle = absoluteAngle - agent.rotation;
+    return this.inCone(this.relativeAngle(agent, position), direction);
+  }
 
-    // Normalize to [-PI, PI]
-    while (relativeAngle > Math.PI) relativeAngle -= 2 * Math.PI;
-    while (relativeAngle < -Math.PI) relativeAngle += 2 * Math.PI;
+  /**
+   * Whether a relative angle (NaN = same position, in every cone) falls
+   * in a direction cone
+   */
+  private inCone(relativeAngle: number, direction: Direction): boolean {
+    if (Number.isNaN(relativeAngle)) return true;
 
     const coneWidth = this.trophicConfig.visionAngle;
 
@@ -357,7 +463,7 @@ export class TrophicSensorySystem extends SensorySystem {
   gatherDetailedTrophic(
     agent: TrophicAgent,
     world: TrophicWorldLike,
-    spatialHash?: SpatialHash<TrophicAgent>
+    spatialHash?: SpatialQuery<TrophicAgent>
   ): {
     base: TrophicSensoryInput;
     predatorFront: number;
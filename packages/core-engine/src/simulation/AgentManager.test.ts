@@ -0,0 +1,171 @@
+/**
+ * AgentManager.test.ts - Tests for dead-agent retention, recycling, default brains
+ * and change tracking
+ */
+
+import { describe, it, expect } from 'vitest';
+import { AgentManager } from './AgentManager';
+import { NeuralBrain } from '../neural/NeuralBrain';
+import { MLPBrain } from '../neural/MLPBrain';
+import { CHANGE_POSITION, CHANGE_ENERGY, CHANGE_ALIVE, CHANGE_ALL } from './ChangeTracker';
+
+function setup(config: Record<string, unknown> = {}) {
+  const manager = new AgentManager(200, 200, {
+    initialPopulation: 6,
+    autoRespawn: false,
+    respawnDelay: 5,
+    ...config,
+  });
+  manager.initialize();
+  return manager;
+}
+
+describe('AgentManager dead-agent retention', () => {
+  it('expires dead agents by tick, not wall time', () => {
+    const manager = setup();
+    const [a, b] = manager.getAllAgents();
+
+    manager.update(0);
+    a.die();
+    manager.update(1);
+    b.die();
+    manager.update(3);
+
+    const dead = manager.getDeadAgents();
+    expect(dead.map(r => r.agent)).toEqual([a, b]);
+    expect(dead.map(r => r.diedAt)).toEqual([1, 2]);
+
+    // Retention is respawnDelay * 2 = 10 ticks
+    manager.update(11);
+    expect(manager.getDeadAgentCount()).toBe(2);
+    manager.update(12);
+    expect(manager.getDeadAgents().map(r => r.agent)).toEqual([b]);
+    manager.update(14);
+    expect(manager.getDeadAgentCount()).toBe(0);
+  });
+
+  it('evicts the oldest records once capacity is reached', () => {
+    const manager = setup({ deadAgentCapacity: 2 });
+    const agents = manager.getAllAgents();
+
+    manager.update(0);
+    for (const agent of agents.slice(0, 4)) agent.die();
+
+    const dead = manager.getDeadAgents().map(r => r.agent);
+    expect(dead).toEqual([agents[2], agents[3]]);
+  });
+
+  it('forgets dead agents on initialize', () => {
+    const manager = setup();
+    manager.getAllAgents()[0].die();
+    manager.initialize();
+    expect(manager.getDeadAgentCount()).toBe(0);
+  });
+
+  it('releases expired agents to the pool when recycling', () => {
+    const manager = setup({ recycleAgents: true });
+    const [a] = manager.getAllAgents();
+
+    manager.update(0);
+    a.die();
+    manager.update(1);
+    expect(manager.getAgentPool().size).toBe(0);
+
+    manager.update(12);
+    expect(manager.getAgentPool().size).toBe(1);
+    expect(manager.getAgentPool().acquire()).toBe(a);
+  });
+
+  it('does not pool agents when recycling is off', () => {
+    const manager = setup();
+    manager.getAllAgents()[0].die();
+    manager.update(1);
+    manager.update(20);
+    expect(manager.getAgentPool().size).toBe(0);
+  });
+});
+
+describe('AgentManager disposal', () => {
+  it('disposes living agents dropped by initialize and clearForRestore', () => {
+    const manager = setup();
+    const disposed: string[] = [];
+    const track = () => {
+      for (const agent of manager.getAllAgents()) {
+        agent.dispose = () => { disposed.push(agent.id); };
+      }
+    };
+
+    track();
+    manager.getAllAgents()[0].die();
+    manager.initialize();
+    expect(disposed).toHaveLength(5);
+
+    track();
+    manager.clearForRestore();
+    expect(disposed).toHaveLength(11);
+  });
+});
+
+describe('AgentManager default brains', () => {
+  it('keeps NeuralBrain for a single hidden layer', () => {
+    const manager = setup({ networkLayers: [7, 12, 3] });
+    expect(manager.getAllAgents()[0].brain).toBeInstanceOf(NeuralBrain);
+  });
+
+  it('builds deeper layer lists as MLPBrains from the genome', () => {
+    const layers = [7, 16, 8, 3];
+    const manager = setup({ networkLayers: layers });
+    const agent = manager.getAllAgents()[0];
+
+    expect(agent.brain).toBeInstanceOf(MLPBrain);
+    const network = (agent.brain as MLPBrain).getMultiLayerNetwork();
+    expect(network.getLayers()).toEqual(layers);
+    expect(network.toNeuralLayers()).toEqual(agent.genome.extractNeuralWeights(layers));
+  });
+});
+
+describe('AgentManager change tracking', () => {
+  it('reports existing agents as spawned, then only what changed', () => {
+    const manager = setup();
+    const agents = manager.getAllAgents();
+    const first = manager.collectChanges();
+    expect(first.spawnIds).toEqual(agents.map(a => a.id));
+    expect(first.bits.every(b => b === CHANGE_ALL)).toBe(true);
+
+    expect(manager.collectChanges().slots).toEqual([]);
+
+    agents[1].position.x += 3;
+    agents[2].energy -= 1;
+    const second = manager.collectChanges();
+    expect(second.slots).toEqual([agents[1].slot, agents[2].slot]);
+    expect(second.bits).toEqual([CHANGE_POSITION, CHANGE_ENERGY]);
+  });
+
+  it('records deaths and released slots', () => {
+    const manager = setup();
+    manager.trackChanges();
+    manager.collectChanges();
+    const agent = manager.getAllAgents()[0];
+    const slot = agent.slot;
+
+    agent.die();
+    const died = manager.collectChanges();
+    expect(died.deathIds).toEqual([agent.id]);
+    expect(died.deathSlots).toEqual([slot]);
+    expect(died.bits[died.slots.indexOf(slot)] & CHANGE_ALIVE).toBe(CHANGE_ALIVE);
+
+    manager.update(1);
+    const released = manager.collectChanges();
+    expect(released.slots).toEqual([slot]);
+    expect(manager.trackChanges().idAt(slot)).toBe('');
+  });
+
+  it('reports a reset when the population is reinitialized', () => {
+    const manager = setup();
+    manager.collectChanges();
+    manager.initialize();
+    const changes = manager.collectChanges();
+    expect(changes.reset).toBe(true);
+    expect(changes.spawnIds).toHaveLength(6);
+  });
+});
@@ -5,10 +5,18 @@
  */
 
 import { Agent, Position, AgentConfig, DEFAULT_AGENT_CONFIG } from '../agents/Agent';
+import { AgentPool } from '../agents/AgentPool';
 import { Brain } from '../neural/Brain';
 import { NeuralBrain } from '../neural/NeuralBrain';
+import { MLPBrain } from '../neural/MLPBrain';
+import { RecurrentBrain, RECURRENT_BRAIN_TYPE } from '../neural/RecurrentBrain';
+import { multiLayerWeightCount } from '../neural/MultiLayerNetwork';
+import { RecurrentStateBuffer } from '../neural/RecurrentStateBuffer';
 import { Genome } from '../genetics/Genome';
 import { LineageRegistry } from '../lineage/Lineage';
+import { SpatialHash } from '../spatial';
+import { RingBuffer } from '../utils/RingBuffer';
+import { ChangeTracker, ChangeSet } from './ChangeTracker';
 
 export interface AgentManagerConfig {
   initialPopulation: number;
@@ -20,6 +28,12 @@ export interface AgentManagerConfig {
   brainType: string;
   genomeSize: number;
   networkLayers: number[];
+  speciesCount: number;        // Founding species, assigned round-robin on spawn
+  spatialCellSize: number;     // Cell size of the agent spatial index
+  deadAgentCapacity: number;   // Dead agents retained at most; the oldest are evicted first
+  recycleAgents: boolean;      // Reuse expired dead agents for offspring (see AgentPool)
+  agentPoolSize: number;       // Maximum dead agents kept for reuse
+  sharedRecurrentState: boolean; // Back recurrent brain state with a SharedArrayBuffer (workers)
 }
 
 export const DEFAULT_AGENT_MANAGER_CONFIG: AgentManagerConfig = {
@@ -32,6 +46,12 @@ export const DEFAULT_AGENT_MANAGER_CONFIG: AgentManagerConfig = {
   brainType: 'neural',
   genomeSize: 100,
   networkLayers: [7, 12, 3],
+  speciesCount: 1,
+  spatialCellSize: 25,
+  deadAgentCapacity: 256,
+  recycleAgents: false,
+  agentPoolSize: 256,
+  sharedRecurrentState: false,
 };
 
 export interface SpawnOptions {
@@ -44,15 +64,64 @@ export interface SpawnOptions {
   energy?: number;
 }
 
+/**
+ * A dead agent retained for respawnDelay * 2 ticks after death
+ */
+export interface DeadAgentRecord {
+  agent: Agent;
+  diedAt: number;   // Tick of death
+}
+
+// Ring entry; records are reused and cleared on expiry so corpses can be GC'd
+interface DeadAgentSlot {
+  agent: Agent | null;
+  diedAt: number;
+}
+
+/**
+ * Inline compatibility check for mate search (e.g. ReproductiveIsolation)
+ */
+export type MateFilter = (agent: Agent, candidate: Agent) => boolean;
+
 export class AgentManager {
   private agents: Map<string, Agent> = new Map();
-  private deadAgents: Map<string, { agent: Agent; diedAt: number }> = new Map();
+  // Ordered by death tick, so expiry only ever looks at the oldest entries
+  private deadAgents: RingBuffer<DeadAgentSlot>;
+  private spareRecords: DeadAgentSlot[] = [];
+  private tick: number = 0;   // Tick that deaths are attributed to (the next update)
   private config: AgentManagerConfig;
   private worldWidth: number;
   private worldHeight: number;
   private idCounter: number = 0;
   private lineageTracker?: LineageRegistry;
 
+  // Dense slot allocation for per-agent columns (see Agent.slot)
+  private freeSlots: number[] = [];
+  private nextSlot: number = 0;
+  private recurrentStates: RecurrentStateBuffer;
+
+  // Dirty bits and spawn/death lists, once trackChanges() has been called
+  private changes: ChangeTracker | null = null;
+
+  // Spatial index over agent positions, valid between build and invalidate
+  private index: SpatialHash<Agent>;
+  private indexed: boolean = false;
+
+  // Running state of findNearestMate, read by the bound visitor
+  private mateSeeker: Agent | null = null;
+  private mateFilter: MateFilter | undefined = undefined;
+  private mateEligible: ((candidate: Agent) => boolean) | undefined = undefined;
+  private mateBest: Agent | null = null;
+  private mateBestDistSq: number = Infinity;
+
+  // Dead agents awaiting reuse as offspring (only when recycleAgents is set)
+  private pool: AgentPool;
+
+  // Shared callbacks, so registering an agent allocates no closures
+  private readonly deathHandler = (agent: Agent): void => this.handleAgentDeath(agent);
+  private readonly reproduceHandler = (parent: Agent, offspring: Agent): void =>
+    this.handleAgentReproduce(parent, offspring);
+
   private stats = {
     totalSpawned: 0,
     totalDied: 0,
@@ -75,12 +144,26 @@ export class AgentManager {
     this.worldHeight = worldHeight;
     this.config = { ...DEFAULT_AGENT_MANAGER_CONFIG, ...config };
     this.lineageTracker = lineageRegistry;
+    this.index = new SpatialHash<Agent>({
+      cellSize: this.config.spatialCellSize,
+      worldWidth,
+      worldHeight,
+      wrapEdges: true,
+    });
+    this.pool = new AgentPool({ maxSize: this.config.agentPoolSize });
+    this.recurrentStates = new RecurrentStateBuffer({ shared: this.config.sharedRecurrentState });
+    this.deadAgents = new RingBuffer<DeadAgentSlot>(this.config.deadAgentCapacity);
   }
 
   initialize(): void {
+    this.disposeAgents();
     this.agents.clear();
-    this.deadAgents.clear();
+    this.clearDeadAgents();
+    this.pool.clear();
+    this.releaseSpatialIndex();
+    this.resetSlots();
     this.idCounter = 0;
+    this.tick = 0;
     this.stats = {
       totalSpawned: 0,
       totalDied: 0,
@@ -100,19 +183,20 @@ export class AgentManager {
       return null;
     }
 
-    const id = `agent_${this.idCounter++}`;
+    const index = this.idCounter++;
+    const id = `agent_${index}`;
     const position = options.position ?? this.getRandomPosition();
     const rotation = Math.random() * Math.PI * 2;
     const energy = options.energy ?? this.config.agentConfig.maxEnergy * 0.7;
 
-    // Create brain
-    const brain = options.brain ?? this.createDefaultBrain();
-
     // Create genome
     const genome = options.genome ?? Genome.forNeuralNetwork(this.config.networkLayers);
 
+    // Create brain
+    const brain = options.brain ?? this.createDefaultBrain(genome);
+
     // Determine species and lineage
-    const speciesId = options.speciesId ?? 'species_0';
+    const speciesId = options.speciesId ?? `species_${index % Math.max(1, this.config.speciesCount)}`;
     const lineageId = options.lineageId ?? `lineage_${id}`;
     const generation = options.generation ?? 0;
 
@@ -130,10 +214,11 @@ export class AgentManager {
     );
 
     // Set up callbacks
-    agent.onDeath = (a) => this.handleAgentDeath(a);
-    agent.onReproduce = (parent, offspring) => this.handleAgentReproduce(parent, offspring);
+    this.attachCallbacks(agent);
 
+    this.assignSlot(agent);
     this.agents.set(id, agent);
+    if (this.indexed) this.index.insert(agent);
     this.stats.totalSpawned++;
 
     if (generation > this.stats.maxGenerationReached) {
@@ -144,8 +229,24 @@ export class AgentManager {
     return agent;
   }
 
-  private createDefaultBrain(): Brain {
-    const [inputSize, ...rest] = this.config.networkLayers;
+  /**
+   * Layer lists with more than one hidden layer get an MLPBrain whose
+   * weights are read from the genome; shallower lists keep NeuralBrain.
+   * brainType 'recurrent' uses the first hidden layer size as state size.
+   */
+  private createDefaultBrain(genome: Genome): Brain {
+    const layers = this.config.networkLayers;
+    if (this.config.brainType === RECURRENT_BRAIN_TYPE) {
+      return new RecurrentBrain({ hiddenSize: layers[1], mutationRate: 0.1, mutationStrength: 0.3 });
+    }
+    if (layers.length > 3) {
+      const config = { layers, mutationRate: 0.1, mutationStrength: 0.3 };
+      return genome.size >= multiLayerWeightCount(layers)
+        ? MLPBrain.fromGenome(genome, config)
+        : new MLPBrain(config);
+    }
+
+    const [inputSize, ...rest] = layers;
     const outputSize = rest[rest.length - 1];
     const hiddenSize = rest.length > 1 ? rest[0] : inputSize;
 
@@ -165,9 +266,21 @@ export class AgentManager {
     };
   }
 
+  private attachCallbacks(agent: Agent): void {
+    agent.onDeath = this.deathHandler;
+    agent.onReproduce = this.reproduceHandler;
+    agent.pool = this.config.recycleAgents ? this.pool : undefined;
+  }
+
   private handleAgentDeath(agent: Agent): void {
     this.stats.totalDied++;
-    this.deadAgents.set(agent.id, { agent, diedAt: Date.now() });
+    const record = this.spareRecords.pop() ?? { agent, diedAt: 0 };
+    record.agent = agent;
+    record.diedAt = this.tick;
+    this.changes?.death(agent.slot, agent.id);
+
+    const evicted = this.deadAgents.push(record);
+    if (evicted) this.expireDeadAgent(evicted);
     this.onAgentDeath?.(agent);
   }
 
@@ -175,9 +288,10 @@ export class AgentManager {
     this.stats.totalReproduced++;
 
     // Register offspring
-    offspring.onDeath = (a) => this.handleAgentDeath(a);
-    offspring.onReproduce = (p, o) => this.handleAgentReproduce(p, o);
+    this.attachCallbacks(offspring);
+    this.assignSlot(offspring);
     this.agents.set(offspring.id, offspring);
+    if (this.indexed) this.index.insert(offspring);
     this.stats.totalSpawned++;
 
     if (offspring.generation > this.stats.maxGenerationReached) {
@@ -198,7 +312,10 @@ export class AgentManager {
     this.onAgentSpawn?.(offspring);
   }
 
-  update(_currentTick: number): void {
+  update(currentTick: number): void {
+    this.invalidateSpatialIndex();
+    this.tick = currentTick;
+
     // Remove dead agents from main map
     const toRemove: string[] = [];
     for (const [id, agent] of this.agents) {
@@ -207,6 +324,7 @@ export class AgentManager {
       }
     }
     for (const id of toRemove) {
+      this.releaseSlot(this.agents.get(id)!);
       this.agents.delete(id);
     }
 
@@ -220,12 +338,125 @@ export class AgentManager {
 
     // Clean up old dead agents
     const maxDeadAge = this.config.respawnDelay * 2;
-    const now = Date.now();
-    for (const [id, { diedAt }] of this.deadAgents) {
-      if (now - diedAt > maxDeadAge) {
-        this.deadAgents.delete(id);
+    for (let oldest = this.deadAgents.get(0); oldest; oldest = this.deadAgents.get(0)) {
+      if (currentTick - oldest.diedAt <= maxDeadAge) break;
+      this.expireDeadAgent(this.deadAgents.shift()!);
+    }
+
+    // Deaths from here on happen during the next tick
+    this.tick = currentTick + 1;
+  }
+
+  // Agents dropped without dying still release their external rows
+  private disposeAgents(): void {
+    for (const agent of this.agents.values()) {
+      if (agent.alive()) agent.dispose();
+    }
+  }
+
+  private expireDeadAgent(record: DeadAgentSlot): void {
+    if (record.agent) this.recycle(record.agent);
+    record.agent = null;
+    this.spareRecords.push(record);
+  }
+
+  private clearDeadAgents(): void {
+    while (this.deadAgents.length > 0) {
+      const record = this.deadAgents.shift()!;
+      record.agent = null;
+      this.spareRecords.push(record);
+    }
+  }
+
+  /**
+   * Recently dead agents still within retention, oldest first
+   */
+  getDeadAgents(): DeadAgentRecord[] {
+    return this.deadAgents.toArray().map(({ agent, diedAt }) => ({ agent: agent!, diedAt }));
+  }
+
+  getDeadAgentCount(): number {
+    return this.deadAgents.length;
+  }
+
+  // Subclassed agents carry extra state and are never pooled
+  private recycle(agent: Agent): void {
+    if (!this.config.recycleAgents || agent.constructor !== Agent) return;
+    if (this.agents.get(agent.id) === agent) return;
+    this.pool.release(agent);
+  }
+
+  getAgentPool(): AgentPool {
+    return this.pool;
+  }
+
+  /**
+   * Upper bound on agent slots handed out so far (for sizing columns)
+   */
+  getSlotCapacity(): number {
+    return this.nextSlot;
+  }
+
+  /**
+   * Hidden state of recurrent brains, one row per agent slot
+   */
+  getRecurrentStates(): RecurrentStateBuffer {
+    return this.recurrentStates;
+  }
+
+  /**
+   * Start recording per-slot changes, spawns and deaths (see
+   * collectChanges). Agents already present are reported as spawned.
+   */
+  trackChanges(): ChangeTracker {
+    if (!this.changes) {
+      this.changes = new ChangeTracker(Math.max(1, this.nextSlot));
+      for (const agent of this.agents.values()) {
+        this.changes.spawn(agent.slot, agent.id);
+      }
+    }
+    return this.changes;
+  }
+
+  isTrackingChanges(): boolean {
+    return this.changes !== null;
+  }
+
+  /**
+   * Sweep living slots for position, energy and alive changes (O(agents);
+   * skipped when `sweep` is false), then move everything recorded since
+   * the last call into `out`. Spawns, deaths and released slots are
+   * recorded as they happen and need no sweep.
+   */
+  collectChanges(out?: ChangeSet, sweep: boolean = true): ChangeSet {
+    const changes = this.trackChanges();
+    if (sweep) {
+      for (const agent of this.agents.values()) {
+        changes.observe(agent.slot, agent.position.x, agent.position.y, agent.energy, agent.alive());
       }
     }
+    return changes.take(out);
+  }
+
+  private assignSlot(agent: Agent): void {
+    agent.slot = this.freeSlots.length > 0 ? this.freeSlots.pop()! : this.nextSlot++;
+    agent.brain.bindState?.(this.recurrentStates, agent.slot);
+    this.changes?.spawn(agent.slot, agent.id);
+  }
+
+  private releaseSlot(agent: Agent): void {
+    if (agent.slot < 0) return;
+    agent.brain.bindState?.(null, -1);
+    this.changes?.release(agent.slot);
+    this.freeSlots.push(agent.slot);
+    agent.slot = -1;
+  }
+
+  private resetSlots(): void {
+    this.freeSlots = [];
+    this.nextSlot = 0;
+    this.recurrentStates.clear();
+    this.changes?.reset();
   }
 
   getAgent(id: string): Agent | undefined {
@@ -236,6 +467,13 @@ export class AgentManager {
     return Array.from(this.agents.values());
   }
 
+  /**
+   * Iterate all agents without building an array
+   */
+  iterateAgents(): IterableIterator<Agent> {
+    return this.agents.values();
+  }
+
   getAliveAgents(): Agent[] {
     return Array.from(this.agents.values()).filter(a => a.alive());
   }
@@ -252,24 +490,158 @@ export class AgentManager {
     return count;
   }
 
+  // ==========================================================================
+  // Spatial Queries
+  // ==========================================================================
+
+  /**
+   * Index current agent positions. Proximity queries use the index until
+   * invalidateSpatialIndex() is called; build it after movement for the tick
+   * is done, or keep it current with updateSpatialIndex() as agents move.
+   * Agents spawned while indexed are added to it. The engine shares this
+   * index with the trophic phase, so it is built at most once per set of
+   * positions in a tick.
+   */
+  buildSpatialIndex(): void {
+    this.index.clear();
+    for (const agent of this.agents.values()) {
+      if (agent.alive()) this.index.insert(agent);
+    }
+    this.indexed = true;
+  }
+
+  /**
+   * Fall back to linear scans until the index is rebuilt. Cells keep their
+   * entries until the next build, for readers of getSpatialIndex().
+   */
+  invalidateSpatialIndex(): void {
+    this.indexed = false;
+  }
+
+  /**
+   * Re-bucket an agent that moved while the index is built (per-agent
+   * action processing moves agents one at a time)
+   */
+  updateSpatialIndex(agent: Agent): void {
+    if (this.indexed) this.index.update(agent);
+  }
+
+  isSpatiallyIndexed(): boolean {
+    return this.indexed;
+  }
+
+  /**
+   * The agent index itself (live, not a copy). Current only while
+   * isSpatiallyIndexed() is true.
+   */
+  getSpatialIndex(): SpatialHash<Agent> {
+    return this.index;
+  }
+
+  /**
+   * Nearest living agent within radius that the filter accepts as a mate
+   * (ties by id). One pass over the neighbours: the filter only runs on a
+   * candidate nearer than the best accepted so far, so an expensive check
+   * such as ReproductiveIsolation.canMate is skipped for most of them.
+   */
+  findNearestMate(
+    agent: Agent,
+    radius: number,
+    filter?: MateFilter,
+    eligible?: (candidate: Agent) => boolean
+  ): Agent | null {
+    this.mateSeeker = agent;
+    this.mateFilter = filter;
+    this.mateEligible = eligible;
+    this.mateBest = null;
+    this.mateBestDistSq = Infinity;
+
+    this.forEachNear(agent.position.x, agent.position.y, radius, this.visitMate);
+
+    const mate = this.mateBest;
+    this.mateSeeker = null;
+    this.mateFilter = undefined;
+    this.mateEligible = undefined;
+    this.mateBest = null;
+    return mate;
+  }
+
+  /**
+   * Visitor for findNearestMate. Bound once so the search allocates nothing.
+   */
+  private visitMate = (candidate: Agent, distSq: number): void => {
+    const agent = this.mateSeeker!;
+    if (candidate === agent) return;
+
+    const best = this.mateBest;
+    if (
+      best &&
+      (distSq > this.mateBestDistSq ||
+        (distSq === this.mateBestDistSq && candidate.id >= best.id))
+    ) {
+      return;
+    }
+    if (this.mateEligible && !this.mateEligible(candidate)) return;
+    if (this.mateFilter && !this.mateFilter(agent, candidate)) return;
+
+    this.mateBest = candidate;
+    this.mateBestDistSq = distSq;
+  };
+
   getAgentsNear(x: number, y: number, radius: number): Agent[] {
     const result: Agent[] = [];
+    this.forEachNear(x, y, radius, (agent) => {
+      result.push(agent);
+    });
+    return result;
+  }
+
+  /**
+   * Visit living agents within radius: through the index when built,
+   * otherwise by scanning every agent. Both measure across wrapped edges.
+   */
+  private forEachNear(
+    x: number,
+    y: number,
+    radius: number,
+    visitor: (agent: Agent, distanceSq: number) => void
+  ): void {
+    if (this.indexed) {
+      this.index.forEachInRadius(x, y, radius, (agent, distSq) => {
+        if (agent.alive()) visitor(agent, distSq);
+      });
+      return;
+    }
+
     const radiusSq = radius * radius;
 
     for (const agent of this.agents.values()) {
       if (!agent.alive()) continue;
 
-      const dx = agent.position.x - x;
-      const dy = agent.position.y - y;
-      if (dx * dx + dy * dy <= radiusSq) {
-        result.push(agent);
+      const distSq = this.wrappedDistanceSq(x, y, agent.position);
+      if (distSq <= radiusSq) {
+        visitor(agent, distSq);
       }
     }
-
-    return result;
   }
 
+  /**
+   * Nearest living agent, optionally within maxRadius. When indexed and no
+   * radius is given, searches rings of doubling radius: an agent nearer
+   * than the first hit lies inside that ring too. Past the farthest wrapped
+   * distance it falls back to the scan.
+   */
   getClosestAgent(x: number, y: number, excludeId?: string, maxRadius?: number): Agent | null {
+    if (this.indexed) {
+      if (maxRadius) return this.closestIndexed(x, y, maxRadius, excludeId);
+
+      const farthest = Math.hypot(this.worldWidth / 2, this.worldHeight / 2);
+      for (let radius = this.config.spatialCellSize; radius < farthest; radius *= 2) {
+        const closest = this.closestIndexed(x, y, radius, excludeId);
+        if (closest) return closest;
+      }
+    }
+
     let closest: Agent | null = null;
     let closestDistSq = maxRadius ? maxRadius * maxRadius : Infinity;
 
@@ -277,9 +649,7 @@ export class AgentManager {
       if (!agent.alive()) continue;
       if (excludeId && agent.id === excludeId) continue;
 
-      const dx = agent.position.x - x;
-      const dy = agent.position.y - y;
-      const distSq = dx * dx + dy * dy;
+      const distSq = this.wrappedDistanceSq(x, y, agent.position);
 
       if (distSq < closestDistSq) {
         closest = agent;
@@ -290,6 +660,45 @@ export class AgentManager {
     return closest;
   }
 
+  private closestIndexed(x: number, y: number, radius: number, excludeId?: string): Agent | null {
+    let closest: Agent | null = null;
+    let closestDistSq = radius * radius;
+    this.index.forEachInRadius(x, y, radius, (agent, distSq) => {
+      if (!agent.alive() || (excludeId && agent.id === excludeId)) return;
+      if (distSq < closestDistSq) {
+        closest = agent;
+        closestDistSq = distSq;
+      }
+    });
+    return closest;
+  }
+
+  /**
+   * Squared distance across wrapped world edges, as the index measures it
+   */
+  private wrappedDistanceSq(x: number, y: number, position: Position): number {
+    let dx = position.x - x;
+    let dy = position.y - y;
+    const halfWidth = this.worldWidth / 2;
+    const halfHeight = this.worldHeight / 2;
+
+    if (dx > halfWidth) dx -= this.worldWidth;
+    else if (dx < -halfWidth) dx += this.worldWidth;
+
+    if (dy > halfHeight) dy -= this.worldHeight;
+    else if (dy < -halfHeight) dy += this.worldHeight;
+
+    return dx * dx + dy * dy;
+  }
+
+  /**
+   * Drop the index and its entries (reset and load)
+   */
+  private releaseSpatialIndex(): void {
+    this.index.clear();
+    this.indexed = false;
+  }
+
   getAgentsBySpecies(speciesId: string): Agent[] {
     return Array.from(this.agents.values()).filter(a => a.speciesId === speciesId);
   }
@@ -310,6 +719,7 @@ export class AgentManager {
     const agent = this.agents.get(id);
     if (agent) {
       if (agent.alive()) agent.die();
+      this.releaseSlot(agent);
       this.agents.delete(id);
       return true;
     }
@@ -319,9 +729,14 @@ export class AgentManager {
   clear(): void {
     for (const agent of this.agents.values()) {
       if (agent.alive()) agent.die();
+      agent.brain.bindState?.(null, -1);
+      agent.slot = -1;
     }
     this.agents.clear();
-    this.deadAgents.clear();
+    this.clearDeadAgents();
+    this.pool.clear();
+    this.releaseSpatialIndex();
+    this.resetSlots();
   }
 
   getStats() {
@@ -392,9 +807,9 @@ export class AgentManager {
     }
 
     // Set up callbacks
-    agent.onDeath = (a) => this.handleAgentDeath(a);
-    agent.onReproduce = (parent, offspring) => this.handleAgentReproduce(parent, offspring);
+    this.attachCallbacks(agent);
 
+    this.assignSlot(agent);
     this.agents.set(id, agent);
 
     // Update id counter to avoid collisions
@@ -414,9 +829,14 @@ export class AgentManager {
    * Reset manager without triggering death callbacks (for loading)
    */
   clearForRestore(): void {
+    this.disposeAgents();
     this.agents.clear();
-    this.deadAgents.clear();
+    this.clearDeadAgents();
+    this.pool.clear();
+    this.releaseSpatialIndex();
+    this.resetSlots();
     this.idCounter = 0;
+    this.tick = 0;
     this.stats = {
       totalSpawned: 0,
       totalDied: 0,
@@ -0,0 +1,256 @@
+/**
+ * ChangeTracker.ts - Per-slot dirty bits with spawn and death lists
+ *
+ * AgentManager and FoodManager each create one when change tracking is
+ * switched on (trackChanges()). Slots are agent slots or food store rows.
+ *
+ * Spawns, deaths and released slots are recorded as they happen. Position,
+ * energy and alive changes are found by observe(), which compares an entity
+ * with the float32 values seen at its previous sweep. That catches writes
+ * from anywhere (phases, restores, plain field writes) without touching the
+ * hot paths, and ignores changes too small to show in a float32 frame.
+ * A sweep costs O(live entities); the Observer runs one per tick.
+ *
+ * take() hands out everything recorded since the previous take and clears it.
+ */
+
+// ============================================================================
+// Change Bits
+// ============================================================================
+
+export const CHANGE_POSITION = 1;
+export const CHANGE_ENERGY = 2;
+export const CHANGE_ALIVE = 4;
+export const CHANGE_ALL = CHANGE_POSITION | CHANGE_ENERGY | CHANGE_ALIVE;
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * Changes since the previous take(). Arrays are parallel per kind.
+ */
+export interface ChangeSet {
+  slots: number[];        // Slots with dirty bits
+  bits: number[];         // CHANGE_* for each entry of slots
+  spawnIds: string[];
+  spawnSlots: number[];
+  deathIds: string[];
+  deathSlots: number[];
+  reset: boolean;         // Tracking restarted; earlier slot contents are void
+}
+
+export function createChangeSet(): ChangeSet {
+  return {
+    slots: [],
+    bits: [],
+    spawnIds: [],
+    spawnSlots: [],
+    deathIds: [],
+    deathSlots: [],
+    reset: false,
+  };
+}
+
+// ============================================================================
+// ChangeTracker Class
+// ============================================================================
+
+export class ChangeTracker {
+  private capacity: number;
+  private dirty: Uint8Array;
+  private dirtySlots: number[] = [];
+
+  // Values at the previous observe(); NaN / 2 force a change on first sight
+  private xs: Float32Array;
+  private ys: Float32Array;
+  private energies: Float32Array;
+  private alive: Uint8Array;
+
+  private ids: string[] = [];
+  private pending: ChangeSet = createChangeSet();
+
+  constructor(initialSlots: number = 256) {
+    this.capacity = Math.max(1, initialSlots);
+    this.dirty = new Uint8Array(this.capacity);
+    this.xs = new Float32Array(this.capacity).fill(NaN);
+    this.ys = new Float32Array(this.capacity).fill(NaN);
+    this.energies = new Float32Array(this.capacity).fill(NaN);
+    this.alive = new Uint8Array(this.capacity).fill(2);
+  }
+
+  /**
+   * Set dirty bits on a slot
+   */
+  mark(slot: number, bits: number): void {
+    if (slot < 0) return;
+    this.ensure(slot);
+    if (this.dirty[slot] === 0) this.dirtySlots.push(slot);
+    this.dirty[slot] |= bits;
+  }
+
+  /**
+   * Compare a slot's entity with its previous sweep and mark what changed
+   */
+  observe(slot: number, x: number, y: number, energy: number, alive: boolean): void {
+    if (slot < 0) return;
+    this.ensure(slot);
+    let bits = 0;
+
+    const fx = Math.fround(x);
+    const fy = Math.fround(y);
+    if (fx !== this.xs[slot] || fy !== this.ys[slot]) {
+      this.xs[slot] = fx;
+      this.ys[slot] = fy;
+      bits |= CHANGE_POSITION;
+    }
+    const fe = Math.fround(energy);
+    if (fe !== this.energies[slot]) {
+      this.energies[slot] = fe;
+      bits |= CHANGE_ENERGY;
+    }
+    const a = alive ? 1 : 0;
+    if (a !== this.alive[slot]) {
+      this.alive[slot] = a;
+      bits |= CHANGE_ALIVE;
+    }
+
+    if (bits !== 0) this.mark(slot, bits);
+  }
+
+  /**
+   * A new entity took the slot
+   */
+  spawn(slot: number, id: string): void {
+    if (slot < 0) return;
+    this.forget(slot);
+    this.ids[slot] = id;
+    this.pending.spawnIds.push(id);
+    this.pending.spawnSlots.push(slot);
+    this.mark(slot, CHANGE_ALL);
+  }
+
+  /**
+   * The entity in the slot died (or, for food, was removed)
+   */
+  death(slot: number, id: string): void {
+    this.pending.deathIds.push(id);
+    this.pending.deathSlots.push(slot);
+    this.mark(slot, CHANGE_ALIVE);
+  }
+
+  /**
+   * The slot no longer holds an entity
+   */
+  release(slot: number): void {
+    if (slot < 0 || slot >= this.capacity) return;
+    this.forget(slot);
+    this.ids[slot] = '';
+    this.mark(slot, CHANGE_ALIVE);
+  }
+
+  /**
+   * Id of the entity in a slot, '' when empty
+   */
+  idAt(slot: number): string {
+    return this.ids[slot] ?? '';
+  }
+
+  /**
+   * Drop everything; the next take() reports reset
+   */
+  reset(): void {
+    for (const slot of this.dirtySlots) this.dirty[slot] = 0;
+    this.dirtySlots.length = 0;
+    this.xs.fill(NaN);
+    this.ys.fill(NaN);
+    this.energies.fill(NaN);
+    this.alive.fill(2);
+    this.ids = [];
+    this.pending = createChangeSet();
+    this.pending.reset = true;
+  }
+
+  /**
+   * Move recorded changes into `out` (cleared first) and start over
+   */
+  take(out: ChangeSet = createChangeSet()): ChangeSet {
+    const pending = this.pending;
+    out.slots.length = 0;
+    out.bits.length = 0;
+    for (const slot of this.dirtySlots) {
+      out.slots.push(slot);
+      out.bits.push(this.dirty[slot]);
+      this.dirty[slot] = 0;
+    }
+    this.dirtySlots.length = 0;
+
+    copyInto(out.spawnIds, pending.spawnIds);
+    copyInto(out.spawnSlots, pending.spawnSlots);
+    copyInto(out.deathIds, pending.deathIds);
+    copyInto(out.deathSlots, pending.deathSlots);
+    out.reset = pending.reset;
+
+    pending.spawnIds.length = 0;
+    pending.spawnSlots.length = 0;
+    pending.deathIds.length = 0;
+    pending.deathSlots.length = 0;
+    pending.reset = false;
+    return out;
+  }
+
+  /**
+   * True when nothing has been recorded since the last take()
+   */
+  isClean(): boolean {
+    const pending = this.pending;
+    return (
+      this.dirtySlots.length === 0 &&
+      pending.spawnIds.length === 0 &&
+      pending.deathIds.length === 0 &&
+      !pending.reset
+    );
+  }
+
+  memoryUsage(): number {
+    return this.capacity * (1 + 4 * 3 + 1);
+  }
+
+  private forget(slot: number): void {
+    this.ensure(slot);
+    this.xs[slot] = NaN;
+    this.ys[slot] = NaN;
+    this.energies[slot] = NaN;
+    this.alive[slot] = 2;
+  }
+
+  private ensure(slot: number): void {
+    if (slot < this.capacity) return;
+    let capacity = this.capacity;
+    while (capacity <= slot) capacity *= 2;
+
+    const growF32 = (src: Float32Array) => {
+      const dst = new Float32Array(capacity).fill(NaN);
+      dst.set(src);
+      return dst;
+    };
+    this.xs = growF32(this.xs);
+    this.ys = growF32(this.ys);
+    this.energies = growF32(this.energies);
+
+    const alive = new Uint8Array(capacity).fill(2);
+    alive.set(this.alive);
+    this.alive = alive;
+
+    const dirty = new Uint8Array(capacity);
+    dirty.set(this.dirty);
+    this.dirty = dirty;
+
+    this.capacity = capacity;
+  }
+}
+
+function copyInto<T>(dst: T[], src: T[]): void {
+  dst.length = src.length;
+  for (let i = 0; i < src.length; i++) dst[i] = src[i];
+}
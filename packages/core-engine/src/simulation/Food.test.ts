@@ -0,0 +1,155 @@
+/**
+ * Food.test.ts - Tests for food storage, decay and respawn scheduling
+ */
+
+import { describe, it, expect } from 'vitest';
+import { Food, FoodManager, FoodStore } from './Food';
+import { CHANGE_ALIVE, CHANGE_ENERGY } from './ChangeTracker';
+
+function manager(overrides: Record<string, unknown> = {}, food: Record<string, number> = {}) {
+  return new FoodManager(100, 100, {
+    initialCount: 5,
+    maxCount: 10,
+    spawnRate: 0,
+    clusteringFactor: 0,
+    foodConfig: { energyValue: 20, respawnDelay: 10, decayRate: 0, ...food },
+    ...overrides,
+  });
+}
+
+describe('Food', () => {
+  it('should decay lazily and expire on update', () => {
+    const food = new Food('f', 10, 10, { energyValue: 10, decayRate: 4 });
+
+    food.update(2);
+    expect(food.energy).toBe(2);
+    expect(food.isConsumed).toBe(false);
+
+    food.update(3);
+    expect(food.isConsumed).toBe(true);
+    expect(food.energy).toBe(0);
+    expect(food.consumedAt).toBe(3);
+  });
+
+  it('should round-trip through JSON', () => {
+    const food = new Food('f', 1, 2, { energyValue: 15 });
+    food.consume(7);
+
+    const restored = Food.fromJSON(food.toJSON());
+    expect(restored.toJSON()).toEqual(food.toJSON());
+    expect(restored.canRespawn(7 + 100)).toBe(true);
+  });
+});
+
+describe('FoodStore', () => {
+  it('should keep a dense active list', () => {
+    const store = new FoodStore(2);
+    const rows = [0, 1, 2, 3].map(i => store.allocate(i, i, 10, 0, 0));
+
+    store.consume(rows[1], 0);
+    expect(store.activeCount).toBe(3);
+
+    const active = new Set<number>();
+    for (let i = 0; i < store.activeCount; i++) active.add(store.getActiveRow(i));
+    expect(active).toEqual(new Set([rows[0], rows[2], rows[3]]));
+
+    store.release(rows[0]);
+    expect(store.activeCount).toBe(2);
+    expect(store.allocate(9, 9, 10, 0, 0)).toBe(rows[0]);
+  });
+});
+
+describe('FoodManager', () => {
+  it('should respawn consumed food after the delay', () => {
+    const fm = manager();
+    fm.initialize();
+    fm.update(0);
+
+    const [food] = fm.getAllFood();
+    expect(fm.consumeFood(food.id, 0)).toBe(20);
+    expect(fm.getActiveCount()).toBe(4);
+
+    for (let t = 1; t < 10; t++) fm.update(t);
+    expect(food.isConsumed).toBe(true);
+
+    fm.update(10);
+    expect(food.isConsumed).toBe(false);
+    expect(food.energy).toBe(20);
+    expect(fm.getActiveCount()).toBe(5);
+    expect(fm.getStats().totalRespawned).toBe(1);
+  });
+
+  it('should expire decaying food without per-tick scans', () => {
+    const fm = manager({}, { decayRate: 5, respawnDelay: 0 });
+    fm.initialize();
+
+    for (let t = 0; t < 4; t++) fm.update(t);
+    expect(fm.getActiveCount()).toBe(5);
+    expect(fm.getAllFood()[0].energy).toBe(5);
+
+    fm.update(4);
+    expect(fm.getActiveCount()).toBe(0);
+    expect(fm.getStats().totalDecayed).toBe(5);
+  });
+
+  it('should ignore a pending respawn for removed food', () => {
+    const fm = manager();
+    fm.initialize();
+    fm.update(0);
+
+    const [food] = fm.getAllFood();
+    fm.consumeFood(food.id, 0);
+    fm.removeFood(food.id);
+    const replacement = fm.spawnFood(1, 50, 50)!;
+
+    for (let t = 1; t <= 10; t++) fm.update(t);
+    expect(replacement.isConsumed).toBe(false);
+    expect(fm.getStats().totalRespawned).toBe(0);
+    expect(food.isConsumed).toBe(true);
+    expect(food.x).not.toBe(50);
+  });
+
+  it('should reschedule restored food against the first update tick', () => {
+    const fm = manager();
+    fm.clearForRestore();
+    fm.restoreFood({ id: 'food_3', x: 5, y: 5, energy: 0, isConsumed: true, consumedAt: 495, spawnedAt: 0 });
+
+    fm.update(500);
+    expect(fm.getActiveCount()).toBe(0);
+    fm.update(505);
+    expect(fm.getActiveCount()).toBe(1);
+    expect(fm.spawnFood(505)!.id).toBe('food_4');
+  });
+
+  it('should find the closest active food', () => {
+    const fm = manager({ initialCount: 0 });
+    fm.initialize();
+    const near = fm.spawnFood(0, 10, 10)!;
+    fm.spawnFood(0, 40, 40);
+    const nearest = fm.spawnFood(0, 12, 12)!;
+    fm.consumeFood(near.id, 0);
+
+    expect(fm.getClosestFood(10, 10)).toBe(nearest);
+    expect(fm.getClosestFood(80, 80, 5)).toBeNull();
+    expect(fm.getFoodNear(10, 10, 10)).toEqual([nearest]);
+  });
+
+  it('should track consumed and removed food by row', () => {
+    const fm = manager();
+    fm.initialize();
+    fm.update(0);
+    expect(fm.collectChanges().spawnIds).toHaveLength(5);
+
+    const [eaten, removed] = fm.getAllFood();
+    const removedRow = removed.row;
+    fm.consumeFood(eaten.id, 0);
+    fm.removeFood(removed.id);
+    const changes = fm.collectChanges();
+
+    expect([...changes.slots].sort()).toEqual([eaten.row, removedRow].sort());
+    expect(changes.bits[changes.slots.indexOf(eaten.row)]).toBe(CHANGE_ENERGY | CHANGE_ALIVE);
+    expect(changes.deathIds).toEqual([removed.id]);
+    expect(changes.deathSlots).toEqual([removedRow]);
+    expect(fm.trackChanges().idAt(removedRow)).toBe('');
+  });
+});
@@ -2,8 +2,16 @@
  * Food.ts - Food/Resource system for the simulation
  *
  * Manages food entities that agents can consume for energy.
+ *
+ * Food state lives in a columnar FoodStore; a Food object is a handle onto
+ * one row. Decay is evaluated lazily from the tick energy was last set, and
+ * decay expiry and respawn are driven by a timing wheel, so per-tick upkeep
+ * only touches food with an event due that tick.
  */
 
+import { TimingWheel } from '../utils/TimingWheel';
+import { ChangeTracker, ChangeSet } from './ChangeTracker';
+
 export interface FoodConfig {
   energyValue: number;
   respawnDelay: number; // Ticks before respawning, 0 = no respawn
@@ -28,31 +36,418 @@ export interface FoodState {
   spawnedAt: number;
 }
 
+// ============================================================================
+// Food Store
+// ============================================================================
+
+/**
+ * Structure-of-arrays storage for food rows.
+ *
+ * Keeps a dense list of active (unconsumed) rows for O(1) counting and
+ * random picks. When scheduling is enabled, each row has at most one
+ * pending event in the timing wheel: decay expiry while active, respawn
+ * while consumed. The `due` column holds the deadline of that event, and
+ * anything the wheel reports with a different deadline is stale.
+ */
+export class FoodStore {
+  private capacity: number;
+  private rowCount: number = 0;
+  private freeRows: number[] = [];
+
+  private xs: Float64Array;
+  private ys: Float64Array;
+  private energyBase: Float64Array;    // Energy at energyTick
+  private energyTick: Float64Array;
+  private decayRates: Float64Array;
+  private respawnDelays: Float64Array;
+  private consumed: Uint8Array;
+  private consumedAts: Float64Array;   // NaN = never consumed
+  private due: Float64Array;           // Pending event tick, -1 = none
+
+  private activeRows: Int32Array;
+  private activePos: Int32Array;       // Index into activeRows, -1 = inactive
+  private active: number = 0;
+
+  private wheel: TimingWheel | null;
+  private clock: number = 0;
+
+  constructor(capacity: number = 64, scheduled: boolean = false) {
+    this.capacity = Math.max(1, Math.floor(capacity));
+    this.xs = new Float64Array(this.capacity);
+    this.ys = new Float64Array(this.capacity);
+    this.energyBase = new Float64Array(this.capacity);
+    this.energyTick = new Float64Array(this.capacity);
+    this.decayRates = new Float64Array(this.capacity);
+    this.respawnDelays = new Float64Array(this.capacity);
+    this.consumed = new Uint8Array(this.capacity);
+    this.consumedAts = new Float64Array(this.capacity);
+    this.due = new Float64Array(this.capacity).fill(-1);
+    this.activeRows = new Int32Array(this.capacity);
+    this.activePos = new Int32Array(this.capacity).fill(-1);
+    this.wheel = scheduled ? new TimingWheel(0) : null;
+  }
+
+  /**
+   * Current tick used to evaluate decayed energy
+   */
+  get tick(): number {
+    return this.clock;
+  }
+
+  get activeCount(): number {
+    return this.active;
+  }
+
+  /**
+   * Number of pending respawn/decay events
+   */
+  get pendingEvents(): number {
+    return this.wheel ? this.wheel.size : 0;
+  }
+
+  /**
+   * Row of the i-th active food, 0 <= i < activeCount
+   */
+  getActiveRow(i: number): number {
+    return this.activeRows[i];
+  }
+
+  allocate(
+    x: number,
+    y: number,
+    energy: number,
+    decayRate: number,
+    respawnDelay: number,
+    isConsumed: boolean = false,
+    consumedAt?: number
+  ): number {
+    let row = this.freeRows.pop();
+    if (row === undefined) {
+      if (this.rowCount >= this.capacity) this.grow();
+      row = this.rowCount++;
+    }
+
+    this.xs[row] = x;
+    this.ys[row] = y;
+    this.energyBase[row] = energy;
+    this.energyTick[row] = this.clock;
+    this.decayRates[row] = decayRate;
+    this.respawnDelays[row] = respawnDelay;
+    this.consumed[row] = 1;
+    this.consumedAts[row] = consumedAt ?? NaN;
+    this.activePos[row] = -1;
+    if (!isConsumed) this.activate(row);
+
+    this.reschedule(row);
+    return row;
+  }
+
+  release(row: number): void {
+    if (!this.consumed[row]) this.deactivate(row);
+    this.due[row] = -1;
+    this.freeRows.push(row);
+  }
+
+  getX(row: number): number {
+    return this.xs[row];
+  }
+
+  getY(row: number): number {
+    return this.ys[row];
+  }
+
+  setPosition(row: number, x: number, y: number): void {
+    this.xs[row] = x;
+    this.ys[row] = y;
+  }
+
+  energyAt(row: number, tick: number): number {
+    const base = this.energyBase[row];
+    const rate = this.decayRates[row];
+    if (this.consumed[row] || rate <= 0) return base;
+    const elapsed = tick - this.energyTick[row];
+    return elapsed > 0 ? Math.max(0, base - rate * elapsed) : base;
+  }
+
+  getEnergy(row: number): number {
+    return this.energyAt(row, this.clock);
+  }
+
+  setEnergy(row: number, energy: number): void {
+    this.energyBase[row] = energy;
+    this.energyTick[row] = this.clock;
+    this.reschedule(row);
+  }
+
+  isConsumed(row: number): boolean {
+    return this.consumed[row] === 1;
+  }
+
+  setConsumed(row: number, isConsumed: boolean): void {
+    if (isConsumed === this.isConsumed(row)) return;
+    if (isConsumed) {
+      this.energyBase[row] = this.getEnergy(row);
+      this.deactivate(row);
+    } else {
+      this.energyTick[row] = this.clock;
+      this.activate(row);
+    }
+    this.reschedule(row);
+  }
+
+  getConsumedAt(row: number): number | undefined {
+    const at = this.consumedAts[row];
+    return Number.isNaN(at) ? undefined : at;
+  }
+
+  setConsumedAt(row: number, tick: number | undefined): void {
+    this.consumedAts[row] = tick ?? NaN;
+    this.reschedule(row);
+  }
+
+  /**
+   * Mark a row consumed and return the energy it held at tick
+   */
+  consume(row: number, tick: number): number {
+    if (this.consumed[row]) return 0;
+
+    const energy = this.energyAt(row, tick);
+    this.energyBase[row] = 0;
+    this.consumedAts[row] = tick;
+    this.deactivate(row);
+    this.reschedule(row);
+    return energy;
+  }
+
+  /**
+   * Make a row active again with fresh energy, decaying from the current tick
+   */
+  restore(row: number, energy: number): void {
+    this.energyBase[row] = energy;
+    this.energyTick[row] = this.clock;
+    this.consumedAts[row] = NaN;
+    if (this.consumed[row]) this.activate(row);
+    this.reschedule(row);
+  }
+
+  /**
+   * Apply decay expiry for a single row without the wheel. Returns true if
+   * the row ran out of energy.
+   */
+  sync(row: number, tick: number): boolean {
+    if (tick > this.clock) this.clock = tick;
+    if (this.consumed[row] || this.decayRates[row] <= 0) return false;
+    if (this.energyAt(row, tick) > 0) return false;
+
+    this.expire(row, tick);
+    return true;
+  }
+
+  /**
+   * Advance the clock to tick and fire due events. Rows that run out of
+   * energy are marked consumed before onDecayed is called; onRespawnDue is
+   * responsible for calling restore().
+   */
+  advance(
+    tick: number,
+    onDecayed: (row: number) => void,
+    onRespawnDue: (row: number) => void
+  ): void {
+    if (tick > this.clock) this.clock = tick;
+    if (!this.wheel) return;
+
+    this.wheel.advance(tick, (row, dueTick) => {
+      if (this.due[row] !== dueTick) return;
+      this.due[row] = -1;
+
+      if (this.consumed[row]) {
+        onRespawnDue(row);
+      } else {
+        this.expire(row, dueTick);
+        onDecayed(row);
+      }
+    });
+  }
+
+  /**
+   * Move the clock to tick and recompute every pending event. Used once
+   * after bulk loading, when rows were written before the tick was known.
+   */
+  rebase(tick: number): void {
+    this.clock = tick;
+    if (this.wheel) this.wheel.reset(tick - 1);
+
+    const free = new Uint8Array(this.rowCount);
+    for (const row of this.freeRows) free[row] = 1;
+
+    for (let row = 0; row < this.rowCount; row++) {
+      if (free[row]) continue;
+      this.energyTick[row] = tick;
+      this.reschedule(row);
+    }
+  }
+
+  private expire(row: number, tick: number): void {
+    this.energyBase[row] = 0;
+    this.consumedAts[row] = tick;
+    this.deactivate(row);
+    this.reschedule(row);
+  }
+
+  private activate(row: number): void {
+    this.consumed[row] = 0;
+    this.activePos[row] = this.active;
+    this.activeRows[this.active++] = row;
+  }
+
+  private deactivate(row: number): void {
+    this.consumed[row] = 1;
+    const pos = this.activePos[row];
+    if (pos < 0) return;
+
+    // Swap-remove from the dense active list
+    const last = this.activeRows[--this.active];
+    this.activeRows[pos] = last;
+    this.activePos[last] = pos;
+    this.activePos[row] = -1;
+  }
+
+  private reschedule(row: number): void {
+    this.due[row] = -1;
+    if (!this.wheel) return;
+
+    let due = -1;
+    if (!this.consumed[row]) {
+      const rate = this.decayRates[row];
+      if (rate > 0) {
+        due = this.energyTick[row] + Math.ceil(this.energyBase[row] / rate);
+      }
+    } else {
+      const delay = this.respawnDelays[row];
+      const consumedAt = this.consumedAts[row];
+      if (delay > 0 && !Number.isNaN(consumedAt)) {
+        due = consumedAt + delay;
+      }
+    }
+    if (due < 0) return;
+
+    due = Math.max(due, this.wheel.currentTick + 1);
+    this.due[row] = due;
+    this.wheel.schedule(row, due);
+  }
+
+  private grow(): void {
+    const capacity = this.capacity * 2;
+    const growF64 = (src: Float64Array, fill: number = 0) => {
+      const dst = new Float64Array(capacity);
+      if (fill !== 0) dst.fill(fill);
+      dst.set(src);
+      return dst;
+    };
+
+    this.xs = growF64(this.xs);
+    this.ys = growF64(this.ys);
+    this.energyBase = growF64(this.energyBase);
+    this.energyTick = growF64(this.energyTick);
+    this.decayRates = growF64(this.decayRates);
+    this.respawnDelays = growF64(this.respawnDelays);
+    this.consumedAts = growF64(this.consumedAts);
+    this.due = growF64(this.due, -1);
+
+    const consumed = new Uint8Array(capacity);
+    consumed.set(this.consumed);
+    this.consumed = consumed;
+
+    const activeRows = new Int32Array(capacity);
+    activeRows.set(this.activeRows);
+    this.activeRows = activeRows;
+
+    const activePos = new Int32Array(capacity).fill(-1);
+    activePos.set(this.activePos);
+    this.activePos = activePos;
+
+    this.capacity = capacity;
+  }
+}
+
+// ============================================================================
+// Food
+// ============================================================================
+
 export class Food {
   readonly id: string;
-  x: number;
-  y: number;
-  energy: number;
-  isConsumed: boolean;
-  consumedAt?: number;
   readonly spawnedAt: number;
 
   private config: FoodConfig;
+  private store: FoodStore;
+  private storeRow: number;
 
   constructor(
     id: string,
     x: number,
     y: number,
     config?: Partial<FoodConfig>,
-    spawnedAt: number = 0
+    spawnedAt: number = 0,
+    store?: FoodStore
   ) {
     this.id = id;
-    this.x = x;
-    this.y = y;
     this.config = { ...DEFAULT_FOOD_CONFIG, ...config };
-    this.energy = this.config.energyValue;
-    this.isConsumed = false;
     this.spawnedAt = spawnedAt;
+    this.store = store ?? new FoodStore(1);
+    this.storeRow = this.store.allocate(
+      x,
+      y,
+      this.config.energyValue,
+      this.config.decayRate,
+      this.config.respawnDelay
+    );
+  }
+
+  /**
+   * Row of this food in its store
+   */
+  get row(): number {
+    return this.storeRow;
+  }
+
+  get x(): number {
+    return this.store.getX(this.storeRow);
+  }
+
+  set x(value: number) {
+    this.store.setPosition(this.storeRow, value, this.y);
+  }
+
+  get y(): number {
+    return this.store.getY(this.storeRow);
+  }
+
+  set y(value: number) {
+    this.store.setPosition(this.storeRow, this.x, value);
+  }
+
+  get energy(): number {
+    return this.store.getEnergy(this.storeRow);
+  }
+
+  set energy(value: number) {
+    this.store.setEnergy(this.storeRow, value);
+  }
+
+  get isConsumed(): boolean {
+    return this.store.isConsumed(this.storeRow);
+  }
+
+  set isConsumed(value: boolean) {
+    this.store.setConsumed(this.storeRow, value);
+  }
+
+  get consumedAt(): number | undefined {
+    return this.store.getConsumedAt(this.storeRow);
+  }
+
+  set consumedAt(value: number | undefined) {
+    this.store.setConsumedAt(this.storeRow, value);
   }
 
   get position(): { x: number; y: number } {
@@ -60,49 +455,59 @@ export class Food {
   }
 
   update(currentTick: number): void {
-    if (this.isConsumed) return;
-
-    // Apply decay
-    if (this.config.decayRate > 0) {
-      this.energy -= this.config.decayRate;
-      if (this.energy <= 0) {
-        this.energy = 0;
-        this.isConsumed = true;
-        this.consumedAt = currentTick;
-      }
-    }
+    // Decay is evaluated lazily; this only settles expiry for the tick
+    this.store.sync(this.storeRow, currentTick);
   }
 
   consume(currentTick: number): number {
-    if (this.isConsumed) return 0;
-
-    const energyGained = this.energy;
-    this.energy = 0;
-    this.isConsumed = true;
-    this.consumedAt = currentTick;
-    return energyGained;
+    return this.store.consume(this.storeRow, currentTick);
   }
 
   canRespawn(currentTick: number): boolean {
     if (!this.isConsumed) return false;
     if (this.config.respawnDelay <= 0) return false;
-    if (this.consumedAt === undefined) return false;
+    const consumedAt = this.consumedAt;
+    if (consumedAt === undefined) return false;
 
-    return currentTick - this.consumedAt >= this.config.respawnDelay;
+    return currentTick - consumedAt >= this.config.respawnDelay;
   }
 
   respawn(x?: number, y?: number): void {
-    this.x = x ?? this.x;
-    this.y = y ?? this.y;
-    this.energy = this.config.energyValue;
-    this.isConsumed = false;
-    this.consumedAt = undefined;
+    this.store.setPosition(this.storeRow, x ?? this.x, y ?? this.y);
+    this.store.restore(this.storeRow, this.config.energyValue);
+  }
+
+  /**
+   * Move this food into a private store, releasing its row in the shared one.
+   * Used when the food is removed so the row can be reused safely.
+   */
+  detach(): void {
+    const store = new FoodStore(1);
+    const row = store.allocate(
+      this.x,
+      this.y,
+      this.energy,
+      this.config.decayRate,
+      this.config.respawnDelay,
+      this.isConsumed,
+      this.consumedAt
+    );
+    this.store.release(this.storeRow);
+    this.store = store;
+    this.storeRow = row;
   }
 
   getConfig(): FoodConfig {
     return { ...this.config };
   }
 
+  /**
+   * Energy when fresh, without copying the config (for per-frame readers)
+   */
+  get maxEnergy(): number {
+    return this.config.energyValue;
+  }
+
   toJSON(): FoodState {
     return {
       id: this.id,
@@ -115,8 +520,8 @@ export class Food {
     };
   }
 
-  static fromJSON(state: FoodState, config?: Partial<FoodConfig>): Food {
-    const food = new Food(state.id, state.x, state.y, config, state.spawnedAt);
+  static fromJSON(state: FoodState, config?: Partial<FoodConfig>, store?: FoodStore): Food {
+    const food = new Food(state.id, state.x, state.y, config, state.spawnedAt, store);
     food.energy = state.energy;
     food.isConsumed = state.isConsumed;
     food.consumedAt = state.consumedAt;
@@ -124,6 +529,10 @@ export class Food {
   }
 }
 
+// ============================================================================
+// Food Manager
+// ============================================================================
+
 export interface FoodManagerConfig {
   initialCount: number;
   maxCount: number;
@@ -142,11 +551,17 @@ export const DEFAULT_FOOD_MANAGER_CONFIG: FoodManagerConfig = {
 
 export class FoodManager {
   private foods: Map<string, Food> = new Map();
+  private rows: Array<Food | undefined> = [];   // Food by store row
+  private store: FoodStore;
   private config: FoodManagerConfig;
   private worldWidth: number;
   private worldHeight: number;
   private idCounter: number = 0;
   private spawnAccumulator: number = 0;
+  private needsRebase: boolean = true;
+
+  // Dirty bits and spawn/removal lists by store row, once trackChanges() has been called
+  private changes: ChangeTracker | null = null;
 
   private stats = {
     totalSpawned: 0,
@@ -163,10 +578,11 @@ export class FoodManager {
     this.worldWidth = worldWidth;
     this.worldHeight = worldHeight;
     this.config = { ...DEFAULT_FOOD_MANAGER_CONFIG, ...config };
+    this.store = this.createStore();
   }
 
   initialize(): void {
-    this.foods.clear();
+    this.resetStorage();
     this.idCounter = 0;
     this.spawnAccumulator = 0;
 
@@ -177,34 +593,35 @@ export class FoodManager {
   }
 
   update(currentTick: number): void {
-
-    // Update all food
-    for (const food of this.foods.values()) {
-      if (!food.isConsumed) {
-        food.update(currentTick);
-        if (food.isConsumed) {
-          this.stats.totalDecayed++;
-        }
-      }
+    if (this.needsRebase) {
+      this.store.rebase(currentTick);
+      this.needsRebase = false;
     }
 
-    // Handle respawning
-    for (const food of this.foods.values()) {
-      if (food.canRespawn(currentTick)) {
-        const pos = this.getSpawnPosition();
-        food.respawn(pos.x, pos.y);
-        this.stats.totalRespawned++;
-      }
-    }
+    // Fire decay expiries and respawns due by this tick
+    this.store.advance(currentTick, this.onDecayed, this.onRespawnDue);
 
     // Spawn new food based on spawn rate
     this.spawnAccumulator += this.config.spawnRate;
-    while (this.spawnAccumulator >= 1 && this.getActiveCount() < this.config.maxCount) {
+    while (this.spawnAccumulator >= 1 && this.store.activeCount < this.config.maxCount) {
       this.spawnFood(currentTick);
       this.spawnAccumulator -= 1;
     }
   }
 
+  private onDecayed = (_row: number): void => {
+    this.stats.totalDecayed++;
+  };
+
+  private onRespawnDue = (row: number): void => {
+    const food = this.rows[row];
+    if (!food) return;
+
+    const pos = this.getSpawnPosition();
+    food.respawn(pos.x, pos.y);
+    this.stats.totalRespawned++;
+  };
+
   spawnFood(currentTick: number, x?: number, y?: number): Food | null {
     if (this.foods.size >= this.config.maxCount) return null;
 
@@ -213,8 +630,8 @@ export class FoodManager {
       : this.getSpawnPosition();
 
     const id = `food_${this.idCounter++}`;
-    const food = new Food(id, pos.x, pos.y, this.config.foodConfig, currentTick);
-    this.foods.set(id, food);
+    const food = new Food(id, pos.x, pos.y, this.config.foodConfig, currentTick, this.store);
+    this.track(food);
     this.stats.totalSpawned++;
     return food;
   }
@@ -230,14 +647,16 @@ export class FoodManager {
 
     // Cluster around existing food
     if (Math.random() < this.config.clusteringFactor) {
-      const activeFoods = this.getActiveFood();
-      if (activeFoods.length > 0) {
-        const center = activeFoods[Math.floor(Math.random() * activeFoods.length)];
+      const activeCount = this.store.activeCount;
+      if (activeCount > 0) {
+        const center = this.store.getActiveRow(Math.floor(Math.random() * activeCount));
         const radius = 20 + Math.random() * 30;
         const angle = Math.random() * Math.PI * 2;
+        const cx = this.store.getX(center);
+        const cy = this.store.getY(center);
         return {
-          x: ((center.x + Math.cos(angle) * radius) % this.worldWidth + this.worldWidth) % this.worldWidth,
-          y: ((center.y + Math.sin(angle) * radius) % this.worldHeight + this.worldHeight) % this.worldHeight,
+          x: ((cx + Math.cos(angle) * radius) % this.worldWidth + this.worldWidth) % this.worldWidth,
+          y: ((cy + Math.sin(angle) * radius) % this.worldHeight + this.worldHeight) % this.worldHeight,
         };
       }
     }
@@ -263,33 +682,52 @@ export class FoodManager {
     return this.foods.get(id);
   }
 
+  /**
+   * Food stored at a FoodStore row (see Food.row)
+   */
+  getFoodByRow(row: number): Food | undefined {
+    return this.rows[row];
+  }
+
   getAllFood(): Food[] {
     return Array.from(this.foods.values());
   }
 
+  /**
+   * Iterate all food without building an array
+   */
+  iterateFood(): IterableIterator<Food> {
+    return this.foods.values();
+  }
+
+  getFoodCount(): number {
+    return this.foods.size;
+  }
+
   getActiveFood(): Food[] {
-    return Array.from(this.foods.values()).filter(f => !f.isConsumed);
+    const count = this.store.activeCount;
+    const result: Food[] = new Array(count);
+    for (let i = 0; i < count; i++) {
+      result[i] = this.rows[this.store.getActiveRow(i)] as Food;
+    }
+    return result;
   }
 
   getActiveCount(): number {
-    let count = 0;
-    for (const food of this.foods.values()) {
-      if (!food.isConsumed) count++;
-    }
-    return count;
+    return this.store.activeCount;
   }
 
   getFoodNear(x: number, y: number, radius: number): Food[] {
     const result: Food[] = [];
     const radiusSq = radius * radius;
+    const store = this.store;
 
-    for (const food of this.foods.values()) {
-      if (food.isConsumed) continue;
-
-      const dx = food.x - x;
-      const dy = food.y - y;
+    for (let i = 0; i < store.activeCount; i++) {
+      const row = store.getActiveRow(i);
+      const dx = store.getX(row) - x;
+      const dy = store.getY(row) - y;
       if (dx * dx + dy * dy <= radiusSq) {
-        result.push(food);
+        result.push(this.rows[row] as Food);
       }
     }
 
@@ -297,38 +735,45 @@ export class FoodManager {
   }
 
   getClosestFood(x: number, y: number, maxRadius?: number): Food | null {
-    let closest: Food | null = null;
+    let closestRow = -1;
     let closestDistSq = maxRadius ? maxRadius * maxRadius : Infinity;
+    const store = this.store;
 
-    for (const food of this.foods.values()) {
-      if (food.isConsumed) continue;
-
-      const dx = food.x - x;
-      const dy = food.y - y;
+    for (let i = 0; i < store.activeCount; i++) {
+      const row = store.getActiveRow(i);
+      const dx = store.getX(row) - x;
+      const dy = store.getY(row) - y;
       const distSq = dx * dx + dy * dy;
 
       if (distSq < closestDistSq) {
-        closest = food;
+        closestRow = row;
         closestDistSq = distSq;
       }
     }
 
-    return closest;
+    return closestRow >= 0 ? (this.rows[closestRow] as Food) : null;
   }
 
   removeFood(id: string): boolean {
+    const food = this.foods.get(id);
+    if (!food) return false;
+
+    this.rows[food.row] = undefined;
+    this.changes?.death(food.row, food.id);
+    this.changes?.release(food.row);
+    food.detach();
     return this.foods.delete(id);
   }
 
   clear(): void {
-    this.foods.clear();
+    this.resetStorage();
   }
 
   getStats() {
     return {
       ...this.stats,
       currentCount: this.foods.size,
-      activeCount: this.getActiveCount(),
+      activeCount: this.store.activeCount,
     };
   }
 
@@ -344,7 +789,7 @@ export class FoodManager {
    * Reset manager for loading (doesn't trigger any callbacks)
    */
   clearForRestore(): void {
-    this.foods.clear();
+    this.resetStorage();
     this.idCounter = 0;
     this.spawnAccumulator = 0;
     this.stats = {
@@ -359,8 +804,8 @@ export class FoodManager {
    * Restore a food item directly (for loading saves)
    */
   restoreFood(state: FoodState): Food {
-    const food = Food.fromJSON(state, this.config.foodConfig);
-    this.foods.set(food.id, food);
+    const food = Food.fromJSON(state, this.config.foodConfig, this.store);
+    this.track(food);
 
     // Update id counter to avoid collisions
     const numPart = parseInt(state.id.replace('food_', ''), 10);
@@ -380,4 +825,65 @@ export class FoodManager {
     if (stats.totalDecayed !== undefined) this.stats.totalDecayed = stats.totalDecayed;
     if (stats.totalRespawned !== undefined) this.stats.totalRespawned = stats.totalRespawned;
   }
+
+  /**
+   * Start recording per-row changes, spawns and removals (see
+   * collectChanges). Food already present is reported as spawned.
+   * Consumption and respawn show up as alive changes.
+   */
+  trackChanges(): ChangeTracker {
+    if (!this.changes) {
+      this.changes = new ChangeTracker(Math.max(1, this.rows.length));
+      for (const food of this.foods.values()) {
+        this.changes.spawn(food.row, food.id);
+      }
+    }
+    return this.changes;
+  }
+
+  isTrackingChanges(): boolean {
+    return this.changes !== null;
+  }
+
+  /**
+   * Sweep stored rows for position, energy and consumed changes (O(rows);
+   * skipped when `sweep` is false), then move everything recorded since
+   * the last call into `out`. Decay changes energy without a write, so
+   * only a sweep sees it.
+   */
+  collectChanges(out?: ChangeSet, sweep: boolean = true): ChangeSet {
+    const changes = this.trackChanges();
+    if (sweep) {
+      const store = this.store;
+      const rows = this.rows;
+      for (let row = 0; row < rows.length; row++) {
+        if (!rows[row]) continue;
+        changes.observe(row, store.getX(row), store.getY(row), store.getEnergy(row), !store.isConsumed(row));
+      }
+    }
+    return changes.take(out);
+  }
+
+  private track(food: Food): void {
+    this.foods.set(food.id, food);
+    this.rows[food.row] = food;
+    this.changes?.spawn(food.row, food.id);
+  }
+
+  /**
+   * Start over with an empty store. Handles from the old store stay valid
+   * because the old store is never reused. Deadlines are recomputed against
+   * the first tick passed to update().
+   */
+  private resetStorage(): void {
+    this.foods.clear();
+    this.rows = [];
+    this.store = this.createStore();
+    this.needsRebase = true;
+    this.changes?.reset();
+  }
+
+  private createStore(): FoodStore {
+    return new FoodStore(Math.max(16, this.config.maxCount), true);
+  }
 }
@@ -0,0 +1,126 @@
+/**
+ * FoodField.test.ts - Tests for the continuous food field
+ */
+
+import { describe, it, expect } from 'vitest';
+import { FoodField } from './FoodField';
+import { SimulationEngine } from './SimulationEngine';
+import { simulationToJSON, loadSimulationFromJSON } from './Serialization';
+import { World } from '../world/World';
+import { Direction } from '../sensory/Direction';
+import '../world/ChunkedGrid';
+
+function makeField(config = {}) {
+  const world = new World({ dimensions: { width: 64, height: 64 }, wrapEdges: true });
+  const field = new FoodField(world, { enabled: true, ...config });
+  field.initialize();
+  return { world, field };
+}
+
+describe('FoodField', () => {
+  it('should register its layer on the world', () => {
+    const { world, field } = makeField({ initialDensity: 3 });
+
+    expect(world.hasLayer('__foodField')).toBe(true);
+    expect(field.densityAt(10, 10)).toBe(3);
+  });
+
+  it('should reject a layer that is not densely stored', () => {
+    const world = new World({ dimensions: { width: 64, height: 64 }, wrapEdges: true });
+    world.addLayer({ name: 'patchy', type: 'float32', backend: 'chunked' });
+
+    expect(() => new FoodField(world, { enabled: true, layer: 'patchy' })).toThrow(/dense/);
+  });
+
+  it('should eat from the nearest cells up to the bite size', () => {
+    const { field } = makeField({ initialDensity: 2, biteSize: 5, eatRadius: 1 });
+
+    expect(field.eat(10.5, 10.5)).toBe(5);
+    expect(field.densityAt(10, 10)).toBe(0);
+    expect(field.getStats().totalEaten).toBe(5);
+  });
+
+  it('should regrow toward capacity', () => {
+    const { field } = makeField({ initialDensity: 0, capacity: 4, regrowthRate: 0.5 });
+
+    field.update(1);
+    expect(field.densityAt(0, 0)).toBeCloseTo(2);
+    field.update(2);
+    expect(field.densityAt(0, 0)).toBeCloseTo(3);
+  });
+
+  it('should sense food in the facing direction', () => {
+    const { field } = makeField({ initialDensity: 0, regrowthRate: 0, capacity: 5, visionRange: 40 });
+    const grid = field.getGrid();
+    for (let y = 28; y < 36; y++) {
+      for (let x = 40; x < 56; x++) grid.set(x, y, 5);
+    }
+    field.update(1);
+
+    const ahead = field.sense(32, 32, 0, Direction.FRONT);
+    const behind = field.sense(32, 32, Math.PI, Direction.FRONT);
+    expect(ahead).toBeGreaterThan(0.3);
+    expect(behind).toBeLessThan(ahead / 4);
+  });
+
+  it('should drive an engine in field mode', () => {
+    const engine = new SimulationEngine({
+      engine: { seed: 1, world: { dimensions: { width: 128, height: 128 } } },
+      agents: { initialPopulation: 10 },
+      foodField: { enabled: true },
+    });
+
+    engine.initialize();
+    engine.step(20);
+
+    expect(engine.getFoodManager().getAllFood()).toHaveLength(0);
+    expect(engine.getFoodField()!.getStats().totalEnergy).toBeGreaterThan(0);
+  });
+
+  it('should count field energy in the food statistics', () => {
+    const engine = new SimulationEngine({
+      engine: { seed: 1, world: { dimensions: { width: 64, height: 64 } } },
+      agents: { initialPopulation: 0 },
+      statistics: { snapshotInterval: 1 },
+      foodField: { enabled: true },
+    });
+
+    engine.initialize();
+    engine.step(3);
+
+    const snapshot = engine.getStatistics().getLatestSnapshot()!;
+    expect(snapshot.food.totalEnergy).toBeCloseTo(engine.getFoodField()!.getStats().totalEnergy, 2);
+    expect(snapshot.food.totalEnergy).toBeGreaterThan(0);
+  });
+
+  it('should survive a save and load', () => {
+    const engine = new SimulationEngine({
+      engine: { seed: 1, world: { dimensions: { width: 64, height: 64 } } },
+      agents: { initialPopulation: 0 },
+      foodField: { enabled: true, capacity: 8 },
+    });
+    engine.initialize();
+    engine.step(2);
+    const field = engine.getFoodField()!;
+    field.eat(100, 100);
+    field.eat(300, 40);
+
+    const loaded = loadSimulationFromJSON(simulationToJSON(engine)).getFoodField()!;
+
+    expect(loaded).not.toBeNull();
+    expect(loaded.getConfig().capacity).toBe(8);
+    expect(Array.from(loaded.getGrid().data)).toEqual(Array.from(field.getGrid().data));
+    expect(loaded.getStats()).toEqual(field.getStats());
+    expect(loaded.densityAt(100, 100)).toBe(field.densityAt(100, 100));
+  });
+
+  it('should leave the world untouched when disabled', () => {
+    const engine = new SimulationEngine({
+      engine: { world: { dimensions: { width: 128, height: 128 } } },
+      agents: { initialPopulation: 0 },
+    });
+
+    expect(engine.getFoodField()).toBeNull();
+    expect(engine.getWorld().layerNames).toEqual([]);
+  });
+});
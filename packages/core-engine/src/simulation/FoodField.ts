@@ -0,0 +1,341 @@
+/**
+ * FoodField.ts - Continuous food field backed by a World grid layer
+ *
+ * An alternative to discrete Food items for large worlds. Food is an
+ * amount of energy per grid cell that regrows toward a cell capacity,
+ * diffuses and decays with the fused Grid kernel, and is eaten by cell. Cost is
+ * fixed per cell rather than per food unit.
+ *
+ * Sensing samples the field along each directional cone. A mip pyramid of
+ * block averages lets distant samples cover the cone's width with a single
+ * read.
+ *
+ * The field reads and writes the layer's backing array directly, so the
+ * layer must use the dense backend.
+ */
+
+import { World } from '../world/World';
+import { Grid } from '../world/Grid';
+import { SensoryInput } from '../neural/Brain';
+import { Direction, DIRECTION_ANGLES, DIRECTION_CONE_WIDTHS } from '../sensory/Direction';
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+export interface FoodFieldConfig {
+  enabled: boolean;
+  layer: string;              // World layer holding the field (dense backend)
+  initialDensity: number;     // Starting energy per cell
+  capacity: number;           // Maximum energy per cell
+  regrowthRate: number;       // Fraction of missing energy regrown per tick
+  diffusionRate: number;      // Grid.diffuse rate, 0 = off
+  decayRate: number;          // Grid.decay rate, 0 = off
+  dynamicsInterval: number;   // Ticks between diffuse/decay passes
+  biteSize: number;           // Maximum energy taken per eat action
+  eatRadius: number;          // Neighbourhood eaten from, in cells
+  visionRange: number;        // Sensing range in world units
+  senseSamples: number;       // Samples along each cone
+  mipLevels: number;          // Pyramid levels above the base grid, 0 = point samples
+  weight: number;             // How strongly food registers on sensory channels
+}
+
+export const DEFAULT_FOOD_FIELD_CONFIG: FoodFieldConfig = {
+  enabled: false,
+  layer: '__foodField',
+  initialDensity: 2,
+  capacity: 5,
+  regrowthRate: 0.002,
+  diffusionRate: 0,
+  decayRate: 0,
+  dynamicsInterval: 10,
+  biteSize: 20,
+  eatRadius: 2,
+  visionRange: 100,
+  senseSamples: 4,
+  mipLevels: 5,
+  weight: 1.0,
+};
+
+export interface FoodFieldStats {
+  totalEnergy: number;
+  totalEaten: number;
+  bites: number;
+}
+
+const SENSED_DIRECTIONS: Direction[] = [
+  Direction.FRONT,
+  Direction.FRONT_LEFT,
+  Direction.FRONT_RIGHT,
+  Direction.LEFT,
+  Direction.RIGHT,
+];
+
+// ============================================================================
+// FoodField Class
+// ============================================================================
+
+export class FoodField {
+  private config: FoodFieldConfig;
+  private world: World;
+  private grid: Grid;
+  private mips: Float32Array[] = [];
+  private mipWidths: number[] = [];
+  private mipHeights: number[] = [];
+  private totalEaten: number = 0;
+  private bites: number = 0;
+  private senseBuffer: Float64Array = new Float64Array(SENSED_DIRECTIONS.length);
+
+  constructor(world: World, config?: Partial<FoodFieldConfig>) {
+    this.config = { ...DEFAULT_FOOD_FIELD_CONFIG, ...config };
+    this.world = world;
+    this.grid = world.getLayer(this.config.layer) ?? world.addLayer({
+      name: this.config.layer,
+      type: 'float32',
+      min: 0,
+      max: this.config.capacity,
+    });
+    if (!this.grid.dense) {
+      throw new Error(`FoodField layer '${this.config.layer}' must use the dense grid backend`);
+    }
+    this.allocateMips();
+  }
+
+  get enabled(): boolean {
+    return this.config.enabled;
+  }
+
+  /**
+   * Fill the field with its initial density
+   */
+  initialize(): void {
+    this.grid.fill(Math.min(this.config.initialDensity, this.config.capacity));
+    this.totalEaten = 0;
+    this.bites = 0;
+    this.buildMips();
+  }
+
+  /**
+   * Regrow every cell, run periodic diffusion/decay and refresh the pyramid
+   */
+  update(currentTick: number): void {
+    const data = this.grid.data;
+    const capacity = this.config.capacity;
+    const rate = this.config.regrowthRate;
+
+    if (rate > 0) {
+      for (let i = 0; i < data.length; i++) {
+        data[i] += (capacity - data[i]) * rate;
+      }
+      this.grid.markDirty(0, data.length);
+    }
+
+    const interval = Math.max(1, this.config.dynamicsInterval);
+    if (currentTick % interval === 0 && (this.config.diffusionRate > 0 || this.config.decayRate > 0)) {
+      this.world.updateLayers([{
+        layer: this.config.layer,
+        diffusionRate: this.config.diffusionRate,
+        decayRate: this.config.decayRate,
+      }]);
+    }
+
+    this.buildMips();
+  }
+
+  /**
+   * Eat from the cells around a world position, nearest cell first.
+   * Returns the energy taken, at most biteSize.
+   */
+  eat(x: number, y: number): number {
+    const grid = this.grid;
+    const data = grid.data;
+    const cell = this.world.worldToGrid(x, y);
+    const r = Math.max(0, Math.floor(this.config.eatRadius));
+
+    let remaining = this.config.biteSize;
+    for (let ring = 0; ring <= r && remaining > 0; ring++) {
+      for (let dy = -ring; dy <= ring && remaining > 0; dy++) {
+        for (let dx = -ring; dx <= ring && remaining > 0; dx++) {
+          if (Math.max(Math.abs(dx), Math.abs(dy)) !== ring) continue;
+          const cx = cell.x + dx;
+          const cy = cell.y + dy;
+          if (!grid.wrapEdges && !grid.inBounds(cx, cy)) continue;
+
+          const index = grid.index(cx, cy);
+          const taken = Math.min(data[index], remaining);
+          data[index] -= taken;
+          grid.markDirty(index);
+          remaining -= taken;
+        }
+      }
+    }
+
+    const eaten = this.config.biteSize - remaining;
+    if (eaten > 0) {
+      this.totalEaten += eaten;
+      this.bites++;
+    }
+    return eaten;
+  }
+
+  /**
+   * Food signal in a single direction, 0..1
+   */
+  sense(x: number, y: number, rotation: number, direction: Direction): number {
+    const range = this.config.visionRange;
+    const samples = Math.max(1, this.config.senseSamples);
+    const angle = rotation + DIRECTION_ANGLES[direction];
+    const halfWidth = Math.tan(DIRECTION_CONE_WIDTHS[direction] / 2);
+    const cos = Math.cos(angle);
+    const sin = Math.sin(angle);
+    const cellSize = this.world.cellSize;
+
+    let best = 0;
+    for (let i = 0; i < samples; i++) {
+      const d = range * (i + 0.5) / samples;
+      const spread = 2 * d * halfWidth / cellSize;
+      const level = spread > 1 ? Math.min(this.mips.length, Math.floor(Math.log2(spread))) : 0;
+
+      const density = this.sampleLevel(level, (x + cos * d) / cellSize, (y + sin * d) / cellSize);
+      const signal = (density / this.config.capacity) * (1 - d / range);
+      if (signal > best) best = signal;
+    }
+
+    return Math.min(1, best);
+  }
+
+  /**
+   * Overlay field food onto an agent's directional channels
+   */
+  applySensing(x: number, y: number, rotation: number, input: SensoryInput): SensoryInput {
+    const w = this.config.weight;
+    const signal = this.senseBuffer;
+    for (let i = 0; i < SENSED_DIRECTIONS.length; i++) {
+      signal[i] = this.sense(x, y, rotation, SENSED_DIRECTIONS[i]) * w;
+    }
+
+    return {
+      ...input,
+      front: Math.min(1, input.front + signal[0]),
+      frontLeft: Math.min(1, input.frontLeft + signal[1]),
+      frontRight: Math.min(1, input.frontRight + signal[2]),
+      left: Math.min(1, input.left + signal[3]),
+      right: Math.min(1, input.right + signal[4]),
+    };
+  }
+
+  /**
+   * Energy density at a world position (base level)
+   */
+  densityAt(x: number, y: number): number {
+    const cell = this.world.worldToGrid(x, y);
+    return this.grid.get(cell.x, cell.y);
+  }
+
+  /**
+   * Grid cell index containing a world position
+   */
+  cellIndexAt(x: number, y: number): number {
+    const cell = this.world.worldToGrid(x, y);
+    return this.grid.index(cell.x, cell.y);
+  }
+
+  /**
+   * Overwrite the field with saved cell energies and counters (for loading
+   * saves); `values` must cover the whole layer
+   */
+  restore(values: ArrayLike<number>, stats: Partial<FoodFieldStats> = {}): void {
+    if (values.length !== this.grid.size) {
+      throw new Error(`FoodField restore expects ${this.grid.size} cells, got ${values.length}`);
+    }
+    this.grid.data.set(values);
+    this.grid.markDirty(0, this.grid.size);
+    this.totalEaten = stats.totalEaten ?? 0;
+    this.bites = stats.bites ?? 0;
+    this.buildMips();
+  }
+
+  getGrid(): Grid {
+    return this.grid;
+  }
+
+  getStats(): FoodFieldStats {
+    return {
+      totalEnergy: this.grid.sum(),
+      totalEaten: this.totalEaten,
+      bites: this.bites,
+    };
+  }
+
+  getConfig(): FoodFieldConfig {
+    return { ...this.config };
+  }
+
+  // Level 0 is the grid itself; level k averages 2^k x 2^k blocks
+  private sampleLevel(level: number, gx: number, gy: number): number {
+    if (level === 0) {
+      return this.sampleGrid(Math.floor(gx), Math.floor(gy));
+    }
+
+    const w = this.mipWidths[level - 1];
+    const h = this.mipHeights[level - 1];
+    const scale = 1 << level;
+    let mx = Math.floor(gx / scale);
+    let my = Math.floor(gy / scale);
+    if (this.grid.wrapEdges) {
+      mx = ((mx % w) + w) % w;
+      my = ((my % h) + h) % h;
+    } else if (mx < 0 || mx >= w || my < 0 || my >= h) {
+      return 0;
+    }
+    return this.mips[level - 1][my * w + mx];
+  }
+
+  private sampleGrid(cx: number, cy: number): number {
+    if (!this.grid.wrapEdges && !this.grid.inBounds(cx, cy)) return 0;
+    return this.grid.data[this.grid.index(cx, cy)];
+  }
+
+  private allocateMips(): void {
+    let w = this.grid.width;
+    let h = this.grid.height;
+    for (let l = 0; l < this.config.mipLevels && (w > 1 || h > 1); l++) {
+      w = Math.ceil(w / 2);
+      h = Math.ceil(h / 2);
+      this.mips.push(new Float32Array(w * h));
+      this.mipWidths.push(w);
+      this.mipHeights.push(h);
+    }
+  }
+
+  private buildMips(): void {
+    let src = this.grid.data as Float32Array;
+    let sw = this.grid.width;
+    let sh = this.grid.height;
+
+    for (let l = 0; l < this.mips.length; l++) {
+      const dst = this.mips[l];
+      const dw = this.mipWidths[l];
+      const dh = this.mipHeights[l];
+
+      for (let y = 0; y < dh; y++) {
+        const y0 = y * 2;
+        const y1 = Math.min(y0 + 1, sh - 1);
+        for (let x = 0; x < dw; x++) {
+          const x0 = x * 2;
+          const x1 = Math.min(x0 + 1, sw - 1);
+          dst[y * dw + x] = (
+            src[y0 * sw + x0] + src[y0 * sw + x1] +
+            src[y1 * sw + x0] + src[y1 * sw + x1]
+          ) * 0.25;
+        }
+      }
+
+      src = dst;
+      sw = dw;
+      sh = dh;
+    }
+  }
+}
+
+export default FoodField;
@@ -0,0 +1,257 @@
+/**
+ * InteractionSystem.test.ts - Tests for batched action resolution
+ */
+
+import { describe, it, expect } from 'vitest';
+import { InteractionSystem } from './InteractionSystem';
+import { FoodManager } from './Food';
+import { AgentManager } from './AgentManager';
+import { Agent } from '../agents/Agent';
+import { Action, Actions } from '../agents/Action';
+import { Genome } from '../genetics/Genome';
+import { Brain, SensoryInput, BrainOutput } from '../neural/Brain';
+
+class IdleBrain implements Brain {
+  readonly type = 'idle';
+  readonly inputSize = 7;
+  readonly outputSize = 3;
+
+  think(_input: SensoryInput): BrainOutput {
+    return { moveForward: 0, rotate: 0, action: 0 };
+  }
+
+  mutate(): Brain {
+    return new IdleBrain();
+  }
+
+  clone(): Brain {
+    return new IdleBrain();
+  }
+
+  toJSON(): object {
+    return { type: this.type };
+  }
+}
+
+function makeAgent(id: string, x: number, y: number): Agent {
+  return new Agent(id, 'species_0', { x, y }, 0, 50, new IdleBrain(), Genome.withSize(10), 0, id);
+}
+
+function setup() {
+  const foodManager = new FoodManager(500, 500, { initialCount: 0, spawnRate: 0 });
+  foodManager.initialize();
+  const agentManager = new AgentManager(500, 500, { initialPopulation: 0 });
+  const system = new InteractionSystem(500, 500, { tieBreakSeed: 7 });
+  return { foodManager, agentManager, system };
+}
+
+describe('InteractionSystem', () => {
+  describe('resolveActions', () => {
+    it('should give contested food to the nearest agent regardless of order', () => {
+      const run = (order: string[]) => {
+        const { foodManager, agentManager, system } = setup();
+        const food = foodManager.spawnFood(0, 100, 100)!;
+        const agents: Record<string, Agent> = {
+          far: makeAgent('far', 108, 100),
+          near: makeAgent('near', 103, 100),
+        };
+        const list = order.map(id => agents[id]);
+        const actions: Action[][] = list.map(() => [Actions.eat()]);
+
+        system.resolveActions(list, actions, agentManager, foodManager, 0);
+        return {
+          far: agents.far.energy,
+          near: agents.near.energy,
+          consumed: food.isConsumed,
+          contested: system.getStats().contestedEats,
+        };
+      };
+
+      const a = run(['far', 'near']);
+      const b = run(['near', 'far']);
+
+      expect(a).toEqual(b);
+      expect(a.near).toBeGreaterThan(a.far);
+      expect(a.consumed).toBe(true);
+      expect(a.contested).toBe(1);
+    });
+
+    it('should not carry requests over between ticks', () => {
+      const { foodManager, agentManager, system } = setup();
+      const first = foodManager.spawnFood(0, 100, 100)!;
+      const second = foodManager.spawnFood(0, 300, 300)!;
+      const a = makeAgent('a', 102, 100);
+      const b = makeAgent('b', 302, 300);
+
+      system.resolveActions([a, b], [[Actions.eat(first.id)], [Actions.idle()]], agentManager, foodManager, 0);
+      system.resolveActions([b], [[Actions.eat()]], agentManager, foodManager, 1);
+
+      expect(first.isConsumed).toBe(true);
+      expect(second.isConsumed).toBe(true);
+      expect(system.getStats().contestedEats).toBe(0);
+    });
+
+    it('should break distance ties with the seeded hash', () => {
+      const winner = (order: string[]) => {
+        const { foodManager, agentManager, system } = setup();
+        foodManager.spawnFood(0, 100, 100);
+        const agents = order.map(id => makeAgent(id, id === 'a' ? 95 : 105, 100));
+
+        system.resolveActions(agents, agents.map(() => [Actions.eat()]), agentManager, foodManager, 3);
+        return agents.find(agent => agent.energy > 50)?.id;
+      };
+
+      expect(winner(['a', 'b'])).toBeDefined();
+      expect(winner(['a', 'b'])).toBe(winner(['b', 'a']));
+    });
+
+    it('should recheck a granted mate at commit time', () => {
+      const { foodManager, agentManager, system } = setup();
+      const a = agentManager.spawnAgent({ position: { x: 100, y: 100 }, energy: 80 })!;
+      const b = agentManager.spawnAgent({ position: { x: 104, y: 100 }, energy: 80 })!;
+      a.age = b.age = 100;
+
+      const results = system.resolveActions(
+        [a, b],
+        [[Actions.reproduce()], [Actions.reproduce()]],
+        agentManager,
+        foodManager,
+        0
+      );
+
+      // Each targets the other; whoever commits second finds its mate spent
+      expect(results.every(result => result.success)).toBe(true);
+      expect(results.filter(result => result.targetId !== undefined)).toHaveLength(1);
+      expect(system.getStats().contestedMates).toBe(1);
+    });
+
+    it('should apply movement before selecting targets', () => {
+      const { foodManager, agentManager, system } = setup();
+      foodManager.spawnFood(0, 120, 100);
+      const agent = makeAgent('a1', 100, 100);
+
+      const results = system.resolveActions(
+        [agent],
+        [[Actions.move(1), Actions.eat()]],
+        agentManager,
+        foodManager,
+        0
+      );
+
+      expect(agent.position.x).toBeGreaterThan(100);
+      expect(results).toHaveLength(1);
+      expect(results[0].type).toBe('eat');
+    });
+  });
+});
+
+describe('AgentManager mate search', () => {
+  function population() {
+    const manager = new AgentManager(500, 500, { initialPopulation: 0, autoRespawn: false });
+    const parent = manager.spawnAgent({ position: { x: 100, y: 100 } })!;
+    const near = manager.spawnAgent({ position: { x: 104, y: 100 } })!;
+    const far = manager.spawnAgent({ position: { x: 110, y: 100 } })!;
+    manager.spawnAgent({ position: { x: 300, y: 300 } });
+    return { manager, parent, near, far };
+  }
+
+  it('should return the nearest mate with and without the index', () => {
+    const { manager, parent, near } = population();
+
+    expect(manager.findNearestMate(parent, 15)).toBe(near);
+    manager.buildSpatialIndex();
+    expect(manager.isSpatiallyIndexed()).toBe(true);
+    expect(manager.findNearestMate(parent, 15)).toBe(near);
+    expect(manager.getAgentsNear(100, 100, 15)).toHaveLength(3);
+  });
+
+  it('should apply the compatibility filter nearest first', () => {
+    const { manager, parent, near, far } = population();
+    manager.buildSpatialIndex();
+    const checked: string[] = [];
+
+    const mate = manager.findNearestMate(parent, 15, (_a, candidate) => {
+      checked.push(candidate.id);
+      return candidate !== near;
+    });
+
+    expect(mate).toBe(far);
+    expect(checked).toEqual([near.id, far.id]);
+  });
+
+  it('should find mates across the world edge when indexed', () => {
+    const manager = new AgentManager(500, 500, { initialPopulation: 0, autoRespawn: false });
+    const parent = manager.spawnAgent({ position: { x: 2, y: 250 } })!;
+    const mate = manager.spawnAgent({ position: { x: 497, y: 250 } })!;
+
+    manager.buildSpatialIndex();
+    expect(manager.findNearestMate(parent, 10)).toBe(mate);
+    manager.update(0);
+    expect(manager.isSpatiallyIndexed()).toBe(false);
+  });
+
+  it('should find mates across the world edge without the index', () => {
+    const manager = new AgentManager(500, 500, { initialPopulation: 0, autoRespawn: false });
+    const parent = manager.spawnAgent({ position: { x: 2, y: 250 } })!;
+    const mate = manager.spawnAgent({ position: { x: 497, y: 250 } })!;
+
+    expect(manager.isSpatiallyIndexed()).toBe(false);
+    expect(manager.findNearestMate(parent, 10)).toBe(mate);
+    expect(manager.getClosestAgent(2, 250, parent.id, 10)).toBe(mate);
+  });
+
+  it('should find the closest agent through the index without a radius', () => {
+    const manager = new AgentManager(1000, 1000, { initialPopulation: 0, autoRespawn: false });
+    const origin = manager.spawnAgent({ position: { x: 10, y: 10 } })!;
+    const across = manager.spawnAgent({ position: { x: 900, y: 10 } })!;
+    manager.spawnAgent({ position: { x: 300, y: 300 } });
+
+    expect(manager.getClosestAgent(10, 10, origin.id)).toBe(across);
+    manager.buildSpatialIndex();
+    expect(manager.getClosestAgent(10, 10, origin.id)).toBe(across);
+    expect(manager.getClosestAgent(500, 500)?.position.x).toBe(300);
+  });
+
+  it('should index mates for per-agent processing and track movers', () => {
+    const manager = new AgentManager(500, 500, { initialPopulation: 0, autoRespawn: false });
+    const parent = manager.spawnAgent({ position: { x: 100, y: 100 }, energy: 90 })!;
+    const partner = manager.spawnAgent({ position: { x: 116, y: 100 }, energy: 90 })!;
+    parent.age = partner.age = 100;
+    partner.rotation = Math.PI;
+    const foodManager = new FoodManager(500, 500, { initialCount: 0, spawnRate: 0 });
+    const system = new InteractionSystem(500, 500);
+
+    system.processActions(partner, [Actions.move(1)], manager, foodManager, 0);
+    expect(manager.isSpatiallyIndexed()).toBe(false);
+    const result = system.processActions(parent, [Actions.reproduce()], manager, foodManager, 0)[0];
+    expect(result.targetId).toBe(partner.id);
+    expect(manager.isSpatiallyIndexed()).toBe(true);
+
+    // Later moves re-bucket the mover instead of leaving the index stale
+    partner.rotation = 0;
+    for (let i = 0; i < 20; i++) {
+      system.processActions(partner, [Actions.move(1)], manager, foodManager, 0);
+    }
+    expect(manager.getAgentsNear(partner.position.x, 100, 1)).toContain(partner);
+  });
+
+  it('should reject mates through the configured reproductive isolation', () => {
+    const reproduce = (system: InteractionSystem) => {
+      const manager = new AgentManager(500, 500, { initialPopulation: 0, autoRespawn: false });
+      const parent = manager.spawnAgent({ position: { x: 100, y: 100 }, energy: 90 })!;
+      const partner = manager.spawnAgent({ position: { x: 104, y: 100 }, energy: 90 })!;
+      parent.age = partner.age = 100;
+      const foodManager = new FoodManager(500, 500, { initialCount: 0, spawnRate: 0 });
+      return system.processActions(parent, [Actions.reproduce()], manager, foodManager, 0)[0];
+    };
+
+    expect(reproduce(new InteractionSystem(500, 500)).targetId).toBeDefined();
+
+    const isolated = new InteractionSystem(500, 500, {
+      reproductiveIsolation: { matingDistanceThreshold: -1 },
+    });
+    const result = reproduce(isolated);
+    expect(result.success).toBe(true);
+    expect(result.targetId).toBeUndefined();
+  });
+});
@@ -7,7 +7,17 @@
 import { Agent, Position } from '../agents/Agent';
 import { Action, ActionType } from '../agents/Action';
 import { Food, FoodManager } from './Food';
-import { AgentManager } from './AgentManager';
+import { FoodField } from './FoodField';
+import { AgentManager, MateFilter } from './AgentManager';
+import { ReproductiveIsolation } from '../speciation/ReproductiveIsolation';
+import { PopulationId, ReproductiveIsolationConfig } from '../speciation/types';
+
+/**
+ * Agents with a physical body report their own collision radius
+ */
+interface CollidableAgent {
+  getCollisionRadius(): number;
+}
 
 export interface InteractionConfig {
   eatRadius: number;
@@ -16,6 +26,10 @@ export interface InteractionConfig {
   enableCollisions: boolean;
   enableFeeding: boolean;
   enableMating: boolean;
+  batchResolution: boolean;  // Resolve a whole tick of actions at once (resolveActions); opt-in
+  tieBreakSeed: number;      // Seeds the hash that breaks equal-distance conflicts
+  // Restrict mate search with ReproductiveIsolation.canMate (null = any partner)
+  reproductiveIsolation: Partial<ReproductiveIsolationConfig> | null;
 }
 
 export const DEFAULT_INTERACTION_CONFIG: InteractionConfig = {
@@ -25,6 +39,9 @@ export const DEFAULT_INTERACTION_CONFIG: InteractionConfig = {
   enableCollisions: true,
   enableFeeding: true,
   enableMating: true,
+  batchResolution: false,
+  tieBreakSeed: 0,
+  reproductiveIsolation: null,
 };
 
 export interface InteractionResult {
@@ -36,10 +53,64 @@ export interface InteractionResult {
   offspring?: Agent;
 }
 
+const INTENT_MOVE = 1;
+const INTENT_ROTATE = 2;
+const INTENT_EAT = 4;
+const INTENT_MATE = 8;
+
+/**
+ * Stable per-tick tie-break value for an agent (FNV-1a over the id, mixed
+ * with seed and tick)
+ */
+function hashTieBreak(seed: number, tick: number, id: string): number {
+  let h = (0x811c9dc5 ^ seed) >>> 0;
+  for (let i = 0; i < id.length; i++) {
+    h ^= id.charCodeAt(i);
+    h = Math.imul(h, 0x01000193);
+  }
+  h ^= Math.imul(tick, 0x9e3779b1);
+  h ^= h >>> 16;
+  h = Math.imul(h, 0x85ebca6b);
+  h ^= h >>> 13;
+  return h >>> 0;
+}
+
+/**
+ * Mate filter backed by ReproductiveIsolation.canMate. Populations default
+ * to species IDs.
+ */
+export function isolationMateFilter(
+  isolation: ReproductiveIsolation,
+  populationOf: (agent: Agent) => PopulationId = (agent) => agent.speciesId
+): MateFilter {
+  return (agent, candidate) => isolation.canMate(
+    {
+      id: agent.id,
+      genome: agent.genome,
+      populationId: populationOf(agent),
+      position: agent.position,
+      age: agent.age,
+      energy: agent.energy,
+      speciesId: agent.speciesId,
+    },
+    {
+      id: candidate.id,
+      genome: candidate.genome,
+      populationId: populationOf(candidate),
+      position: candidate.position,
+      age: candidate.age,
+      energy: candidate.energy,
+      speciesId: candidate.speciesId,
+    }
+  );
+}
+
 export class InteractionSystem {
   private config: InteractionConfig;
   private worldWidth: number;
   private worldHeight: number;
+  private foodField: FoodField | null = null;
+  private mateFilter: MateFilter | null = null;
 
   private stats = {
     totalEatAttempts: 0,
@@ -47,8 +118,31 @@ export class InteractionSystem {
     totalMateAttempts: 0,
     successfulMates: 0,
     collisionsDetected: 0,
+    contestedEats: 0,
+    contestedMates: 0,
   };
 
+  // Intent buffers for batched resolution, indexed like the agent list
+  private bufferCapacity: number = 0;
+  private moveSpeed: Float32Array = new Float32Array(0);
+  private rotateDelta: Float32Array = new Float32Array(0);
+  private intentFlags: Uint8Array = new Uint8Array(0);
+  private eatTarget: Int32Array = new Int32Array(0);
+  private eatDistance: Float64Array = new Float64Array(0);
+  private mateTarget: Int32Array = new Int32Array(0);
+  private mateDistance: Float64Array = new Float64Array(0);
+  private tieBreak: Uint32Array = new Uint32Array(0);
+  private granted: Uint8Array = new Uint8Array(0);
+  private eatRequests: Array<string | undefined> = [];
+  private mateRequests: Array<string | undefined> = [];
+  private actingIndex: Map<Agent, number> = new Map();  // Agent -> index in the tick's list
+  private eatOrder: number[] = [];
+  private mateOrder: number[] = [];
+
+  // Claim keys read by the bound comparator in claimOrder
+  private claimTarget: Int32Array = this.eatTarget;
+  private claimDistance: Float64Array = this.eatDistance;
+
   constructor(
     worldWidth: number,
     worldHeight: number,
@@ -57,6 +151,26 @@ export class InteractionSystem {
     this.worldWidth = worldWidth;
     this.worldHeight = worldHeight;
     this.config = { ...DEFAULT_INTERACTION_CONFIG, ...config };
+    if (this.config.reproductiveIsolation) {
+      this.mateFilter = isolationMateFilter(
+        new ReproductiveIsolation(this.config.reproductiveIsolation)
+      );
+    }
+  }
+
+  /**
+   * Eat from a continuous food field instead of discrete food items
+   */
+  setFoodField(field: FoodField | null): void {
+    this.foodField = field;
+  }
+
+  /**
+   * Restrict mate search to compatible partners. Replaces the filter built
+   * from config.reproductiveIsolation.
+   */
+  setMateFilter(filter: MateFilter | null): void {
+    this.mateFilter = filter;
   }
 
   processActions(
@@ -72,6 +186,7 @@ export class InteractionSystem {
       switch (action.type) {
         case ActionType.MOVE:
           agent.executeMove(action.speed, this.worldWidth, this.worldHeight);
+          agentManager.updateSpatialIndex(agent);
           break;
 
         case ActionType.ROTATE:
@@ -109,6 +224,10 @@ export class InteractionSystem {
   ): InteractionResult | null {
     this.stats.totalEatAttempts++;
 
+    if (this.foodField) {
+      return this.processFieldEat(agent);
+    }
+
     // Find food to eat
     let food: Food | null = null;
 
@@ -153,6 +272,26 @@ export class InteractionSystem {
     };
   }
 
+  private processFieldEat(agent: Agent): InteractionResult {
+    const energyGained = this.foodField!.eat(agent.position.x, agent.position.y);
+    if (energyGained > 0) {
+      agent.executeEat(energyGained);
+      this.stats.successfulEats++;
+      return {
+        type: 'eat',
+        agentId: agent.id,
+        success: true,
+        energyChange: energyGained,
+      };
+    }
+
+    return {
+      type: 'eat',
+      agentId: agent.id,
+      success: false,
+    };
+  }
+
   private processReproduce(
     agent: Agent,
     agentManager: AgentManager,
@@ -183,17 +322,15 @@ export class InteractionSystem {
     }
 
     if (!mate) {
-      const nearbyAgents = agentManager.getAgentsNear(
-        agent.position.x,
-        agent.position.y,
-        this.config.mateRadius
-      );
-      for (const nearby of nearbyAgents) {
-        if (nearby.id !== agent.id && nearby.alive()) {
-          mate = nearby;
-          break;
-        }
+      // Indexed on first use in a tick; processActions re-buckets movers
+      if (!agentManager.isSpatiallyIndexed()) {
+        agentManager.buildSpatialIndex();
       }
+      mate = agentManager.findNearestMate(
+        agent,
+        this.config.mateRadius,
+        this.mateFilter ?? undefined
+      ) ?? undefined;
     }
 
     // Reproduce (with or without mate)
@@ -217,6 +354,320 @@ export class InteractionSystem {
     };
   }
 
+  // ==========================================================================
+  // Batched Resolution
+  // ==========================================================================
+
+  /**
+   * Resolve one tick of actions for all agents at once.
+   *
+   * 1. Intents are collected into typed buffers indexed like `agents`.
+   * 2. Movement and rotation are applied; they only touch the acting agent.
+   * 3. Each agent picks its eat and mate targets from post-move positions.
+   *    This reads shared state without writing it.
+   * 4. Conflicts are resolved per target: the nearest claimant wins, and
+   *    ties go to a hash of (seed, tick, agent id). Losers fail their eat
+   *    and reproduce without a mate.
+   * 5. Eats and reproductions are committed in one pass. A granted mate is
+   *    checked again first: if an earlier commit left it unable to
+   *    reproduce, the agent reproduces without a mate.
+   *
+   * The outcome does not depend on the order of `agents`, and steps 2-3 are
+   * independent per agent. The agent index built for step 3 is left built
+   * for later phases of the tick (predation); AgentManager.update() drops it.
+   */
+  resolveActions(
+    agents: Agent[],
+    actions: Array<Action[] | undefined>,
+    agentManager: AgentManager,
+    foodManager: FoodManager,
+    currentTick: number
+  ): InteractionResult[] {
+    const n = agents.length;
+    this.ensureBuffers(n);
+
+    const flags = this.intentFlags;
+    const eatTarget = this.eatTarget;
+    const mateTarget = this.mateTarget;
+    const eatRequests = this.eatRequests;
+    const mateRequests = this.mateRequests;
+    const indexOf = this.actingIndex;
+    eatRequests.length = n;
+    mateRequests.length = n;
+    indexOf.clear();
+
+    // Phase 1: collect intents
+    for (let i = 0; i < n; i++) {
+      const agent = agents[i];
+      indexOf.set(agent, i);
+      eatRequests[i] = undefined;
+      mateRequests[i] = undefined;
+      flags[i] = 0;
+      eatTarget[i] = -1;
+      mateTarget[i] = -1;
+      this.granted[i] = 0;
+      this.tieBreak[i] = hashTieBreak(this.config.tieBreakSeed, currentTick, agent.id);
+
+      const list = actions[i];
+      if (!list || !agent.alive()) continue;
+
+      for (const action of list) {
+        switch (action.type) {
+          case ActionType.MOVE:
+            flags[i] |= INTENT_MOVE;
+            this.moveSpeed[i] = action.speed;
+            break;
+          case ActionType.ROTATE:
+            flags[i] |= INTENT_ROTATE;
+            this.rotateDelta[i] = action.angleDelta;
+            break;
+          case ActionType.EAT:
+            if (this.config.enableFeeding) {
+              flags[i] |= INTENT_EAT;
+              eatRequests[i] = action.targetId;
+            }
+            break;
+          case ActionType.REPRODUCE:
+            if (this.config.enableMating) {
+              flags[i] |= INTENT_MATE;
+              mateRequests[i] = action.mateId;
+            }
+            break;
+        }
+      }
+    }
+
+    // Phase 2: self-only effects
+    for (let i = 0; i < n; i++) {
+      if (flags[i] & INTENT_MOVE) {
+        agents[i].executeMove(this.moveSpeed[i], this.worldWidth, this.worldHeight);
+      }
+      if (flags[i] & INTENT_ROTATE) {
+        agents[i].executeRotate(this.rotateDelta[i]);
+      }
+    }
+
+    // Phase 3: target selection against one index of post-move positions
+    agentManager.buildSpatialIndex();
+    for (let i = 0; i < n; i++) {
+      if (flags[i] & INTENT_EAT) {
+        this.selectFood(i, agents[i], foodManager, eatRequests[i]);
+      }
+      if (flags[i] & INTENT_MATE) {
+        this.selectMate(i, agents[i], agentManager, mateRequests[i]);
+      }
+    }
+
+    // Phase 4: conflict resolution
+    const eaters = this.claimOrder(this.eatOrder, n, INTENT_EAT, eatTarget, this.eatDistance);
+    const fieldMode = this.foodField !== null;
+    for (let k = 0; k < eaters.length; k++) {
+      const i = eaters[k];
+      const first = k === 0 || eatTarget[eaters[k - 1]] !== eatTarget[i];
+      // Field cells are shared; claims only order who eats first
+      if (first || fieldMode) {
+        this.granted[i] |= INTENT_EAT;
+      } else {
+        this.stats.contestedEats++;
+      }
+    }
+
+    const maters = this.claimOrder(this.mateOrder, n, INTENT_MATE, mateTarget, this.mateDistance);
+    for (let k = 0; k < maters.length; k++) {
+      const i = maters[k];
+      if (mateTarget[i] < 0) continue;
+      const first = k === 0 || mateTarget[maters[k - 1]] !== mateTarget[i];
+      if (first) {
+        this.granted[i] |= INTENT_MATE;
+      } else {
+        this.stats.contestedMates++;
+      }
+    }
+
+    // Phase 5: commit
+    const results: InteractionResult[] = [];
+    for (const i of eaters) {
+      results.push(this.commitEat(i, agents[i], foodManager, currentTick));
+    }
+    for (const i of maters) {
+      let mate = this.granted[i] & INTENT_MATE ? agents[mateTarget[i]] : undefined;
+      if (mate && !mate.canReproduce()) {
+        mate = undefined;
+        this.stats.contestedMates++;
+      }
+      results.push(this.commitReproduce(agents[i], mate));
+    }
+
+    // Drop agent references held by the reused buffers
+    indexOf.clear();
+    eatRequests.length = 0;
+    mateRequests.length = 0;
+    return results;
+  }
+
+  private selectFood(i: number, agent: Agent, foodManager: FoodManager, targetId?: string): void {
+    const { x, y } = agent.position;
+
+    if (this.foodField) {
+      this.eatTarget[i] = this.foodField.cellIndexAt(x, y);
+      this.eatDistance[i] = 0;
+      return;
+    }
+
+    let food: Food | null = null;
+    if (targetId) {
+      food = foodManager.getFood(targetId) ?? null;
+      if (food && (food.isConsumed || !this.isInRange(agent.position, food.position, this.config.eatRadius))) {
+        food = null;
+      }
+    }
+    if (!food) {
+      food = foodManager.getClosestFood(x, y, this.config.eatRadius);
+    }
+
+    if (food) {
+      this.eatTarget[i] = food.row;
+      this.eatDistance[i] = this.getDistance(agent.position, food.position);
+    }
+  }
+
+  private selectMate(
+    i: number,
+    agent: Agent,
+    agentManager: AgentManager,
+    mateId?: string
+  ): void {
+    if (!agent.canReproduce()) return;
+    const indexOf = this.actingIndex;
+
+    if (mateId) {
+      const requested = agentManager.getAgent(mateId);
+      const j = requested ? indexOf.get(requested) : undefined;
+      if (
+        requested &&
+        j !== undefined &&
+        requested.alive() &&
+        this.isInRange(agent.position, requested.position, this.config.mateRadius) &&
+        (!this.mateFilter || this.mateFilter(agent, requested))
+      ) {
+        this.mateTarget[i] = j;
+        this.mateDistance[i] = this.getDistance(agent.position, requested.position);
+        return;
+      }
+    }
+
+    // Nearest compatible neighbour acting this tick, ties by id
+    const best = agentManager.findNearestMate(
+      agent,
+      this.config.mateRadius,
+      this.mateFilter ?? undefined,
+      this.isActing
+    );
+
+    if (best) {
+      this.mateTarget[i] = indexOf.get(best)!;
+      this.mateDistance[i] = this.getDistance(agent.position, best.position);
+    }
+  }
+
+  /**
+   * Agents with the given intent, sorted by (target, distance, tie-break)
+   */
+  private claimOrder(
+    order: number[],
+    n: number,
+    intent: number,
+    target: Int32Array,
+    dist: Float64Array
+  ): number[] {
+    order.length = 0;
+    for (let i = 0; i < n; i++) {
+      if (this.intentFlags[i] & intent) order.push(i);
+    }
+
+    this.claimTarget = target;
+    this.claimDistance = dist;
+    order.sort(this.compareClaims);
+    return order;
+  }
+
+  // Bound once, so resolveActions allocates no per-tick closures
+  private compareClaims = (a: number, b: number): number =>
+    (this.claimTarget[a] - this.claimTarget[b]) ||
+    (this.claimDistance[a] - this.claimDistance[b]) ||
+    (this.tieBreak[a] - this.tieBreak[b]) ||
+    (a - b);
+
+  private isActing = (candidate: Agent): boolean => this.actingIndex.has(candidate);
+
+  private commitEat(i: number, agent: Agent, foodManager: FoodManager, currentTick: number): InteractionResult {
+    this.stats.totalEatAttempts++;
+
+    if (!(this.granted[i] & INTENT_EAT) || this.eatTarget[i] < 0) {
+      return { type: 'eat', agentId: agent.id, success: false };
+    }
+
+    if (this.foodField) {
+      return this.processFieldEat(agent);
+    }
+
+    const food = foodManager.getFoodByRow(this.eatTarget[i]);
+    if (!food) {
+      return { type: 'eat', agentId: agent.id, success: false };
+    }
+
+    const energyGained = foodManager.consumeFood(food.id, currentTick);
+    if (energyGained > 0) {
+      agent.executeEat(energyGained);
+      this.stats.successfulEats++;
+      return {
+        type: 'eat',
+        agentId: agent.id,
+        targetId: food.id,
+        success: true,
+        energyChange: energyGained,
+      };
+    }
+
+    return { type: 'eat', agentId: agent.id, targetId: food.id, success: false };
+  }
+
+  private commitReproduce(agent: Agent, mate?: Agent): InteractionResult {
+    this.stats.totalMateAttempts++;
+
+    const offspring = agent.reproduce(mate);
+    if (offspring) {
+      this.stats.successfulMates++;
+      return {
+        type: 'reproduce',
+        agentId: agent.id,
+        targetId: mate?.id,
+        success: true,
+        offspring,
+      };
+    }
+
+    return { type: 'reproduce', agentId: agent.id, success: false };
+  }
+
+  private ensureBuffers(n: number): void {
+    if (n <= this.bufferCapacity) return;
+
+    let capacity = Math.max(16, this.bufferCapacity);
+    while (capacity < n) capacity *= 2;
+
+    this.moveSpeed = new Float32Array(capacity);
+    this.rotateDelta = new Float32Array(capacity);
+    this.intentFlags = new Uint8Array(capacity);
+    this.eatTarget = new Int32Array(capacity);
+    this.eatDistance = new Float64Array(capacity);
+    this.mateTarget = new Int32Array(capacity);
+    this.mateDistance = new Float64Array(capacity);
+    this.tieBreak = new Uint32Array(capacity);
+    this.granted = new Uint8Array(capacity);
+    this.bufferCapacity = capacity;
+  }
+
   detectCollisions(agents: Agent[]): { agent1: Agent; agent2: Agent }[] {
     if (!this.config.enableCollisions) return [];
 
@@ -228,7 +679,7 @@ export class InteractionSystem {
         const a1 = aliveAgents[i];
         const a2 = aliveAgents[j];
 
-        if (this.isInRange(a1.position, a2.position, this.config.collisionRadius)) {
+        if (this.isInRange(a1.position, a2.position, this.collisionRangeOf(a1, a2))) {
           collisions.push({ agent1: a1, agent2: a2 });
           this.stats.collisionsDetected++;
         }
@@ -238,6 +689,19 @@ export class InteractionSystem {
     return collisions;
   }
 
+  /**
+   * Contact distance for a pair. Agents with a compiled body (morphology)
+   * expose their own radius; others fall back to the configured radius.
+   */
+  private collisionRangeOf(a1: Agent, a2: Agent): number {
+    const r1 = (a1 as Partial<CollidableAgent>).getCollisionRadius;
+    const r2 = (a2 as Partial<CollidableAgent>).getCollisionRadius;
+    if (typeof r1 === 'function' && typeof r2 === 'function') {
+      return r1.call(a1) + r2.call(a2);
+    }
+    return this.config.collisionRadius;
+  }
+
   private isInRange(pos1: Position, pos2: { x: number; y: number }, radius: number): boolean {
     const dx = this.wrapDistance(pos1.x - pos2.x, this.worldWidth);
     const dy = this.wrapDistance(pos1.y - pos2.y, this.worldHeight);
@@ -268,6 +732,8 @@ export class InteractionSystem {
       totalMateAttempts: 0,
       successfulMates: 0,
       collisionsDetected: 0,
+      contestedEats: 0,
+      contestedMates: 0,
     };
   }
 
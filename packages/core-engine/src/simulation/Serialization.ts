@@ -7,8 +7,14 @@
 import { SimulationEngine, SimulationConfig, SimulationCallbacks } from './SimulationEngine';
 import { Agent } from '../agents/Agent';
 import { Food, FoodState } from './Food';
+import type { FoodField } from './FoodField';
+import type { Brain, BrainConfig, BrainState } from '../neural/Brain';
 import { NeuralBrain } from '../neural/NeuralBrain';
 import { NeuralNetwork } from '../neural/NeuralNetwork';
+import { MLPBrain } from '../neural/MLPBrain';
+import { MultiLayerNetwork, MultiLayerNetworkState } from '../neural/MultiLayerNetwork';
+import { RecurrentBrain, RECURRENT_BRAIN_TYPE } from '../neural/RecurrentBrain';
+import { RecurrentStateBuffer } from '../neural/RecurrentStateBuffer';
 import { Genome } from '../genetics/Genome';
 import { VERSION } from '../index';
 
@@ -25,6 +31,8 @@ export interface SerializedSimulation {
   };
   agents: SerializedAgent[];
   food: SerializedFood[];
+  recurrentStates?: string;   // Base64 RecurrentStateBuffer.toBytes(), indexed by brain.stateSlot
+  foodField?: SerializedFoodField;
   statistics: {
     totalBirths: number;
     totalDeaths: number;
@@ -54,6 +62,10 @@ export interface SerializedAgent {
       hiddenBias: number[];
       outputBias: number[];
     };
+    multiLayerNetwork?: MultiLayerNetworkState;   // MLPBrain
+    multiLayerConfig?: BrainConfig;               // MLPBrain mutation settings and label
+    state?: BrainState;                           // RecurrentBrain; hidden state inline unless stateSlot is set
+    stateSlot?: number;                           // RecurrentBrain row in recurrentStates
   };
   stats: {
     totalDistance: number;
@@ -72,6 +84,12 @@ export interface SerializedFood {
   consumedAtTick?: number;
 }
 
+export interface SerializedFoodField {
+  cells: string;              // Base64 Float32Array of cell energies, row-major
+  totalEaten: number;
+  bites: number;
+}
+
 /**
  * Serialize a simulation to JSON-compatible object
  */
@@ -79,8 +97,15 @@ export function serializeSimulation(simulation: SimulationEngine): SerializedSim
   const config = simulation.getConfig();
   const agentManager = simulation.getAgentManager();
   const foodManager = simulation.getFoodManager();
+  const foodField = simulation.getFoodField();
   const statistics = simulation.getStatistics();
   const summary = statistics.getSummary();
+  const agents = agentManager.getAllAgents().map(serializeAgent);
+
+  // Recurrent hidden state goes out as one block; agents keep their slot
+  const recurrentStates = agents.some((agent) => agent.brain.stateSlot !== undefined)
+    ? bytesToBase64(agentManager.getRecurrentStates().toBytes())
+    : undefined;
 
   return {
     version: VERSION,
@@ -89,6 +114,7 @@ export function serializeSimulation(simulation: SimulationEngine): SerializedSim
       engine: config,
       agents: agentManager.getConfig(),
       food: foodManager.getConfig(),
+      foodField: foodField?.getConfig(),
       interaction: {},
       sensory: {},
       statistics: {},
@@ -97,8 +123,10 @@ export function serializeSimulation(simulation: SimulationEngine): SerializedSim
       tick: simulation.getCurrentTick(),
       simulationTime: simulation.getSimulationTime(),
     },
-    agents: agentManager.getAllAgents().map(serializeAgent),
+    agents,
     food: foodManager.getAllFood().map(serializeFood),
+    recurrentStates,
+    foodField: foodField ? serializeFoodField(foodField) : undefined,
     statistics: {
       totalBirths: summary.totalBirths,
       totalDeaths: summary.totalDeaths,
@@ -116,6 +144,18 @@ function serializeAgent(agent: Agent): SerializedAgent {
   if ('getNetwork' in agent.brain && typeof agent.brain.getNetwork === 'function') {
     const network = (agent.brain as { getNetwork: () => NeuralNetwork }).getNetwork();
     brainData.networkWeights = network.getWeights();
+  } else if (agent.brain instanceof MLPBrain) {
+    const { mutationRate, mutationStrength, label } = agent.brain.getConfig();
+    brainData.multiLayerNetwork = agent.brain.getMultiLayerNetwork().serialize();
+    brainData.multiLayerConfig = { mutationRate, mutationStrength, label };
+  } else if (agent.brain instanceof RecurrentBrain) {
+    const slot = agent.brain.getStateSlot();
+    if (slot >= 0) {
+      brainData.state = agent.brain.serialize(false);
+      brainData.stateSlot = slot;
+    } else {
+      brainData.state = agent.brain.serialize();
+    }
   }
 
   return {
@@ -147,6 +187,32 @@ function serializeFood(food: Food): SerializedFood {
   };
 }
 
+function serializeFoodField(field: FoodField): SerializedFoodField {
+  const cells = Float32Array.from(field.getGrid().data);
+  const { totalEaten, bites } = field.getStats();
+  return {
+    cells: bytesToBase64(new Uint8Array(cells.buffer)),
+    totalEaten,
+    bites,
+  };
+}
+
+function bytesToBase64(bytes: Uint8Array): string {
+  let binary = '';
+  const chunk = 0x8000;
+  for (let i = 0; i < bytes.length; i += chunk) {
+    binary += String.fromCharCode(...bytes.subarray(i, i + chunk));
+  }
+  return btoa(binary);
+}
+
+function base64ToBytes(text: string): Uint8Array {
+  const binary = atob(text);
+  const bytes = new Uint8Array(binary.length);
+  for (let i = 0; i < binary.length; i++) bytes[i] = binary.charCodeAt(i);
+  return bytes;
+}
+
 /**
  * Convert serialized simulation to JSON string
  */
@@ -293,9 +359,21 @@ export function loadSimulation(
     foodManager.restoreFood(foodState);
   }
 
+  // Restore the food field; saves from before it was persisted start fresh
+  const foodField = simulation.getFoodField();
+  if (foodField && data.foodField) {
+    const bytes = base64ToBytes(data.foodField.cells);
+    foodField.restore(new Float32Array(bytes.buffer, bytes.byteOffset, bytes.byteLength / 4), data.foodField);
+  } else if (foodField) {
+    foodField.initialize();
+  }
+
   // Restore agents
   const agentManager = simulation.getAgentManager();
   const agentConfig = agentManager.getConfig();
+  const recurrentStates = data.recurrentStates
+    ? RecurrentStateBuffer.fromBytes(base64ToBytes(data.recurrentStates))
+    : undefined;
 
   for (const agentData of data.agents) {
     // Reconstruct genome
@@ -308,8 +386,15 @@ export function loadSimulation(
     }
 
     // Reconstruct brain
-    let brain: NeuralBrain;
-    if (agentData.brain.networkWeights) {
+    let brain: Brain;
+    if (agentData.brain.state?.type === RECURRENT_BRAIN_TYPE) {
+      brain = RecurrentBrain.fromState(agentData.brain.state, recurrentStates, agentData.brain.stateSlot);
+    } else if (agentData.brain.multiLayerNetwork) {
+      brain = new MLPBrain(
+        { ...agentData.brain.multiLayerConfig },
+        MultiLayerNetwork.deserialize(agentData.brain.multiLayerNetwork)
+      );
+    } else if (agentData.brain.networkWeights) {
       // Restore with saved weights
       const nw = agentData.brain.networkWeights;
 
@@ -330,8 +415,13 @@ export function loadSimulation(
       );
     } else {
       // Create new brain with default architecture
-      const [inputSize, hiddenSize, outputSize] = agentConfig.networkLayers;
-      brain = new NeuralBrain({ inputSize, hiddenSize, outputSize });
+      const layers = agentConfig.networkLayers;
+      if (layers.length > 3) {
+        brain = new MLPBrain({ layers });
+      } else {
+        const [inputSize, hiddenSize, outputSize] = layers;
+        brain = new NeuralBrain({ inputSize, hiddenSize, outputSize });
+      }
     }
 
     // Restore agent
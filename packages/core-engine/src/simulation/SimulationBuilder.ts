@@ -11,6 +11,7 @@ import {
   DEFAULT_SIMULATION_CONFIG,
 } from './SimulationEngine';
 import { AgentManagerConfig } from './AgentManager';
+import { FoodFieldConfig } from './FoodField';
 import { PresetName, getPreset } from '../presets/SimulationPresets';
 
 export class SimulationBuilder {
@@ -140,6 +141,14 @@ export class SimulationBuilder {
     return this;
   }
 
+  /**
+   * Model food as a continuous field on a World grid layer
+   */
+  withFoodField(config: Partial<FoodFieldConfig> = {}): this {
+    this.config.foodField = { ...this.config.foodField, ...config, enabled: true };
+    return this;
+  }
+
   /**
    * Set interaction radii
    */
@@ -222,6 +231,16 @@ export class SimulationBuilder {
     return this;
   }
 
+  /**
+   * Enable predation with an initial food web
+   */
+  withPredation(edges: Array<{ predator: string; prey: string }>): this {
+    if (!this.config.trophic) this.config.trophic = {};
+    this.config.trophic.enabled = true;
+    this.config.trophic.predation = edges;
+    return this;
+  }
+
   /**
    * Set statistics history
    */
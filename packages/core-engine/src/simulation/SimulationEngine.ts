@@ -13,11 +13,15 @@ import { World } from '../world/World';
 import { SensorySystem, SensorConfig } from '../sensory/SensorySystem';
 import { SensoryInput } from '../neural/Brain';
 import { Agent } from '../agents/Agent';
-import { AgentManager, AgentManagerConfig } from './AgentManager';
+import { AgentManager, AgentManagerConfig, MateFilter } from './AgentManager';
 import { FoodManager, FoodManagerConfig, Food } from './Food';
-import { InteractionSystem, InteractionConfig } from './InteractionSystem';
+import { FoodField, FoodFieldConfig } from './FoodField';
+import { InteractionSystem, InteractionConfig, InteractionResult } from './InteractionSystem';
 import { Statistics, StatisticsConfig } from './Statistics';
 import { LineageRegistry } from '../lineage/Lineage';
+import { TrophicPhase, TrophicPhaseConfig } from './TrophicPhase';
+import { createRandom } from '../utils/Random';
+import type { LLMDecisionCache } from '../neural/llm/LLMDecisionCache';
 
 export interface SimulationConfig {
   engine: Partial<EngineConfig>;
@@ -26,6 +30,8 @@ export interface SimulationConfig {
   interaction: Partial<InteractionConfig>;
   sensory: Partial<SensorConfig>;
   statistics: Partial<StatisticsConfig>;
+  trophic?: Partial<TrophicPhaseConfig>;
+  foodField?: Partial<FoodFieldConfig>;
 }
 
 export const DEFAULT_SIMULATION_CONFIG: SimulationConfig = {
@@ -35,6 +41,8 @@ export const DEFAULT_SIMULATION_CONFIG: SimulationConfig = {
   interaction: {},
   sensory: {},
   statistics: {},
+  trophic: {},
+  foodField: {},
 };
 
 export interface SimulationSnapshot {
@@ -66,9 +74,15 @@ export class SimulationEngine {
   private sensorySystem: SensorySystem;
   private agentManager: AgentManager;
   private foodManager: FoodManager;
+  private foodField: FoodField | null;  // Only when config.foodField.enabled
   private interactionSystem: InteractionSystem;
   private statistics: Statistics;
   private lineageRegistry: LineageRegistry;
+  private trophicPhase: TrophicPhase;
+  private decisionCache: LLMDecisionCache | null = null;
+
+  // Per-tick action lists, index-aligned with the alive agents (reused)
+  private actionBuffer: Array<ReturnType<Agent['update']> | undefined> = [];
 
   // Timing
   private lastUpdateTime: number = 0;
@@ -99,15 +113,32 @@ export class SimulationEngine {
     );
 
     this.foodManager = new FoodManager(width, height, fullConfig.food);
+    // The field adds a world layer, so it is only built when enabled
+    this.foodField = fullConfig.foodField?.enabled
+      ? new FoodField(this.world, fullConfig.foodField)
+      : null;
+
+    this.interactionSystem = new InteractionSystem(width, height, {
+      tieBreakSeed: this.config.seed ?? 0,
+      ...fullConfig.interaction,
+    });
+    if (this.foodField) {
+      this.interactionSystem.setFoodField(this.foodField);
+    }
 
-    this.interactionSystem = new InteractionSystem(
+    this.statistics = new Statistics(fullConfig.statistics);
+
+    // Seeded runs resolve hunts deterministically
+    const trophicRandom = this.config.seed !== undefined
+      ? createRandom(this.config.seed)
+      : null;
+    this.trophicPhase = new TrophicPhase(
       width,
       height,
-      fullConfig.interaction
+      fullConfig.trophic,
+      trophicRandom ? () => trophicRandom.random() : Math.random
     );
 
-    this.statistics = new Statistics(fullConfig.statistics);
-
     // Wire up callbacks
     this.setupCallbacks();
   }
@@ -115,6 +146,7 @@ export class SimulationEngine {
   private setupCallbacks(): void {
     this.agentManager.onAgentDeath = (agent) => {
       this.statistics.recordDeath();
+      this.trophicPhase.forgetAgent(agent);
       this.callbacks.onAgentDeath?.(agent);
     };
 
@@ -132,13 +164,34 @@ export class SimulationEngine {
     this.callbacks = { ...this.callbacks, ...callbacks };
   }
 
+  /**
+   * Restrict mate search to compatible partners (e.g. isolationMateFilter).
+   * Replaces the filter built from interaction.reproductiveIsolation.
+   */
+  setMateFilter(filter: MateFilter | null): void {
+    this.interactionSystem.setMateFilter(filter);
+  }
+
+  /**
+   * Drive an LLM decision cache's TTL clock from the simulation tick
+   */
+  setDecisionCache(cache: LLMDecisionCache | null): void {
+    this.decisionCache = cache;
+    cache?.setTick(this.currentTick);
+  }
+
   initialize(): void {
     if (this.state !== SimulationState.IDLE) {
       this.reset();
     }
 
     this.agentManager.initialize();
-    this.foodManager.initialize();
+    if (this.foodField) {
+      this.foodManager.clear();
+      this.foodField.initialize();
+    } else {
+      this.foodManager.initialize();
+    }
     this.statistics.initialize();
 
     this.currentTick = 0;
@@ -192,6 +245,7 @@ export class SimulationEngine {
     this.agentManager.clear();
     this.foodManager.clear();
     this.statistics.clear();
+    this.trophicPhase.clear();
   }
 
   step(count: number = 1): void {
@@ -265,57 +319,118 @@ export class SimulationEngine {
 
   private tick(): void {
     this.statistics.beginTick(this.currentTick);
+    this.decisionCache?.setTick(this.currentTick);
 
     // 1. Update food
-    this.foodManager.update(this.currentTick);
+    if (this.foodField) {
+      this.foodField.update(this.currentTick);
+    } else {
+      this.foodManager.update(this.currentTick);
+    }
 
     // 2. Gather sensory input and process agent decisions
     const agents = this.agentManager.getAliveAgents();
-    const allActions: Map<string, ReturnType<Agent['update']>> = new Map();
+    const allActions = this.actionBuffer;
+    allActions.length = agents.length;
+    const trophic = this.trophicPhase.enabled;
+
+    // AgentManager's index is shared with the trophic phase: built here for
+    // threat sensing, and again after movement for mating and hunts
+    const agentIndex = this.agentManager.getSpatialIndex();
+    if (trophic) {
+      this.agentManager.buildSpatialIndex();
+    }
 
-    for (const agent of agents) {
-      const sensoryInput = this.gatherSensoryInput(agent);
+    for (let i = 0; i < agents.length; i++) {
+      const agent = agents[i];
+      let sensoryInput = this.gatherSensoryInput(agent);
+      if (this.foodField) {
+        sensoryInput = this.foodField.applySensing(
+          agent.position.x,
+          agent.position.y,
+          agent.rotation,
+          sensoryInput
+        );
+      }
+      if (trophic) {
+        sensoryInput = this.trophicPhase.applyThreatSensing(agent, sensoryInput, agentIndex);
+      }
       const actions = agent.update(sensoryInput, this.config.timing.deltaTime);
-      allActions.set(agent.id, actions);
+      allActions[i] = actions;
     }
 
-    // 3. Process actions and interactions
-    for (const agent of agents) {
-      const actions = allActions.get(agent.id);
-      if (actions && agent.alive()) {
-        const results = this.interactionSystem.processActions(
-          agent,
-          actions,
-          this.agentManager,
-          this.foodManager,
-          this.currentTick
-        );
+    // Sensing positions go stale as soon as agents move
+    this.agentManager.invalidateSpatialIndex();
 
-        // Track food consumption
-        for (const result of results) {
-          if (result.type === 'eat' && result.success) {
-            this.statistics.recordFoodConsumed();
+    // 3. Process actions and interactions
+    if (this.interactionSystem.getConfig().batchResolution) {
+      const results = this.interactionSystem.resolveActions(
+        agents,
+        allActions,
+        this.agentManager,
+        this.foodManager,
+        this.currentTick
+      );
+      for (const result of results) {
+        this.recordInteraction(result, trophic);
+      }
+    } else {
+      for (let i = 0; i < agents.length; i++) {
+        const agent = agents[i];
+        const actions = allActions[i];
+        if (actions && agent.alive()) {
+          const results = this.interactionSystem.processActions(
+            agent,
+            actions,
+            this.agentManager,
+            this.foodManager,
+            this.currentTick
+          );
+          for (const result of results) {
+            this.recordInteraction(result, trophic);
           }
         }
       }
     }
 
-    // 4. Update agent manager (handle deaths, respawns)
+    // 4. Resolve predation (mating may leave a current post-move index built)
+    if (trophic) {
+      if (!this.agentManager.isSpatiallyIndexed()) {
+        this.agentManager.buildSpatialIndex();
+      }
+      this.trophicPhase.resolveHunts(agents, this.currentTick, agentIndex);
+    }
+
+    // 5. Update agent manager (handle deaths, respawns)
     this.agentManager.update(this.currentTick);
 
-    // 5. Update statistics
+    // 6. Update statistics
     this.statistics.endTick(
       this.agentManager.getAllAgents(),
-      this.foodManager.getAllFood()
+      this.foodManager.getAllFood(),
+      this.foodField
     );
 
-    // 6. Increment tick
+    // 7. Increment tick
     this.currentTick++;
     this.simulationTime += this.config.timing.deltaTime;
 
     this.callbacks.onTick?.(this.currentTick, this.statistics.getSummary());
   }
 
+  /**
+   * Track food consumption from an interaction result
+   */
+  private recordInteraction(result: InteractionResult, trophic: boolean): void {
+    if (result.type !== 'eat' || !result.success) return;
+
+    this.statistics.recordFoodConsumed();
+    if (trophic) {
+      const agent = this.agentManager.getAgent(result.agentId);
+      if (agent) this.trophicPhase.recordFoodConsumption(agent);
+    }
+  }
+
   private gatherSensoryInput(agent: Agent): SensoryInput {
     // Create a world-like interface for the sensory system
     const worldLike = {
@@ -375,6 +490,10 @@ export class SimulationEngine {
     return this.foodManager;
   }
 
+  getFoodField(): FoodField | null {
+    return this.foodField;
+  }
+
   getStatistics(): Statistics {
     return this.statistics;
   }
@@ -387,6 +506,10 @@ export class SimulationEngine {
     return this.world;
   }
 
+  getTrophicPhase(): TrophicPhase {
+    return this.trophicPhase;
+  }
+
   getConfig(): EngineConfig {
     return { ...this.config };
   }
@@ -427,6 +550,7 @@ export class SimulationEngine {
   prepareForRestore(): void {
     this.agentManager.clearForRestore();
     this.foodManager.clearForRestore();
+    this.trophicPhase.clear();
     this.currentTick = 0;
     this.simulationTime = 0;
   }
@@ -6,6 +6,7 @@
 
 import { Agent } from '../agents/Agent';
 import { Food } from './Food';
+import type { FoodField } from './FoodField';
 
 export interface PopulationStats {
   count: number;
@@ -126,7 +127,11 @@ export class Statistics {
     this.resetTickCounters();
   }
 
-  endTick(agents: Agent[], foods: Food[]): void {
+  /**
+   * Close the tick. A food field's energy is added to the food totals; it is
+   * only summed on snapshot ticks.
+   */
+  endTick(agents: Agent[], foods: Food[], foodField: FoodField | null = null): void {
     const now = Date.now();
     const tickDuration = now - this.lastTickTime;
 
@@ -138,7 +143,7 @@ export class Statistics {
 
     // Take snapshot if needed
     if (this.currentTick % this.config.snapshotInterval === 0) {
-      const snapshot = this.createSnapshot(agents, foods, tickDuration);
+      const snapshot = this.createSnapshot(agents, foods, foodField, tickDuration);
       this.history.push(snapshot);
 
       // Trim history
@@ -148,12 +153,17 @@ export class Statistics {
     }
   }
 
-  private createSnapshot(agents: Agent[], foods: Food[], tickDuration: number): TickSnapshot {
+  private createSnapshot(
+    agents: Agent[],
+    foods: Food[],
+    foodField: FoodField | null,
+    tickDuration: number
+  ): TickSnapshot {
     return {
       tick: this.currentTick,
       timestamp: Date.now(),
       population: this.calculatePopulationStats(agents),
-      food: this.calculateFoodStats(foods),
+      food: this.calculateFoodStats(foods, foodField),
       performance: this.calculatePerformanceStats(tickDuration),
     };
   }
@@ -201,9 +211,9 @@ export class Statistics {
     };
   }
 
-  private calculateFoodStats(foods: Food[]): FoodStats {
+  private calculateFoodStats(foods: Food[], foodField: FoodField | null): FoodStats {
     let activeCount = 0;
-    let totalEnergy = 0;
+    let totalEnergy = foodField ? foodField.getStats().totalEnergy : 0;
 
     for (const food of foods) {
       if (!food.isConsumed) {
@@ -0,0 +1,189 @@
+/**
+ * TrophicPhase.test.ts - Tests for the predation phase of the tick
+ */
+
+import { describe, it, expect } from 'vitest';
+import { TrophicPhase } from './TrophicPhase';
+import { SimulationEngine } from './SimulationEngine';
+import { Agent } from '../agents/Agent';
+import { Genome } from '../genetics/Genome';
+import { Brain, SensoryInput, BrainOutput } from '../neural/Brain';
+
+class IdleBrain implements Brain {
+  readonly type = 'idle';
+  readonly inputSize = 7;
+  readonly outputSize = 3;
+
+  think(_input: SensoryInput): BrainOutput {
+    return { moveForward: 0, rotate: 0, action: 0 };
+  }
+
+  mutate(): Brain {
+    return new IdleBrain();
+  }
+
+  clone(): Brain {
+    return new IdleBrain();
+  }
+
+  toJSON(): object {
+    return { type: this.type };
+  }
+}
+
+function makeAgent(id: string, speciesId: string, x: number, y: number, rotation = 0): Agent {
+  return new Agent(id, speciesId, { x, y }, rotation, 50, new IdleBrain(), Genome.withSize(10), 0, id);
+}
+
+const EMPTY_INPUT: SensoryInput = {
+  front: 0,
+  frontLeft: 0,
+  frontRight: 0,
+  left: 0,
+  right: 0,
+  energy: 0.5,
+  bias: 1,
+};
+
+describe('TrophicPhase', () => {
+  const predation = [{ predator: 'wolf', prey: 'sheep' }];
+
+  describe('hunt resolution', () => {
+    it('should let a predator kill nearby prey', () => {
+      const phase = new TrophicPhase(500, 500, { enabled: true, predation }, () => 0);
+      const wolf = makeAgent('w1', 'wolf', 100, 100);
+      const sheep = makeAgent('s1', 'sheep', 110, 100);
+
+      phase.buildIndex([wolf, sheep]);
+      phase.resolveHunts([wolf, sheep], 0);
+
+      expect(sheep.alive()).toBe(false);
+      expect(wolf.energy).toBeGreaterThan(50 - 5);
+      expect(phase.getStats().preyKilled).toBe(1);
+    });
+
+    it('should not hunt when prey escapes', () => {
+      const phase = new TrophicPhase(500, 500, { enabled: true, predation }, () => 0.99);
+      const wolf = makeAgent('w1', 'wolf', 100, 100);
+      const sheep = makeAgent('s1', 'sheep', 110, 100);
+
+      phase.buildIndex([wolf, sheep]);
+      phase.resolveHunts([wolf, sheep], 0);
+
+      expect(sheep.alive()).toBe(true);
+      expect(phase.getStats().huntsAttempted).toBe(1);
+    });
+
+    it('should resolve contested prey independently of agent order', () => {
+      const run = (order: string[]) => {
+        const phase = new TrophicPhase(500, 500, { enabled: true, predation }, () => 0);
+        const agents: Record<string, Agent> = {
+          w1: makeAgent('w1', 'wolf', 120, 100),
+          w2: makeAgent('w2', 'wolf', 95, 100),
+          s1: makeAgent('s1', 'sheep', 100, 100),
+        };
+        const list = order.map(id => agents[id]);
+        phase.buildIndex(list);
+        phase.resolveHunts(list, 0);
+        return {
+          w1: agents.w1.energy,
+          w2: agents.w2.energy,
+          contested: phase.getStats().contestedHunts,
+        };
+      };
+
+      const a = run(['w1', 'w2', 's1']);
+      const b = run(['s1', 'w2', 'w1']);
+
+      expect(a).toEqual(b);
+      // Nearest predator wins, the other does not pay the hunting cost
+      expect(a.w2).toBeGreaterThan(a.w1);
+      expect(a.w1).toBe(50);
+      expect(a.contested).toBe(1);
+    });
+
+    it('should hunt across the world seam', () => {
+      const phase = new TrophicPhase(500, 500, { enabled: true, predation }, () => 0);
+      const wolf = makeAgent('w1', 'wolf', 495, 100);
+      const sheep = makeAgent('s1', 'sheep', 5, 100);
+
+      phase.buildIndex([wolf, sheep]);
+      phase.resolveHunts([wolf, sheep], 0);
+
+      expect(sheep.alive()).toBe(false);
+    });
+
+    it('should hunt from positions after movement', () => {
+      const phase = new TrophicPhase(500, 500, { enabled: true, predation }, () => 0);
+      const wolf = makeAgent('w1', 'wolf', 100, 100);
+      const sheep = makeAgent('s1', 'sheep', 300, 100);
+
+      phase.buildIndex([wolf, sheep]);
+      sheep.position.x = 105;
+      phase.resolveHunts([wolf, sheep], 0);
+
+      expect(sheep.alive()).toBe(false);
+    });
+
+    it('should ignore species without a predation relationship', () => {
+      const phase = new TrophicPhase(500, 500, { enabled: true, predation }, () => 0);
+      const a = makeAgent('a', 'sheep', 100, 100);
+      const b = makeAgent('b', 'sheep', 105, 100);
+
+      phase.buildIndex([a, b]);
+      phase.resolveHunts([a, b], 0);
+
+      expect(phase.getStats().huntsAttempted).toBe(0);
+    });
+  });
+
+  describe('threat sensing', () => {
+    it('should lower the front channel for a predator ahead', () => {
+      const phase = new TrophicPhase(500, 500, { enabled: true, predation });
+      const sheep = makeAgent('s1', 'sheep', 100, 100, 0);
+      const wolf = makeAgent('w1', 'wolf', 140, 100);
+
+      phase.buildIndex([sheep, wolf]);
+      const input = phase.applyThreatSensing(sheep, { ...EMPTY_INPUT, front: 0.5 });
+
+      expect(input.front).toBeLessThan(0.5);
+      expect(input.front).toBeGreaterThanOrEqual(-1);
+      expect(input.left).toBe(0);
+      expect(input.energy).toBe(EMPTY_INPUT.energy);
+    });
+
+    it('should see a predator ahead across the world edge', () => {
+      const phase = new TrophicPhase(500, 500, { enabled: true, predation });
+      const sheep = makeAgent('s1', 'sheep', 490, 100, 0);
+      const wolf = makeAgent('w1', 'wolf', 20, 100);
+
+      phase.buildIndex([sheep, wolf]);
+      const input = phase.applyThreatSensing(sheep, { ...EMPTY_INPUT });
+
+      expect(input.front).toBeLessThan(0);
+      expect(input.left).toBe(0);
+      expect(input.right).toBe(0);
+    });
+  });
+
+  describe('engine integration', () => {
+    it('should run a seeded predator-prey simulation', () => {
+      const engine = new SimulationEngine({
+        engine: { seed: 42, world: { dimensions: { width: 200, height: 200 } } },
+        agents: { initialPopulation: 30, speciesCount: 2 },
+        trophic: {
+          enabled: true,
+          predation: [{ predator: 'species_1', prey: 'species_0' }],
+        },
+      });
+
+      engine.step(50);
+
+      expect(engine.getCurrentTick()).toBe(50);
+      expect(engine.getTrophicPhase().getStats().huntsAttempted).toBeGreaterThan(0);
+      expect(engine.getTrophicPhase().getSpatialIndex().size).toBeGreaterThan(0);
+      expect(engine.getTrophicPhase().getSpatialIndex())
+        .toBe(engine.getAgentManager().getSpatialIndex());
+    });
+  });
+});
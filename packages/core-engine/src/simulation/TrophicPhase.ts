@@ -0,0 +1,383 @@
+/**
+ * TrophicPhase.ts - Predation phase of the simulation tick
+ *
+ * Owns the trophic systems (role tracker, hunting, threat sensing) and reads
+ * agents through one spatial index shared by threat sensing and hunt
+ * resolution. The engine passes AgentManager's index, so the tick builds
+ * one index per set of positions for every phase; standalone callers use
+ * the phase's own index (buildIndex).
+ */
+
+import { Agent } from '../agents/Agent';
+import { SensoryInput } from '../neural/Brain';
+import { SpatialHash, SpatialQuery, QueryResult } from '../spatial';
+import { TrophicRoleTracker } from '../trophic/TrophicRoleTracker';
+import { HuntingSystem, HuntingSystemConfig } from '../trophic/HuntingSystem';
+import { TrophicAgent } from '../trophic/types';
+import {
+  TrophicSensorySystem,
+  TrophicSensorConfig,
+  TrophicWorldLike,
+  PredatorChannels,
+  createPredatorChannels,
+} from '../sensory/TrophicSensorySystem';
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+export interface PredationEdge {
+  predator: string;   // Predator species ID
+  prey: string;       // Prey species ID
+}
+
+export interface TrophicPhaseConfig {
+  enabled: boolean;
+  hunting: Partial<HuntingSystemConfig>;
+  sensory: Partial<TrophicSensorConfig>;
+  cellSize: number;               // Spatial index cell size
+  threatWeight: number;           // How far a predator pulls a directional channel below zero
+  predation: PredationEdge[];     // Food-web edges known from the start
+}
+
+export const DEFAULT_TROPHIC_PHASE_CONFIG: TrophicPhaseConfig = {
+  enabled: false,
+  hunting: {},
+  sensory: {},
+  cellSize: 50,
+  threatWeight: 1.0,
+  predation: [],
+};
+
+export interface TrophicPhaseStats {
+  huntsAttempted: number;
+  huntsSuccessful: number;
+  preyKilled: number;
+  contestedHunts: number;  // Attempts skipped because the prey was already taken
+}
+
+// ============================================================================
+// Agent View
+// ============================================================================
+
+/**
+ * Adapts a simulation Agent to the trophic interfaces. Physical traits are
+ * read through when the agent has a body (e.g. MorphologicalAgent).
+ */
+class TrophicAgentView implements TrophicAgent {
+  constructor(readonly agent: Agent, readonly speciesSlot: number) {}
+
+  get id(): string { return this.agent.id; }
+  get speciesId(): string { return this.agent.speciesId; }
+  get position(): { x: number; y: number } { return this.agent.position; }
+  get rotation(): number { return this.agent.rotation; }
+  get energy(): number { return this.agent.energy; }
+  get isAlive(): boolean { return this.agent.alive(); }
+  get size(): number | undefined { return (this.agent as Partial<TrophicAgent>).size; }
+  get speed(): number | undefined { return (this.agent as Partial<TrophicAgent>).speed; }
+  get strength(): number | undefined { return (this.agent as Partial<TrophicAgent>).strength; }
+  get perception(): number | undefined { return (this.agent as Partial<TrophicAgent>).perception; }
+  get slot(): number { return this.agent.slot; }
+}
+
+/**
+ * Presents an index of Agents as an index of their trophic views
+ */
+class TrophicIndexView implements SpatialQuery<TrophicAgentView> {
+  source: SpatialHash<Agent>;
+  private visitor: ((entity: TrophicAgentView, distanceSq: number) => void) | null = null;
+
+  constructor(source: SpatialHash<Agent>, private viewOf: (agent: Agent) => TrophicAgentView) {
+    this.source = source;
+  }
+
+  queryRadiusSorted(x: number, y: number, radius: number): QueryResult<TrophicAgentView>[] {
+    const results: QueryResult<TrophicAgentView>[] = [];
+    for (const { entity, distance } of this.source.queryRadiusSorted(x, y, radius)) {
+      if (entity.alive()) results.push({ entity: this.viewOf(entity), distance });
+    }
+    return results;
+  }
+
+  forEachInRadius(
+    x: number,
+    y: number,
+    radius: number,
+    visitor: (entity: TrophicAgentView, distanceSq: number) => void
+  ): void {
+    const outer = this.visitor;
+    this.visitor = visitor;
+    this.source.forEachInRadius(x, y, radius, this.forward);
+    this.visitor = outer;
+  }
+
+  // Bound once so visits allocate no closures; dead agents get no view
+  private forward = (agent: Agent, distanceSq: number): void => {
+    if (agent.alive()) this.visitor!(this.viewOf(agent), distanceSq);
+  };
+}
+
+interface HuntIntent {
+  predator: TrophicAgentView;
+  prey: TrophicAgentView;
+  distance: number;
+}
+
+// The index always supplies neighbours, so the world fallback is unused
+const EMPTY_WORLD: TrophicWorldLike = {
+  getAgents: () => [],
+  getFood: () => [],
+};
+
+// ============================================================================
+// TrophicPhase Class
+// ============================================================================
+
+export class TrophicPhase {
+  private config: TrophicPhaseConfig;
+  private tracker: TrophicRoleTracker;
+  private hunting: HuntingSystem;
+  private sensory: TrophicSensorySystem;
+  private ownIndex: SpatialHash<Agent>;
+  private index: TrophicIndexView;
+  private views: Map<string, TrophicAgentView> = new Map();
+  private stats: TrophicPhaseStats;
+
+  // Reused per-tick buffers for batched target selection
+  private predatorBuffer: TrophicAgentView[] = [];
+  private preyBuffer: Array<TrophicAgent | null> = [];
+  private distanceBuffer: number[] = [];
+  private threat: PredatorChannels = createPredatorChannels();
+
+  constructor(
+    worldWidth: number,
+    worldHeight: number,
+    config?: Partial<TrophicPhaseConfig>,
+    random: () => number = Math.random
+  ) {
+    this.config = { ...DEFAULT_TROPHIC_PHASE_CONFIG, ...config };
+    this.tracker = new TrophicRoleTracker(this.config.hunting);
+    this.hunting = new HuntingSystem(
+      this.tracker,
+      { worldWidth, worldHeight, wrapEdges: true, ...this.config.hunting },
+      random
+    );
+    this.sensory = new TrophicSensorySystem(this.tracker, {
+      worldWidth,
+      worldHeight,
+      wrapEdges: true,
+      ...this.config.sensory,
+      useSpatialHash: true,
+    });
+    this.ownIndex = new SpatialHash<Agent>({
+      cellSize: this.config.cellSize,
+      worldWidth,
+      worldHeight,
+      wrapEdges: true,
+    });
+    this.index = new TrophicIndexView(this.ownIndex, (agent) => this.viewOf(agent));
+    this.stats = this.emptyStats();
+    this.seedFoodWeb();
+  }
+
+  get enabled(): boolean {
+    return this.config.enabled;
+  }
+
+  /**
+   * Rebuild the phase's own agent index, for callers that do not pass one.
+   * resolveHunts() rebuilds it from post-movement positions.
+   */
+  buildIndex(agents: Agent[]): void {
+    this.ownIndex.clear();
+    for (const agent of agents) {
+      if (agent.alive()) this.ownIndex.insert(agent);
+    }
+  }
+
+  /**
+   * Subtract predator proximity from an agent's directional channels,
+   * keeping the 7-input layout. Food raises a channel and a predator in the
+   * same cone lowers it, down to -1, so brains that steer toward high
+   * channels steer away from predators; a negative channel means a threat
+   * outweighs any food there. Writes into `input` and returns it.
+   * `index` must hold current positions; without it the own index is read.
+   */
+  applyThreatSensing(agent: Agent, input: SensoryInput, index?: SpatialHash<Agent>): SensoryInput {
+    this.index.source = index ?? this.ownIndex;
+    const threat = this.sensory.sensePredatorChannels(
+      this.viewOf(agent),
+      EMPTY_WORLD,
+      this.index,
+      this.threat
+    );
+    const w = this.config.threatWeight;
+
+    input.front = Math.max(-1, input.front - threat.front * w);
+    input.frontLeft = Math.max(-1, input.frontLeft - threat.frontLeft * w);
+    input.frontRight = Math.max(-1, input.frontRight - threat.frontRight * w);
+    input.left = Math.max(-1, input.left - threat.left * w);
+    input.right = Math.max(-1, input.right - threat.right * w);
+    return input;
+  }
+
+  /**
+   * Select and resolve hunts for the tick.
+   *
+   * Agents have moved since sensing, so `index` must be built from their
+   * current positions; without it the own index is rebuilt from `agents`.
+   * Each predator then picks its best target from the index. Intents are
+   * then grouped by prey and resolved in (prey id, distance, predator id)
+   * order, so the outcome does not depend on agent iteration order. Once a
+   * prey is killed, the remaining predators targeting it do not attempt.
+   */
+  resolveHunts(agents: Agent[], tick: number, index?: SpatialHash<Agent>): void {
+    this.hunting.advanceCooldowns(tick);
+    if (!index) this.buildIndex(agents);
+    this.index.source = index ?? this.ownIndex;
+
+    const predators = this.predatorBuffer;
+    predators.length = 0;
+    for (const agent of agents) {
+      if (agent.alive()) predators.push(this.viewOf(agent));
+    }
+
+    const preyOut = this.preyBuffer;
+    const distanceOut = this.distanceBuffer;
+    preyOut.length = predators.length;
+    distanceOut.length = predators.length;
+    this.hunting.getBestTargets(predators, this.index, tick, preyOut, distanceOut);
+
+    const intents: HuntIntent[] = [];
+    for (let i = 0; i < predators.length; i++) {
+      const prey = preyOut[i];
+      if (prey) {
+        intents.push({
+          predator: predators[i],
+          prey: prey as TrophicAgentView,
+          distance: distanceOut[i],
+        });
+      }
+      preyOut[i] = null;
+    }
+
+    intents.sort(compareIntents);
+
+    for (const { predator, prey } of intents) {
+      if (!predator.isAlive) continue;
+      if (!prey.isAlive) {
+        this.stats.contestedHunts++;
+        continue;
+      }
+
+      const outcome = this.hunting.processHunt(predator, prey, tick);
+      this.stats.huntsAttempted++;
+
+      const hunter = predator.agent;
+      if (outcome.predatorEnergyChange < 0) {
+        hunter.energy += outcome.predatorEnergyChange;
+      } else if (outcome.predatorEnergyChange > 0) {
+        hunter.executeEat(outcome.predatorEnergyChange);
+      }
+
+      if (outcome.preyEnergyChange < 0) {
+        this.stats.huntsSuccessful++;
+        prey.agent.energy += outcome.preyEnergyChange;
+        if (outcome.preyKilled || prey.agent.energy <= 0) {
+          prey.agent.die();
+          this.stats.preyKilled++;
+        }
+      }
+
+      if (hunter.energy <= 0) {
+        hunter.die();
+      }
+    }
+
+    this.tracker.updateRoles(tick);
+  }
+
+  /**
+   * Record non-predatory feeding for role detection
+   */
+  recordFoodConsumption(agent: Agent): void {
+    this.tracker.recordFoodConsumption(agent.speciesId);
+  }
+
+  /**
+   * Drop per-agent state when an agent leaves the simulation
+   */
+  forgetAgent(agent: Agent): void {
+    this.hunting.clearCooldown(this.viewOf(agent));
+    this.views.delete(agent.id);
+  }
+
+  private viewOf(agent: Agent): TrophicAgentView {
+    let view = this.views.get(agent.id);
+    if (!view || view.agent !== agent) {
+      view = new TrophicAgentView(agent, this.tracker.registerSpecies(agent.speciesId));
+      this.views.set(agent.id, view);
+    }
+    return view;
+  }
+
+  private seedFoodWeb(): void {
+    for (const { predator, prey } of this.config.predation) {
+      this.tracker.declarePredation(predator, prey);
+    }
+  }
+
+  private emptyStats(): TrophicPhaseStats {
+    return {
+      huntsAttempted: 0,
+      huntsSuccessful: 0,
+      preyKilled: 0,
+      contestedHunts: 0,
+    };
+  }
+
+  // Getters
+  getTrophicTracker(): TrophicRoleTracker {
+    return this.tracker;
+  }
+
+  getHuntingSystem(): HuntingSystem {
+    return this.hunting;
+  }
+
+  /**
+   * The agent index read by the last sensing or hunt pass
+   */
+  getSpatialIndex(): SpatialHash<Agent> {
+    return this.index.source;
+  }
+
+  getStats(): TrophicPhaseStats {
+    return { ...this.stats };
+  }
+
+  getConfig(): TrophicPhaseConfig {
+    return { ...this.config };
+  }
+
+  /**
+   * Reset all trophic state, keeping the seeded food web
+   */
+  clear(): void {
+    this.ownIndex.clear();
+    this.index.source = this.ownIndex;
+    this.views.clear();
+    this.hunting.clear();
+    this.tracker.clear();
+    this.stats = this.emptyStats();
+    this.seedFoodWeb();
+  }
+}
+
+function compareIntents(a: HuntIntent, b: HuntIntent): number {
+  if (a.prey.id !== b.prey.id) return a.prey.id < b.prey.id ? -1 : 1;
+  if (a.distance !== b.distance) return a.distance - b.distance;
+  return a.predator.id < b.predator.id ? -1 : a.predator.id > b.predator.id ? 1 : 0;
+}
+
+export default TrophicPhase;
@@ -5,6 +5,7 @@
 // Food system
 export {
   Food,
+  FoodStore,
   FoodManager,
   DEFAULT_FOOD_CONFIG,
   DEFAULT_FOOD_MANAGER_CONFIG,
@@ -16,6 +17,17 @@ export type {
   FoodManagerConfig,
 } from './Food';
 
+// Continuous food field
+export {
+  FoodField,
+  DEFAULT_FOOD_FIELD_CONFIG,
+} from './FoodField';
+
+export type {
+  FoodFieldConfig,
+  FoodFieldStats,
+} from './FoodField';
+
 // Agent management
 export {
   AgentManager,
@@ -25,12 +37,27 @@ export {
 export type {
   AgentManagerConfig,
   SpawnOptions,
+  MateFilter,
+  DeadAgentRecord,
 } from './AgentManager';
 
+// Change tracking
+export {
+  ChangeTracker,
+  createChangeSet,
+  CHANGE_POSITION,
+  CHANGE_ENERGY,
+  CHANGE_ALIVE,
+  CHANGE_ALL,
+} from './ChangeTracker';
+
+export type { ChangeSet } from './ChangeTracker';
+
 // Interaction system
 export {
   InteractionSystem,
   DEFAULT_INTERACTION_CONFIG,
+  isolationMateFilter,
 } from './InteractionSystem';
 
 export type {
@@ -38,6 +65,18 @@ export type {
   InteractionResult,
 } from './InteractionSystem';
 
+// Trophic phase
+export {
+  TrophicPhase,
+  DEFAULT_TROPHIC_PHASE_CONFIG,
+} from './TrophicPhase';
+
+export type {
+  TrophicPhaseConfig,
+  TrophicPhaseStats,
+  PredationEdge,
+} from './TrophicPhase';
+
 // Statistics
 export {
   Statistics,
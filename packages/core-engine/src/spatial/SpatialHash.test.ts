@@ -212,6 +212,21 @@ describe('SpatialHash', () => {
     });
   });
 
+  // =====================
+  // FOR EACH IN RADIUS TESTS
+  // =====================
+  describe('forEachInRadius', () => {
+    it('should visit entities within radius with squared distance', () => {
+      spatialHash.insert({ id: 'in', position: { x: 30, y: 40 } });
+      spatialHash.insert({ id: 'out', position: { x: 200, y: 200 } });
+
+      const visited: Array<[string, number]> = [];
+      spatialHash.forEachInRadius(0, 0, 100, (e, distSq) => visited.push([e.id, distSq]));
+
+      expect(visited).toEqual([['in', 2500]]);
+    });
+  });
+
   // =====================
   // FIND NEAREST TESTS
   // =====================
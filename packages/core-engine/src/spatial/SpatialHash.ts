@@ -209,6 +209,54 @@ export class SpatialHash<T extends SpatialEntity> {
     return results.sort((a, b) => a.distance - b.distance);
   }
 
+  /**
+   * Visit every entity within a radius without allocating result arrays.
+   * Visit order follows cell layout, not distance.
+   */
+  forEachInRadius(
+    x: number,
+    y: number,
+    radius: number,
+    visitor: (entity: T, distanceSq: number) => void
+  ): void {
+    const radiusSq = radius * radius;
+
+    const cellRadius = Math.ceil(radius / this.config.cellSize);
+    const centerCX = Math.floor(x / this.config.cellSize);
+    const centerCY = Math.floor(y / this.config.cellSize);
+
+    for (let dy = -cellRadius; dy <= cellRadius; dy++) {
+      for (let dx = -cellRadius; dx <= cellRadius; dx++) {
+        let cx = centerCX + dx;
+        let cy = centerCY + dy;
+
+        if (this.config.wrapEdges) {
+          cx = ((cx % this.cellsX) + this.cellsX) % this.cellsX;
+          cy = ((cy % this.cellsY) + this.cellsY) % this.cellsY;
+        } else if (cx < 0 || cx >= this.cellsX || cy < 0 || cy >= this.cellsY) {
+          continue;
+        }
+
+        const h = cy * this.cellsX + cx;
+        const cell = this.cells.get(h);
+        if (!cell) continue;
+
+        for (let i = 0; i < cell.length; i++) {
+          const entity = cell[i];
+          const distSq = this.distanceSquared(
+            x,
+            y,
+            entity.position.x,
+            entity.position.y
+          );
+          if (distSq <= radiusSq) {
+            visitor(entity, distSq);
+          }
+        }
+      }
+    }
+  }
+
   /**
    * Find the nearest entity to a point within a maximum radius
    */
@@ -37,6 +37,20 @@ export interface QueryResult<T> {
   distance: number;
 }
 
+/**
+ * Radius queries consumers need from an index (SpatialHash, or a view that
+ * maps another index's entities)
+ */
+export interface SpatialQuery<T> {
+  queryRadiusSorted(x: number, y: number, radius: number): QueryResult<T>[];
+  forEachInRadius(
+    x: number,
+    y: number,
+    radius: number,
+    visitor: (entity: T, distanceSq: number) => void
+  ): void;
+}
+
 export interface SpatialStats {
   entityCount: number;
   cellCount: number;
@@ -230,6 +230,19 @@ describe('HuntingSystem', () => {
       expect(result.reason).toBe('out_of_range');
     });
 
+    it('should measure range across the seam when wrapping', () => {
+      const wrapped = new HuntingSystem(trophicTracker, {
+        worldWidth: 500,
+        worldHeight: 500,
+        wrapEdges: true,
+      });
+      const predator = createAgent('pred', 'carnivore', 495, 100);
+      const prey = createAgent('prey', 'herbivore', 5, 100);
+
+      expect(wrapped.attemptHunt(predator, prey, 0).reason).not.toBe('out_of_range');
+      expect(huntingSystem.attemptHunt(predator, prey, 0).reason).toBe('out_of_range');
+    });
+
     it('should return failure for dead prey', () => {
       const predator = createAgent('pred', 'carnivore', 100, 100);
       const deadPrey = createAgent('prey', 'herbivore', 110, 100, { isAlive: false });
@@ -390,6 +403,48 @@ describe('HuntingSystem', () => {
       const best = huntingSystem.getBestTarget(predator, emptyHash, 0);
       expect(best).toBeNull();
     });
+
+    it('should match the first result of findPotentialPrey', () => {
+      spatialHash.insert(createAgent('prey1', 'herbivore', 110, 100, { energy: 100 }));
+      spatialHash.insert(createAgent('prey2', 'herbivore', 105, 100, { energy: 50 }));
+      spatialHash.insert(createAgent('prey3', 'herbivore', 95, 105, { energy: 80 }));
+
+      const predator = createAgent('pred', 'carnivore', 100, 100);
+      const sorted = huntingSystem.findPotentialPrey(predator, spatialHash, 0);
+      const best = huntingSystem.getBestTarget(predator, spatialHash, 0);
+
+      expect(best!.agent.id).toBe(sorted[0].agent.id);
+      expect(best!.successChance).toBeCloseTo(sorted[0].successChance, 10);
+      expect(best!.distance).toBeCloseTo(sorted[0].distance, 10);
+    });
+
+    it('should fill a caller-provided target', () => {
+      spatialHash.insert(createAgent('prey1', 'herbivore', 110, 100));
+      const predator = createAgent('pred', 'carnivore', 100, 100);
+      const out = { agent: predator, distance: 0, successChance: 0, expectedEnergyGain: 0 };
+
+      const best = huntingSystem.getBestTarget(predator, spatialHash, 0, out);
+
+      expect(best).toBe(out);
+      expect(out.agent.id).toBe('prey1');
+    });
+
+    it('should select targets for all predators in one batch', () => {
+      spatialHash.insert(createAgent('prey1', 'herbivore', 110, 100));
+      const predators = [
+        createAgent('pred1', 'carnivore', 100, 100),
+        createAgent('pred2', 'carnivore', 400, 400),
+      ];
+      const preyOut: Array<TrophicAgent | null> = [];
+      const distanceOut = new Float64Array(2);
+
+      const found = huntingSystem.getBestTargets(predators, spatialHash, 0, preyOut, distanceOut);
+
+      expect(found).toBe(1);
+      expect(preyOut[0]!.id).toBe('prey1');
+      expect(distanceOut[0]).toBeCloseTo(10, 10);
+      expect(preyOut[1]).toBeNull();
+    });
   });
 
   // =====================
@@ -451,6 +506,49 @@ describe('HuntingSystem', () => {
       const config = huntingSystem.getConfig();
       expect(huntingSystem.getCooldownRemaining(predator.id, 5)).toBe(config.huntingCooldown - 5);
     });
+
+    it('should keep slotted cooldowns in the slot column', () => {
+      const predator = createAgent('pred', 'carnivore', 100, 100, { slot: 3 });
+      const prey = createAgent('prey', 'herbivore', 110, 100);
+
+      huntingSystem.attemptHunt(predator, prey, 0);
+
+      const config = huntingSystem.getConfig();
+      expect(huntingSystem.canHunt(predator, 1)).toBe(false);
+      expect(huntingSystem.getCooldownRemaining(predator, 1)).toBe(config.huntingCooldown - 1);
+      expect(huntingSystem.getCooldownRemaining(predator.id, 1)).toBe(0);
+    });
+
+    it('should fire ready transitions when slotted cooldowns expire', () => {
+      const predator = createAgent('pred', 'carnivore', 100, 100, { slot: 100 });
+      const prey = createAgent('prey', 'herbivore', 110, 100);
+      const ready: Array<[number, number]> = [];
+      huntingSystem.onPredatorReady = (slot, tick) => ready.push([slot, tick]);
+
+      huntingSystem.attemptHunt(predator, prey, 0);
+      const cooldown = huntingSystem.getConfig().huntingCooldown;
+
+      huntingSystem.advanceCooldowns(cooldown - 1);
+      expect(ready).toEqual([]);
+
+      huntingSystem.advanceCooldowns(cooldown);
+      expect(ready).toEqual([[100, cooldown]]);
+      expect(huntingSystem.canHunt(predator, cooldown)).toBe(true);
+    });
+
+    it('should not fire for cleared slotted cooldowns', () => {
+      const predator = createAgent('pred', 'carnivore', 100, 100, { slot: 0 });
+      const prey = createAgent('prey', 'herbivore', 110, 100);
+      let fired = 0;
+      huntingSystem.onPredatorReady = () => fired++;
+
+      huntingSystem.attemptHunt(predator, prey, 0);
+      huntingSystem.clearCooldown(predator);
+      huntingSystem.advanceCooldowns(1000);
+
+      expect(fired).toBe(0);
+      expect(huntingSystem.canHunt(predator, 1)).toBe(true);
+    });
   });
 
   // =====================
@@ -13,7 +13,8 @@ import {
   HuntResult,
 } from './types';
 import { TrophicRoleTracker } from './TrophicRoleTracker';
-import { SpatialHash, QueryResult } from '../spatial';
+import { SpatialQuery, QueryResult } from '../spatial';
+import { TimingWheel } from '../utils/TimingWheel';
 
 // ============================================================================
 // HuntingSystem Types
@@ -24,6 +25,9 @@ export interface HuntingSystemConfig extends TrophicConfig {
   killThreshold: number;        // Damage threshold to kill prey (0-1 of prey energy)
   escapeSpeedBonus: number;     // Bonus to escape chance per speed difference
   sizeDisadvantage: number;     // How much larger predators are penalized hunting smaller prey
+  worldWidth: number;           // World size for toroidal distance (0 = unbounded)
+  worldHeight: number;
+  wrapEdges: boolean;           // Match the spatial index's wrapping when range-checking
 }
 
 export const DEFAULT_HUNTING_CONFIG: HuntingSystemConfig = {
@@ -32,6 +36,9 @@ export const DEFAULT_HUNTING_CONFIG: HuntingSystemConfig = {
   killThreshold: 0.8,
   escapeSpeedBonus: 0.1,
   sizeDisadvantage: 0.1,
+  worldWidth: 0,
+  worldHeight: 0,
+  wrapEdges: false,
 };
 
 export interface HuntingTarget {
@@ -56,15 +63,34 @@ export interface HuntingSystemStats {
 export class HuntingSystem {
   private config: HuntingSystemConfig;
   private trophicTracker: TrophicRoleTracker;
-  private huntCooldowns: Map<string, number>; // agentId -> tick when can hunt again
+  private slotCooldowns: Int32Array;       // agent slot -> tick when can hunt again (0 = ready)
+  private cooldownWheel: TimingWheel;     // Expires slot cooldowns
+  private huntCooldowns: Map<string, number>; // Agents without a slot: agentId -> tick
   private stats: HuntingSystemStats;
+  private random: () => number;
+
+  // Streaming best-target scan state (reused across calls, see scanCandidate)
+  private scanPredator: TrophicAgent | null = null;
+  private scanBest: TrophicAgent | null = null;
+  private scanBestScore: number = -Infinity;
+  private scanBestDistance: number = Infinity;
+  private scanBestChance: number = 0;
+
+  /**
+   * Fired when a slotted predator's cooldown expires (see advanceCooldowns)
+   */
+  onPredatorReady?: (slot: number, tick: number) => void;
 
   constructor(
     trophicTracker: TrophicRoleTracker,
-    config?: Partial<HuntingSystemConfig>
+    config?: Partial<HuntingSystemConfig>,
+    random: () => number = Math.random
   ) {
     this.config = { ...DEFAULT_HUNTING_CONFIG, ...config };
     this.trophicTracker = trophicTracker;
+    this.random = random;
+    this.slotCooldowns = new Int32Array(64);
+    this.cooldownWheel = new TimingWheel();
     this.huntCooldowns = new Map();
     this.stats = {
       totalHuntsAttempted: 0,
@@ -80,7 +106,7 @@ export class HuntingSystem {
    */
   findPotentialPrey(
     predator: TrophicAgent,
-    spatialHash: SpatialHash<TrophicAgent>,
+    spatialHash: SpatialQuery<TrophicAgent>,
     tick: number
   ): HuntingTarget[] {
     // Check if predator can hunt
@@ -135,12 +161,7 @@ export class HuntingSystem {
     }
 
     // Check cooldown
-    const cooldownEnd = this.huntCooldowns.get(predator.id);
-    if (cooldownEnd !== undefined && tick < cooldownEnd) {
-      return false;
-    }
-
-    return true;
+    return tick >= this.getCooldownEnd(predator);
   }
 
   /**
@@ -153,6 +174,11 @@ export class HuntingSystem {
     }
 
     // Use trophic tracker to determine if this is a threat relationship
+    const a = predator.speciesSlot;
+    const b = prey.speciesSlot;
+    if (a !== undefined && b !== undefined && a >= 0 && b >= 0) {
+      return this.trophicTracker.isThreatToSlot(a, b);
+    }
     return this.trophicTracker.isThreatTo(predator.speciesId, prey.speciesId);
   }
 
@@ -225,8 +251,7 @@ export class HuntingSystem {
     }
 
     // Check cooldown
-    const cooldownEnd = this.huntCooldowns.get(predator.id);
-    if (cooldownEnd !== undefined && tick < cooldownEnd) {
+    if (tick < this.getCooldownEnd(predator)) {
       return {
         success: false,
         reason: 'cooldown',
@@ -252,14 +277,14 @@ export class HuntingSystem {
     }
 
     // Apply cooldown
-    this.huntCooldowns.set(predator.id, tick + this.config.huntingCooldown);
+    this.setCooldownEnd(predator, tick + this.config.huntingCooldown);
 
     // Energy cost is always paid
     const energySpent = this.config.huntingEnergyCost;
 
     // Calculate success
     const successChance = this.calculateHuntSuccessChance(predator, prey, distance);
-    const success = Math.random() < successChance;
+    const success = this.random() < successChance;
 
     // Record the interaction
     const interaction: TrophicInteraction = {
@@ -338,17 +363,105 @@ export class HuntingSystem {
   }
 
   /**
-   * Get the best hunting target for an agent
+   * Get the best hunting target for an agent.
+   *
+   * Streams over neighbours once, keeping only the running best by expected
+   * value (ties go to the nearer prey, then the lower id). When `out` is
+   * given it is filled in and returned, so the scan allocates nothing.
    */
   getBestTarget(
     predator: TrophicAgent,
-    spatialHash: SpatialHash<TrophicAgent>,
-    tick: number
+    spatialHash: SpatialQuery<TrophicAgent>,
+    tick: number,
+    out?: HuntingTarget
   ): HuntingTarget | null {
-    const targets = this.findPotentialPrey(predator, spatialHash, tick);
-    return targets.length > 0 ? targets[0] : null;
+    const prey = this.scanBestTarget(predator, spatialHash, tick);
+    if (!prey) return null;
+
+    const target = out ?? ({} as HuntingTarget);
+    target.agent = prey;
+    target.distance = this.scanBestDistance;
+    target.successChance = this.scanBestChance;
+    target.expectedEnergyGain = prey.energy * this.config.energyTransferRatio;
+    return target;
+  }
+
+  /**
+   * Select the best target for every predator in one pass.
+   * Writes the prey (or null) and its distance at each predator's index.
+   * Returns the number of predators that found a target.
+   */
+  getBestTargets(
+    predators: ArrayLike<TrophicAgent>,
+    spatialHash: SpatialQuery<TrophicAgent>,
+    tick: number,
+    preyOut: Array<TrophicAgent | null>,
+    distanceOut: Float64Array | number[]
+  ): number {
+    let found = 0;
+    for (let i = 0; i < predators.length; i++) {
+      const prey = this.scanBestTarget(predators[i], spatialHash, tick);
+      preyOut[i] = prey;
+      distanceOut[i] = prey ? this.scanBestDistance : Infinity;
+      if (prey) found++;
+    }
+    return found;
+  }
+
+  /**
+   * Run the streaming scan and leave the winner in the scan fields
+   */
+  private scanBestTarget(
+    predator: TrophicAgent,
+    spatialHash: SpatialQuery<TrophicAgent>,
+    tick: number
+  ): TrophicAgent | null {
+    if (!predator.isAlive || !this.canHunt(predator, tick)) {
+      return null;
+    }
+
+    this.scanPredator = predator;
+    this.scanBest = null;
+    this.scanBestScore = -Infinity;
+    this.scanBestDistance = Infinity;
+    this.scanBestChance = 0;
+
+    spatialHash.forEachInRadius(
+      predator.position.x,
+      predator.position.y,
+      this.config.huntingRange,
+      this.scanCandidate
+    );
+
+    this.scanPredator = null;
+    return this.scanBest;
   }
 
+  /**
+   * Visitor for scanBestTarget. Bound once so the scan allocates no closures.
+   */
+  private scanCandidate = (prey: TrophicAgent, distanceSq: number): void => {
+    const predator = this.scanPredator!;
+    if (prey.id === predator.id || !prey.isAlive) return;
+    if (!this.isValidPrey(predator, prey)) return;
+
+    const distance = Math.sqrt(distanceSq);
+    const successChance = this.calculateHuntSuccessChance(predator, prey, distance);
+    const score = successChance * prey.energy * this.config.energyTransferRatio;
+
+    if (
+      score > this.scanBestScore ||
+      (score === this.scanBestScore &&
+        (distance < this.scanBestDistance ||
+          (distance === this.scanBestDistance && prey.id < this.scanBest!.id)))
+    ) {
+      this.scanBest = prey;
+      this.scanBestScore = score;
+      this.scanBestDistance = distance;
+      this.scanBestChance = successChance;
+    }
+  };
+
   /**
    * Calculate direction to prey from predator
    */
@@ -356,43 +469,109 @@ export class HuntingSystem {
     predator: TrophicAgent,
     prey: TrophicAgent
   ): number {
-    const dx = prey.position.x - predator.position.x;
-    const dy = prey.position.y - predator.position.y;
+    const dx = this.wrapOffset(prey.position.x - predator.position.x, this.config.worldWidth);
+    const dy = this.wrapOffset(prey.position.y - predator.position.y, this.config.worldHeight);
     return Math.atan2(dy, dx);
   }
 
   /**
-   * Calculate distance between two positions
+   * Calculate distance between two positions, across the world seam when
+   * wrapEdges is set (the same metric as the wrapped spatial index)
    */
   private calculateDistance(
     pos1: { x: number; y: number },
     pos2: { x: number; y: number }
   ): number {
-    const dx = pos2.x - pos1.x;
-    const dy = pos2.y - pos1.y;
+    const dx = this.wrapOffset(pos2.x - pos1.x, this.config.worldWidth);
+    const dy = this.wrapOffset(pos2.y - pos1.y, this.config.worldHeight);
     return Math.sqrt(dx * dx + dy * dy);
   }
 
+  private wrapOffset(diff: number, size: number): number {
+    if (!this.config.wrapEdges || size <= 0) return diff;
+    if (diff > size / 2) return diff - size;
+    if (diff < -size / 2) return diff + size;
+    return diff;
+  }
+
   /**
-   * Clear cooldown for an agent (e.g., on death)
+   * Expire cooldowns up to the given tick, firing onPredatorReady for each
+   * slotted predator that becomes able to hunt again
    */
-  clearCooldown(agentId: string): void {
-    this.huntCooldowns.delete(agentId);
+  advanceCooldowns(tick: number): void {
+    this.cooldownWheel.advance(tick, this.expireCooldown);
+  }
+
+  private expireCooldown = (slot: number, dueTick: number): void => {
+    // Skip stale entries: the cooldown was cleared or pushed further out
+    const end = this.slotCooldowns[slot];
+    if (end === 0 || end > dueTick) return;
+    this.slotCooldowns[slot] = 0;
+    this.onPredatorReady?.(slot, dueTick);
+  };
+
+  /**
+   * Tick at which the predator may hunt again (0 when ready)
+   */
+  private getCooldownEnd(predator: TrophicAgent): number {
+    const slot = predator.slot;
+    if (slot !== undefined && slot >= 0) {
+      return slot < this.slotCooldowns.length ? this.slotCooldowns[slot] : 0;
+    }
+    return this.huntCooldowns.get(predator.id) ?? 0;
+  }
+
+  private setCooldownEnd(predator: TrophicAgent, end: number): void {
+    const slot = predator.slot;
+    if (slot === undefined || slot < 0) {
+      this.huntCooldowns.set(predator.id, end);
+      return;
+    }
+
+    if (slot >= this.slotCooldowns.length) {
+      let capacity = this.slotCooldowns.length;
+      while (capacity <= slot) capacity *= 2;
+      const grown = new Int32Array(capacity);
+      grown.set(this.slotCooldowns);
+      this.slotCooldowns = grown;
+    }
+    this.slotCooldowns[slot] = end;
+    this.cooldownWheel.schedule(slot, end);
+  }
+
+  /**
+   * Clear cooldown for an agent (e.g., on death). Pass the agent itself for
+   * slotted agents so the slot can be reused without inheriting a cooldown.
+   */
+  clearCooldown(agent: string | TrophicAgent): void {
+    if (typeof agent === 'string') {
+      this.huntCooldowns.delete(agent);
+      return;
+    }
+    const slot = agent.slot;
+    if (slot !== undefined && slot >= 0) {
+      if (slot < this.slotCooldowns.length) this.slotCooldowns[slot] = 0;
+    } else {
+      this.huntCooldowns.delete(agent.id);
+    }
   }
 
   /**
    * Clear all cooldowns
    */
   clearAllCooldowns(): void {
+    this.slotCooldowns.fill(0);
+    this.cooldownWheel.clear();
     this.huntCooldowns.clear();
   }
 
   /**
    * Get remaining cooldown ticks for an agent
    */
-  getCooldownRemaining(agentId: string, currentTick: number): number {
-    const cooldownEnd = this.huntCooldowns.get(agentId);
-    if (cooldownEnd === undefined) return 0;
+  getCooldownRemaining(agent: string | TrophicAgent, currentTick: number): number {
+    const cooldownEnd = typeof agent === 'string'
+      ? this.huntCooldowns.get(agent) ?? 0
+      : this.getCooldownEnd(agent);
     return Math.max(0, cooldownEnd - currentTick);
   }
 
@@ -434,7 +613,8 @@ export class HuntingSystem {
    * Clear all state
    */
   clear(): void {
-    this.huntCooldowns.clear();
+    this.clearAllCooldowns();
+    this.cooldownWheel.reset();
     this.resetStats();
   }
 }
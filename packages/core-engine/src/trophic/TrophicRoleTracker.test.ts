@@ -204,6 +204,7 @@ describe('TrophicRoleTracker', () => {
 
       const stats = smallHistoryTracker.getStats();
       expect(stats.totalInteractions).toBe(5);
+      expect(stats.recentInteractions.map(i => i.tick)).toEqual([5, 6, 7, 8, 9]);
     });
   });
 
@@ -442,6 +443,72 @@ describe('TrophicRoleTracker', () => {
     it('should identify opportunity for predator', () => {
       expect(tracker.isOpportunityFor('carnivore', 'herbivore')).toBe(true);
     });
+
+    it('should answer slot bit tests consistently with isThreatTo', () => {
+      const species = ['carnivore', 'herbivore', 'newcomer'];
+      const slots = species.map(id => tracker.registerSpecies(id));
+
+      for (let a = 0; a < species.length; a++) {
+        for (let b = 0; b < species.length; b++) {
+          expect(tracker.isThreatToSlot(slots[a], slots[b])).toBe(
+            tracker.isThreatTo(species[a], species[b])
+          );
+        }
+      }
+      expect(tracker.isThreatToSlot(slots[0], slots[2])).toBe(true);
+    });
+
+    it('should keep masks valid as species slots grow', () => {
+      for (let i = 0; i < 40; i++) {
+        tracker.registerSpecies(`species_${i}`);
+      }
+
+      expect(tracker.isThreatTo('carnivore', 'herbivore')).toBe(true);
+      expect(tracker.isThreatTo('carnivore', 'species_39')).toBe(true);
+      expect(tracker.isThreatTo('herbivore', 'species_39')).toBe(false);
+    });
+  });
+
+  // =====================
+  // INTERACTION MATRIX TESTS
+  // =====================
+  describe('interaction matrix', () => {
+    it('should count hunts and kills per species pair', () => {
+      for (let i = 0; i < 4; i++) {
+        tracker.recordHuntInteraction({
+          tick: i,
+          predatorId: 'p',
+          predatorSpeciesId: 'wolf',
+          preyId: `s_${i}`,
+          preySpeciesId: 'sheep',
+          success: i % 2 === 0,
+          energyTransferred: 0,
+          interactionType: 'hunt',
+        });
+      }
+
+      expect(tracker.getHuntCount('wolf', 'sheep')).toBe(4);
+      expect(tracker.getKillCount('wolf', 'sheep')).toBe(2);
+      expect(tracker.getHuntCount('sheep', 'wolf')).toBe(0);
+      expect(tracker.getHuntCount('wolf', 'unknown')).toBe(0);
+    });
+
+    it('should assign stable dense species slots', () => {
+      const a = tracker.registerSpecies('a');
+      const b = tracker.registerSpecies('b');
+
+      expect(a).toBe(0);
+      expect(b).toBe(1);
+      expect(tracker.registerSpecies('a')).toBe(a);
+      expect(tracker.getSpeciesSlot('missing')).toBe(-1);
+    });
+
+    it('should make declared predation an immediate threat', () => {
+      tracker.declarePredation('fox', 'rabbit');
+
+      expect(tracker.isThreatTo('fox', 'rabbit')).toBe(true);
+      expect(tracker.isThreatTo('rabbit', 'fox')).toBe(false);
+    });
   });
 
   // =====================
@@ -3,6 +3,10 @@
  *
  * Observes agent behavior (hunting success, food consumption) to determine
  * ecological roles emergently rather than by pre-assignment.
+ *
+ * Species are also given dense slots. Hunt counts live in a species x species
+ * matrix, and the threat relation is precomputed as a bitmask per predator
+ * slot so sensing can answer "is this neighbour a threat?" with one bit test.
  */
 
 import {
@@ -15,6 +19,7 @@ import {
   SpeciesTrophicStats,
   TrophicTrackerStats,
 } from './types';
+import { RingBuffer } from '../utils/RingBuffer';
 
 // ============================================================================
 // TrophicRoleTracker Class
@@ -22,17 +27,136 @@ import {
 
 export class TrophicRoleTracker {
   private speciesProfiles: Map<string, TrophicProfile>;
-  private interactionHistory: TrophicInteraction[];
-  private maxHistorySize: number;
+  private interactionHistory: RingBuffer<TrophicInteraction>;
   private config: TrophicConfig;
 
+  // Dense species indexing
+  private speciesSlots: Map<string, number> = new Map();
+  private slotSpecies: string[] = [];
+  private slotCapacity: number = 0;
+  private huntCounts: Uint32Array = new Uint32Array(0);  // [predator * capacity + prey]
+  private killCounts: Uint32Array = new Uint32Array(0);
+  private threatWords: number = 0;                       // 32-bit words per mask row
+  private threatBits: Uint32Array = new Uint32Array(0);  // row = predator, bit = prey
+
   constructor(config?: Partial<TrophicConfig>, maxHistorySize: number = 1000) {
     this.config = { ...DEFAULT_TROPHIC_CONFIG, ...config };
     this.speciesProfiles = new Map();
-    this.interactionHistory = [];
-    this.maxHistorySize = maxHistorySize;
+    this.interactionHistory = new RingBuffer(maxHistorySize);
+  }
+
+  // ==========================================================================
+  // Species Slots
+  // ==========================================================================
+
+  /**
+   * Dense slot for a species, or -1 if it has not been seen
+   */
+  getSpeciesSlot(speciesId: string): number {
+    return this.speciesSlots.get(speciesId) ?? -1;
+  }
+
+  /**
+   * Get or assign the dense slot for a species
+   */
+  registerSpecies(speciesId: string): number {
+    const existing = this.speciesSlots.get(speciesId);
+    if (existing !== undefined) return existing;
+
+    const slot = this.slotSpecies.length;
+    this.speciesSlots.set(speciesId, slot);
+    this.slotSpecies.push(speciesId);
+
+    if (slot >= this.slotCapacity) {
+      this.growSlots(Math.max(8, this.slotCapacity * 2));
+    } else {
+      this.refreshThreatsFor(slot);
+    }
+    return slot;
+  }
+
+  /**
+   * Precomputed threat test by species slot (see isThreatTo)
+   */
+  isThreatToSlot(predatorSlot: number, preySlot: number): boolean {
+    return (
+      (this.threatBits[predatorSlot * this.threatWords + (preySlot >>> 5)] >>> (preySlot & 31)) & 1
+    ) === 1;
   }
 
+  /**
+   * Number of hunts a predator species has attempted on a prey species
+   */
+  getHuntCount(predatorSpeciesId: string, preySpeciesId: string): number {
+    const a = this.getSpeciesSlot(predatorSpeciesId);
+    const b = this.getSpeciesSlot(preySpeciesId);
+    return a < 0 || b < 0 ? 0 : this.huntCounts[a * this.slotCapacity + b];
+  }
+
+  /**
+   * Number of successful hunts of a prey species by a predator species
+   */
+  getKillCount(predatorSpeciesId: string, preySpeciesId: string): number {
+    const a = this.getSpeciesSlot(predatorSpeciesId);
+    const b = this.getSpeciesSlot(preySpeciesId);
+    return a < 0 || b < 0 ? 0 : this.killCounts[a * this.slotCapacity + b];
+  }
+
+  private growSlots(capacity: number): void {
+    const old = this.slotCapacity;
+    const hunts = new Uint32Array(capacity * capacity);
+    const kills = new Uint32Array(capacity * capacity);
+    for (let row = 0; row < old; row++) {
+      hunts.set(this.huntCounts.subarray(row * old, row * old + old), row * capacity);
+      kills.set(this.killCounts.subarray(row * old, row * old + old), row * capacity);
+    }
+    this.huntCounts = hunts;
+    this.killCounts = kills;
+    this.slotCapacity = capacity;
+
+    this.threatWords = Math.ceil(capacity / 32);
+    this.threatBits = new Uint32Array(capacity * this.threatWords);
+    this.refreshThreatMasks();
+  }
+
+  private setThreatBit(predatorSlot: number, preySlot: number, value: boolean): void {
+    const index = predatorSlot * this.threatWords + (preySlot >>> 5);
+    const bit = 1 << (preySlot & 31);
+    if (value) {
+      this.threatBits[index] |= bit;
+    } else {
+      this.threatBits[index] &= ~bit;
+    }
+  }
+
+  /**
+   * Recompute every threat bit from current roles and known relationships
+   */
+  private refreshThreatMasks(): void {
+    const n = this.slotSpecies.length;
+    for (let a = 0; a < n; a++) {
+      for (let b = 0; b < n; b++) {
+        this.setThreatBit(a, b, this.computeThreat(this.slotSpecies[a], this.slotSpecies[b]));
+      }
+    }
+  }
+
+  /**
+   * Recompute the row and column of one species slot
+   */
+  private refreshThreatsFor(slot: number): void {
+    const id = this.slotSpecies[slot];
+    for (let other = 0; other < this.slotSpecies.length; other++) {
+      const otherId = this.slotSpecies[other];
+      this.setThreatBit(slot, other, this.computeThreat(id, otherId));
+      this.setThreatBit(other, slot, this.computeThreat(otherId, id));
+    }
+  }
+
+  // ==========================================================================
+  // Profiles and Interactions
+  // ==========================================================================
+
   /**
    * Get or create profile for a species
    */
@@ -53,8 +177,13 @@ export class TrophicRoleTracker {
   recordHuntInteraction(interaction: TrophicInteraction): void {
     // Add to history
     this.interactionHistory.push(interaction);
-    if (this.interactionHistory.length > this.maxHistorySize) {
-      this.interactionHistory.shift();
+
+    const predatorSlot = this.registerSpecies(interaction.predatorSpeciesId);
+    const preySlot = this.registerSpecies(interaction.preySpeciesId);
+    const cell = predatorSlot * this.slotCapacity + preySlot;
+    this.huntCounts[cell]++;
+    if (interaction.success) {
+      this.killCounts[cell]++;
     }
 
     // Update predator profile
@@ -74,6 +203,8 @@ export class TrophicRoleTracker {
     const preyProfile = this.getOrCreateProfile(interaction.preySpeciesId);
     if (interaction.success) {
       preyProfile.predatorSpeciesIds.add(interaction.predatorSpeciesId);
+      // A known predator relationship is a threat regardless of role
+      this.setThreatBit(predatorSlot, preySlot, true);
     }
   }
 
@@ -178,6 +309,20 @@ export class TrophicRoleTracker {
       profile.confidence = sampleConfidence * roleConfidence;
       profile.lastRoleUpdateTick = tick;
     }
+
+    this.refreshThreatMasks();
+  }
+
+  /**
+   * Declare a known predator-prey relationship (e.g. seeded by a preset).
+   * Behaves as if the predator species had already hunted the prey species.
+   */
+  declarePredation(predatorSpeciesId: string, preySpeciesId: string): void {
+    this.getOrCreateProfile(predatorSpeciesId).preySpeciesIds.add(preySpeciesId);
+    this.getOrCreateProfile(preySpeciesId).predatorSpeciesIds.add(predatorSpeciesId);
+    const predatorSlot = this.registerSpecies(predatorSpeciesId);
+    const preySlot = this.registerSpecies(preySpeciesId);
+    this.setThreatBit(predatorSlot, preySlot, true);
   }
 
   /**
@@ -214,6 +359,18 @@ export class TrophicRoleTracker {
    * Check if agent should be considered a threat to another
    */
   isThreatTo(potentialPredatorSpeciesId: string, potentialPreySpeciesId: string): boolean {
+    const predatorSlot = this.speciesSlots.get(potentialPredatorSpeciesId);
+    const preySlot = this.speciesSlots.get(potentialPreySpeciesId);
+    if (predatorSlot !== undefined && preySlot !== undefined) {
+      return this.isThreatToSlot(predatorSlot, preySlot);
+    }
+    return this.computeThreat(potentialPredatorSpeciesId, potentialPreySpeciesId);
+  }
+
+  /**
+   * Evaluate the threat relation from roles and known relationships
+   */
+  private computeThreat(potentialPredatorSpeciesId: string, potentialPreySpeciesId: string): boolean {
     const predatorRole = this.getRole(potentialPredatorSpeciesId);
     const preyRole = this.getRole(potentialPreySpeciesId);
 
@@ -344,7 +501,7 @@ export class TrophicRoleTracker {
       totalSpecies: this.speciesProfiles.size,
       roleDistribution,
       totalInteractions: this.interactionHistory.length,
-      recentInteractions: this.interactionHistory.slice(-10),
+      recentInteractions: this.interactionHistory.last(10),
       foodWebDensity,
     };
   }
@@ -354,7 +511,14 @@ export class TrophicRoleTracker {
    */
   clear(): void {
     this.speciesProfiles.clear();
-    this.interactionHistory = [];
+    this.interactionHistory.clear();
+    this.speciesSlots.clear();
+    this.slotSpecies = [];
+    this.slotCapacity = 0;
+    this.huntCounts = new Uint32Array(0);
+    this.killCounts = new Uint32Array(0);
+    this.threatWords = 0;
+    this.threatBits = new Uint32Array(0);
   }
 
   /**
@@ -390,7 +554,7 @@ export class TrophicRoleTracker {
     return {
       config: this.config,
       profiles,
-      recentInteractions: this.interactionHistory.slice(-100),
+      recentInteractions: this.interactionHistory.last(100),
     };
   }
 }
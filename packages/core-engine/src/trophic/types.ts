@@ -125,6 +125,8 @@ export interface TrophicAgent {
   position: { x: number; y: number };
   energy: number;
   isAlive: boolean;
+  slot?: number;                // Dense agent slot, enables column-stored state
+  speciesSlot?: number;         // TrophicRoleTracker species slot
 
   // Traits that affect hunting
   size?: number;
@@ -0,0 +1,55 @@
+/**
+ * RingBuffer.test.ts - Tests for the fixed-capacity circular buffer
+ */
+
+import { describe, it, expect } from 'vitest';
+import { RingBuffer } from './RingBuffer';
+
+describe('RingBuffer', () => {
+  it('should keep items in insertion order until full', () => {
+    const ring = new RingBuffer<number>(3);
+    ring.push(1);
+    ring.push(2);
+
+    expect(ring.length).toBe(2);
+    expect(ring.toArray()).toEqual([1, 2]);
+  });
+
+  it('should evict the oldest item when full', () => {
+    const ring = new RingBuffer<number>(3);
+    [1, 2, 3].forEach(n => ring.push(n));
+
+    expect(ring.push(4)).toBe(1);
+    expect(ring.toArray()).toEqual([2, 3, 4]);
+    expect(ring.get(0)).toBe(2);
+    expect(ring.peekLast()).toBe(4);
+  });
+
+  it('should return the most recent n items', () => {
+    const ring = new RingBuffer<number>(4);
+    for (let i = 0; i < 10; i++) ring.push(i);
+
+    expect(ring.last(2)).toEqual([8, 9]);
+    expect(ring.last(10)).toEqual([6, 7, 8, 9]);
+  });
+
+  it('should shift from the front', () => {
+    const ring = new RingBuffer<number>(2);
+    ring.push(1);
+    ring.push(2);
+    ring.push(3);
+
+    expect(ring.shift()).toBe(2);
+    expect(ring.length).toBe(1);
+    expect([...ring]).toEqual([3]);
+  });
+
+  it('should reset on clear', () => {
+    const ring = new RingBuffer<number>(2);
+    ring.push(1);
+    ring.clear();
+
+    expect(ring.length).toBe(0);
+    expect(ring.last(5)).toEqual([]);
+  });
+});
@@ -0,0 +1,96 @@
+/**
+ * RingBuffer.ts - Fixed-capacity circular buffer
+ *
+ * Keeps the most recent `capacity` items. Pushing is O(1); once full, the
+ * oldest item is overwritten instead of shifting the whole array.
+ */
+
+export class RingBuffer<T> {
+  readonly capacity: number;
+
+  private items: Array<T | undefined>;
+  private head: number = 0;   // Index of the oldest item
+  private count: number = 0;
+
+  constructor(capacity: number) {
+    this.capacity = Math.max(1, Math.floor(capacity));
+    this.items = new Array(this.capacity);
+  }
+
+  get length(): number {
+    return this.count;
+  }
+
+  /**
+   * Append an item, evicting the oldest when full. Returns the evicted item.
+   */
+  push(item: T): T | undefined {
+    if (this.count < this.capacity) {
+      this.items[(this.head + this.count) % this.capacity] = item;
+      this.count++;
+      return undefined;
+    }
+
+    const evicted = this.items[this.head];
+    this.items[this.head] = item;
+    this.head = (this.head + 1) % this.capacity;
+    return evicted;
+  }
+
+  /**
+   * Item at position i, where 0 is the oldest
+   */
+  get(i: number): T | undefined {
+    if (i < 0 || i >= this.count) return undefined;
+    return this.items[(this.head + i) % this.capacity];
+  }
+
+  /**
+   * Most recent item
+   */
+  peekLast(): T | undefined {
+    return this.get(this.count - 1);
+  }
+
+  /**
+   * Remove and return the oldest item
+   */
+  shift(): T | undefined {
+    if (this.count === 0) return undefined;
+    const item = this.items[this.head];
+    this.items[this.head] = undefined;
+    this.head = (this.head + 1) % this.capacity;
+    this.count--;
+    return item;
+  }
+
+  /**
+   * The last n items, oldest first
+   */
+  last(n: number): T[] {
+    const take = Math.max(0, Math.min(n, this.count));
+    const result: T[] = new Array(take);
+    for (let i = 0; i < take; i++) {
+      result[i] = this.items[(this.head + this.count - take + i) % this.capacity] as T;
+    }
+    return result;
+  }
+
+  toArray(): T[] {
+    return this.last(this.count);
+  }
+
+  clear(): void {
+    this.items = new Array(this.capacity);
+    this.head = 0;
+    this.count = 0;
+  }
+
+  *[Symbol.iterator](): Iterator<T> {
+    for (let i = 0; i < this.count; i++) {
+      yield this.items[(this.head + i) % this.capacity] as T;
+    }
+  }
+}
+
+export default RingBuffer;
@@ -0,0 +1,82 @@
+/**
+ * TimingWheel.test.ts - Tests for the hierarchical timing wheel
+ */
+
+import { describe, it, expect } from 'vitest';
+import { TimingWheel } from './TimingWheel';
+
+function collect(wheel: TimingWheel, toTick: number): Array<[number, number]> {
+  const fired: Array<[number, number]> = [];
+  wheel.advance(toTick, (key, due) => fired.push([key, due]));
+  return fired;
+}
+
+describe('TimingWheel', () => {
+  it('should fire entries at their due tick', () => {
+    const wheel = new TimingWheel();
+    wheel.schedule(1, 5);
+    wheel.schedule(2, 3);
+
+    expect(collect(wheel, 2)).toEqual([]);
+    expect(collect(wheel, 3)).toEqual([[2, 3]]);
+    expect(collect(wheel, 10)).toEqual([[1, 5]]);
+    expect(wheel.size).toBe(0);
+  });
+
+  it('should fire past deadlines on the next advance', () => {
+    const wheel = new TimingWheel(10);
+    wheel.schedule(7, 4);
+
+    expect(collect(wheel, 11)).toEqual([[7, 11]]);
+  });
+
+  it('should cascade entries across levels in deadline order', () => {
+    const wheel = new TimingWheel(0, { slotsPerLevel: 4, levels: 3 });
+    const dues = [1, 3, 4, 7, 15, 16, 17, 40, 63, 64, 65, 200];
+    dues.forEach((due, i) => wheel.schedule(i, due));
+
+    const fired: number[] = [];
+    wheel.advance(300, (_key, due) => fired.push(due));
+
+    expect(fired).toEqual(dues);
+  });
+
+  it('should match a naive scheduler over randomized deadlines', () => {
+    const wheel = new TimingWheel(0, { slotsPerLevel: 8, levels: 2 });
+    const expected = new Map<number, number>();
+    let seed = 12345;
+    const next = () => (seed = (seed * 1103515245 + 12345) % 2147483648) / 2147483648;
+
+    for (let tick = 0; tick < 500; tick++) {
+      if (tick % 3 === 0) {
+        const key = tick;
+        const due = tick + 1 + Math.floor(next() * 150);
+        expected.set(key, due);
+        wheel.schedule(key, due);
+      }
+      wheel.advance(tick, (key, due) => {
+        expect(due).toBe(tick);
+        expect(expected.get(key)).toBe(due);
+        expected.delete(key);
+      });
+    }
+
+    wheel.advance(1000, (key) => expected.delete(key));
+    expect(expected.size).toBe(0);
+  });
+
+  it('should skip empty stretches of time', () => {
+    const wheel = new TimingWheel();
+    wheel.advance(1_000_000, () => {});
+    expect(wheel.currentTick).toBe(1_000_000);
+  });
+
+  it('should drop pending entries on clear', () => {
+    const wheel = new TimingWheel();
+    wheel.schedule(1, 5);
+    wheel.clear();
+
+    expect(wheel.size).toBe(0);
+    expect(collect(wheel, 10)).toEqual([]);
+  });
+});
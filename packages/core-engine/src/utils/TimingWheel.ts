@@ -0,0 +1,180 @@
+/**
+ * TimingWheel.ts - Hierarchical timing wheel for tick-based expirations
+ *
+ * Schedules integer keys (agent slots, food indices, ...) to fire at a future
+ * tick. Scheduling and expiry are O(1) amortized regardless of how many
+ * timers are pending, unlike scanning a map of deadlines every tick.
+ *
+ * Level 0 has one bucket per tick; each higher level has buckets that span a
+ * whole revolution of the level below and are cascaded down as time reaches
+ * them. Deadlines beyond the top level wait in an overflow list.
+ *
+ * Entries are not deduplicated or cancellable: a key rescheduled or cleared
+ * before it fires will still be reported. Consumers validate against their
+ * own deadline column when a key fires.
+ */
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+export interface TimingWheelConfig {
+  slotsPerLevel: number;  // Buckets per level
+  levels: number;         // Number of levels
+}
+
+export const DEFAULT_TIMING_WHEEL_CONFIG: TimingWheelConfig = {
+  slotsPerLevel: 64,
+  levels: 4,              // 64^4 ticks before falling back to overflow
+};
+
+// ============================================================================
+// TimingWheel Class
+// ============================================================================
+
+export class TimingWheel {
+  private config: TimingWheelConfig;
+  private spans: number[];            // Ticks covered by one bucket per level
+  private buckets: number[][][];      // [level][bucket] -> packed [key, due, ...]
+  private overflow: number[] = [];
+  private now: number;
+  private pending: number = 0;
+
+  constructor(startTick: number = 0, config?: Partial<TimingWheelConfig>) {
+    this.config = { ...DEFAULT_TIMING_WHEEL_CONFIG, ...config };
+    this.config.slotsPerLevel = Math.max(2, Math.floor(this.config.slotsPerLevel));
+    this.config.levels = Math.max(1, Math.floor(this.config.levels));
+    this.now = startTick;
+
+    this.spans = [];
+    this.buckets = [];
+    let span = 1;
+    for (let l = 0; l < this.config.levels; l++) {
+      this.spans.push(span);
+      const level: number[][] = [];
+      for (let b = 0; b < this.config.slotsPerLevel; b++) {
+        level.push([]);
+      }
+      this.buckets.push(level);
+      span *= this.config.slotsPerLevel;
+    }
+  }
+
+  /**
+   * Last tick processed by advance()
+   */
+  get currentTick(): number {
+    return this.now;
+  }
+
+  /**
+   * Number of scheduled entries not yet fired
+   */
+  get size(): number {
+    return this.pending;
+  }
+
+  /**
+   * Schedule a key to fire at dueTick. Past deadlines fire on the next advance.
+   */
+  schedule(key: number, dueTick: number): void {
+    const due = dueTick > this.now ? Math.floor(dueTick) : this.now + 1;
+    this.place(key, due);
+    this.pending++;
+  }
+
+  /**
+   * Advance to toTick, firing every entry due in (currentTick, toTick]
+   * in deadline order.
+   */
+  advance(toTick: number, onExpire: (key: number, dueTick: number) => void): void {
+    if (this.pending === 0) {
+      if (toTick > this.now) this.now = Math.floor(toTick);
+      return;
+    }
+
+    const size = this.config.slotsPerLevel;
+    const top = this.config.levels - 1;
+
+    while (this.now < toTick) {
+      this.now++;
+
+      // Re-check overflow once per top-level bucket
+      if (this.overflow.length > 0 && this.now % this.spans[top] === 0) {
+        const entries = this.overflow;
+        this.overflow = [];
+        for (let i = 0; i < entries.length; i += 2) {
+          this.place(entries[i], entries[i + 1]);
+        }
+      }
+
+      // Cascade higher levels first so entries can fall through several levels
+      for (let l = top; l >= 1; l--) {
+        if (this.now % this.spans[l] !== 0) continue;
+        const index = Math.floor(this.now / this.spans[l]) % size;
+        const entries = this.buckets[l][index];
+        if (entries.length === 0) continue;
+        this.buckets[l][index] = [];
+        for (let i = 0; i < entries.length; i += 2) {
+          this.place(entries[i], entries[i + 1]);
+        }
+      }
+
+      const index = this.now % size;
+      const expired = this.buckets[0][index];
+      if (expired.length === 0) continue;
+      this.buckets[0][index] = [];
+      this.pending -= expired.length / 2;
+      for (let i = 0; i < expired.length; i += 2) {
+        onExpire(expired[i], expired[i + 1]);
+      }
+
+      if (this.pending === 0) {
+        if (toTick > this.now) this.now = Math.floor(toTick);
+        return;
+      }
+    }
+  }
+
+  /**
+   * Drop all pending entries, keeping the current tick
+   */
+  clear(): void {
+    for (const level of this.buckets) {
+      for (let b = 0; b < level.length; b++) {
+        level[b] = [];
+      }
+    }
+    this.overflow = [];
+    this.pending = 0;
+  }
+
+  /**
+   * Reset to a new tick with no pending entries
+   */
+  reset(startTick: number = 0): void {
+    this.clear();
+    this.now = startTick;
+  }
+
+  getConfig(): TimingWheelConfig {
+    return { ...this.config };
+  }
+
+  private place(key: number, due: number): void {
+    const size = this.config.slotsPerLevel;
+    const delta = due - this.now;
+
+    for (let l = 0; l < this.config.levels; l++) {
+      if (delta < this.spans[l] * size) {
+        const index = Math.floor(due / this.spans[l]) % size;
+        this.buckets[l][index].push(key, due);
+        return;
+      }
+    }
+
+    this.overflow.push(key, due);
+  }
+}
+
+export default TimingWheel;
@@ -9,3 +9,12 @@ export {
   resetGlobalRandom,
   createRandom,
 } from './Random';
+
+export {
+  TimingWheel,
+  DEFAULT_TIMING_WHEEL_CONFIG,
+} from './TimingWheel';
+
+export type { TimingWheelConfig } from './TimingWheel';
+
+export { RingBuffer } from './RingBuffer';
@@ -0,0 +1,138 @@
+/**
+ * ChunkedGrid.test.ts - Tests for the sparse tiled grid backend
+ */
+
+import { describe, it, expect } from 'vitest';
+import { Grid } from './Grid';
+import { ChunkedGrid } from './ChunkedGrid';
+import { World } from './World';
+
+function pair(width: number, height: number, wrapEdges: boolean, chunkSize = 4, defaultValue = 0) {
+  const base = { name: 'test', type: 'float32' as const, dimensions: { width, height }, wrapEdges, defaultValue };
+  return {
+    dense: new Grid(base),
+    chunked: new ChunkedGrid({ ...base, backend: 'chunked', chunkSize }),
+  };
+}
+
+function expectSame(chunked: Grid, dense: Grid): void {
+  const a = chunked.data;
+  const b = dense.data;
+  expect(a.length).toBe(b.length);
+  for (let i = 0; i < b.length; i++) {
+    expect(a[i]).toBeCloseTo(b[i], 5);
+  }
+}
+
+describe('ChunkedGrid', () => {
+  it('allocates tiles only on non-default writes', () => {
+    const { chunked } = pair(64, 64, true, 8);
+    expect(chunked.residentTiles).toBe(0);
+    expect(chunked.memoryUsage()).toBe(0);
+
+    chunked.set(3, 3, 0);
+    expect(chunked.residentTiles).toBe(0);
+
+    chunked.set(3, 3, 1);
+    chunked.set(60, 2, 2);
+    expect(chunked.residentTiles).toBe(2);
+    expect(chunked.memoryUsage()).toBe(2 * 8 * 8 * 4);
+    expect(chunked.get(3, 3)).toBe(1);
+    expect(chunked.get(-4, 2)).toBe(2);
+    expect(chunked.get(10, 10)).toBe(0);
+  });
+
+  for (const wrap of [true, false]) {
+    it(`diffuses like the dense grid (${wrap ? 'wrapped' : 'bounded'})`, () => {
+      const { dense, chunked } = pair(13, 10, wrap, 4, 0);
+      for (const [x, y, v] of [[0, 0, 5], [6, 5, 3], [12, 9, 2], [3, 9, 1]]) {
+        dense.set(x, y, v);
+        chunked.set(x, y, v);
+      }
+
+      for (let i = 0; i < 3; i++) {
+        dense.diffuse(0.3);
+        chunked.diffuse(0.3);
+      }
+      expectSame(chunked, dense);
+
+      dense.update(0.2, 0.1);
+      chunked.update(0.2, 0.1);
+      expectSame(chunked, dense);
+    });
+  }
+
+  it('only touches tiles near resident tiles', () => {
+    const { chunked } = pair(256, 256, true, 16);
+    chunked.set(100, 100, 4);
+
+    chunked.diffuse(0.5);
+    expect(chunked.residentTiles).toBeLessThanOrEqual(9);
+    expect(chunked.sum()).toBeCloseTo(4, 4);
+
+    chunked.decay(0.5);
+    expect(chunked.sum()).toBeCloseTo(2, 4);
+  });
+
+  it('releases tiles that return to the default value', () => {
+    const { chunked } = pair(32, 32, true, 8);
+    chunked.set(1, 1, 1);
+    chunked.decay(1);
+    expect(chunked.residentTiles).toBe(0);
+    expect(chunked.get(1, 1)).toBe(0);
+  });
+
+  it('handles a non-zero default that decay moves', () => {
+    const { dense, chunked } = pair(9, 9, false, 4, 1);
+    chunked.set(2, 2, 3);
+    dense.set(2, 2, 3);
+
+    dense.decay(0.5);
+    chunked.decay(0.5);
+    expectSame(chunked, dense);
+  });
+
+  it('reports sum and range including missing tiles', () => {
+    const { chunked } = pair(10, 10, true, 4, 0.5);
+    chunked.set(0, 0, 3);
+    expect(chunked.sum()).toBeCloseTo(99 * 0.5 + 3, 5);
+    expect(chunked.range()).toEqual({ min: 0.5, max: 3 });
+  });
+
+  it('round-trips through dense snapshots', () => {
+    const { dense, chunked } = pair(12, 7, true, 5);
+    dense.set(4, 4, 2);
+    dense.set(11, 0, 1);
+
+    chunked.restore(dense.snapshot());
+    expectSame(chunked, dense);
+    expect(chunked.residentTiles).toBe(2);
+
+    const copy = new Grid({ name: 'copy', type: 'float32', dimensions: { width: 12, height: 7 } });
+    copy.restore(chunked.snapshot());
+    expectSame(copy, dense);
+
+    const cloned = chunked.clone();
+    cloned.set(6, 6, 9);
+    expect(chunked.get(6, 6)).toBe(0);
+    expect(cloned.residentTiles).toBe(3);
+  });
+
+  it('is selected through the layer config', () => {
+    const world = new World({
+      dimensions: { width: 4096, height: 4096 },
+      seed: 1,
+      layers: [{ name: 'scent', type: 'float32', backend: 'chunked', chunkSize: 32 }],
+    });
+    const layer = world.getLayer('scent')!;
+
+    expect(layer).toBeInstanceOf(ChunkedGrid);
+    expect(layer.dense).toBe(false);
+    expect(world.getStats().memoryUsage).toBe(0);
+
+    world.setValue('scent', 2000, 2000, 1);
+    world.updateLayers([{ layer: 'scent', diffusionRate: 0.1, decayRate: 0.01 }]);
+    expect(world.getValue('scent', 2000, 2000)).toBeGreaterThan(0);
+    expect((layer as ChunkedGrid).residentTiles).toBeLessThanOrEqual(9);
+  });
+});
@@ -0,0 +1,540 @@
+/**
+ * GenesisX Core Engine - Chunked Grid
+ *
+ * Sparse grid backend for huge worlds with little activity. The grid is
+ * split into square tiles that are allocated on the first non-default
+ * write; a missing tile reads as the layer's default value. Diffusion and
+ * decay only visit resident tiles (plus their neighbours when diffusing),
+ * and tiles that return to all-default are released again.
+ *
+ * Checkpoints are copy-on-write: a checkpoint holds references to the
+ * current tiles, which are then frozen; the next write to a frozen tile
+ * copies it first, and restoring a checkpoint swaps its tiles back in.
+ *
+ * Same API as Grid, selected with `backend: 'chunked'` in GridLayerConfig.
+ * `data` is a dense copy here, not the live store: read and write through
+ * get/set (or getAt/setAt) instead.
+ */
+
+import type { WorldDimensions, GridLayerConfig } from '../engine/EngineConfig';
+import { Grid, GridCheckpoint, TypedArray, GRID_ARRAY_TYPES, registerGridBackend } from './Grid';
+
+export const DEFAULT_CHUNK_SIZE = 64;
+
+const MIN_SPARE_TILES = 8;
+
+// ============================================================================
+// ChunkedGrid Class
+// ============================================================================
+
+export class ChunkedGrid<T extends TypedArray = Float32Array> extends Grid<T> {
+  public readonly chunkSize: number;
+  public readonly tilesX: number;
+  public readonly tilesY: number;
+
+  private tiles: Array<T | null>;
+  private next: Array<T | null>;
+  private spare: T[] = [];
+  private needed: Uint8Array;
+  private frozen: Uint8Array;   // Tile is referenced by a checkpoint
+  private probe: T;
+  private storedDefault: number;
+
+  constructor(config: GridLayerConfig & { dimensions: WorldDimensions }) {
+    super(config);
+    this.chunkSize = Math.max(1, Math.floor(config.chunkSize ?? DEFAULT_CHUNK_SIZE));
+    this.tilesX = Math.ceil(this.width / this.chunkSize);
+    this.tilesY = Math.ceil(this.height / this.chunkSize);
+
+    const tileCount = this.tilesX * this.tilesY;
+    this.tiles = new Array(tileCount).fill(null);
+    this.next = new Array(tileCount).fill(null);
+    this.needed = new Uint8Array(tileCount);
+    this.frozen = new Uint8Array(tileCount);
+
+    // Default as it reads back from the element type (e.g. 0.5 in uint8 is 0)
+    this.probe = this.allocate(1);
+    this.storedDefault = this.stored(this.defaultValue);
+  }
+
+  get dense(): boolean {
+    return false;
+  }
+
+  /**
+   * Dense copy of the whole grid. Writes to it are not reflected.
+   */
+  get data(): T {
+    const out = this.allocate(this.size);
+    if (this.defaultValue !== 0) out.fill(this.defaultValue);
+
+    const C = this.chunkSize;
+    for (let t = 0; t < this.tiles.length; t++) {
+      const tile = this.tiles[t];
+      if (!tile) continue;
+      const x0 = (t % this.tilesX) * C;
+      const y0 = Math.floor(t / this.tilesX) * C;
+      const tw = Math.min(C, this.width - x0);
+      const th = Math.min(C, this.height - y0);
+      for (let ly = 0; ly < th; ly++) {
+        out.set(tile.subarray(ly * C, ly * C + tw), (y0 + ly) * this.width + x0);
+      }
+    }
+    return out;
+  }
+
+  get residentTiles(): number {
+    let count = 0;
+    for (const tile of this.tiles) {
+      if (tile) count++;
+    }
+    return count;
+  }
+
+  get tileCount(): number {
+    return this.tiles.length;
+  }
+
+  // --------------------------------------------------------------------------
+  // Cell access
+  // --------------------------------------------------------------------------
+
+  get(x: number, y: number): number {
+    return this.read(x, y);
+  }
+
+  getAt(index: number): number {
+    if (index < 0 || index >= this.size) {
+      return this.defaultValue;
+    }
+    return this.read(index % this.width, Math.floor(index / this.width));
+  }
+
+  set(x: number, y: number, value: number): void {
+    if (!this.wrapEdges && !this.inBounds(x, y)) {
+      return;
+    }
+    if (this.wrapEdges) {
+      x = ((x % this.width) + this.width) % this.width;
+      y = ((y % this.height) + this.height) % this.height;
+    }
+    this.write(x, y, Math.max(this.min, Math.min(this.max, value)));
+  }
+
+  setAt(index: number, value: number): void {
+    if (index < 0 || index >= this.size) {
+      return;
+    }
+    this.set(index % this.width, Math.floor(index / this.width), value);
+  }
+
+  fill(value: number): void {
+    const clamped = Math.max(this.min, Math.min(this.max, value));
+    this.releaseAll();
+    if (this.stored(clamped) === this.storedDefault) return;
+
+    for (let t = 0; t < this.tiles.length; t++) {
+      const tile = this.acquireTile();
+      tile.fill(clamped);
+      this.tiles[t] = tile;
+    }
+  }
+
+  clear(): void {
+    this.releaseAll();
+  }
+
+  copyFrom(source: Grid<T>): void {
+    if (source.size !== this.size) {
+      throw new Error('Grid size mismatch');
+    }
+
+    if (source instanceof ChunkedGrid && source.chunkSize === this.chunkSize &&
+        source.storedDefault === this.storedDefault) {
+      this.releaseAll();
+      for (let t = 0; t < source.tiles.length; t++) {
+        const tile = source.tiles[t];
+        if (tile) {
+          const copy = this.acquireTile();
+          copy.set(tile);
+          this.tiles[t] = copy;
+        }
+      }
+      return;
+    }
+
+    this.loadDense(source.data);
+  }
+
+  forEach(callback: (value: number, x: number, y: number, index: number) => void): void {
+    for (let y = 0, i = 0; y < this.height; y++) {
+      for (let x = 0; x < this.width; x++, i++) {
+        callback(this.read(x, y), x, y, i);
+      }
+    }
+  }
+
+  map(callback: (value: number, x: number, y: number, index: number) => number): void {
+    for (let y = 0, i = 0; y < this.height; y++) {
+      for (let x = 0; x < this.width; x++, i++) {
+        const newValue = callback(this.read(x, y), x, y, i);
+        this.write(x, y, Math.max(this.min, Math.min(this.max, newValue)));
+      }
+    }
+  }
+
+  reduce<R>(callback: (acc: R, value: number, x: number, y: number) => R, initial: R): R {
+    let acc = initial;
+    for (let y = 0; y < this.height; y++) {
+      for (let x = 0; x < this.width; x++) {
+        acc = callback(acc, this.read(x, y), x, y);
+      }
+    }
+    return acc;
+  }
+
+  // --------------------------------------------------------------------------
+  // Dynamics
+  // --------------------------------------------------------------------------
+
+  getScratch(): T {
+    throw new Error(`Chunked grid "${this.name}" has no dense scratch buffer`);
+  }
+
+  swap(): void {
+    // Tiles are double-buffered internally
+  }
+
+  copyToScratch(): void {
+    this.getScratch();
+  }
+
+  diffuse(rate: number): void {
+    this.step(rate, 1, -Infinity, Infinity);
+  }
+
+  decay(rate: number): void {
+    this.step(0, 1 - rate, -Infinity, Infinity);
+  }
+
+  update(diffusionRate: number, decayRate: number, clamp: boolean = true): void {
+    this.step(
+      diffusionRate,
+      1 - decayRate,
+      clamp ? this.min : -Infinity,
+      clamp ? this.max : Infinity
+    );
+  }
+
+  /**
+   * One fused diffuse/decay/clamp pass over the tiles that can change.
+   * Missing tiles are skipped whenever the default value is a fixed point
+   * of the update; otherwise every tile is materialized first.
+   */
+  private step(rate: number, keep: number, min: number, max: number): void {
+    const def = this.defaultValue;
+    const defaultOut = Math.max(min, Math.min(max, def * keep));
+    if (this.stored(defaultOut) !== this.storedDefault) {
+      this.materializeAll();
+    }
+
+    const { tilesX, tilesY } = this;
+    const needed = this.needed;
+    needed.fill(0);
+    for (let t = 0; t < this.tiles.length; t++) {
+      if (!this.tiles[t]) continue;
+      needed[t] = 1;
+      if (rate === 0) continue;
+
+      const tx = t % tilesX;
+      const ty = Math.floor(t / tilesX);
+      for (let dy = -1; dy <= 1; dy++) {
+        for (let dx = -1; dx <= 1; dx++) {
+          let nx = tx + dx;
+          let ny = ty + dy;
+          if (this.wrapEdges) {
+            nx = (nx + tilesX) % tilesX;
+            ny = (ny + tilesY) % tilesY;
+          } else if (nx < 0 || nx >= tilesX || ny < 0 || ny >= tilesY) {
+            continue;
+          }
+          needed[ny * tilesX + nx] = 1;
+        }
+      }
+    }
+
+    for (let t = 0; t < this.tiles.length; t++) {
+      if (needed[t]) this.next[t] = this.stepTile(t, rate, keep, min, max);
+    }
+
+    for (let t = 0; t < this.tiles.length; t++) {
+      if (!needed[t]) continue;
+      const old = this.tiles[t];
+      if (old && !this.frozen[t]) this.spare.push(old);
+      this.tiles[t] = this.next[t];
+      this.next[t] = null;
+      this.frozen[t] = 0;
+    }
+    this.trimSpare();
+  }
+
+  // Returns the new tile, or null when it came out all-default
+  private stepTile(t: number, rate: number, keep: number, min: number, max: number): T | null {
+    const C = this.chunkSize;
+    const x0 = (t % this.tilesX) * C;
+    const y0 = Math.floor(t / this.tilesX) * C;
+    const tw = Math.min(C, this.width - x0);
+    const th = Math.min(C, this.height - y0);
+    const src = this.tiles[t];
+    const dst = this.acquireTile();
+    const def = this.defaultValue;
+    const clampOn = min !== -Infinity || max !== Infinity;
+    let allDefault = true;
+
+    for (let ly = 0; ly < th; ly++) {
+      const gy = y0 + ly;
+      for (let lx = 0; lx < tw; lx++) {
+        const i = ly * C + lx;
+        const current = src ? src[i] : def;
+        let v = current;
+
+        if (rate !== 0) {
+          let sum: number;
+          if (src && lx > 0 && lx < tw - 1 && ly > 0 && ly < th - 1) {
+            const up = i - C;
+            const down = i + C;
+            sum =
+              src[up - 1] + src[up] + src[up + 1] +
+              src[i + 1] + src[down + 1] + src[down] +
+              src[down - 1] + src[i - 1];
+          } else {
+            const gx = x0 + lx;
+            sum =
+              this.read(gx - 1, gy - 1) + this.read(gx, gy - 1) + this.read(gx + 1, gy - 1) +
+              this.read(gx + 1, gy) + this.read(gx + 1, gy + 1) + this.read(gx, gy + 1) +
+              this.read(gx - 1, gy + 1) + this.read(gx - 1, gy);
+          }
+          v = current + (sum / 8 - current) * rate;
+        }
+
+        v *= keep;
+        if (clampOn) v = v < min ? min : v > max ? max : v;
+        dst[i] = v;
+        if (dst[i] !== this.storedDefault) allDefault = false;
+      }
+    }
+
+    if (allDefault) {
+      this.spare.push(dst);
+      return null;
+    }
+    return dst;
+  }
+
+  // --------------------------------------------------------------------------
+  // Snapshots and statistics
+  // --------------------------------------------------------------------------
+
+  /**
+   * Copy-on-write checkpoint: shares every resident tile with the live
+   * grid. `previous` is not needed, since unchanged tiles are already
+   * the same objects.
+   */
+  checkpoint(_previous?: GridCheckpoint): GridCheckpoint {
+    for (let t = 0; t < this.tiles.length; t++) {
+      if (this.tiles[t]) this.frozen[t] = 1;
+    }
+    return {
+      layer: this.name,
+      size: this.size,
+      blockSize: this.chunkSize,
+      chunked: true,
+      blocks: this.tiles.slice(),
+    };
+  }
+
+  /**
+   * Swap a checkpoint's tiles back in. They stay frozen, so the checkpoint
+   * can be restored again later.
+   */
+  restoreCheckpoint(checkpoint: GridCheckpoint): void {
+    if (!checkpoint.chunked || checkpoint.external || checkpoint.size !== this.size ||
+        checkpoint.blockSize !== this.chunkSize || checkpoint.blocks.length !== this.tiles.length) {
+      throw new Error('Checkpoint layout mismatch');
+    }
+
+    this.releaseAll();
+    for (let t = 0; t < this.tiles.length; t++) {
+      const tile = checkpoint.blocks[t] as T | null;
+      this.tiles[t] = tile;
+      this.frozen[t] = tile ? 1 : 0;
+    }
+  }
+
+  snapshot(): ArrayBuffer {
+    const dense = this.data;
+    return dense.buffer instanceof ArrayBuffer ? dense.buffer : dense.slice().buffer as ArrayBuffer;
+  }
+
+  restore(buffer: ArrayBuffer): void {
+    const ArrayConstructor = GRID_ARRAY_TYPES[this.dataType];
+    const restored = new ArrayConstructor(buffer);
+    if (restored.length !== this.size) {
+      throw new Error('Snapshot size mismatch');
+    }
+    this.loadDense(restored);
+  }
+
+  clone(): ChunkedGrid<T> {
+    const cloned = new ChunkedGrid<T>({
+      name: this.name,
+      type: this.dataType,
+      dimensions: { width: this.width, height: this.height },
+      defaultValue: this.defaultValue,
+      min: this.min,
+      max: this.max,
+      wrapEdges: this.wrapEdges,
+      backend: 'chunked',
+      chunkSize: this.chunkSize
+    });
+    cloned.copyFrom(this);
+    return cloned;
+  }
+
+  sum(): number {
+    let total = 0;
+    this.forEachTile((tile, tw, th) => {
+      if (!tile) {
+        total += this.storedDefault * tw * th;
+        return;
+      }
+      for (let ly = 0; ly < th; ly++) {
+        const row = ly * this.chunkSize;
+        for (let lx = 0; lx < tw; lx++) total += tile[row + lx];
+      }
+    });
+    return total;
+  }
+
+  range(): { min: number; max: number } {
+    let min = Infinity;
+    let max = -Infinity;
+    this.forEachTile((tile, tw, th) => {
+      if (!tile) {
+        if (this.storedDefault < min) min = this.storedDefault;
+        if (this.storedDefault > max) max = this.storedDefault;
+        return;
+      }
+      for (let ly = 0; ly < th; ly++) {
+        const row = ly * this.chunkSize;
+        for (let lx = 0; lx < tw; lx++) {
+          const val = tile[row + lx];
+          if (val < min) min = val;
+          if (val > max) max = val;
+        }
+      }
+    });
+    return { min, max };
+  }
+
+  /**
+   * Bytes held by resident tiles plus released tiles kept for reuse
+   */
+  memoryUsage(): number {
+    const tileBytes = this.chunkSize * this.chunkSize * GRID_ARRAY_TYPES[this.dataType].BYTES_PER_ELEMENT;
+    return (this.residentTiles + this.spare.length) * tileBytes;
+  }
+
+  // --------------------------------------------------------------------------
+  // Tile storage
+  // --------------------------------------------------------------------------
+
+  private read(x: number, y: number): number {
+    if (this.wrapEdges) {
+      x = ((x % this.width) + this.width) % this.width;
+      y = ((y % this.height) + this.height) % this.height;
+    } else if (x < 0 || x >= this.width || y < 0 || y >= this.height) {
+      return this.defaultValue;
+    }
+    const C = this.chunkSize;
+    const tile = this.tiles[Math.floor(y / C) * this.tilesX + Math.floor(x / C)];
+    return tile ? tile[(y % C) * C + (x % C)] : this.defaultValue;
+  }
+
+  // In-bounds write of an already clamped value
+  private write(x: number, y: number, value: number): void {
+    const C = this.chunkSize;
+    const t = Math.floor(y / C) * this.tilesX + Math.floor(x / C);
+    let tile = this.tiles[t];
+    if (!tile) {
+      if (this.stored(value) === this.storedDefault) return;
+      tile = this.acquireTile();
+      tile.fill(this.defaultValue);
+      this.tiles[t] = tile;
+    } else if (this.frozen[t]) {
+      const copy = this.acquireTile();
+      copy.set(tile);
+      this.tiles[t] = tile = copy;
+      this.frozen[t] = 0;
+    }
+    tile[(y % C) * C + (x % C)] = value;
+  }
+
+  private loadDense(data: ArrayLike<number>): void {
+    this.releaseAll();
+    for (let y = 0, i = 0; y < this.height; y++) {
+      for (let x = 0; x < this.width; x++, i++) {
+        this.write(x, y, data[i]);
+      }
+    }
+  }
+
+  private materializeAll(): void {
+    for (let t = 0; t < this.tiles.length; t++) {
+      if (this.tiles[t]) continue;
+      const tile = this.acquireTile();
+      tile.fill(this.defaultValue);
+      this.tiles[t] = tile;
+    }
+  }
+
+  private forEachTile(callback: (tile: T | null, tw: number, th: number) => void): void {
+    const C = this.chunkSize;
+    for (let t = 0; t < this.tiles.length; t++) {
+      const x0 = (t % this.tilesX) * C;
+      const y0 = Math.floor(t / this.tilesX) * C;
+      callback(this.tiles[t], Math.min(C, this.width - x0), Math.min(C, this.height - y0));
+    }
+  }
+
+  private acquireTile(): T {
+    return this.spare.pop() ?? this.allocate(this.chunkSize * this.chunkSize);
+  }
+
+  private releaseAll(): void {
+    for (let t = 0; t < this.tiles.length; t++) {
+      const tile = this.tiles[t];
+      if (tile) {
+        if (!this.frozen[t]) this.spare.push(tile);
+        this.tiles[t] = null;
+        this.frozen[t] = 0;
+      }
+    }
+    this.trimSpare();
+  }
+
+  // Keep enough spare tiles for the next step's double buffering, no more
+  private trimSpare(): void {
+    const keep = Math.max(MIN_SPARE_TILES, this.residentTiles);
+    if (this.spare.length > keep) this.spare.length = keep;
+  }
+
+  private stored(value: number): number {
+    this.probe[0] = value;
+    return this.probe[0];
+  }
+}
+
+registerGridBackend('chunked', (config) => new ChunkedGrid(config));
+
+export default ChunkedGrid;
@@ -0,0 +1,196 @@
+/**
+ * FileBackedGrid.test.ts - Tests for the file-backed grid backend
+ */
+
+import { describe, it, expect, beforeAll, afterAll } from 'vitest';
+import * as fs from 'node:fs';
+import * as os from 'node:os';
+import * as path from 'node:path';
+import { Grid } from './Grid';
+import { FileBackedGrid, GridFileSystem, registerFileGridBackend } from './FileBackedGrid';
+import { World } from './World';
+
+let dir: string;
+
+beforeAll(() => {
+  dir = fs.mkdtempSync(path.join(os.tmpdir(), 'gx-grid-'));
+});
+
+afterAll(() => {
+  fs.rmSync(dir, { recursive: true, force: true });
+});
+
+function pair(name: string, width: number, height: number, wrapEdges: boolean, pageSize = 16, cachePages = 4) {
+  const base = { name, type: 'float32' as const, dimensions: { width, height }, wrapEdges };
+  return {
+    dense: new Grid(base),
+    file: new FileBackedGrid(
+      { ...base, backend: 'file', file: path.join(dir, `${name}.bin`), pageSize, cachePages },
+      fs as unknown as GridFileSystem
+    ),
+  };
+}
+
+function expectSame(file: Grid, dense: Grid): void {
+  const a = file.data;
+  const b = dense.data;
+  expect(a.length).toBe(b.length);
+  for (let i = 0; i < b.length; i++) {
+    expect(a[i]).toBeCloseTo(b[i], 5);
+  }
+}
+
+describe('FileBackedGrid', () => {
+  for (const wrap of [true, false]) {
+    it(`diffuses like the dense grid (${wrap ? 'wrapped' : 'bounded'})`, () => {
+      const { dense, file } = pair(`diffuse-${wrap}`, 13, 10, wrap);
+      for (const [x, y, v] of [[0, 0, 5], [6, 5, 3], [12, 9, 2], [3, 9, 1]]) {
+        dense.set(x, y, v);
+        file.set(x, y, v);
+      }
+
+      for (let i = 0; i < 3; i++) {
+        dense.diffuse(0.3);
+        file.diffuse(0.3);
+      }
+      expectSame(file, dense);
+
+      dense.update(0.2, 0.1);
+      file.update(0.2, 0.1);
+      expectSame(file, dense);
+      expect(file.sum()).toBeCloseTo(dense.sum(), 4);
+      file.close();
+    });
+  }
+
+  it('keeps at most cachePages pages in memory', () => {
+    const { file } = pair('lru', 64, 64, true, 64, 3);
+    for (let y = 0; y < 64; y++) {
+      file.set(y, y, y);
+    }
+    const stats = file.getCacheStats();
+    expect(stats.cachedPages).toBe(3);
+    expect(stats.writebacks).toBeGreaterThan(0);
+    expect(file.memoryUsage()).toBe(3 * 64 * 4);
+
+    for (let y = 0; y < 64; y++) {
+      expect(file.get(y, y)).toBe(y);
+    }
+    file.close();
+  });
+
+  it('persists the layer to its file on flush', () => {
+    const target = path.join(dir, 'persist.bin');
+    const config = {
+      name: 'persist', type: 'float32' as const, dimensions: { width: 8, height: 8 },
+      file: target, pageSize: 8, cachePages: 2,
+    };
+    const first = new FileBackedGrid(config, fs as unknown as GridFileSystem);
+    first.set(2, 3, 7);
+    first.set(7, 7, 1);
+    first.close();
+
+    const onDisk = new Float32Array(new Uint8Array(fs.readFileSync(target)).buffer);
+    expect(onDisk[3 * 8 + 2]).toBe(7);
+
+    const reopened = new FileBackedGrid({ ...config, resume: true }, fs as unknown as GridFileSystem);
+    expect(reopened.get(2, 3)).toBe(7);
+    expect(reopened.get(7, 7)).toBe(1);
+    reopened.close();
+
+    const fresh = new FileBackedGrid(config, fs as unknown as GridFileSystem);
+    expect(fresh.get(2, 3)).toBe(0);
+    expect(fresh.sum()).toBe(0);
+    fresh.close();
+  });
+
+  it('refuses to restore a world checkpoint holding an external layer', async () => {
+    await registerFileGridBackend();
+    const target = path.join(dir, 'checkpoint.bin');
+    const world = new World({
+      dimensions: { width: 16, height: 16 },
+      seed: 1,
+      layers: [
+        { name: 'scent', type: 'float32', backend: 'file', file: target, pageSize: 32, cachePages: 2 },
+        { name: 'food', type: 'float32' },
+      ],
+    });
+    world.setValue('scent', 3, 4, 2);
+    world.setValue('food', 1, 1, 5);
+
+    const checkpoint = world.checkpoint();
+    expect(checkpoint.grids.scent.external).toBe(true);
+    expect(checkpoint.grids.scent.blocks).toHaveLength(0);
+    const onDisk = new Float32Array(new Uint8Array(fs.readFileSync(target)).buffer);
+    expect(onDisk[4 * 16 + 3]).toBe(2);
+
+    world.setValue('food', 1, 1, 0);
+    world.setValue('scent', 3, 4, 9);
+    expect(() => world.restoreCheckpoint(checkpoint)).toThrow(/external/);
+    expect(world.getValue('food', 1, 1)).toBe(0);
+    expect(world.getValue('scent', 3, 4)).toBe(9);
+    expect(() => new Grid({ name: 'scent', type: 'float32', dimensions: { width: 16, height: 16 } })
+      .restoreCheckpoint(checkpoint.grids.scent)).toThrow();
+    (world.getLayer('scent') as FileBackedGrid).close();
+  });
+
+  it('closes the file when it cannot resume from it', () => {
+    const target = path.join(dir, 'resize.bin');
+    fs.writeFileSync(target, new Uint8Array(10));
+    const opened: number[] = [];
+    const closed: number[] = [];
+    const tracking: GridFileSystem = {
+      ...(fs as unknown as GridFileSystem),
+      openSync: (file, flags) => {
+        const fd = fs.openSync(file, flags);
+        opened.push(fd);
+        return fd;
+      },
+      closeSync: (fd) => {
+        closed.push(fd);
+        fs.closeSync(fd);
+      },
+    };
+
+    const config = { name: 'resize', type: 'float32' as const, dimensions: { width: 4, height: 4 }, file: target };
+    expect(() => new FileBackedGrid({ ...config, resume: true }, tracking)).toThrow(/resume/);
+    expect(closed).toEqual(opened);
+    expect(fs.statSync(target).size).toBe(10);
+
+    const grid = new FileBackedGrid(config, tracking);
+    expect(grid.get(1, 1)).toBe(0);
+    grid.close();
+  });
+
+  it('restores dense snapshots but refuses to take one', () => {
+    const { dense, file } = pair('snapshot', 12, 7, true, 10);
+    dense.set(4, 4, 2);
+    dense.set(11, 0, 1);
+
+    file.restore(dense.snapshot());
+    expectSame(file, dense);
+
+    expect(() => file.snapshot()).toThrow(/flush/);
+    expect(file.clone().dense).toBe(true);
+    file.close();
+  });
+
+  it('is selected through the layer config once registered', async () => {
+    await registerFileGridBackend();
+    const world = new World({
+      dimensions: { width: 256, height: 256 },
+      seed: 1,
+      layers: [{ name: 'scent', type: 'float32', backend: 'file', file: path.join(dir, 'world.bin'), pageSize: 1024, cachePages: 8 }],
+    });
+    const layer = world.getLayer('scent') as FileBackedGrid;
+
+    expect(layer).toBeInstanceOf(FileBackedGrid);
+    expect(layer.dense).toBe(false);
+
+    world.setValue('scent', 100, 100, 1);
+    world.updateLayers([{ layer: 'scent', diffusionRate: 0.1, decayRate: 0.01 }]);
+    expect(world.getValue('scent', 101, 100)).toBeGreaterThan(0);
+    expect(layer.memoryUsage()).toBeLessThan(256 * 256 * 4);
+    layer.close();
+  });
+});
@@ -0,0 +1,543 @@
+/**
+ * GenesisX Core Engine - File-backed Grid
+ *
+ * Node-only grid backend for headless runs on fields too large for the
+ * heap. The layer lives in a file; cells are read and written through an
+ * LRU cache of fixed-size pages using positioned fs reads and writes, so
+ * resident memory is bounded by `cachePages * pageSize` elements.
+ *
+ * Diffusion and decay stream the file row by row with a three-row window,
+ * updating in place. The file holds only the current state: flush() makes
+ * it a complete copy of the layer, snapshot() is refused rather than
+ * reading the whole layer into memory, and checkpoint() flushes and returns
+ * an external marker that cannot be restored.
+ *
+ * A new grid starts from defaultValue, overwriting whatever the file held;
+ * set `resume` in the layer config to continue from an existing file.
+ *
+ * The backend registers itself under 'file' once registerFileGridBackend()
+ * has resolved; this module has no static Node imports so it stays safe to
+ * bundle for the browser.
+ */
+
+import type { WorldDimensions, GridLayerConfig } from '../engine/EngineConfig';
+import { Grid, GridCheckpoint, TypedArray, GRID_ARRAY_TYPES, registerGridBackend } from './Grid';
+import { fusedRows } from './GridKernels';
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+export const DEFAULT_PAGE_SIZE = 16384;     // Elements per page
+export const DEFAULT_CACHE_PAGES = 64;
+
+/**
+ * The subset of node:fs used by the backend
+ */
+export interface GridFileSystem {
+  openSync(path: string, flags: string): number;
+  closeSync(fd: number): void;
+  readSync(fd: number, buffer: Uint8Array, offset: number, length: number, position: number): number;
+  writeSync(fd: number, buffer: Uint8Array, offset: number, length: number, position: number): number;
+  fstatSync(fd: number): { size: number };
+  ftruncateSync(fd: number, length: number): void;
+  fsyncSync(fd: number): void;
+}
+
+export interface FileBackedGridStats {
+  cachedPages: number;
+  hits: number;
+  misses: number;
+  writebacks: number;
+}
+
+interface Page<T> {
+  data: T;
+  dirty: boolean;
+}
+
+// ============================================================================
+// FileBackedGrid Class
+// ============================================================================
+
+export class FileBackedGrid<T extends TypedArray = Float32Array> extends Grid<T> {
+  public readonly file: string;
+  public readonly pageSize: number;
+  public readonly cachePages: number;
+
+  private fs: GridFileSystem;
+  private fd: number;
+  private bytesPerElement: number;
+  private pages: Map<number, Page<T>> = new Map();
+  private hotIndex: number = -1;
+  private hotPage: Page<T> | null = null;
+  private hits: number = 0;
+  private misses: number = 0;
+  private writebacks: number = 0;
+
+  // Row window for streaming updates
+  private window: T | null = null;
+  private windowOut: T | null = null;
+  private firstRow: T | null = null;
+
+  constructor(config: GridLayerConfig & { dimensions: WorldDimensions }, fs: GridFileSystem) {
+    super(config);
+    if (!config.file) {
+      throw new Error(`File-backed grid "${config.name}" needs a file path`);
+    }
+    this.file = config.file;
+    this.pageSize = Math.max(1, Math.floor(config.pageSize ?? DEFAULT_PAGE_SIZE));
+    this.cachePages = Math.max(2, Math.floor(config.cachePages ?? DEFAULT_CACHE_PAGES));
+    this.fs = fs;
+    this.bytesPerElement = GRID_ARRAY_TYPES[this.dataType].BYTES_PER_ELEMENT;
+
+    const bytes = this.size * this.bytesPerElement;
+    if (config.resume) {
+      this.fd = fs.openSync(this.file, 'r+');
+      try {
+        const size = fs.fstatSync(this.fd).size;
+        if (size !== bytes) {
+          throw new Error(`Cannot resume grid "${this.name}": ${this.file} holds ${size} bytes, expected ${bytes}`);
+        }
+      } catch (error) {
+        fs.closeSync(this.fd);
+        throw error;
+      }
+    } else {
+      this.fd = fs.openSync(this.file, 'w+');
+      try {
+        fs.ftruncateSync(this.fd, bytes);
+        this.fillFile(this.defaultValue);
+      } catch (error) {
+        fs.closeSync(this.fd);
+        throw error;
+      }
+    }
+  }
+
+  get dense(): boolean {
+    return false;
+  }
+
+  /**
+   * Dense in-memory copy of the whole layer. Only sensible for layers that
+   * fit in memory; writes to it are not reflected.
+   */
+  get data(): T {
+    const out = this.allocate(this.size);
+    this.readRange(0, this.size, out);
+    return out;
+  }
+
+  // --------------------------------------------------------------------------
+  // Cell access
+  // --------------------------------------------------------------------------
+
+  get(x: number, y: number): number {
+    if (!this.wrapEdges && !this.inBounds(x, y)) {
+      return this.defaultValue;
+    }
+    return this.readAt(this.index(x, y));
+  }
+
+  getAt(index: number): number {
+    if (index < 0 || index >= this.size) {
+      return this.defaultValue;
+    }
+    return this.readAt(index);
+  }
+
+  set(x: number, y: number, value: number): void {
+    if (!this.wrapEdges && !this.inBounds(x, y)) {
+      return;
+    }
+    this.writeAt(this.index(x, y), Math.max(this.min, Math.min(this.max, value)));
+  }
+
+  setAt(index: number, value: number): void {
+    if (index < 0 || index >= this.size) {
+      return;
+    }
+    this.writeAt(index, Math.max(this.min, Math.min(this.max, value)));
+  }
+
+  fill(value: number): void {
+    this.dropCache();
+    this.fillFile(Math.max(this.min, Math.min(this.max, value)));
+  }
+
+  clear(): void {
+    this.fill(this.defaultValue);
+  }
+
+  copyFrom(source: Grid<T>): void {
+    if (source.size !== this.size) {
+      throw new Error('Grid size mismatch');
+    }
+    this.writeRange(0, source.data);
+  }
+
+  forEach(callback: (value: number, x: number, y: number, index: number) => void): void {
+    const row = this.rowBuffer();
+    for (let y = 0; y < this.height; y++) {
+      this.readRange(y * this.width, this.width, row);
+      for (let x = 0; x < this.width; x++) {
+        callback(row[x], x, y, y * this.width + x);
+      }
+    }
+  }
+
+  map(callback: (value: number, x: number, y: number, index: number) => number): void {
+    const row = this.rowBuffer();
+    for (let y = 0; y < this.height; y++) {
+      this.readRange(y * this.width, this.width, row);
+      for (let x = 0; x < this.width; x++) {
+        const newValue = callback(row[x], x, y, y * this.width + x);
+        row[x] = Math.max(this.min, Math.min(this.max, newValue));
+      }
+      this.writeRange(y * this.width, row);
+    }
+  }
+
+  reduce<R>(callback: (acc: R, value: number, x: number, y: number) => R, initial: R): R {
+    let acc = initial;
+    const row = this.rowBuffer();
+    for (let y = 0; y < this.height; y++) {
+      this.readRange(y * this.width, this.width, row);
+      for (let x = 0; x < this.width; x++) {
+        acc = callback(acc, row[x], x, y);
+      }
+    }
+    return acc;
+  }
+
+  // --------------------------------------------------------------------------
+  // Dynamics
+  // --------------------------------------------------------------------------
+
+  getScratch(): T {
+    throw new Error(`File-backed grid "${this.name}" has no dense scratch buffer`);
+  }
+
+  swap(): void {
+    // Updates stream in place
+  }
+
+  copyToScratch(): void {
+    this.getScratch();
+  }
+
+  diffuse(rate: number): void {
+    this.stream(rate, 1, -Infinity, Infinity);
+  }
+
+  decay(rate: number): void {
+    this.stream(0, 1 - rate, -Infinity, Infinity);
+  }
+
+  update(diffusionRate: number, decayRate: number, clamp: boolean = true): void {
+    this.stream(
+      diffusionRate,
+      1 - decayRate,
+      clamp ? this.min : -Infinity,
+      clamp ? this.max : Infinity
+    );
+  }
+
+  /**
+   * In-place row streaming. The window holds the old rows y-1, y, y+1;
+   * row 0 is kept aside so the last row can wrap onto its old value.
+   */
+  private stream(rate: number, keep: number, min: number, max: number): void {
+    const w = this.width;
+    const h = this.height;
+    if (!this.window) {
+      this.window = this.allocateLocal(w * 3);
+      this.windowOut = this.allocateLocal(w * 3);
+      this.firstRow = this.allocateLocal(w);
+    }
+    const win = this.window;
+    const out = this.windowOut!;
+    const first = this.firstRow!;
+    const up = win.subarray(0, w) as T;
+    const cur = win.subarray(w, 2 * w) as T;
+    const down = win.subarray(2 * w, 3 * w) as T;
+
+    this.readRange(0, w, first);
+    if (this.wrapEdges) {
+      this.readRange((h - 1) * w, w, up);
+    } else {
+      up.fill(this.defaultValue);
+    }
+    cur.set(first);
+
+    for (let y = 0; y < h; y++) {
+      if (y + 1 < h) {
+        this.readRange((y + 1) * w, w, down);
+      } else if (this.wrapEdges) {
+        down.set(first);
+      } else {
+        down.fill(this.defaultValue);
+      }
+
+      fusedRows(win, out, w, 3, 1, 2, rate, keep, min, max, this.wrapEdges, this.defaultValue);
+      this.writeRange(y * w, out.subarray(w, 2 * w) as T);
+
+      up.set(cur);
+      cur.set(down);
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // Persistence
+  // --------------------------------------------------------------------------
+
+  /**
+   * Write dirty pages back and sync the file. After this the file is a
+   * complete snapshot of the layer.
+   */
+  flush(): void {
+    for (const [index, page] of this.pages) {
+      if (page.dirty) this.writePage(index, page);
+    }
+    this.fs.fsyncSync(this.fd);
+  }
+
+  /**
+   * Flush and close the file. The grid cannot be used afterwards.
+   */
+  close(): void {
+    this.flush();
+    this.dropCache();
+    this.fs.closeSync(this.fd);
+    this.fd = -1;
+  }
+
+  /**
+   * Refused: a dense copy of a layer too large for the heap is exactly what
+   * this backend avoids. flush() leaves a complete copy in the file.
+   */
+  snapshot(): ArrayBuffer {
+    throw new Error(`File-backed grid "${this.name}" has no in-memory snapshot; flush() persists it to ${this.file}`);
+  }
+
+  restore(buffer: ArrayBuffer): void {
+    const ArrayConstructor = GRID_ARRAY_TYPES[this.dataType];
+    const restored = new ArrayConstructor(buffer);
+    if (restored.length !== this.size) {
+      throw new Error('Snapshot size mismatch');
+    }
+    this.writeRange(0, restored as T);
+  }
+
+  /**
+   * Flush the file and return an external marker. Copying the layer into
+   * memory would defeat the backend, so the checkpoint holds no blocks and
+   * cannot be restored.
+   */
+  checkpoint(_previous?: GridCheckpoint): GridCheckpoint {
+    this.flush();
+    return {
+      layer: this.name,
+      size: this.size,
+      blockSize: this.pageSize,
+      chunked: false,
+      blocks: [],
+      external: true,
+    };
+  }
+
+  restoreCheckpoint(_checkpoint: GridCheckpoint): void {
+    throw new Error(`File-backed grid "${this.name}" keeps only its current state and cannot be restored from a checkpoint`);
+  }
+
+  /**
+   * In-memory dense copy
+   */
+  clone(): Grid<T> {
+    const cloned = new Grid<T>({
+      name: this.name,
+      type: this.dataType,
+      dimensions: { width: this.width, height: this.height },
+      defaultValue: this.defaultValue,
+      min: this.min,
+      max: this.max,
+      wrapEdges: this.wrapEdges
+    });
+    cloned.data.set(this.data);
+    return cloned;
+  }
+
+  sum(): number {
+    let total = 0;
+    this.forEachPage((page, length) => {
+      for (let i = 0; i < length; i++) total += page[i];
+    });
+    return total;
+  }
+
+  range(): { min: number; max: number } {
+    let min = Infinity;
+    let max = -Infinity;
+    this.forEachPage((page, length) => {
+      for (let i = 0; i < length; i++) {
+        const val = page[i];
+        if (val < min) min = val;
+        if (val > max) max = val;
+      }
+    });
+    return { min, max };
+  }
+
+  /**
+   * Bytes held in memory: cached pages plus the streaming window
+   */
+  memoryUsage(): number {
+    const pageBytes = this.pageSize * this.bytesPerElement;
+    const windowBytes = this.window ? this.width * 7 * this.bytesPerElement : 0;
+    return this.pages.size * pageBytes + windowBytes;
+  }
+
+  getCacheStats(): FileBackedGridStats {
+    return {
+      cachedPages: this.pages.size,
+      hits: this.hits,
+      misses: this.misses,
+      writebacks: this.writebacks,
+    };
+  }
+
+  // --------------------------------------------------------------------------
+  // Page cache
+  // --------------------------------------------------------------------------
+
+  private readAt(index: number): number {
+    const p = Math.floor(index / this.pageSize);
+    return this.page(p).data[index - p * this.pageSize];
+  }
+
+  private writeAt(index: number, value: number): void {
+    const p = Math.floor(index / this.pageSize);
+    const page = this.page(p);
+    page.data[index - p * this.pageSize] = value;
+    page.dirty = true;
+  }
+
+  private readRange(start: number, length: number, out: T): void {
+    let done = 0;
+    while (done < length) {
+      const index = start + done;
+      const p = Math.floor(index / this.pageSize);
+      const offset = index - p * this.pageSize;
+      const take = Math.min(length - done, this.pageSize - offset);
+      out.set(this.page(p).data.subarray(offset, offset + take) as T, done);
+      done += take;
+    }
+  }
+
+  private writeRange(start: number, values: T): void {
+    let done = 0;
+    while (done < values.length) {
+      const index = start + done;
+      const p = Math.floor(index / this.pageSize);
+      const offset = index - p * this.pageSize;
+      const take = Math.min(values.length - done, this.pageSize - offset);
+      const page = this.page(p);
+      page.data.set(values.subarray(done, done + take) as T, offset);
+      page.dirty = true;
+      done += take;
+    }
+  }
+
+  private page(index: number): Page<T> {
+    if (index === this.hotIndex) {
+      this.hits++;
+      return this.hotPage!;
+    }
+
+    let page = this.pages.get(index);
+    if (page) {
+      this.hits++;
+      this.pages.delete(index);
+    } else {
+      this.misses++;
+      if (this.pages.size >= this.cachePages) this.evictOldest();
+      page = { data: this.allocateLocal(this.pageSize), dirty: false };
+      this.readPage(index, page);
+    }
+    this.pages.set(index, page);
+    this.hotIndex = index;
+    this.hotPage = page;
+    return page;
+  }
+
+  private evictOldest(): void {
+    const oldest = this.pages.keys().next();
+    if (oldest.done) return;
+    const page = this.pages.get(oldest.value)!;
+    if (page.dirty) this.writePage(oldest.value, page);
+    this.pages.delete(oldest.value);
+    if (oldest.value === this.hotIndex) {
+      this.hotIndex = -1;
+      this.hotPage = null;
+    }
+  }
+
+  private readPage(index: number, page: Page<T>): void {
+    const length = Math.min(this.pageSize, this.size - index * this.pageSize);
+    const bytes = new Uint8Array(page.data.buffer, page.data.byteOffset, length * this.bytesPerElement);
+    this.fs.readSync(this.fd, bytes, 0, bytes.length, index * this.pageSize * this.bytesPerElement);
+  }
+
+  private writePage(index: number, page: Page<T>): void {
+    const length = Math.min(this.pageSize, this.size - index * this.pageSize);
+    const bytes = new Uint8Array(page.data.buffer, page.data.byteOffset, length * this.bytesPerElement);
+    this.fs.writeSync(this.fd, bytes, 0, bytes.length, index * this.pageSize * this.bytesPerElement);
+    page.dirty = false;
+    this.writebacks++;
+  }
+
+  // Stream pages without disturbing the cache more than necessary
+  private forEachPage(callback: (page: T, length: number) => void): void {
+    const pageCount = Math.ceil(this.size / this.pageSize);
+    for (let p = 0; p < pageCount; p++) {
+      callback(this.page(p).data, Math.min(this.pageSize, this.size - p * this.pageSize));
+    }
+  }
+
+  private fillFile(value: number): void {
+    const chunk = this.allocateLocal(this.pageSize);
+    chunk.fill(value);
+    const bytes = new Uint8Array(chunk.buffer, chunk.byteOffset, chunk.byteLength);
+    const total = this.size * this.bytesPerElement;
+    for (let position = 0; position < total; position += bytes.length) {
+      this.fs.writeSync(this.fd, bytes, 0, Math.min(bytes.length, total - position), position);
+    }
+  }
+
+  private dropCache(): void {
+    this.pages.clear();
+    this.hotIndex = -1;
+    this.hotPage = null;
+  }
+
+  private rowBuffer(): T {
+    return this.allocateLocal(this.width);
+  }
+
+  // Never shared, regardless of the layer config
+  private allocateLocal(length: number): T {
+    return new GRID_ARRAY_TYPES[this.dataType](length) as T;
+  }
+}
+
+/**
+ * Load node:fs and register the 'file' grid backend. Resolves once layers
+ * with `backend: 'file'` can be created.
+ */
+export async function registerFileGridBackend(fs?: GridFileSystem): Promise<void> {
+  const fileSystem = fs ?? (await import('node:fs')) as unknown as GridFileSystem;
+  registerGridBackend('file', (config) => new FileBackedGrid(config, fileSystem));
+}
+
+export default FileBackedGrid;
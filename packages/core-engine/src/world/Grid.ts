@@ -6,6 +6,7 @@
  */
 
 import type { WorldDimensions, GridLayerConfig } from '../engine/EngineConfig';
+import { fusedRows, scaleInPlace } from './GridKernels';
 
 // ============================================================================
 // Type Definitions
@@ -21,13 +22,34 @@ export type TypedArray = Float32Array | Uint8Array | Int32Array | Uint32Array;
 
 export type GridDataType = 'float32' | 'uint8' | 'int32' | 'uint32';
 
-const TYPE_MAP: Record<GridDataType, TypedArrayConstructor> = {
+export const GRID_ARRAY_TYPES: Record<GridDataType, TypedArrayConstructor> = {
   float32: Float32Array,
   uint8: Uint8Array,
   int32: Int32Array,
   uint32: Uint32Array
 };
 
+/**
+ * Block-structured grid checkpoint. Blocks are immutable once captured and
+ * may be shared with the live grid (chunked backend) or with the previous
+ * checkpoint (dense backend); null is an all-default block.
+ *
+ * An external checkpoint holds no blocks: the layer persists itself (file
+ * backend) and keeps only its current state, so it cannot be restored.
+ */
+export interface GridCheckpoint {
+  readonly layer: string;
+  readonly size: number;
+  readonly blockSize: number;       // Elements per block (chunked: tile edge length)
+  readonly chunked: boolean;
+  readonly blocks: ReadonlyArray<TypedArray | null>;
+  readonly external?: boolean;      // No blocks; see above
+}
+
+// Dense checkpoints track writes and share memory in blocks of this many cells
+export const CHECKPOINT_BLOCK_SHIFT = 12;
+export const CHECKPOINT_BLOCK_SIZE = 1 << CHECKPOINT_BLOCK_SHIFT;
+
 // ============================================================================
 // Grid Class
 // ============================================================================
@@ -42,10 +64,15 @@ export class Grid<T extends TypedArray = Float32Array> {
   public readonly min: number;
   public readonly max: number;
   public readonly defaultValue: number;
+  public readonly shared: boolean;
 
   private _data: T;
   private _scratch: T | null = null;
 
+  // Blocks written since `cleanAs`, the checkpoint the data last matched
+  private dirty: Uint8Array;
+  private cleanAs: GridCheckpoint | null = null;
+
   constructor(config: GridLayerConfig & { dimensions: WorldDimensions }) {
     this.name = config.name;
     this.width = config.dimensions.width;
@@ -56,19 +83,51 @@ export class Grid<T extends TypedArray = Float32Array> {
     this.min = config.min ?? -Infinity;
     this.max = config.max ?? Infinity;
     this.defaultValue = config.defaultValue ?? 0;
+    this.shared = config.shared ?? false;
 
-    const ArrayConstructor = TYPE_MAP[this.dataType];
-    this._data = new ArrayConstructor(this.size) as T;
+    this._data = this.allocate(this.dense ? this.size : 0);
+    this.dirty = new Uint8Array(this.dense ? Math.ceil(this.size / CHECKPOINT_BLOCK_SIZE) : 0);
 
     if (this.defaultValue !== 0) {
       this._data.fill(this.defaultValue);
     }
   }
 
+  /**
+   * Whether `data` is the live backing store (false for chunked storage,
+   * where it is a dense copy)
+   */
+  get dense(): boolean {
+    return true;
+  }
+
+  /**
+   * The live backing store. Callers that write through it directly must
+   * report the cells they wrote with markDirty().
+   */
   get data(): T {
     return this._data;
   }
 
+  /**
+   * Record a write to cells [start, end) for the next checkpoint()
+   */
+  markDirty(start: number, end: number = start + 1): void {
+    const last = (Math.min(end, this.size) - 1) >>> CHECKPOINT_BLOCK_SHIFT;
+    for (let b = Math.max(0, start) >>> CHECKPOINT_BLOCK_SHIFT; b <= last; b++) {
+      this.dirty[b] = 1;
+    }
+  }
+
+  protected allocate(length: number = this.size): T {
+    const ArrayConstructor = GRID_ARRAY_TYPES[this.dataType];
+    if (this.shared) {
+      const bytes = length * ArrayConstructor.BYTES_PER_ELEMENT;
+      return new ArrayConstructor(new SharedArrayBuffer(bytes)) as T;
+    }
+    return new ArrayConstructor(length) as T;
+  }
+
   index(x: number, y: number): number {
     if (this.wrapEdges) {
       x = ((x % this.width) + this.width) % this.width;
@@ -107,7 +166,9 @@ export class Grid<T extends TypedArray = Float32Array> {
       return;
     }
     const clamped = Math.max(this.min, Math.min(this.max, value));
-    this._data[this.index(x, y)] = clamped;
+    const index = this.index(x, y);
+    this._data[index] = clamped;
+    this.dirty[index >>> CHECKPOINT_BLOCK_SHIFT] = 1;
   }
 
   setAt(index: number, value: number): void {
@@ -116,6 +177,7 @@ export class Grid<T extends TypedArray = Float32Array> {
     }
     const clamped = Math.max(this.min, Math.min(this.max, value));
     this._data[index] = clamped;
+    this.dirty[index >>> CHECKPOINT_BLOCK_SHIFT] = 1;
   }
 
   add(x: number, y: number, delta: number): void {
@@ -163,6 +225,7 @@ export class Grid<T extends TypedArray = Float32Array> {
   fill(value: number): void {
     const clamped = Math.max(this.min, Math.min(this.max, value));
     this._data.fill(clamped);
+    this.dirty.fill(1);
   }
 
   clear(): void {
@@ -174,36 +237,40 @@ export class Grid<T extends TypedArray = Float32Array> {
       throw new Error('Grid size mismatch');
     }
     this._data.set(source.data);
+    this.dirty.fill(1);
   }
 
   forEach(callback: (value: number, x: number, y: number, index: number) => void): void {
-    for (let i = 0; i < this.size; i++) {
-      const { x, y } = this.coords(i);
-      callback(this._data[i], x, y, i);
+    for (let y = 0, i = 0; y < this.height; y++) {
+      for (let x = 0; x < this.width; x++, i++) {
+        callback(this._data[i], x, y, i);
+      }
     }
   }
 
   map(callback: (value: number, x: number, y: number, index: number) => number): void {
-    for (let i = 0; i < this.size; i++) {
-      const { x, y } = this.coords(i);
-      const newValue = callback(this._data[i], x, y, i);
-      this._data[i] = Math.max(this.min, Math.min(this.max, newValue));
+    for (let y = 0, i = 0; y < this.height; y++) {
+      for (let x = 0; x < this.width; x++, i++) {
+        const newValue = callback(this._data[i], x, y, i);
+        this._data[i] = Math.max(this.min, Math.min(this.max, newValue));
+      }
     }
+    this.dirty.fill(1);
   }
 
   reduce<R>(callback: (acc: R, value: number, x: number, y: number) => R, initial: R): R {
     let acc = initial;
-    for (let i = 0; i < this.size; i++) {
-      const { x, y } = this.coords(i);
-      acc = callback(acc, this._data[i], x, y);
+    for (let y = 0, i = 0; y < this.height; y++) {
+      for (let x = 0; x < this.width; x++, i++) {
+        acc = callback(acc, this._data[i], x, y);
+      }
     }
     return acc;
   }
 
   getScratch(): T {
     if (!this._scratch) {
-      const ArrayConstructor = TYPE_MAP[this.dataType];
-      this._scratch = new ArrayConstructor(this.size) as T;
+      this._scratch = this.allocate();
     }
     return this._scratch;
   }
@@ -213,6 +280,7 @@ export class Grid<T extends TypedArray = Float32Array> {
       const temp = this._data;
       this._data = this._scratch;
       this._scratch = temp;
+      this.dirty.fill(1);
     }
   }
 
@@ -223,19 +291,32 @@ export class Grid<T extends TypedArray = Float32Array> {
 
   diffuse(rate: number): void {
     const scratch = this.getScratch();
-    for (let i = 0; i < this.size; i++) {
-      const { x, y } = this.coords(i);
-      const current = this._data[i];
-      const neighborAvg = this.avgNeighbors8(x, y);
-      scratch[i] = current + (neighborAvg - current) * rate;
-    }
+    fusedRows(
+      this._data, scratch, this.width, this.height, 0, this.height,
+      rate, 1, -Infinity, Infinity, this.wrapEdges, this.defaultValue
+    );
     this.swap();
   }
 
   decay(rate: number): void {
-    for (let i = 0; i < this.size; i++) {
-      this._data[i] *= (1 - rate);
-    }
+    scaleInPlace(this._data, 1 - rate);
+    this.dirty.fill(1);
+  }
+
+  /**
+   * Diffuse, decay and (optionally) clamp to [min, max] in a single sweep
+   */
+  update(diffusionRate: number, decayRate: number, clamp: boolean = true): void {
+    const diffusing = diffusionRate !== 0;
+    const target = diffusing ? this.getScratch() : this._data;
+    fusedRows(
+      this._data, target, this.width, this.height, 0, this.height,
+      diffusionRate, 1 - decayRate,
+      clamp ? this.min : -Infinity, clamp ? this.max : Infinity,
+      this.wrapEdges, this.defaultValue
+    );
+    if (diffusing) this.swap();
+    else this.dirty.fill(1);
   }
 
   snapshot(): ArrayBuffer {
@@ -250,12 +331,75 @@ export class Grid<T extends TypedArray = Float32Array> {
   }
 
   restore(buffer: ArrayBuffer): void {
-    const ArrayConstructor = TYPE_MAP[this.dataType];
+    const ArrayConstructor = GRID_ARRAY_TYPES[this.dataType];
     const restored = new ArrayConstructor(buffer);
     if (restored.length !== this.size) {
       throw new Error('Snapshot size mismatch');
     }
     this._data.set(restored as T);
+    this.dirty.fill(1);
+  }
+
+  /**
+   * Capture the grid block by block. Blocks unchanged since `previous` are
+   * shared with it instead of copied. When `previous` is the last checkpoint
+   * taken or restored, writes since then were tracked per block and only
+   * the written blocks are compared and copied, so a checkpoint of a
+   * sparsely written field costs little beyond the blocks that changed.
+   * Otherwise every block is compared.
+   */
+  checkpoint(previous?: GridCheckpoint): GridCheckpoint {
+    const B = CHECKPOINT_BLOCK_SIZE;
+    const data = this._data;
+    const reuse = previous && !previous.chunked && previous.size === this.size &&
+      previous.blockSize === B ? previous.blocks : undefined;
+    const tracked = reuse !== undefined && previous === this.cleanAs;
+    const blocks: TypedArray[] = [];
+
+    for (let start = 0, b = 0; start < this.size; start += B, b++) {
+      const end = Math.min(this.size, start + B);
+      const prior = reuse?.[b];
+      if (tracked && prior && !this.dirty[b]) {
+        blocks.push(prior);
+        continue;
+      }
+      if (prior && prior.length === end - start && prior.constructor === data.constructor) {
+        let same = true;
+        for (let i = start; i < end; i++) {
+          if (data[i] !== prior[i - start]) {
+            same = false;
+            break;
+          }
+        }
+        if (same) {
+          blocks.push(prior);
+          continue;
+        }
+      }
+      blocks.push(data.slice(start, end));
+    }
+
+    const checkpoint: GridCheckpoint = { layer: this.name, size: this.size, blockSize: B, chunked: false, blocks };
+    this.dirty.fill(0);
+    this.cleanAs = checkpoint;
+    return checkpoint;
+  }
+
+  restoreCheckpoint(checkpoint: GridCheckpoint): void {
+    if (checkpoint.chunked || checkpoint.external || checkpoint.size !== this.size) {
+      throw new Error('Checkpoint layout mismatch');
+    }
+    for (let b = 0; b < checkpoint.blocks.length; b++) {
+      const block = checkpoint.blocks[b];
+      const start = b * checkpoint.blockSize;
+      if (block) {
+        this._data.set(block as T, start);
+      } else {
+        this._data.fill(this.defaultValue, start, Math.min(this.size, start + checkpoint.blockSize));
+      }
+    }
+    this.dirty.fill(0);
+    this.cleanAs = checkpoint.blockSize === CHECKPOINT_BLOCK_SIZE ? checkpoint : null;
   }
 
   clone(): Grid<T> {
@@ -266,7 +410,8 @@ export class Grid<T extends TypedArray = Float32Array> {
       defaultValue: this.defaultValue,
       min: this.min,
       max: this.max,
-      wrapEdges: this.wrapEdges
+      wrapEdges: this.wrapEdges,
+      shared: this.shared
     });
     cloned._data.set(this._data);
     return cloned;
@@ -302,6 +447,23 @@ export class Grid<T extends TypedArray = Float32Array> {
   }
 }
 
+// ============================================================================
+// Grid Backends
+// ============================================================================
+
+export type GridFactory = (config: GridLayerConfig & { dimensions: WorldDimensions }) => Grid;
+
+const GRID_BACKENDS: Map<string, GridFactory> = new Map([
+  ['dense', (config) => new Grid(config)],
+]);
+
+/**
+ * Register a storage backend selectable through GridLayerConfig.backend
+ */
+export function registerGridBackend(name: string, factory: GridFactory): void {
+  GRID_BACKENDS.set(name, factory);
+}
+
 // ============================================================================
 // Grid Manager
 // ============================================================================
@@ -330,10 +492,12 @@ export class GridManager {
     if (this._grids.has(config.name)) {
       throw new Error(`Grid layer "${config.name}" already exists`);
     }
-    const grid = new Grid({
-      ...config,
-      dimensions: this._dimensions
-    });
+    const backend = config.backend ?? 'dense';
+    const factory = GRID_BACKENDS.get(backend);
+    if (!factory) {
+      throw new Error(`Unknown grid backend "${backend}"`);
+    }
+    const grid = factory({ ...config, dimensions: this._dimensions });
     this._grids.set(config.name, grid);
     return grid;
   }
@@ -366,11 +530,35 @@ export class GridManager {
     return snapshots;
   }
 
-  restoreAll(snapshots: Record<string, ArrayBuffer>): void {
-    for (const [name, buffer] of Object.entries(snapshots)) {
+  /**
+   * Checkpoint every layer, sharing unchanged blocks with `previous`
+   */
+  checkpointAll(previous?: Record<string, GridCheckpoint>): Record<string, GridCheckpoint> {
+    const checkpoints: Record<string, GridCheckpoint> = {};
+    this._grids.forEach((grid, name) => {
+      checkpoints[name] = grid.checkpoint(previous?.[name]);
+    });
+    return checkpoints;
+  }
+
+  /**
+   * Restore full snapshots or checkpoints. Checkpointed chunked layers get
+   * their tile references swapped back in rather than copied. Throws before
+   * touching any layer when one was checkpointed as external.
+   */
+  restoreAll(snapshots: Record<string, ArrayBuffer | GridCheckpoint>): void {
+    for (const [name, state] of Object.entries(snapshots)) {
+      if (!(state instanceof ArrayBuffer) && state.external && this._grids.has(name)) {
+        throw new Error(`Grid layer "${name}" was checkpointed as external and cannot be restored`);
+      }
+    }
+    for (const [name, state] of Object.entries(snapshots)) {
       const grid = this._grids.get(name);
-      if (grid) {
-        grid.restore(buffer);
+      if (!grid) continue;
+      if (state instanceof ArrayBuffer) {
+        grid.restore(state);
+      } else {
+        grid.restoreCheckpoint(state);
       }
     }
   }
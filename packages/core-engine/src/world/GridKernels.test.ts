@@ -0,0 +1,192 @@
+/**
+ * GridKernels.test.ts - Tests for the fused grid kernels and band workers
+ */
+
+import { describe, it, expect } from 'vitest';
+import { Grid } from './Grid';
+import { World } from './World';
+import { GridWorkerPool } from './GridWorkers';
+
+function makeGrid(width: number, height: number, wrapEdges: boolean, defaultValue = 0, shared = false): Grid {
+  const grid = new Grid({
+    name: 'test',
+    type: 'float32',
+    dimensions: { width, height },
+    wrapEdges,
+    defaultValue,
+    shared,
+  });
+  for (let i = 0; i < grid.size; i++) {
+    grid.data[i] = ((i * 37) % 11) / 3;
+  }
+  return grid;
+}
+
+// Reference per-cell diffusion using the wrapped accessors
+function referenceDiffuse(grid: Grid, rate: number): Float32Array {
+  const out = new Float32Array(grid.size);
+  for (let y = 0; y < grid.height; y++) {
+    for (let x = 0; x < grid.width; x++) {
+      const i = y * grid.width + x;
+      const current = grid.data[i];
+      out[i] = current + (grid.avgNeighbors8(x, y) - current) * rate;
+    }
+  }
+  return out;
+}
+
+function expectClose(actual: ArrayLike<number>, expected: ArrayLike<number>): void {
+  expect(actual.length).toBe(expected.length);
+  for (let i = 0; i < expected.length; i++) {
+    expect(actual[i]).toBeCloseTo(expected[i], 5);
+  }
+}
+
+describe('Grid.diffuse', () => {
+  const shapes: Array<[number, number]> = [[1, 1], [2, 3], [5, 4], [16, 9]];
+
+  for (const [w, h] of shapes) {
+    it(`matches the per-cell reference on ${w}x${h} (wrapped)`, () => {
+      const grid = makeGrid(w, h, true);
+      const expected = referenceDiffuse(grid, 0.3);
+      grid.diffuse(0.3);
+      expectClose(grid.data, expected);
+    });
+
+    it(`matches the per-cell reference on ${w}x${h} (bounded)`, () => {
+      const grid = makeGrid(w, h, false, 0.5);
+      const expected = referenceDiffuse(grid, 0.3);
+      grid.diffuse(0.3);
+      expectClose(grid.data, expected);
+    });
+  }
+});
+
+describe('Grid.update', () => {
+  it('diffuses, decays and clamps in one pass', () => {
+    const grid = new Grid({
+      name: 'test',
+      type: 'float32',
+      dimensions: { width: 6, height: 5 },
+      max: 2,
+    });
+    for (let i = 0; i < grid.size; i++) grid.data[i] = i % 4;
+
+    const reference = grid.clone();
+    reference.diffuse(0.2);
+    reference.decay(0.1);
+    const expected = Array.from(reference.data, v => Math.min(2, v));
+
+    grid.update(0.2, 0.1);
+    expectClose(grid.data, expected);
+  });
+
+  it('decays in place without allocating scratch', () => {
+    const grid = makeGrid(4, 4, true);
+    const before = grid.memoryUsage();
+    const expected = Array.from(grid.data, v => v * 0.5);
+
+    grid.update(0, 0.5);
+
+    expectClose(grid.data, expected);
+    expect(grid.memoryUsage()).toBe(before);
+  });
+});
+
+describe('World.updateLayers', () => {
+  it('updates several layers in one sweep', () => {
+    const world = new World({ dimensions: { width: 8, height: 8 }, seed: 1 });
+    const a = world.addLayer({ name: 'a', type: 'float32' });
+    const b = world.addLayer({ name: 'b', type: 'float32', max: 1 });
+    for (let i = 0; i < 64; i++) {
+      a.data[i] = i % 5;
+      b.data[i] = (i % 3) * 0.6;
+    }
+
+    const refA = a.clone();
+    refA.diffuse(0.25);
+    const refB = Array.from(b.data, v => Math.min(1, v * 0.9));
+
+    world.updateLayers([
+      { layer: 'a', diffusionRate: 0.25 },
+      { layer: 'b', decayRate: 0.1 },
+      { layer: 'missing', decayRate: 0.5 },
+    ]);
+
+    expectClose(a.data, refA.data);
+    expectClose(b.data, refB);
+  });
+});
+
+describe('GridWorkerPool', () => {
+  it('produces the same result as the single-threaded kernel', async () => {
+    const pool = await GridWorkerPool.create({ threads: 2, minCells: 0 });
+    try {
+      const world = new World({ dimensions: { width: 33, height: 21 }, seed: 1 });
+      const layer = world.addLayer({ name: 'a', type: 'float32', shared: true, max: 3 });
+      for (let i = 0; i < layer.size; i++) layer.data[i] = ((i * 7) % 13) / 4;
+
+      const reference = layer.clone();
+      reference.update(0.4, 0.05);
+
+      world.setWorkerPool(pool);
+      world.updateLayers([{ layer: 'a', diffusionRate: 0.4, decayRate: 0.05 }]);
+
+      expectClose(layer.data, reference.data);
+    } finally {
+      await pool.terminate();
+    }
+  });
+
+  it('rethrows a band that fails in a worker', async () => {
+    // Workers rebuild views by constructor name, which a subclass lacks
+    class ForeignArray extends Float32Array {}
+    const pool = await GridWorkerPool.create({ threads: 1, minCells: 0 });
+    try {
+      const data = new ForeignArray(new SharedArrayBuffer(8 * 8 * 4));
+      const job = {
+        src: data,
+        dst: data,
+        diffusionRate: 0,
+        keep: 0.5,
+        min: -Infinity,
+        max: Infinity,
+        wrap: true,
+        edge: 0,
+      };
+
+      expect(() => pool.run([job], 8, 8)).toThrow(/band threw/);
+
+      const layer = makeGrid(8, 8, true, 0, true);
+      const expected = Array.from(layer.data, v => v * 0.5);
+      pool.run([{ ...job, src: layer.data, dst: layer.data }], 8, 8);
+      expectClose(layer.data, expected);
+    } finally {
+      await pool.terminate();
+    }
+  });
+
+  it('falls back to the calling thread for unshared layers', async () => {
+    const pool = await GridWorkerPool.create({ threads: 1, minCells: 0 });
+    try {
+      const grid = makeGrid(4, 4, true);
+      const job = {
+        src: grid.data,
+        dst: grid.data,
+        diffusionRate: 0,
+        keep: 0.5,
+        min: -Infinity,
+        max: Infinity,
+        wrap: true,
+        edge: 0,
+      };
+      const expected = Array.from(grid.data, v => v * 0.5);
+
+      expect(pool.accepts([job], 4, 4)).toBe(false);
+      pool.run([job], 4, 4);
+      expectClose(grid.data, expected);
+    } finally {
+      await pool.terminate();
+    }
+  });
+});
@@ -0,0 +1,182 @@
+/**
+ * GenesisX Core Engine - Grid Kernels
+ *
+ * Row-oriented, allocation-free kernels over raw grid buffers. The fused
+ * kernel diffuses (8-neighbour average), decays and clamps a band of rows
+ * in a single sweep. Interior cells read their neighbours by direct index;
+ * only the first/last column and rows without a neighbour row take the
+ * wrapped (or edge-valued) slow path.
+ *
+ * fusedRows depends only on wrappedAt and borderCell, so the three sources
+ * can be shipped to worker threads (see GridWorkers).
+ */
+
+import type { TypedArray } from './Grid';
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * One layer's work for a fused update. src and dst may be the same buffer
+ * only when diffusionRate is 0.
+ */
+export interface FusedLayerJob {
+  src: TypedArray;
+  dst: TypedArray;
+  diffusionRate: number;   // 0 = no diffusion
+  keep: number;            // Multiplier after diffusion, i.e. 1 - decay rate
+  min: number;
+  max: number;
+  wrap: boolean;
+  edge: number;            // Value read outside the grid when not wrapping
+}
+
+// ============================================================================
+// Kernels
+// ============================================================================
+
+/**
+ * Slow-path neighbour read: wrapped, or `edge` outside a bounded grid
+ */
+export function wrappedAt(
+  src: ArrayLike<number>,
+  width: number,
+  height: number,
+  x: number,
+  y: number,
+  wrap: boolean,
+  edge: number
+): number {
+  if (wrap) {
+    x = x < 0 ? x + width : x >= width ? x - width : x;
+    y = y < 0 ? y + height : y >= height ? y - height : y;
+  } else if (x < 0 || x >= width || y < 0 || y >= height) {
+    return edge;
+  }
+  return src[y * width + x];
+}
+
+/**
+ * Diffused value of one border cell through wrappedAt
+ */
+export function borderCell(
+  src: ArrayLike<number>,
+  width: number,
+  height: number,
+  x: number,
+  y: number,
+  rate: number,
+  wrap: boolean,
+  edge: number
+): number {
+  const current = src[y * width + x];
+  const sum =
+    wrappedAt(src, width, height, x - 1, y - 1, wrap, edge) +
+    wrappedAt(src, width, height, x, y - 1, wrap, edge) +
+    wrappedAt(src, width, height, x + 1, y - 1, wrap, edge) +
+    wrappedAt(src, width, height, x + 1, y, wrap, edge) +
+    wrappedAt(src, width, height, x + 1, y + 1, wrap, edge) +
+    wrappedAt(src, width, height, x, y + 1, wrap, edge) +
+    wrappedAt(src, width, height, x - 1, y + 1, wrap, edge) +
+    wrappedAt(src, width, height, x - 1, y, wrap, edge);
+  return current + (sum / 8 - current) * rate;
+}
+
+/**
+ * Diffuse, decay and clamp rows [y0, y1) of src into dst
+ */
+export function fusedRows(
+  src: ArrayLike<number>,
+  dst: { [index: number]: number },
+  width: number,
+  height: number,
+  y0: number,
+  y1: number,
+  rate: number,
+  keep: number,
+  min: number,
+  max: number,
+  wrap: boolean,
+  edge: number
+): void {
+  const clampOn = min !== -Infinity || max !== Infinity;
+
+  for (let y = y0; y < y1; y++) {
+    const row = y * width;
+
+    if (rate === 0) {
+      for (let i = row; i < row + width; i++) {
+        let v = src[i] * keep;
+        if (clampOn) v = v < min ? min : v > max ? max : v;
+        dst[i] = v;
+      }
+      continue;
+    }
+
+    const hasRows = wrap || (y > 0 && y < height - 1);
+    if (!hasRows || width < 3) {
+      for (let x = 0; x < width; x++) {
+        let v = borderCell(src, width, height, x, y, rate, wrap, edge) * keep;
+        if (clampOn) v = v < min ? min : v > max ? max : v;
+        dst[row + x] = v;
+      }
+      continue;
+    }
+
+    const up = (y === 0 ? height - 1 : y - 1) * width;
+    const down = (y === height - 1 ? 0 : y + 1) * width;
+
+    // Interior fast path
+    for (let x = 1; x < width - 1; x++) {
+      const current = src[row + x];
+      const sum =
+        src[up + x - 1] + src[up + x] + src[up + x + 1] +
+        src[row + x + 1] + src[down + x + 1] + src[down + x] +
+        src[down + x - 1] + src[row + x - 1];
+      let v = (current + (sum / 8 - current) * rate) * keep;
+      if (clampOn) v = v < min ? min : v > max ? max : v;
+      dst[row + x] = v;
+    }
+
+    // Border columns
+    let v = borderCell(src, width, height, 0, y, rate, wrap, edge) * keep;
+    if (clampOn) v = v < min ? min : v > max ? max : v;
+    dst[row] = v;
+    const last = width - 1;
+    v = borderCell(src, width, height, last, y, rate, wrap, edge) * keep;
+    if (clampOn) v = v < min ? min : v > max ? max : v;
+    dst[row + last] = v;
+  }
+}
+
+/**
+ * Run every job over rows [y0, y1), row by row so all layers of a row are
+ * processed while it is in cache
+ */
+export function fusedUpdate(
+  jobs: FusedLayerJob[],
+  width: number,
+  height: number,
+  y0: number = 0,
+  y1: number = height
+): void {
+  for (let y = y0; y < y1; y++) {
+    for (let j = 0; j < jobs.length; j++) {
+      const job = jobs[j];
+      fusedRows(
+        job.src, job.dst, width, height, y, y + 1,
+        job.diffusionRate, job.keep, job.min, job.max, job.wrap, job.edge
+      );
+    }
+  }
+}
+
+/**
+ * Multiply every element by factor
+ */
+export function scaleInPlace(data: TypedArray, factor: number): void {
+  for (let i = 0; i < data.length; i++) {
+    data[i] *= factor;
+  }
+}
@@ -0,0 +1,257 @@
+/**
+ * GenesisX Core Engine - Grid Worker Pool
+ *
+ * Band-parallel execution of the fused grid kernel on Node worker_threads.
+ * The grid is split into horizontal bands; the calling thread runs the
+ * first band and blocks on an Atomics counter until the workers finish the
+ * rest, so World.updateLayers stays synchronous inside a tick.
+ *
+ * Layers must be allocated with `shared: true` so the workers see the same
+ * memory. Bands only read neighbouring rows of the source buffer, which no
+ * band writes, so no halo exchange is needed.
+ *
+ * The calling thread cannot see worker 'error' or 'exit' events while it
+ * blocks, so workers report through shared memory instead: a band that
+ * throws sets a failed flag, and a worker that exits (uncaught error,
+ * process.exit) marks itself dead and counts its band as failed from its
+ * own exit handler. run() throws as soon as either shows up. A worker
+ * stopped without running its exit handler (terminated from outside,
+ * killed by the OS) is only caught by the timeoutMs bound. After a dead
+ * worker or a timeout the pool is unusable; later run() calls rethrow.
+ *
+ * Node only: worker_threads is imported lazily by create().
+ */
+
+import { fusedRows, fusedUpdate, wrappedAt, borderCell, FusedLayerJob } from './GridKernels';
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+export interface GridWorkerPoolConfig {
+  threads: number;     // Worker threads, in addition to the calling thread
+  minCells: number;    // Smaller grids run on the calling thread only
+  timeoutMs: number;   // Longest wait for the workers' bands in one run()
+}
+
+export const DEFAULT_GRID_WORKER_POOL_CONFIG: GridWorkerPoolConfig = {
+  threads: 3,
+  minCells: 256 * 256,
+  timeoutMs: 10000,
+};
+
+// The calling thread re-checks the deadline at least this often
+const WAIT_SLICE_MS = 50;
+
+// Slots of the shared status buffer
+const DONE_FINISHED = 0;   // Bands finished, successfully or not
+const DONE_FAILED = 1;     // Non-zero once a band threw or its worker exited
+const DONE_DEAD = 2;       // DONE_DEAD + i is non-zero once worker i has exited
+
+interface WorkerLike {
+  postMessage(message: unknown): void;
+  terminate(): Promise<number>;
+  on(event: 'error', listener: (error: Error) => void): unknown;
+  on(event: 'exit', listener: (code: number) => void): unknown;
+  unref?(): void;
+}
+
+interface BandMessage {
+  layers: Array<{
+    ctor: string;
+    src: SharedArrayBuffer;
+    dst: SharedArrayBuffer;
+    rate: number;
+    keep: number;
+    min: number;
+    max: number;
+    wrap: boolean;
+    edge: number;
+  }>;
+  width: number;
+  height: number;
+  y0: number;
+  y1: number;
+}
+
+const WORKER_SOURCE = `
+const { parentPort, workerData } = require('node:worker_threads');
+${wrappedAt.toString()}
+${borderCell.toString()}
+const fusedRows = (${fusedRows.toString()});
+const done = new Int32Array(workerData.done);
+let busy = false;
+process.on('exit', () => {
+  Atomics.store(done, ${DONE_DEAD} + workerData.index, 1);
+  if (busy) {
+    Atomics.store(done, ${DONE_FAILED}, 1);
+    Atomics.add(done, ${DONE_FINISHED}, 1);
+  }
+  Atomics.notify(done, ${DONE_FINISHED});
+});
+parentPort.on('message', (m) => {
+  busy = true;
+  try {
+    const layers = m.layers.map((l) => {
+      const C = globalThis[l.ctor];
+      return { l, src: new C(l.src), dst: new C(l.dst) };
+    });
+    for (let y = m.y0; y < m.y1; y++) {
+      for (const { l, src, dst } of layers) {
+        fusedRows(src, dst, m.width, m.height, y, y + 1,
+          l.rate, l.keep, l.min, l.max, l.wrap, l.edge);
+      }
+    }
+  } catch (e) {
+    Atomics.store(done, ${DONE_FAILED}, 1);
+  }
+  busy = false;
+  Atomics.add(done, ${DONE_FINISHED}, 1);
+  Atomics.notify(done, ${DONE_FINISHED});
+});
+`;
+
+// ============================================================================
+// GridWorkerPool Class
+// ============================================================================
+
+export class GridWorkerPool {
+  private config: GridWorkerPoolConfig;
+  private workers: WorkerLike[];
+  private done: Int32Array;                // Shared with the workers; see DONE_*
+  private failure: Error | null = null;   // Dead worker or timeout; the pool is unusable
+  private terminating: boolean = false;
+
+  private constructor(config: GridWorkerPoolConfig, workers: WorkerLike[], done: Int32Array) {
+    this.config = config;
+    this.workers = workers;
+    this.done = done;
+    // Seen between runs only; during run() the status buffer is what counts
+    for (const worker of workers) {
+      worker.on('error', (error) => this.fail(error));
+      worker.on('exit', (code) => {
+        if (!this.terminating) this.fail(new Error(`Grid worker exited with code ${code}`));
+      });
+    }
+  }
+
+  /**
+   * Spawn the worker threads
+   */
+  static async create(config?: Partial<GridWorkerPoolConfig>): Promise<GridWorkerPool> {
+    const full = { ...DEFAULT_GRID_WORKER_POOL_CONFIG, ...config };
+    const { Worker } = await import('node:worker_threads');
+    const threads = Math.max(0, full.threads);
+    const done = new Int32Array(new SharedArrayBuffer(4 * (DONE_DEAD + threads)));
+    const workers: WorkerLike[] = [];
+    for (let i = 0; i < threads; i++) {
+      const worker = new Worker(WORKER_SOURCE, { eval: true, workerData: { done: done.buffer, index: i } });
+      worker.unref();
+      workers.push(worker);
+    }
+    return new GridWorkerPool(full, workers, done);
+  }
+
+  get threads(): number {
+    return this.workers.length;
+  }
+
+  /**
+   * Whether a job list is worth (and able to be) split across workers
+   */
+  accepts(jobs: FusedLayerJob[], width: number, height: number): boolean {
+    if (this.workers.length === 0 || width * height < this.config.minCells) return false;
+    return jobs.every(job =>
+      job.src.buffer instanceof SharedArrayBuffer &&
+      job.dst.buffer instanceof SharedArrayBuffer
+    );
+  }
+
+  /**
+   * Run the fused kernel over the whole grid, split into bands. Falls back
+   * to the calling thread when accepts() is false.
+   */
+  run(jobs: FusedLayerJob[], width: number, height: number): void {
+    if (!this.accepts(jobs, width, height)) {
+      fusedUpdate(jobs, width, height);
+      return;
+    }
+    if (this.failure) throw this.failure;
+    this.checkWorkers();
+
+    const bands = Math.min(this.workers.length + 1, height);
+    const rowsPerBand = Math.ceil(height / bands);
+    const layers = jobs.map(job => ({
+      ctor: job.src.constructor.name,
+      src: job.src.buffer as SharedArrayBuffer,
+      dst: job.dst.buffer as SharedArrayBuffer,
+      rate: job.diffusionRate,
+      keep: job.keep,
+      min: job.min,
+      max: job.max,
+      wrap: job.wrap,
+      edge: job.edge,
+    }));
+
+    Atomics.store(this.done, DONE_FINISHED, 0);
+    Atomics.store(this.done, DONE_FAILED, 0);
+    let posted = 0;
+    for (let b = 1; b < bands; b++) {
+      const y0 = b * rowsPerBand;
+      const y1 = Math.min(height, y0 + rowsPerBand);
+      if (y0 >= y1) break;
+      const message: BandMessage = { layers, width, height, y0, y1 };
+      this.workers[b - 1].postMessage(message);
+      posted++;
+    }
+
+    fusedUpdate(jobs, width, height, 0, Math.min(height, rowsPerBand));
+
+    // A worker that exits counts its band as finished and failed, so only
+    // one stopped without its exit handler runs into the deadline
+    const deadline = Date.now() + this.config.timeoutMs;
+    for (;;) {
+      const finished = Atomics.load(this.done, DONE_FINISHED);
+      if (finished >= posted) break;
+      if (Date.now() >= deadline) {
+        this.failure = new Error(`Grid workers did not finish within ${this.config.timeoutMs} ms`);
+        throw this.failure;
+      }
+      Atomics.wait(this.done, DONE_FINISHED, finished, WAIT_SLICE_MS);
+    }
+
+    if (Atomics.load(this.done, DONE_FAILED) !== 0) {
+      this.checkWorkers();
+      throw new Error('A grid worker band threw; layers were not fully updated');
+    }
+  }
+
+  // Throw (and disable the pool) if a worker has marked itself dead
+  private checkWorkers(): void {
+    for (let i = 0; i < this.workers.length; i++) {
+      if (Atomics.load(this.done, DONE_DEAD + i) !== 0) {
+        this.fail(new Error(`Grid worker ${i} exited; layers were not fully updated`));
+        throw this.failure!;
+      }
+    }
+  }
+
+  async terminate(): Promise<void> {
+    this.terminating = true;
+    await Promise.all(this.workers.map(worker => worker.terminate()));
+    this.workers = [];
+  }
+
+  /**
+   * Record a dead worker; the pool is unusable from here on
+   */
+  private fail(error: Error): void {
+    if (!this.failure) this.failure = error;
+  }
+
+  getConfig(): GridWorkerPoolConfig {
+    return { ...this.config };
+  }
+}
+
+export default GridWorkerPool;
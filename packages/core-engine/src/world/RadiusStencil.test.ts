@@ -0,0 +1,117 @@
+/**
+ * RadiusStencil.test.ts - Tests for radius stencils and world radius queries
+ */
+
+import { describe, it, expect } from 'vitest';
+import { getRadiusStencil } from './RadiusStencil';
+import { World } from './World';
+
+function makeWorld(wrapEdges: boolean): World {
+  const world = new World({
+    dimensions: { width: 24, height: 20 },
+    seed: 3,
+    wrapEdges,
+    layers: [
+      { name: 'food', type: 'float32', wrapEdges },
+      { name: 'scent', type: 'float32', wrapEdges, backend: 'chunked', chunkSize: 8 },
+    ],
+  });
+  for (let y = 0; y < 20; y++) {
+    for (let x = 0; x < 24; x++) {
+      const value = ((x * 7 + y * 13) % 11) / 10;
+      world.setValue('food', x, y, value);
+      world.setValue('scent', x, y, value);
+    }
+  }
+  return world;
+}
+
+describe('RadiusStencil', () => {
+  it('covers exactly the cells within the radius', () => {
+    for (const radius of [0, 1, 2.5, 5, 10]) {
+      const stencil = getRadiusStencil(radius);
+      let expected = 0;
+      const reach = Math.ceil(radius);
+      for (let dy = -reach; dy <= reach; dy++) {
+        for (let dx = -reach; dx <= reach; dx++) {
+          if (dx * dx + dy * dy <= radius * radius) expected++;
+        }
+      }
+      expect(stencil.length).toBe(expected);
+      for (let k = 0; k < stencil.length; k++) {
+        expect(stencil.distSq[k]).toBe(stencil.dx[k] ** 2 + stencil.dy[k] ** 2);
+        expect(stencil.distSq[k]).toBeLessThanOrEqual(radius * radius);
+        expect(stencil.weights[k]).toBeGreaterThan(0);
+      }
+    }
+  });
+
+  it('is cached per radius', () => {
+    expect(getRadiusStencil(10)).toBe(getRadiusStencil(10));
+  });
+
+  it('shares one stencil between radii covering the same cells', () => {
+    expect(getRadiusStencil(2.5)).toBe(getRadiusStencil(2.55));
+    expect(getRadiusStencil(2.5)).not.toBe(getRadiusStencil(2.7));
+  });
+});
+
+describe('World radius queries', () => {
+  for (const wrap of [true, false]) {
+    it(`reductions match a scan of getCellsInRadius (${wrap ? 'wrapped' : 'bounded'})`, () => {
+      const world = makeWorld(wrap);
+      for (const [cx, cy, radius] of [[0, 0, 3], [12, 10, 5], [23, 19, 4], [5, 18, 10]]) {
+        const cells = world.getCellsInRadius(cx, cy, radius);
+        let sum = 0;
+        let weighted = 0;
+        let max = -Infinity;
+        for (const cell of cells) {
+          const value = world.getValue('food', cell.x, cell.y);
+          const dist = world.distance(cx, cy, cell.x, cell.y);
+          sum += value;
+          weighted += value * (1 - dist / (radius + 1));
+          max = Math.max(max, value);
+        }
+
+        expect(world.sumInRadius('food', cx, cy, radius)).toBeCloseTo(sum, 4);
+        expect(world.sumInRadius('scent', cx, cy, radius)).toBeCloseTo(sum, 4);
+        expect(world.sumInRadius('food', cx, cy, radius, true)).toBeCloseTo(weighted, 4);
+        expect(world.maxInRadius('food', cx, cy, radius)).toBeCloseTo(max, 5);
+
+        let visited = 0;
+        world.forEachCellInRadius(cx, cy, radius, (x, y, index) => {
+          expect(index).toBe(y * 24 + x);
+          visited++;
+        });
+        expect(visited).toBe(cells.length);
+      }
+    });
+  }
+
+  it('keeps the exact scan for fractional centres', () => {
+    const world = makeWorld(false);
+    const cells = world.getCellsInRadius(4.5, 4.5, 1);
+    expect(cells.length).toBe(4);
+  });
+
+  it('treats fractional centres as their containing cell in reductions', () => {
+    const world = makeWorld(true);
+    expect(world.sumInRadius('food', 7.8, 3.2, 4)).toBe(world.sumInRadius('food', 7, 3, 4));
+    expect(world.sumInRadius('missing', 7, 3, 4)).toBe(0);
+    expect(world.maxInRadius('missing', 7, 3, 4)).toBe(-Infinity);
+  });
+
+  it('wraps reductions as the layer does, not as the world does', () => {
+    const world = new World({
+      dimensions: { width: 24, height: 20 },
+      wrapEdges: true,
+      layers: [{ name: 'wall', type: 'float32', wrapEdges: false }],
+    });
+    world.setValue('wall', 23, 0, 5);
+    world.setValue('wall', 1, 0, 2);
+
+    expect(world.sumInRadius('wall', 0, 0, 2)).toBe(2);
+    expect(world.maxInRadius('wall', 0, 0, 2)).toBe(2);
+    expect(world.sumInRadius('wall', 22, 0, 2)).toBe(5);
+  });
+});
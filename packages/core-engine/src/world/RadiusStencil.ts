@@ -0,0 +1,101 @@
+/**
+ * GenesisX Core Engine - Radius Stencils
+ *
+ * Precomputed integer offsets of the cells within a radius of a cell
+ * centre. Stencils are built once per set of covered cells and shared, so
+ * radius queries on the world (sensing, reductions) allocate nothing per
+ * call.
+ *
+ * Offsets are stored row by row in the same order as a y-then-x scan; each
+ * row of a disc is a contiguous, symmetric span, which the reductions use
+ * to walk layer data directly.
+ */
+
+// ============================================================================
+// Types
+// ============================================================================
+
+export interface RadiusStencil {
+  readonly radius: number;        // sqrt of the integer squared radius the stencil covers
+  readonly length: number;        // Number of cells
+  readonly dx: Int32Array;
+  readonly dy: Int32Array;
+  readonly distSq: Int32Array;
+  readonly weights: Float32Array; // Linear falloff: 1 at the centre, > 0 at the rim
+  readonly rowDy: Int32Array;     // One entry per row of the disc
+  readonly rowHalf: Int32Array;   // Row covers dx in [-rowHalf, rowHalf]
+  readonly rowStart: Int32Array;  // Offset of the row's first cell in dx/dy
+}
+
+// ============================================================================
+// Cache
+// ============================================================================
+
+// Keyed by floor(radius^2). Offsets have integer squared distances, so all
+// radii with the same key cover the same cells; the cache holds at most one
+// stencil per integer squared radius, however callers compute their radii.
+const STENCILS: Map<number, RadiusStencil> = new Map();
+
+/**
+ * Get (building on first use) the stencil for a radius
+ */
+export function getRadiusStencil(radius: number): RadiusStencil {
+  const r = Math.max(0, radius);
+  const radiusSq = Math.floor(r * r);
+  let stencil = STENCILS.get(radiusSq);
+  if (!stencil) {
+    stencil = buildRadiusStencil(radiusSq);
+    STENCILS.set(radiusSq, stencil);
+  }
+  return stencil;
+}
+
+/**
+ * Drop all cached stencils
+ */
+export function clearRadiusStencils(): void {
+  STENCILS.clear();
+}
+
+function buildRadiusStencil(radiusSq: number): RadiusStencil {
+  const r = Math.sqrt(radiusSq);
+  const reach = Math.floor(r);
+
+  const rows = 2 * reach + 1;
+  const rowDy = new Int32Array(rows);
+  const rowHalf = new Int32Array(rows);
+  const rowStart = new Int32Array(rows);
+
+  let length = 0;
+  for (let i = 0; i < rows; i++) {
+    const dy = i - reach;
+    let half = Math.floor(Math.sqrt(radiusSq - dy * dy));
+    // Guard against sqrt rounding at exact boundaries
+    while ((half + 1) * (half + 1) + dy * dy <= radiusSq) half++;
+    while (half > 0 && half * half + dy * dy > radiusSq) half--;
+    rowDy[i] = dy;
+    rowHalf[i] = half;
+    rowStart[i] = length;
+    length += 2 * half + 1;
+  }
+
+  const dx = new Int32Array(length);
+  const dyOut = new Int32Array(length);
+  const distSq = new Int32Array(length);
+  const weights = new Float32Array(length);
+
+  let k = 0;
+  for (let i = 0; i < rows; i++) {
+    const dy = rowDy[i];
+    for (let x = -rowHalf[i]; x <= rowHalf[i]; x++) {
+      const d2 = x * x + dy * dy;
+      dx[k] = x;
+      dyOut[k] = dy;
+      distSq[k] = d2;
+      weights[k] = 1 - Math.sqrt(d2) / (r + 1);
+      k++;
+    }
+  }
+
+  return { radius: r, length, dx, dy: dyOut, distSq, weights, rowDy, rowHalf, rowStart };
+}
@@ -0,0 +1,132 @@
+/**
+ * World.test.ts - Tests for copy-on-write and delta world checkpoints
+ */
+
+import { describe, it, expect } from 'vitest';
+import { World } from './World';
+import { ChunkedGrid } from './ChunkedGrid';
+import { CHECKPOINT_BLOCK_SIZE } from './Grid';
+
+function makeWorld(): World {
+  return new World({
+    dimensions: { width: 128, height: 128 },
+    seed: 7,
+    layers: [
+      { name: 'energy', type: 'float32' },
+      { name: 'scent', type: 'float32', backend: 'chunked', chunkSize: 16 },
+    ],
+  });
+}
+
+describe('World checkpoints', () => {
+  it('restores layers, metadata, step and rng state', () => {
+    const world = makeWorld();
+    world.setValue('energy', 5, 5, 3);
+    world.setValue('scent', 70, 70, 2);
+    world.setMetadata('season', 'spring');
+    world.currentStep = 10;
+    world.random();
+
+    const checkpoint = world.checkpoint();
+    const expectedRandom = world.random();
+
+    world.setValue('energy', 5, 5, 9);
+    world.setValue('scent', 70, 70, 8);
+    world.setValue('scent', 1, 1, 1);
+    world.setMetadata('season', 'winter');
+    world.currentStep = 99;
+
+    world.restoreCheckpoint(checkpoint);
+
+    expect(world.getValue('energy', 5, 5)).toBe(3);
+    expect(world.getValue('scent', 70, 70)).toBe(2);
+    expect(world.getValue('scent', 1, 1)).toBe(0);
+    expect(world.getMetadata('season')).toBe('spring');
+    expect(world.currentStep).toBe(10);
+    expect(world.random()).toBe(expectedRandom);
+  });
+
+  it('shares chunked tiles until they are written', () => {
+    const world = makeWorld();
+    const scent = world.getLayer('scent') as ChunkedGrid;
+    scent.set(3, 3, 1);
+    scent.set(100, 100, 1);
+
+    const checkpoint = world.checkpoint();
+    const blocks = checkpoint.grids.scent.blocks;
+    const residentBefore = blocks.filter(Boolean).length;
+
+    scent.set(3, 3, 5);
+
+    expect(blocks[0]![3 * 16 + 3]).toBe(1);
+    expect(scent.get(3, 3)).toBe(5);
+    expect(residentBefore).toBe(2);
+
+    // A second checkpoint shares the untouched tile with the first
+    const second = world.checkpoint(checkpoint);
+    const far = Math.floor(100 / 16) * scent.tilesX + Math.floor(100 / 16);
+    expect(second.grids.scent.blocks[far]).toBe(blocks[far]);
+    expect(second.grids.scent.blocks[0]).not.toBe(blocks[0]);
+  });
+
+  it('can restore the same checkpoint more than once', () => {
+    const world = makeWorld();
+    world.setValue('scent', 20, 20, 4);
+    const checkpoint = world.checkpoint();
+
+    world.restoreCheckpoint(checkpoint);
+    world.setValue('scent', 20, 20, 7);
+    world.updateLayers([{ layer: 'scent', diffusionRate: 0.5 }]);
+    world.restoreCheckpoint(checkpoint);
+
+    expect(world.getValue('scent', 20, 20)).toBe(4);
+    expect(world.getValue('scent', 21, 20)).toBe(0);
+  });
+
+  it('shares unchanged dense blocks with the previous checkpoint', () => {
+    const world = makeWorld();
+    const first = world.checkpoint();
+
+    world.setValue('energy', 0, 0, 1);
+    const second = world.checkpoint(first);
+
+    const a = first.grids.energy.blocks;
+    const b = second.grids.energy.blocks;
+    expect(a.length).toBe(Math.ceil(128 * 128 / CHECKPOINT_BLOCK_SIZE));
+    expect(b[0]).not.toBe(a[0]);
+    for (let i = 1; i < a.length; i++) {
+      expect(b[i]).toBe(a[i]);
+    }
+
+    world.restoreCheckpoint(first);
+    expect(world.getValue('energy', 0, 0)).toBe(0);
+  });
+
+  it('copies only the dense blocks written since the last checkpoint', () => {
+    const world = makeWorld();
+    const grid = world.getLayer('energy')!;
+    const first = world.checkpoint();
+
+    // Direct writes to data are only seen once marked
+    grid.data[0] = 4;
+    const second = world.checkpoint(first);
+    expect(second.grids.energy.blocks[0]).toBe(first.grids.energy.blocks[0]);
+
+    grid.markDirty(0);
+    const third = world.checkpoint(second);
+    expect(third.grids.energy.blocks[0]).not.toBe(second.grids.energy.blocks[0]);
+    expect(third.grids.energy.blocks[0]![0]).toBe(4);
+
+    // Against an older checkpoint every block is compared
+    const fourth = world.checkpoint(first);
+    expect(fourth.grids.energy.blocks[0]![0]).toBe(4);
+    expect(fourth.grids.energy.blocks[1]).toBe(first.grids.energy.blocks[1]);
+
+    world.restoreCheckpoint(first);
+    world.setValue('energy', 0, 127, 2);
+    const fifth = world.checkpoint(first);
+    const last = fifth.grids.energy.blocks.length - 1;
+    expect(fifth.grids.energy.blocks[last]).not.toBe(first.grids.energy.blocks[last]);
+    expect(fifth.grids.energy.blocks[0]).toBe(first.grids.energy.blocks[0]);
+  });
+});
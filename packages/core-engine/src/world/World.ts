@@ -7,7 +7,11 @@
  * - digital-organisms' simple but effective state tracking
  */
 
-import { Grid, GridManager, TypedArray } from './Grid';
+import { Grid, GridCheckpoint, GridManager, TypedArray } from './Grid';
+import './ChunkedGrid';
+import { fusedUpdate, FusedLayerJob } from './GridKernels';
+import { getRadiusStencil } from './RadiusStencil';
+import type { GridWorkerPool } from './GridWorkers';
 import type {
   WorldConfig,
   WorldDimensions,
@@ -40,6 +44,31 @@ export interface WorldStats {
   entityCount: number;
 }
 
+/**
+ * Per-layer settings for World.updateLayers
+ */
+export interface LayerUpdate {
+  layer: string;
+  diffusionRate?: number;
+  decayRate?: number;
+  clamp?: boolean;   // Clamp to the layer's min/max (default true)
+}
+
+/**
+ * In-memory world checkpoint for undo, replay or rewind. Grid blocks are
+ * shared with the live world and earlier checkpoints wherever unchanged.
+ */
+export interface WorldCheckpoint {
+  step: number;
+  rngState: number;
+  metadata: Record<string, unknown>;
+  grids: Record<string, GridCheckpoint>;
+}
+
+const REDUCE_SUM = 0;
+const REDUCE_WEIGHTED_SUM = 1;
+const REDUCE_MAX = 2;
+
 export const StandardLayers = {
   ENERGY: 'energy',
   TERRAIN: 'terrain',
@@ -69,6 +98,7 @@ export class World {
   private readonly _seed: number;
   private _rngState: number;
   private _metadata: Map<string, unknown> = new Map();
+  private _workers?: GridWorkerPool;
 
   constructor(config: WorldConfig) {
     this._config = { ...config };
@@ -232,8 +262,25 @@ export class World {
 
   getCellsInRadius(centerX: number, centerY: number, radius: number): Position[] {
     const cells: Position[] = [];
-    const radiusSq = radius * radius;
 
+    // Cell centres use the shared stencil; fractional centres scan the box
+    if (Number.isInteger(centerX) && Number.isInteger(centerY)) {
+      const stencil = getRadiusStencil(radius);
+      for (let k = 0; k < stencil.length; k++) {
+        let x = centerX + stencil.dx[k];
+        let y = centerY + stencil.dy[k];
+        if (this.wrapEdges) {
+          x = ((x % this.width) + this.width) % this.width;
+          y = ((y % this.height) + this.height) % this.height;
+        } else if (!this.inBounds(x, y)) {
+          continue;
+        }
+        cells.push({ x, y });
+      }
+      return cells;
+    }
+
+    const radiusSq = radius * radius;
     const minX = Math.floor(centerX - radius);
     const maxX = Math.ceil(centerX + radius);
     const minY = Math.floor(centerY - radius);
@@ -243,9 +290,13 @@ export class World {
       for (let x = minX; x <= maxX; x++) {
         const distSq = (x - centerX) ** 2 + (y - centerY) ** 2;
         if (distSq <= radiusSq) {
-          const wrapped = this.wrapCoords(x, y);
-          if (this.wrapEdges || this.inBounds(x, y)) {
-            cells.push({ x: wrapped.x, y: wrapped.y });
+          if (this.wrapEdges) {
+            cells.push({
+              x: ((x % this.width) + this.width) % this.width,
+              y: ((y % this.height) + this.height) % this.height
+            });
+          } else if (this.inBounds(x, y)) {
+            cells.push({ x, y });
           }
         }
       }
@@ -254,6 +305,105 @@ export class World {
     return cells;
   }
 
+  /**
+   * Visit every cell within `radius` of the cell containing (centerX,
+   * centerY), with wrapped coordinates and the cell index. Allocates nothing
+   * beyond the caller's visitor.
+   */
+  forEachCellInRadius(
+    centerX: number,
+    centerY: number,
+    radius: number,
+    visitor: (x: number, y: number, index: number, distSq: number) => void
+  ): void {
+    const stencil = getRadiusStencil(radius);
+    const cx = Math.floor(centerX);
+    const cy = Math.floor(centerY);
+    for (let k = 0; k < stencil.length; k++) {
+      let x = cx + stencil.dx[k];
+      let y = cy + stencil.dy[k];
+      if (this.wrapEdges) {
+        if (x < 0 || x >= this.width) x = ((x % this.width) + this.width) % this.width;
+        if (y < 0 || y >= this.height) y = ((y % this.height) + this.height) % this.height;
+      } else if (!this.inBounds(x, y)) {
+        continue;
+      }
+      visitor(x, y, y * this.width + x, stencil.distSq[k]);
+    }
+  }
+
+  /**
+   * Sum of a layer over the disc around the cell containing (centerX,
+   * centerY). `weighted` applies the stencil's linear distance falloff.
+   */
+  sumInRadius(layer: string, centerX: number, centerY: number, radius: number, weighted: boolean = false): number {
+    const grid = this._grids.getLayer(layer);
+    if (!grid) return 0;
+    return this.reduceInRadius(grid, centerX, centerY, radius, weighted ? REDUCE_WEIGHTED_SUM : REDUCE_SUM);
+  }
+
+  /**
+   * Maximum of a layer over the disc around the cell containing (centerX,
+   * centerY); -Infinity if the layer is missing or the disc lies entirely
+   * outside the world
+   */
+  maxInRadius(layer: string, centerX: number, centerY: number, radius: number): number {
+    const grid = this._grids.getLayer(layer);
+    if (!grid) return -Infinity;
+    return this.reduceInRadius(grid, centerX, centerY, radius, REDUCE_MAX);
+  }
+
+  /**
+   * Walk the stencil row spans directly over the layer data, wrapping as the
+   * layer does (a layer may be bounded inside a wrapping world)
+   */
+  private reduceInRadius(grid: Grid, centerX: number, centerY: number, radius: number, mode: number): number {
+    const stencil = getRadiusStencil(radius);
+    const { rowDy, rowHalf, rowStart, weights } = stencil;
+    const width = grid.width;
+    const height = grid.height;
+    const wrap = grid.wrapEdges;
+    const data = grid.dense ? grid.data : null;
+    const cx = Math.floor(centerX);
+    const cy = Math.floor(centerY);
+
+    let acc = mode === REDUCE_MAX ? -Infinity : 0;
+    for (let r = 0; r < rowDy.length; r++) {
+      let y = cy + rowDy[r];
+      if (y < 0 || y >= height) {
+        if (!wrap) continue;
+        y = ((y % height) + height) % height;
+      }
+
+      const half = rowHalf[r];
+      let x0 = cx - half;
+      let x1 = cx + half;
+      let k = rowStart[r];
+      if (!wrap) {
+        if (x0 < 0) {
+          k -= x0;
+          x0 = 0;
+        }
+        if (x1 >= width) x1 = width - 1;
+      }
+      const crosses = x0 < 0 || x1 >= width;
+      const base = y * width;
+
+      for (let x = x0; x <= x1; x++, k++) {
+        const xx = crosses ? ((x % width) + width) % width : x;
+        const value = data ? data[base + xx] : grid.getAt(base + xx);
+        if (mode === REDUCE_SUM) {
+          acc += value;
+        } else if (mode === REDUCE_WEIGHTED_SUM) {
+          acc += value * weights[k];
+        } else if (value > acc) {
+          acc = value;
+        }
+      }
+    }
+    return acc;
+  }
+
   private _mulberry32(): number {
     let t = (this._rngState += 0x6d2b79f5);
     t = Math.imul(t ^ (t >>> 15), t | 1);
@@ -326,6 +476,64 @@ export class World {
     grid?.decay(rate);
   }
 
+  /**
+   * Diffuse, decay and clamp several layers in one fused sweep over the
+   * rows. Runs band-parallel when a worker pool is attached and every
+   * layer is shared. Chunked layers update separately; unknown layers are
+   * skipped.
+   */
+  updateLayers(updates: LayerUpdate[]): void {
+    const jobs: FusedLayerJob[] = [];
+    const diffused: Grid<TypedArray>[] = [];
+    const inPlace: Grid<TypedArray>[] = [];
+
+    for (const update of updates) {
+      const grid = this._grids.getLayer<TypedArray>(update.layer);
+      if (!grid) continue;
+
+      const rate = update.diffusionRate ?? 0;
+      const clamp = update.clamp ?? true;
+      if (!grid.dense) {
+        grid.update(rate, update.decayRate ?? 0, clamp);
+        continue;
+      }
+      if (rate !== 0) diffused.push(grid);
+      else inPlace.push(grid);
+      jobs.push({
+        src: grid.data,
+        dst: rate !== 0 ? grid.getScratch() : grid.data,
+        diffusionRate: rate,
+        keep: 1 - (update.decayRate ?? 0),
+        min: clamp ? grid.min : -Infinity,
+        max: clamp ? grid.max : Infinity,
+        wrap: grid.wrapEdges,
+        edge: grid.defaultValue,
+      });
+    }
+    if (jobs.length === 0) return;
+
+    if (this._workers) {
+      this._workers.run(jobs, this.width, this.height);
+    } else {
+      fusedUpdate(jobs, this.width, this.height);
+    }
+
+    // Bands cover every row, so every block was written
+    for (const grid of diffused) {
+      grid.swap();
+    }
+    for (const grid of inPlace) {
+      grid.markDirty(0, grid.size);
+    }
+  }
+
+  /**
+   * Attach (or detach) a worker pool for updateLayers
+   */
+  setWorkerPool(pool: GridWorkerPool | undefined): void {
+    this._workers = pool;
+  }
+
   snapshot(): SerializedWorldState {
     return {
       dimensions: this.dimensions,
@@ -354,6 +562,28 @@ export class World {
     }
   }
 
+  /**
+   * Cheap checkpoint of all layers. Pass the previous checkpoint so dense
+   * layers can share their unchanged blocks with it. File-backed layers are
+   * flushed and recorded as external, and restoring a checkpoint that holds
+   * one throws without changing the world.
+   */
+  checkpoint(previous?: WorldCheckpoint): WorldCheckpoint {
+    return {
+      step: this._currentStep,
+      rngState: this._rngState,
+      metadata: this.getAllMetadata(),
+      grids: this._grids.checkpointAll(previous?.grids),
+    };
+  }
+
+  restoreCheckpoint(checkpoint: WorldCheckpoint): void {
+    this._grids.restoreAll(checkpoint.grids);
+    this._metadata = new Map(Object.entries(checkpoint.metadata));
+    this._rngState = checkpoint.rngState;
+    this._currentStep = checkpoint.step;
+  }
+
   clear(): void {
     this._grids.clearAll();
     this._metadata.clear();
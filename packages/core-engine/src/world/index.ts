@@ -3,6 +3,15 @@
  */
 
 export { World, StandardLayers } from './World';
-export type { Position, Region, WorldStats } from './World';
-export { Grid, GridManager } from './Grid';
-export type { TypedArray, GridDataType } from './Grid';
+export type { Position, Region, WorldStats, LayerUpdate, WorldCheckpoint } from './World';
+export { Grid, GridManager, registerGridBackend, CHECKPOINT_BLOCK_SIZE } from './Grid';
+export type { TypedArray, GridDataType, GridFactory, GridCheckpoint } from './Grid';
+export { ChunkedGrid, DEFAULT_CHUNK_SIZE } from './ChunkedGrid';
+export { FileBackedGrid, registerFileGridBackend, DEFAULT_PAGE_SIZE, DEFAULT_CACHE_PAGES } from './FileBackedGrid';
+export type { GridFileSystem, FileBackedGridStats } from './FileBackedGrid';
+export { getRadiusStencil, clearRadiusStencils } from './RadiusStencil';
+export type { RadiusStencil } from './RadiusStencil';
+export { fusedRows, fusedUpdate, scaleInPlace } from './GridKernels';
+export type { FusedLayerJob } from './GridKernels';
+export { GridWorkerPool, DEFAULT_GRID_WORKER_POOL_CONFIG } from './GridWorkers';
+export type { GridWorkerPoolConfig } from './GridWorkers';